@@ -322,7 +322,6 @@ function Get-TweakCatalog {
             Set-RegDword "HKLM" $nvClassKey "PowerMizerEnable" 0 | Out-Null
             Set-RegDword "HKLM" $nvClassKey "PowerMizerLevel" 1 | Out-Null
             Set-RegDword "HKLM" $nvClassKey "PowerMizerLevelAC" 1 | Out-Null
-            Set-RegDword "HKLM" "SYSTEM\CurrentControlSet\Control\GraphicsDrivers" "PendingDriverOperations" 1 | Out-Null
             Set-RegDword "HKLM" "SOFTWARE\NVIDIA Corporation\Global\NVTweak" "Prerender" 1 | Out-Null
             Write-Status "NVIDIA max performance + 1 prerendered frame (skips on non-NVIDIA)"
         }
@@ -809,7 +808,6 @@ function Apply-GPUTweaks {
     Set-RegDword "HKLM" $nvKey "PowerMizerEnable" 0 | Out-Null
     Set-RegDword "HKLM" $nvKey "PowerMizerLevel" 1 | Out-Null
     Set-RegDword "HKLM" $nvKey "PowerMizerLevelAC" 1 | Out-Null
-    Set-RegDword "HKLM" "SYSTEM\CurrentControlSet\Control\GraphicsDrivers" "PendingDriverOperations" 1 | Out-Null
     Set-RegDword "HKLM" "SOFTWARE\NVIDIA Corporation\Global\NVTweak" "Prerender" 1 | Out-Null
     Write-Status "NVIDIA max performance + 1 prerendered frame (skipped if not NVIDIA)"
 
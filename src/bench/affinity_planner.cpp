@@ -0,0 +1,186 @@
+#include "affinity_planner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+namespace affinity_planner {
+
+const char* KindName(DeviceKind kind)
+{
+    switch (kind) {
+    case DeviceKind::Display: return "display";
+    case DeviceKind::Network: return "network";
+    case DeviceKind::Usb:     return "usb";
+    }
+    return "?";
+}
+
+bool ParseKind(const std::string& text, DeviceKind& out)
+{
+    for (DeviceKind k : { DeviceKind::Display, DeviceKind::Network, DeviceKind::Usb })
+        if (text == KindName(k))
+        {
+            out = k;
+            return true;
+        }
+    return false;
+}
+
+// ─── Planning ────────────────────────────────────────────────────────────────
+
+namespace {
+
+enum Tier { kFreePerformance, kFreeEfficiency, kCoreZero, kGameCore };
+
+struct Candidate {
+    uint32_t cpu;        // primary thread of the core
+    Tier     tier;
+    bool     sharesL2;   // with a game core
+    std::size_t quiet;   // rank in quietOrder, size() when unranked
+};
+
+} // namespace
+
+Plan Build(const cpu_topology::Topology& t, const Request& req, bool dwordMask)
+{
+    Plan plan;
+
+    std::set<uint32_t> gameCores;
+    std::set<int>      gameL2;
+    for (uint32_t cpu : req.gameCpus)
+        if (const auto* c = t.Find(cpu))
+        {
+            gameCores.insert(c->core);
+            if (c->l2 >= 0) gameL2.insert(c->l2);
+        }
+    const auto* cpu0 = t.Find(0);
+    const uint32_t core0 = cpu0 ? cpu0->core : UINT32_MAX;
+
+    std::vector<Candidate> candidates;
+    for (uint32_t i = 0; i < t.cores.size(); ++i)
+    {
+        const auto& core = t.cores[i];
+        const auto* p = t.Find(core.cpus[0]);
+        if (!p || (dwordMask && (p->group != 0 || p->number >= 32))) continue;
+
+        Candidate c;
+        c.cpu = p->index;
+        if (gameCores.count(i))                                 c.tier = kGameCore;
+        else if (i == core0)                                    c.tier = kCoreZero;
+        else if (core.efficiencyClass == t.maxEfficiencyClass)  c.tier = kFreePerformance;
+        else                                                    c.tier = kFreeEfficiency;
+        c.sharesL2 = c.tier != kGameCore && p->l2 >= 0 && gameL2.count(p->l2);
+
+        c.quiet = req.quietOrder.size();
+        for (std::size_t r = 0; r < req.quietOrder.size(); ++r)
+            if (std::find(core.cpus.begin(), core.cpus.end(), req.quietOrder[r]) != core.cpus.end())
+            {
+                c.quiet = r;
+                break;
+            }
+        candidates.push_back(c);
+    }
+    // Highest-numbered cores first: the scheduler fills low cores first.
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return std::make_tuple(a.tier, a.sharesL2, a.quiet, ~a.cpu) <
+               std::make_tuple(b.tier, b.sharesL2, b.quiet, ~b.cpu);
+    });
+
+    std::vector<Device> devices = req.devices;
+    std::stable_sort(devices.begin(), devices.end(), [](const Device& a, const Device& b) {
+        return std::tie(a.kind, a.id) < std::tie(b.kind, b.id);
+    });
+    if (devices.empty()) return plan;
+    if (candidates.empty())
+    {
+        plan.notes.push_back("no CPU can be expressed in the affinity value");
+        return plan;
+    }
+
+    const std::size_t n = candidates.size();
+    for (std::size_t i = 0; i < devices.size(); ++i)
+    {
+        // Beyond one core per device, reuse from the least preferred end so
+        // the display keeps its core to itself longest.
+        std::size_t slot = i < n ? i : n - 1 - (i - n) % n;
+        const Candidate& c = candidates[slot];
+        const auto* cpu = t.Find(c.cpu);
+
+        Assignment a;
+        a.deviceId = devices[i].id;
+        a.kind     = devices[i].kind;
+        a.cpu      = c.cpu;
+        a.group    = cpu->group;
+        a.mask     = cpu_topology::GroupMask(t, { c.cpu }, cpu->group);
+        a.shared   = i >= n;
+        if (a.shared)
+            for (auto& other : plan.assignments)
+                if (other.cpu == a.cpu) other.shared = true;
+        plan.assignments.push_back(a);
+
+        std::string who = std::string(KindName(a.kind)) + " " + a.deviceId;
+        switch (c.tier) {
+        case kFreeEfficiency: plan.notes.push_back(who + ": no free P-core, using an E-core"); break;
+        case kCoreZero:       plan.notes.push_back(who + ": no other free core, using core 0"); break;
+        case kGameCore:       plan.notes.push_back(who + ": shares a reserved game core"); break;
+        default: break;
+        }
+        if (a.shared) plan.notes.push_back(who + ": shares CPU " + std::to_string(a.cpu) + " with another device");
+        else if (c.sharesL2) plan.notes.push_back(who + ": shares an L2 cache with the game cores");
+    }
+    return plan;
+}
+
+std::vector<uint32_t> DefaultGameCpus(const cpu_topology::Topology& t)
+{
+    const auto* cpu0 = t.Find(0);
+    std::vector<uint32_t> cores;
+    for (uint32_t i = 0; i < t.cores.size(); ++i)
+        if (t.cores[i].efficiencyClass == t.maxEfficiencyClass && (!cpu0 || cpu0->core != i)) cores.push_back(i);
+
+    std::size_t keep = cores.size() - std::min(kInterruptCores, cores.size() / 2);
+    std::vector<uint32_t> out;
+    for (std::size_t i = 0; i < keep; ++i)
+        out.insert(out.end(), t.cores[cores[i]].cpus.begin(), t.cores[cores[i]].cpus.end());
+    return out;
+}
+
+std::vector<uint32_t> LoadGameCpus(const machine_profile::Profile& p)
+{
+    std::vector<uint32_t> cpus;
+    auto it = p.extra.find("game.cpus");
+    if (it == p.extra.end() || !cpu_topology::ParseCpuList(it->second, cpus)) cpus.clear();
+    return cpus;
+}
+
+void StoreGameCpus(machine_profile::Profile& p, const std::vector<uint32_t>& cpus)
+{
+    if (cpus.empty()) p.extra.erase("game.cpus");
+    else              p.extra["game.cpus"] = cpu_topology::FormatCpuList(cpus);
+}
+
+std::vector<uint32_t> GameCpus(const cpu_topology::Topology& t, const machine_profile::Profile& p)
+{
+    std::vector<uint32_t> cpus = LoadGameCpus(p);
+    return cpus.empty() ? DefaultGameCpus(t) : cpus;
+}
+
+std::string Describe(const Plan& plan)
+{
+    std::ostringstream out;
+    char line[256];
+    for (const auto& a : plan.assignments)
+    {
+        std::snprintf(line, sizeof(line), "  %-8s -> cpu %-3u (group %u, mask 0x%llx)%s  %s\n", KindName(a.kind),
+                      a.cpu, a.group, static_cast<unsigned long long>(a.mask), a.shared ? " shared" : "",
+                      a.deviceId.c_str());
+        out << line;
+    }
+    for (const auto& n : plan.notes) out << "  note: " << n << "\n";
+    return out.str();
+}
+
+} // namespace affinity_planner
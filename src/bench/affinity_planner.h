@@ -0,0 +1,79 @@
+#pragma once
+#include "cpu_topology.h"
+#include "machine_profile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Interrupt affinity planner.  Given the CPU topology, the latency-critical
+// devices (display, network, xHCI controllers) and the CPUs reserved for
+// the game, it gives each device its own physical performance core:
+//
+//   * never the core of CPU 0 (the OS's default target for everything),
+//   * never a core the game runs on, nor one sharing its L2 when avoidable,
+//   * never two devices on SMT siblings of one core,
+//   * no E-cores while P-cores are left.
+//
+// When the machine runs out of cores the rules give way from the bottom
+// up (E-cores, then core 0, then game cores, then sharing a core), and every
+// relaxation is reported.  Pure and deterministic: the same topology and
+// request always give the same plan.
+namespace affinity_planner {
+
+enum class DeviceKind { Display, Network, Usb };
+
+const char* KindName(DeviceKind kind);
+bool        ParseKind(const std::string& text, DeviceKind& out);   // display|network|usb
+
+struct Device {
+    std::string id;            // caller's key, e.g. the class instance path
+    DeviceKind  kind = DeviceKind::Display;
+};
+
+struct Request {
+    std::vector<Device>   devices;
+    std::vector<uint32_t> gameCpus;     // reserved; their whole cores are avoided
+    std::vector<uint32_t> quietOrder;   // optional core_latency::RankByQuietness
+};
+
+struct Assignment {
+    std::string deviceId;
+    DeviceKind  kind   = DeviceKind::Display;
+    uint32_t    cpu    = 0;
+    uint16_t    group  = 0;
+    uint64_t    mask   = 0;            // within `group`
+    bool        shared = false;        // another device got the same core
+};
+
+struct Plan {
+    std::vector<Assignment>  assignments;   // display, network, USB; then id order
+    std::vector<std::string> notes;         // relaxed rules and other caveats
+};
+
+// `dwordMask` limits targets to group 0, CPUs 0-31, for the REG_DWORD
+// *InterruptAffinity value.
+Plan Build(const cpu_topology::Topology& t, const Request& req, bool dwordMask = true);
+
+// Performance cores kept out of the default game set for interrupt targets
+// and RSS queues.  Fixed rather than sized per caller so the interrupt plan,
+// the RSS plan and the game runtime all reserve the same CPUs.
+constexpr std::size_t kInterruptCores = 4;
+
+// Game CPUs when none are configured: every thread of the lowest-numbered
+// performance cores after core 0, leaving the highest kInterruptCores cores
+// (at most half of them) to interrupts.
+std::vector<uint32_t> DefaultGameCpus(const cpu_topology::Topology& t);
+
+// Reserved game CPUs in the machine profile ("game.cpus", cpulist format);
+// empty when not configured.
+std::vector<uint32_t> LoadGameCpus(const machine_profile::Profile& p);
+void                  StoreGameCpus(machine_profile::Profile& p, const std::vector<uint32_t>& cpus);
+
+// The profile's game CPUs, else DefaultGameCpus.  Every planner that avoids
+// the game cores takes them from here.
+std::vector<uint32_t> GameCpus(const cpu_topology::Topology& t, const machine_profile::Profile& p);
+
+std::string Describe(const Plan& plan);
+
+} // namespace affinity_planner
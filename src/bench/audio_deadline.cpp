@@ -0,0 +1,187 @@
+#include "audio_deadline.h"
+#include "bench_clock.h"
+#include "period_timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <avrt.h>
+#else
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace audio_deadline {
+
+const char* SchedulingName(Scheduling s)
+{
+    return s == Scheduling::RealTime ? "rt" : "normal";
+}
+
+static uint64_t PeriodNs(const Config& cfg)
+{
+    return cfg.sampleRate
+         ? static_cast<uint64_t>(cfg.bufferFrames) * 1000000000ULL / cfg.sampleRate
+         : 0;
+}
+
+std::string Describe(const Config& cfg)
+{
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "%uHz %uf (%lluus) load=%.0f%% %s",
+                  cfg.sampleRate, cfg.bufferFrames,
+                  static_cast<unsigned long long>(PeriodNs(cfg) / 1000),
+                  cfg.dspLoad * 100.0, SchedulingName(cfg.scheduling));
+    return buf;
+}
+
+// ─── Synthetic DSP ───────────────────────────────────────────────────────────
+
+// Stereo biquad low-pass over one buffer, repeated until `workNs` has
+// elapsed.  Time-bounded rather than iteration-bounded so the CPU share is
+// the same on every machine.
+class SyntheticDsp {
+public:
+    explicit SyntheticDsp(uint32_t frames)
+        : m_buffer(static_cast<std::size_t>(frames) * 2)
+    {
+        for (std::size_t i = 0; i < m_buffer.size(); ++i)
+            m_buffer[i] = static_cast<float>(std::sin(0.01 * static_cast<double>(i)));
+    }
+
+    void Process(uint64_t startNs, uint64_t workNs)
+    {
+        const float b0 = 0.0675f, b1 = 0.135f, b2 = 0.0675f, a1 = -1.143f, a2 = 0.4128f;
+        do {
+            for (std::size_t i = 0; i < m_buffer.size(); i += 2)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    float x = m_buffer[i + ch];
+                    float y = b0 * x + b1 * m_x1[ch] + b2 * m_x2[ch] - a1 * m_y1[ch] - a2 * m_y2[ch];
+                    m_x2[ch] = m_x1[ch]; m_x1[ch] = x;
+                    m_y2[ch] = m_y1[ch]; m_y1[ch] = y;
+                    m_buffer[i + ch] = y + x * 0.5f;
+                }
+            }
+        } while (bench_clock::NowNs() - startNs < workNs);
+    }
+
+private:
+    std::vector<float> m_buffer;
+    float m_x1[2] = {}, m_x2[2] = {}, m_y1[2] = {}, m_y2[2] = {};
+};
+
+// ─── Simulator thread ────────────────────────────────────────────────────────
+
+static void CallbackThread(const Config& cfg, Result& r, const std::atomic<bool>* cancel)
+{
+#ifdef _WIN32
+    HANDLE mmcss = nullptr;
+    if (cfg.scheduling == Scheduling::RealTime)
+    {
+        DWORD taskIndex = 0;
+        mmcss = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+        if (mmcss)
+        {
+            AvSetMmThreadPriority(mmcss, AVRT_PRIORITY_CRITICAL);
+            r.realTime = true;
+        }
+        else
+        {
+            r.note = "AvSetMmThreadCharacteristics failed (error " +
+                     std::to_string(GetLastError()) + "); ran at normal priority";
+        }
+    }
+#else
+    if (cfg.scheduling == Scheduling::RealTime)
+    {
+        sched_param sp{};
+        sp.sched_priority = std::min(80, sched_get_priority_max(SCHED_FIFO));
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+        if (err == 0)
+            r.realTime = true;
+        else
+            r.note = std::string("SCHED_FIFO denied (") + std::strerror(err) +
+                     "; needs CAP_SYS_NICE or rtprio limit); ran at normal priority";
+    }
+#endif
+
+    SyntheticDsp dsp(cfg.bufferFrames);
+    PeriodTimer  timer;
+
+    const uint64_t workNs = static_cast<uint64_t>(
+        static_cast<double>(r.periodNs) * std::clamp(cfg.dspLoad, 0.0, 1.0));
+    const uint64_t startNs = bench_clock::NowNs();
+    const uint64_t endNs   = startNs + static_cast<uint64_t>(cfg.durationMs) * 1000000ULL;
+    uint64_t deadline = startNs + r.periodNs;
+
+    while (deadline < endNs && !(cancel && cancel->load()))
+    {
+        timer.WaitUntil(deadline);
+        uint64_t wake = bench_clock::NowNs();
+        dsp.Process(wake, workNs);
+        uint64_t done = bench_clock::NowNs();
+
+        ++r.periods;
+        r.lateness.Record(wake > deadline ? wake - deadline : 0);
+        r.callback.Record(done - wake);
+
+        // The buffer filled in this callback is played from the next period
+        // boundary; finishing later than that is an audible glitch.  Periods
+        // overrun entirely are lost too, and the schedule realigns after them.
+        uint64_t due = deadline + r.periodNs;
+        if (done > due)
+        {
+            uint64_t overrun = (done - due) / r.periodNs + 1;
+            r.misses += overrun;
+            deadline += overrun * r.periodNs;
+        }
+        deadline += r.periodNs;
+    }
+
+#ifdef _WIN32
+    if (mmcss) AvRevertMmThreadCharacteristics(mmcss);
+#endif
+}
+
+Result Run(const Config& cfg, const std::atomic<bool>* cancel)
+{
+    Result r;
+    r.periodNs = PeriodNs(cfg);
+    if (r.periodNs == 0) { r.error = "invalid sample rate / buffer size"; return r; }
+
+    std::thread worker(CallbackThread, std::cref(cfg), std::ref(r), cancel);
+    worker.join();
+    r.ok = r.periods > 0;
+    if (!r.ok) r.error = "no callbacks ran";
+    return r;
+}
+
+bool Passed(const Result& r)
+{
+    return r.ok && r.misses == 0;
+}
+
+uint32_t Recommend(const std::vector<std::pair<Config, Result>>& sweep)
+{
+    // Walk down from the largest size; a small size that passes only by luck
+    // while a larger one failed is not a safe recommendation.
+    std::vector<std::pair<uint32_t, bool>> sizes;
+    for (const auto& run : sweep)
+        sizes.emplace_back(run.first.bufferFrames, Passed(run.second));
+    std::sort(sizes.begin(), sizes.end());
+
+    uint32_t best = 0;
+    for (auto it = sizes.rbegin(); it != sizes.rend() && it->second; ++it)
+        best = it->first;
+    return best;
+}
+
+} // namespace audio_deadline
@@ -0,0 +1,58 @@
+#pragma once
+#include "histogram.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Real-time audio deadline simulator.  Runs a periodic callback thread at the
+// period of an audio buffer (frames / sample rate), burns a configurable
+// share of each period on synthetic DSP, and records how late each callback
+// starts and how often it finishes after the buffer was due.  Verifies the
+// SystemResponsiveness / "Pro Audio" MMCSS tweaks the way a DAW feels them.
+namespace audio_deadline {
+
+enum class Scheduling {
+    Normal,     // ordinary thread priority
+    RealTime,   // MMCSS "Pro Audio" task on Windows, SCHED_FIFO on Linux
+};
+
+struct Config {
+    uint32_t   sampleRate   = 48000;
+    uint32_t   bufferFrames = 128;
+    uint32_t   durationMs   = 10000;
+    double     dspLoad      = 0.5;    // fraction of each period spent in DSP work
+    Scheduling scheduling   = Scheduling::RealTime;
+};
+
+struct Result {
+    bool             ok        = false;
+    std::string      error;
+    std::string      note;              // e.g. scheduling request denied
+    bool             realTime  = false; // real-time scheduling actually in effect
+    uint64_t         periodNs  = 0;
+    uint64_t         periods   = 0;     // callbacks run
+    uint64_t         misses    = 0;     // buffers not ready by their deadline
+    LatencyHistogram lateness;          // callback start - scheduled start
+    LatencyHistogram callback;          // callback duration (wake to done)
+};
+
+const char* SchedulingName(Scheduling s);
+
+// Short label, e.g. "48000Hz 128f (2667us) load=50% rt".
+std::string Describe(const Config& cfg);
+
+// Run the simulator on a dedicated thread; blocks for cfg.durationMs or
+// until `cancel` is set.
+Result Run(const Config& cfg, const std::atomic<bool>* cancel = nullptr);
+
+// A buffer size passes when no deadline was missed.
+bool Passed(const Result& r);
+
+// Smallest buffer size from which every larger size in the sweep passed
+// (0 if the largest failed).  Runs must share sample rate and scheduling mode.
+uint32_t Recommend(const std::vector<std::pair<Config, Result>>& sweep);
+
+} // namespace audio_deadline
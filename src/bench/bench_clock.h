@@ -0,0 +1,35 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// Monotonic nanosecond clock shared by every probe.
+// std::chrono::steady_clock is QueryPerformanceCounter on MSVC and
+// CLOCK_MONOTONIC on Linux, so timestamps are comparable across modules.
+namespace bench_clock {
+
+inline uint64_t NowNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Wait until `deadlineNs` (NowNs() time base).  Sleeps while more than
+// `spinNs` remain, then spins, so pacing is not limited to the OS sleep
+// granularity (15.6 ms / 1 ms on Windows).
+inline void SleepUntilNs(uint64_t deadlineNs, uint64_t spinNs = 2000000)
+{
+    for (;;)
+    {
+        uint64_t now = NowNs();
+        if (now >= deadlineNs) return;
+        uint64_t remaining = deadlineNs - now;
+        if (remaining > spinNs)
+            std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - spinNs));
+        else
+            std::this_thread::yield();
+    }
+}
+
+} // namespace bench_clock
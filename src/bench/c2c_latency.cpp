@@ -0,0 +1,237 @@
+#include "c2c_latency.h"
+#include "bench_clock.h"
+#include "thread_util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+namespace c2c_latency {
+
+// ─── Pair measurement ────────────────────────────────────────────────────────
+
+namespace {
+
+struct alignas(64) CacheLine {
+    std::atomic<uint32_t> seq{0};
+};
+
+constexpr uint32_t kBatch  = 50;    // round trips per timed batch
+constexpr uint32_t kWarmup = 200;
+
+// Spin until `pred` holds; yields now and then so an oversubscribed or
+// unpinnable run still makes progress instead of live-locking.
+template <typename Pred>
+bool SpinUntil(Pred pred, const std::atomic<bool>& abort)
+{
+    for (uint32_t spins = 0; !pred(); ++spins)
+    {
+        if (abort.load(std::memory_order_relaxed)) return false;
+        if ((spins & 0xFFFF) == 0xFFFF) std::this_thread::yield();
+    }
+    return true;
+}
+
+} // namespace
+
+// -1 when either thread cannot be pinned: an unpinned pair may share one
+// core and would report a same-core handoff as a cross-core round trip.
+static float MeasurePair(uint32_t cpuA, uint32_t cpuB, const Config& cfg)
+{
+    if (cpuA == cpuB) return -1.0f;
+
+    CacheLine         line;
+    std::atomic<bool> abort{false};
+    std::atomic<int>  ready{0};
+    float             result = -1.0f;
+
+    // Responder: answers every odd sequence number with the next even one.
+    std::thread responder([&]() {
+        if (!thread_util::PinCurrentThread(cpuB))
+        {
+            abort = true;
+            return;
+        }
+        ++ready;
+        uint32_t expect = 1;
+        for (;;)
+        {
+            if (!SpinUntil([&] { return line.seq.load(std::memory_order_acquire) == expect; }, abort))
+                return;
+            line.seq.store(expect + 1, std::memory_order_release);
+            expect += 2;
+        }
+    });
+
+    // Initiator: times batches of round trips.
+    std::thread initiator([&]() {
+        if (!thread_util::PinCurrentThread(cpuA))
+        {
+            abort = true;
+            return;
+        }
+        ++ready;
+        if (!SpinUntil([&] { return ready.load() == 2; }, abort))
+            return;
+
+        const uint64_t giveUp = bench_clock::NowNs() + static_cast<uint64_t>(cfg.pairTimeoutMs) * 1000000ULL;
+        std::vector<float> batches;
+        uint32_t seq = 1;
+        const uint32_t total = kWarmup + cfg.roundTrips;
+        for (uint32_t done = 0; done < total; done += kBatch)
+        {
+            uint64_t t0 = bench_clock::NowNs();
+            for (uint32_t k = 0; k < kBatch; ++k, seq += 2)
+            {
+                line.seq.store(seq, std::memory_order_release);
+                const uint32_t reply = seq + 1;
+                SpinUntil([&] { return line.seq.load(std::memory_order_acquire) == reply; }, abort);
+            }
+            uint64_t t1 = bench_clock::NowNs();
+            if (done >= kWarmup)
+                batches.push_back(static_cast<float>(t1 - t0) / kBatch);
+            if (t1 > giveUp) break;
+        }
+
+        if (!batches.empty())
+        {
+            std::nth_element(batches.begin(), batches.begin() + batches.size() / 2, batches.end());
+            result = batches[batches.size() / 2];
+        }
+        abort = true;
+    });
+
+    initiator.join();
+    responder.join();
+    return result;
+}
+
+Matrix Measure(const Config& cfg, const std::atomic<bool>* cancel, std::atomic<uint32_t>* progress)
+{
+    Matrix m;
+    m.cpus = cfg.cpus;
+    if (m.cpus.empty())
+        for (uint32_t i = 0; i < thread_util::LogicalCpuCount(); ++i) m.cpus.push_back(i);
+
+    const std::size_t n = m.cpus.size();
+    m.rttNs.assign(n, std::vector<float>(n, 0.0f));
+
+    const std::size_t pairs = n * (n - 1) / 2;
+    std::size_t done = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = i + 1; j < n; ++j)
+        {
+            float v = (cancel && cancel->load()) ? -1.0f : MeasurePair(m.cpus[i], m.cpus[j], cfg);
+            m.rttNs[i][j] = m.rttNs[j][i] = v;
+            ++done;
+            if (progress) *progress = static_cast<uint32_t>(done * 1000 / pairs);
+        }
+    }
+    if (progress) *progress = 1000;
+    return m;
+}
+
+std::size_t FailedPairs(const Matrix& m)
+{
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < m.cpus.size(); ++i)
+        for (std::size_t j = i + 1; j < m.cpus.size(); ++j)
+            failed += m.rttNs[i][j] < 0.0f;
+    return failed;
+}
+
+// ─── Clustering ──────────────────────────────────────────────────────────────
+
+// Connected components over edges with rtt <= threshold.
+static std::vector<int> Components(const Matrix& m, float threshold)
+{
+    const std::size_t n = m.cpus.size();
+    std::vector<int> id(n, -1);
+    int next = 0;
+    for (std::size_t s = 0; s < n; ++s)
+    {
+        if (id[s] >= 0) continue;
+        std::vector<std::size_t> stack{ s };
+        id[s] = next;
+        while (!stack.empty())
+        {
+            std::size_t u = stack.back();
+            stack.pop_back();
+            for (std::size_t v = 0; v < n; ++v)
+                if (id[v] < 0 && m.rttNs[u][v] > 0.0f && m.rttNs[u][v] <= threshold)
+                {
+                    id[v] = next;
+                    stack.push_back(v);
+                }
+        }
+        ++next;
+    }
+    return id;
+}
+
+std::vector<int> ClusterDomains(const Matrix& m, double levelRatio)
+{
+    const std::size_t n = m.cpus.size();
+    std::vector<int> single(n, 0);
+
+    std::vector<float> values;
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = i + 1; j < n; ++j)
+            if (m.rttNs[i][j] > 0.0f) values.push_back(m.rttNs[i][j]);
+    if (values.size() < 2) return single;
+    std::sort(values.begin(), values.end());
+
+    // Level boundaries, highest first: the coarsest split is the L3/CCD one.
+    std::vector<float> cuts;
+    for (std::size_t k = 1; k < values.size(); ++k)
+        if (values[k] > values[k - 1] * levelRatio && values[k] - values[k - 1] > 5.0f)
+            cuts.push_back(values[k - 1]);
+    std::reverse(cuts.begin(), cuts.end());
+
+    for (float cut : cuts)
+    {
+        std::vector<int> id = Components(m, cut);
+        std::vector<int> sizes(n, 0);
+        for (int d : id) ++sizes[d];
+        // All-pairs components are SMT siblings, not a cache domain.
+        if (std::any_of(sizes.begin(), sizes.end(), [](int s) { return s > 2; }))
+            return id;
+    }
+    return single;
+}
+
+// ─── Rendering ───────────────────────────────────────────────────────────────
+
+std::string Render(const Matrix& m, const std::vector<int>& domains)
+{
+    std::string out;
+    char buf[32];
+
+    out += "cpu dom |";
+    for (uint32_t c : m.cpus)
+    {
+        std::snprintf(buf, sizeof(buf), "%7u", c);
+        out += buf;
+    }
+    out += "\n--------+" + std::string(m.cpus.size() * 7, '-') + "\n";
+
+    for (std::size_t i = 0; i < m.cpus.size(); ++i)
+    {
+        std::snprintf(buf, sizeof(buf), "%3u %3d |", m.cpus[i], i < domains.size() ? domains[i] : 0);
+        out += buf;
+        for (std::size_t j = 0; j < m.cpus.size(); ++j)
+        {
+            float v = m.rttNs[i][j];
+            if (i == j)        std::snprintf(buf, sizeof(buf), "%7s", "-");
+            else if (v < 0.0f) std::snprintf(buf, sizeof(buf), "%7s", "?");
+            else               std::snprintf(buf, sizeof(buf), "%7.0f", v);
+            out += buf;
+        }
+        out += "\n";
+    }
+    out += "(round-trip ns; dom = cache domain inferred from the matrix)\n";
+    return out;
+}
+
+} // namespace c2c_latency
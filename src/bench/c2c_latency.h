@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Core-to-core cache-line latency.  Two threads pinned to logical CPUs i and
+// j bounce one cache line back and forth; the round-trip time exposes the
+// topology the OS does not report reliably: SMT siblings, shared-L2 modules,
+// L3 / CCD boundaries and hybrid P/E-core clusters.  Where an interrupt lands
+// relative to the game's main thread costs one of these hops.
+namespace c2c_latency {
+
+struct Config {
+    std::vector<uint32_t> cpus;               // empty = every logical CPU
+    uint32_t              roundTrips = 2000;  // measured per pair (after warm-up)
+    uint32_t              pairTimeoutMs = 2000;
+};
+
+struct Matrix {
+    std::vector<uint32_t>           cpus;     // row/column -> logical CPU
+    std::vector<std::vector<float>> rttNs;    // median round trip; 0 on the diagonal, <0 = failed
+};
+
+// Measure every unordered pair once and mirror it.  `progress` receives
+// pairs done / pairs total in 1/1000 units.  A pair is marked failed when
+// it names one CPU twice or either thread cannot be pinned (a CPU that
+// does not exist or is outside the process affinity).
+Matrix Measure(const Config& cfg, const std::atomic<bool>* cancel = nullptr,
+               std::atomic<uint32_t>* progress = nullptr);
+
+// Off-diagonal pairs that were not measured.  A matrix with any is not
+// written to the machine profile.
+std::size_t FailedPairs(const Matrix& m);
+
+// Group CPUs into cache domains from the matrix alone.  Off-diagonal values
+// are split into latency levels at jumps larger than `levelRatio`; the cut
+// is the highest level boundary whose connected components are not all SMT
+// pairs (size <= 2), so a single-CCD SMT part stays one domain while a
+// dual-CCD part splits in two.  Returns one domain id per row.
+std::vector<int> ClusterDomains(const Matrix& m, double levelRatio = 1.3);
+
+// Console rendering: the NxN matrix in ns with domain ids on each row.
+std::string Render(const Matrix& m, const std::vector<int>& domains);
+
+} // namespace c2c_latency
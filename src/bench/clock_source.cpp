@@ -0,0 +1,546 @@
+#include "clock_source.h"
+#include "bench_clock.h"
+#include "thread_util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CLOCK_SOURCE_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace clock_source {
+
+static std::string Lower(std::string s)
+{
+    for (auto& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+static std::string Trim(const std::string& s)
+{
+    auto b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return "";
+    auto e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+// ─── Clock source ────────────────────────────────────────────────────────────
+
+const char* SourceName(Source s)
+{
+    switch (s) {
+    case Source::Unknown: return "unknown";
+    case Source::Tsc:     return "TSC";
+    case Source::Hpet:    return "HPET";
+    case Source::AcpiPm:  return "ACPI PM timer";
+    case Source::Other:   return "other";
+    }
+    return "?";
+}
+
+Source ClassifyFrequency(uint64_t hz)
+{
+    auto around = [&](uint64_t target) { return hz + 1000 >= target && hz <= target + 1000; };
+    if (hz == 10000000) return Source::Tsc;   // 1607+: the invariant TSC scaled to 10 MHz
+    if (around(14318180)) return Source::Hpet;
+    if (around(3579545)) return Source::AcpiPm;
+    if (hz >= 1000000000) return Source::Tsc;   // older builds exposed the raw TSC rate
+    return hz ? Source::Other : Source::Unknown;
+}
+
+Source ClassifyName(const std::string& clocksource)
+{
+    std::string n = Lower(Trim(clocksource));
+    if (n.empty())     return Source::Unknown;
+    if (n == "tsc")    return Source::Tsc;
+    if (n == "hpet")   return Source::Hpet;
+    if (n == "acpi_pm") return Source::AcpiPm;
+    return Source::Other;
+}
+
+std::map<std::string, std::string> ParseBcd(const std::string& text)
+{
+    std::map<std::string, std::string> out;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        line = Trim(line);
+        std::size_t space = line.find_first_of(" \t");
+        if (space == std::string::npos) continue;
+        std::string name = Lower(line.substr(0, space));
+        if (!std::all_of(name.begin(), name.end(), [](char c) { return std::islower(static_cast<unsigned char>(c)); }))
+            continue;   // "----", headings
+        out[name] = Lower(Trim(line.substr(space)));
+    }
+    return out;
+}
+
+CpuInfo QueryCpu()
+{
+    CpuInfo c;
+#ifdef CLOCK_SOURCE_X86
+    c.x86 = true;
+    unsigned a = 0, b = 0, cx = 0, d = 0;
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 1);
+    cx = static_cast<unsigned>(regs[2]);
+    c.hypervisor = (cx >> 31) & 1;
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned>(regs[0]) >= 0x80000007)
+    {
+        __cpuid(regs, 0x80000007);
+        c.invariantTsc = (static_cast<unsigned>(regs[3]) >> 8) & 1;
+    }
+    (void)a; (void)b; (void)d;
+#else
+    if (__get_cpuid(1, &a, &b, &cx, &d)) c.hypervisor = (cx >> 31) & 1;
+    if (__get_cpuid_max(0x80000000, nullptr) >= 0x80000007 && __get_cpuid(0x80000007, &a, &b, &cx, &d))
+        c.invariantTsc = (d >> 8) & 1;
+#endif
+#endif
+    return c;
+}
+
+std::map<std::string, std::string> ReadBcd()
+{
+    std::string out;
+#ifdef _WIN32
+    FILE* p = _popen("bcdedit /enum {current} 2>nul", "r");
+    if (!p) return {};
+    char buf[512];
+    while (std::fgets(buf, sizeof(buf), p)) out += buf;
+    _pclose(p);
+#endif
+    return ParseBcd(out);
+}
+
+#ifndef _WIN32
+static std::string ReadLine(const std::string& path)
+{
+    std::ifstream f(path);
+    std::string line;
+    std::getline(f, line);
+    return Trim(line);
+}
+#endif
+
+ActiveSource QuerySource(const std::string& root)
+{
+    ActiveSource s;
+#ifdef _WIN32
+    (void)root;
+    LARGE_INTEGER f{};
+    QueryPerformanceFrequency(&f);
+    s.frequency = static_cast<uint64_t>(f.QuadPart);
+    s.source    = ClassifyFrequency(s.frequency);
+    char name[48];
+    std::snprintf(name, sizeof(name), "QPC %.3f MHz", s.frequency / 1e6);
+    s.name = name;
+#else
+    std::string dir = root + "/sys/devices/system/clocksource/clocksource0/";
+    s.name      = ReadLine(dir + "current_clocksource");
+    s.available = ReadLine(dir + "available_clocksource");
+    s.source    = ClassifyName(s.name);
+    s.frequency = 1000000000;
+#endif
+    return s;
+}
+
+bool PlatformClockForced(const ActiveSource& s)
+{
+    auto it = s.bcd.find("useplatformclock");
+    return it != s.bcd.end() && it->second == "yes";
+}
+
+// ─── Measurements ────────────────────────────────────────────────────────────
+
+const char* ClockName(Clock c)
+{
+    switch (c) {
+#ifdef _WIN32
+    case Clock::Os:  return "QueryPerformanceCounter";
+#else
+    case Clock::Os:  return "clock_gettime(MONOTONIC)";
+#endif
+    case Clock::Tsc: return "rdtsc";
+    }
+    return "?";
+}
+
+// Raw ticks: QPC counts, nanoseconds, or TSC cycles.
+static inline uint64_t Read(Clock c)
+{
+    if (c == Clock::Tsc)
+    {
+#ifdef CLOCK_SOURCE_X86
+        _mm_lfence();   // not before the preceding loads
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+#ifdef _WIN32
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return static_cast<uint64_t>(t.QuadPart);
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+static double TicksToNs(Clock c, const Report& r)
+{
+    if (c == Clock::Tsc) return r.tscHz > 0 ? 1e9 / r.tscHz : 0;
+    return r.source.frequency ? 1e9 / static_cast<double>(r.source.frequency) : 1;
+}
+
+static double MeasureTscHz(uint32_t ms)
+{
+#ifdef CLOCK_SOURCE_X86
+    uint64_t ns0  = bench_clock::NowNs();
+    uint64_t tsc0 = Read(Clock::Tsc);
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    uint64_t ns1  = bench_clock::NowNs();
+    uint64_t tsc1 = Read(Clock::Tsc);
+    return ns1 > ns0 ? static_cast<double>(tsc1 - tsc0) * 1e9 / static_cast<double>(ns1 - ns0) : 0;
+#else
+    (void)ms;
+    return 0;
+#endif
+}
+
+static Cost MeasureCost(Clock c, uint32_t calls, double tickNs)
+{
+    Cost cost;
+    cost.clock = c;
+    if (tickNs <= 0) return cost;
+    calls = std::max<uint32_t>(calls, 1000);
+
+    uint64_t minStep = UINT64_MAX, repeats = 0;
+    uint64_t prev    = Read(c);
+    uint64_t start   = bench_clock::NowNs();
+    for (uint32_t i = 0; i < calls; ++i)
+    {
+        uint64_t now = Read(c);
+        if (now == prev) ++repeats;
+        else if (now > prev) minStep = std::min(minStep, now - prev);
+        prev = now;
+    }
+    uint64_t elapsed = bench_clock::NowNs() - start;
+
+    cost.ok             = true;
+    cost.nsPerCall      = static_cast<double>(elapsed) / calls;
+    cost.nominalNs      = tickNs;
+    cost.observedNs     = minStep == UINT64_MAX ? 0 : static_cast<double>(minStep) * tickNs;
+    cost.repeatFraction = static_cast<double>(repeats) / calls;
+#ifndef _WIN32
+    if (c == Clock::Os)
+    {
+        timespec res{};
+        if (clock_getres(CLOCK_MONOTONIC, &res) == 0)
+            cost.nominalNs = static_cast<double>(res.tv_sec) * 1e9 + static_cast<double>(res.tv_nsec);
+    }
+#endif
+    return cost;
+}
+
+// Two pinned threads take turns through `turn`.  Each reads the clock after
+// seeing the other's release, so its value must not be below the one the
+// other stored just before.
+struct alignas(64) Handoff {
+    std::atomic<uint32_t> turn{0};
+    char                  pad[60];
+    std::atomic<uint64_t> last{0};
+};
+
+static void PingPong(Clock c, uint32_t cpu, uint32_t side, uint32_t rounds, Handoff& h,
+                     uint64_t& violations, uint64_t& worst)
+{
+    thread_util::PinCurrentThread(cpu);
+    for (uint32_t r = 0; r < rounds; ++r)
+    {
+        uint32_t spins = 0;
+        while (h.turn.load(std::memory_order_acquire) != side)
+            if (++spins % 4096 == 0) std::this_thread::yield();   // pinning may have failed
+        uint64_t now  = Read(c);
+        uint64_t prev = h.last.load(std::memory_order_relaxed);
+        if (now < prev)
+        {
+            ++violations;
+            worst = std::max(worst, prev - now);
+        }
+        h.last.store(now, std::memory_order_relaxed);
+        h.turn.store(1 - side, std::memory_order_release);
+    }
+}
+
+static Monotonicity CheckMonotonic(Clock c, const std::vector<uint32_t>& cpus, uint32_t rounds, double tickNs)
+{
+    Monotonicity m;
+    m.clock = c;
+    if (cpus.size() < 2 || tickNs <= 0) return m;
+    rounds = std::max<uint32_t>(rounds, 10);
+
+    uint64_t worst = 0;
+    for (std::size_t i = 1; i < cpus.size(); ++i)
+    {
+        Handoff  h;
+        uint64_t va = 0, vb = 0, wa = 0, wb = 0;
+        std::thread a(PingPong, c, cpus[0], 0u, rounds, std::ref(h), std::ref(va), std::ref(wa));
+        std::thread b(PingPong, c, cpus[i], 1u, rounds, std::ref(h), std::ref(vb), std::ref(wb));
+        a.join();
+        b.join();
+
+        ++m.pairs;
+        m.handoffs += 2ULL * rounds;
+        if (va + vb)
+        {
+            m.violations += va + vb;
+            m.badCpus.push_back(cpus[i]);
+            worst = std::max({worst, wa, wb});
+        }
+    }
+    m.ok      = true;
+    m.worstNs = static_cast<double>(worst) * tickNs;
+    return m;
+}
+
+Report Run(const Options& o)
+{
+    Report r;
+    r.cpu    = QueryCpu();
+    r.source = QuerySource(o.root);
+    if (r.cpu.x86) r.tscHz = MeasureTscHz(100);
+
+    std::vector<uint32_t> cpus = o.cpus;
+    if (cpus.empty())
+        for (uint32_t i = 0; i < thread_util::LogicalCpuCount(); ++i) cpus.push_back(i);
+
+    for (Clock c : { Clock::Os, Clock::Tsc })
+    {
+        if (c == Clock::Tsc && !r.cpu.x86) continue;
+        r.costs.push_back(MeasureCost(c, o.calls, TicksToNs(c, r)));
+        r.monotonic.push_back(CheckMonotonic(c, cpus, o.rounds, TicksToNs(c, r)));
+    }
+    return r;
+}
+
+// ─── Recommendation ──────────────────────────────────────────────────────────
+
+const char* VerdictName(Verdict v)
+{
+    switch (v) {
+    case Verdict::KeepCurrent:       return "keep the current clock source";
+    case Verdict::DropPlatformClock: return "stop forcing the platform clock";
+    case Verdict::KeepPlatformClock: return "keep the platform clock";
+    case Verdict::TryPlatformClock:  return "try the platform clock";
+    case Verdict::Inconclusive:      return "inconclusive";
+    }
+    return "?";
+}
+
+bool WantsPlatformClock(Verdict v)
+{
+    return v == Verdict::KeepPlatformClock || v == Verdict::TryPlatformClock;
+}
+
+static const Cost* FindCost(const Report& r, Clock c)
+{
+    for (const auto& x : r.costs)
+        if (x.clock == c && x.ok) return &x;
+    return nullptr;
+}
+
+static const Monotonicity* FindMonotonic(const Report& r, Clock c)
+{
+    for (const auto& x : r.monotonic)
+        if (x.clock == c && x.ok) return &x;
+    return nullptr;
+}
+
+static std::string Ns(double ns)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), ns < 10 ? "%.1f ns" : "%.0f ns", ns);
+    return buf;
+}
+
+Recommendation Recommend(const Report& r)
+{
+    Recommendation rec;
+    const Cost*         osCost  = FindCost(r, Clock::Os);
+    const Cost*         tscCost = FindCost(r, Clock::Tsc);
+    const Monotonicity* osMono  = FindMonotonic(r, Clock::Os);
+    const Monotonicity* tscMono = FindMonotonic(r, Clock::Tsc);
+
+    if (r.cpu.hypervisor)
+        rec.reasons.push_back("running under a hypervisor: the clocks are the host's emulation, measure on bare metal");
+    if (!r.cpu.x86)
+    {
+        rec.reasons.push_back("no TSC on this architecture; the firmware's counter is the only choice");
+        return rec;
+    }
+    if (!osCost || !tscMono)
+    {
+        rec.reasons.push_back("nothing measured (a single CPU?)");
+        return rec;
+    }
+
+    bool tscSynced   = tscMono->violations == 0;
+    bool tscReliable = r.cpu.invariantTsc && tscSynced;
+    bool osMonotonic = !osMono || osMono->violations == 0;
+    bool platform    = r.source.source == Source::Hpet || r.source.source == Source::AcpiPm;
+    bool forced      = PlatformClockForced(r.source);
+#ifndef _WIN32
+    // The kernel drops "tsc" from the list once its watchdog marks it unstable.
+    bool tscOffered = r.source.available.find("tsc") != std::string::npos;
+#else
+    bool tscOffered = true;
+#endif
+
+    std::string costs = std::string(ClockName(Clock::Os)) + " costs " + Ns(osCost->nsPerCall) + " per call";
+    if (tscCost) costs += ", rdtsc " + Ns(tscCost->nsPerCall);
+
+    rec.reasons.push_back(std::string("the TSC is ") + (r.cpu.invariantTsc ? "invariant" : "not invariant") +
+                          " and " + (tscSynced ? "stayed monotonic" : "went backwards") + " across " +
+                          std::to_string(tscMono->pairs) + " CPU pair(s)");
+
+    if (platform || forced)
+    {
+        rec.reasons.push_back(std::string("the OS clock reads the ") +
+                              (platform ? SourceName(r.source.source) : "platform clock") + ": " + costs);
+        if (tscReliable && tscOffered)
+        {
+            rec.verdict = Verdict::DropPlatformClock;
+            rec.reasons.push_back("the TSC would serve every read from the core without the shared counter");
+#ifdef _WIN32
+            if (forced) rec.actions.push_back("bcdedit /deletevalue useplatformclock");
+            if (r.source.bcd.count("tscsyncpolicy")) rec.actions.push_back("bcdedit /deletevalue tscsyncpolicy");
+#else
+            rec.actions.push_back("echo tsc > /sys/devices/system/clocksource/clocksource0/current_clocksource");
+            rec.actions.push_back("add clocksource=tsc to the kernel command line to keep it");
+#endif
+        }
+        else
+        {
+            rec.verdict = Verdict::KeepPlatformClock;
+            rec.reasons.push_back(tscOffered ? "the TSC cannot be trusted across cores on this machine"
+                                             : "the kernel has marked the TSC unstable");
+        }
+        return rec;
+    }
+
+    if (!osMonotonic)
+    {
+        rec.verdict = Verdict::TryPlatformClock;
+        rec.reasons.push_back("the OS clock went backwards " + std::to_string(osMono->violations) +
+                              " time(s), by up to " + Ns(osMono->worstNs));
+#ifdef _WIN32
+        rec.actions.push_back("bcdedit /set useplatformclock true");
+        rec.actions.push_back("reboot and run LatencyProbe clock again");
+#else
+        rec.actions.push_back("echo hpet > /sys/devices/system/clocksource/clocksource0/current_clocksource");
+#endif
+        return rec;
+    }
+
+    rec.verdict = Verdict::KeepCurrent;
+    rec.reasons.push_back("the OS clock reads " + std::string(SourceName(r.source.source)) + ": " + costs);
+    rec.reasons.push_back("forcing the platform clock would make every read a shared HPET access");
+#ifdef _WIN32
+    if (r.source.bcd.count("tscsyncpolicy"))
+        rec.reasons.push_back("tscsyncpolicy is set but the TSC is in sync without it");
+#endif
+    return rec;
+}
+
+std::string Describe(const Report& r)
+{
+    std::ostringstream os;
+    char line[200];
+
+    os << "Clock source: " << (r.source.name.empty() ? "unknown" : r.source.name) << " ("
+       << SourceName(r.source.source) << ")";
+    if (!r.source.available.empty()) os << ", available: " << r.source.available;
+    os << "\n";
+    for (const char* key : { "useplatformclock", "useplatformtick", "tscsyncpolicy", "disabledynamictick" })
+    {
+        auto it = r.source.bcd.find(key);
+        if (it != r.source.bcd.end()) os << "  bcd " << key << " = " << it->second << "\n";
+    }
+    if (r.cpu.x86)
+    {
+        std::snprintf(line, sizeof(line), "TSC: %s, %.3f GHz%s\n", r.cpu.invariantTsc ? "invariant" : "not invariant",
+                      r.tscHz / 1e9, r.cpu.hypervisor ? ", under a hypervisor" : "");
+        os << line;
+    }
+
+    std::snprintf(line, sizeof(line), "\n  %-26s %10s %10s %12s %8s\n", "clock", "ns/call", "tick ns",
+                  "min step ns", "repeat");
+    os << line;
+    for (const auto& c : r.costs)
+    {
+        if (!c.ok) continue;
+        std::snprintf(line, sizeof(line), "  %-26s %10.1f %10.2f %12.1f %7.1f%%\n", ClockName(c.clock), c.nsPerCall,
+                      c.nominalNs, c.observedNs, c.repeatFraction * 100.0);
+        os << line;
+    }
+
+    os << "\n";
+    for (const auto& m : r.monotonic)
+    {
+        if (!m.ok)
+        {
+            os << "  " << ClockName(m.clock) << ": cross-core check needs 2+ CPUs\n";
+            continue;
+        }
+        std::snprintf(line, sizeof(line), "  %-26s %u pair(s), %llu handoffs, ", ClockName(m.clock), m.pairs,
+                      static_cast<unsigned long long>(m.handoffs));
+        os << line;
+        if (!m.violations)
+            os << "monotonic\n";
+        else
+        {
+            std::snprintf(line, sizeof(line), "%llu backwards (worst %.0f ns) on CPUs ",
+                          static_cast<unsigned long long>(m.violations), m.worstNs);
+            os << line;
+            for (std::size_t i = 0; i < m.badCpus.size(); ++i) os << (i ? "," : "") << m.badCpus[i];
+            os << "\n";
+        }
+    }
+    return os.str();
+}
+
+std::string Describe(const Recommendation& rec)
+{
+    std::ostringstream os;
+    os << "Recommendation: " << VerdictName(rec.verdict) << "\n";
+    for (const auto& r : rec.reasons) os << "  - " << r << "\n";
+    for (const auto& a : rec.actions) os << "  > " << a << "\n";
+    return os.str();
+}
+
+} // namespace clock_source
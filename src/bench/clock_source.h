@@ -0,0 +1,143 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Which counter QueryPerformanceCounter / CLOCK_MONOTONIC reads, what a read
+// costs, and whether the TSC can be trusted across cores.  The
+// High-Resolution System Timer tweak used to set useplatformclock and
+// tscsyncpolicy blindly; with an invariant, synchronized TSC that moves QPC
+// from a ~20 ns TSC read to a memory-mapped HPET read that costs hundreds of
+// nanoseconds and serializes across cores.  This measures instead:
+//
+//   cost          calls of the OS clock and of rdtsc, ns per call, nominal
+//                 and smallest observed step
+//   monotonicity  timestamps handed between a reference CPU and every other
+//                 CPU through a shared cache line; a later read that is
+//                 smaller than the partner's earlier one went backwards
+//   invariance    CPUID 80000007h EDX[8] (constant rate through P- and
+//                 C-states)
+//   source        Windows: the QPC frequency (10 MHz = TSC, 14.318 MHz =
+//                 HPET, 3.579 MHz = ACPI PM timer) and the BCD settings;
+//                 Linux: clocksource0/current_clocksource in sysfs
+//
+// and Recommend() turns the report into a verdict on the platform clock.
+namespace clock_source {
+
+// ─── Clock source ────────────────────────────────────────────────────────────
+
+enum class Source { Unknown, Tsc, Hpet, AcpiPm, Other };
+
+const char* SourceName(Source s);
+
+// QPC frequency to the counter behind it.
+Source ClassifyFrequency(uint64_t hz);
+
+// Linux clocksource name ("tsc", "hpet", "acpi_pm", "kvm-clock", ...).
+Source ClassifyName(const std::string& clocksource);
+
+// `bcdedit /enum {current}` output to lower-case name -> lower-case value
+// ("useplatformclock" -> "yes").
+std::map<std::string, std::string> ParseBcd(const std::string& text);
+
+struct CpuInfo {
+    bool x86          = false;   // rdtsc / CPUID available
+    bool invariantTsc = false;
+    bool hypervisor   = false;   // CPUID 1 ECX[31]: timings reflect the host's clock emulation
+};
+
+CpuInfo QueryCpu();
+
+struct ActiveSource {
+    Source      source = Source::Unknown;
+    std::string name;            // "tsc", "hpet", "QPC 10.000 MHz"
+    std::string available;       // Linux: available_clocksource
+    uint64_t    frequency = 0;   // OS clock ticks per second (1e9 on Linux)
+    std::map<std::string, std::string> bcd;   // Windows: BCD of the running OS, see ReadBcd()
+};
+
+// Windows: QueryPerformanceFrequency.  Linux:
+// <root>/sys/devices/system/clocksource/clocksource0; root "" is the live
+// system.
+ActiveSource QuerySource(const std::string& root = "");
+
+// `bcdedit /enum {current}` parsed; needs administrator rights, empty
+// otherwise and off Windows.  Run() leaves ActiveSource::bcd to the caller
+// because the GUI captures the output without a console window.
+std::map<std::string, std::string> ReadBcd();
+
+// useplatformclock is set to yes in the BCD.
+bool PlatformClockForced(const ActiveSource& s);
+
+// ─── Measurements ────────────────────────────────────────────────────────────
+
+// Os = QueryPerformanceCounter / clock_gettime(CLOCK_MONOTONIC).
+enum class Clock { Os, Tsc };
+
+const char* ClockName(Clock c);
+
+struct Cost {
+    Clock  clock          = Clock::Os;
+    bool   ok             = false;
+    double nsPerCall      = 0;
+    double nominalNs      = 0;   // tick length the clock claims
+    double observedNs     = 0;   // smallest non-zero step between back-to-back reads
+    double repeatFraction = 0;   // back-to-back reads that returned the same value
+};
+
+struct Monotonicity {
+    Clock                 clock      = Clock::Os;
+    bool                  ok         = false;   // measured (needs 2+ CPUs, and x86 for the TSC)
+    uint32_t              pairs      = 0;
+    uint64_t              handoffs   = 0;
+    uint64_t              violations = 0;
+    double                worstNs    = 0;       // largest backwards step
+    std::vector<uint32_t> badCpus;              // CPUs whose pair saw a violation
+};
+
+struct Options {
+    uint32_t              calls  = 1000000;   // per cost measurement
+    uint32_t              rounds = 2000;      // handoffs per CPU pair
+    std::vector<uint32_t> cpus;               // empty = all; the first is the reference
+    std::string           root;               // sysfs root, "" = live system
+};
+
+struct Report {
+    CpuInfo                   cpu;
+    ActiveSource              source;
+    double                    tscHz = 0;   // rdtsc against the OS clock, 0 without a TSC
+    std::vector<Cost>         costs;
+    std::vector<Monotonicity> monotonic;
+};
+
+// The calling thread is never pinned; the handoffs run on threads of their own.
+Report Run(const Options& o);
+
+// ─── Recommendation ──────────────────────────────────────────────────────────
+
+enum class Verdict {
+    KeepCurrent,         // QPC already reads a trustworthy TSC: leave the BCD alone
+    DropPlatformClock,   // the platform clock is forced but the TSC is fine: delete useplatformclock
+    KeepPlatformClock,   // the platform clock is in use and the TSC is not trustworthy
+    TryPlatformClock,    // the OS clock went backwards across cores: useplatformclock may fix it
+    Inconclusive,        // no TSC (ARM) or nothing measured
+};
+
+const char* VerdictName(Verdict v);
+
+// Verdicts that want useplatformclock set.
+bool WantsPlatformClock(Verdict v);
+
+struct Recommendation {
+    Verdict                  verdict = Verdict::Inconclusive;
+    std::vector<std::string> reasons;
+    std::vector<std::string> actions;   // commands to run, empty = none
+};
+
+Recommendation Recommend(const Report& r);
+
+std::string Describe(const Report& r);
+std::string Describe(const Recommendation& rec);
+
+} // namespace clock_source
@@ -0,0 +1,192 @@
+#include "core_latency.h"
+#include "bench_clock.h"
+#include "period_timer.h"
+#include "thread_util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace core_latency {
+
+// ─── Measurement ─────────────────────────────────────────────────────────────
+
+static void CoreThread(const Config& cfg, uint64_t startNs, uint64_t endNs,
+                       CoreResult& out, std::string& note, std::mutex& noteMutex,
+                       const std::atomic<bool>* cancel)
+{
+    out.pinned = thread_util::PinCurrentThread(out.cpu);
+    if (cfg.realTime)
+    {
+        std::string why;
+        out.realTime = thread_util::RaiseToRealtime(why);
+        if (!out.realTime)
+        {
+            std::lock_guard<std::mutex> lock(noteMutex);
+            if (note.empty()) note = why + "; ran at normal priority";
+        }
+    }
+
+    PeriodTimer timer;
+    const uint64_t interval = static_cast<uint64_t>(cfg.intervalUs) * 1000ULL;
+
+    // Every core shares the same schedule, so a wake-up storm on one core
+    // lines up in time with quiet periods on the others.
+    uint64_t deadline = startNs;
+    while (deadline < endNs && !(cancel && cancel->load()))
+    {
+        timer.WaitUntil(deadline);
+        uint64_t wake = bench_clock::NowNs();
+        out.wakeup.Record(wake > deadline ? wake - deadline : 0);
+
+        // Keep the phase: skip whole periods that passed while we were late.
+        if (wake > deadline) deadline += ((wake - deadline) / interval) * interval;
+        deadline += interval;
+    }
+}
+
+Result Run(const Config& cfg, const std::atomic<bool>* cancel, std::atomic<uint32_t>* progress)
+{
+    Result r;
+    r.intervalUs = cfg.intervalUs;
+    if (cfg.intervalUs == 0) { r.error = "interval must be > 0"; return r; }
+
+    std::vector<uint32_t> cpus = cfg.cpus;
+    if (cpus.empty())
+        for (uint32_t i = 0; i < thread_util::LogicalCpuCount(); ++i) cpus.push_back(i);
+
+    r.cores.resize(cpus.size());
+    for (std::size_t i = 0; i < cpus.size(); ++i) r.cores[i].cpu = cpus[i];
+
+    // Give every thread time to pin itself before the first shared deadline.
+    const uint64_t startNs = bench_clock::NowNs() + 100000000ULL;
+    const uint64_t endNs   = startNs + static_cast<uint64_t>(cfg.durationMs) * 1000000ULL;
+
+    std::mutex noteMutex;
+    std::vector<std::thread> threads;
+    for (auto& core : r.cores)
+        threads.emplace_back(CoreThread, std::cref(cfg), startNs, endNs, std::ref(core),
+                             std::ref(r.note), std::ref(noteMutex), cancel);
+
+    if (progress)
+    {
+        while (!(cancel && cancel->load()))
+        {
+            uint64_t now = bench_clock::NowNs();
+            if (now >= endNs) break;
+            uint64_t done = now > startNs ? now - startNs : 0;
+            *progress = static_cast<uint32_t>(done * 1000 / (endNs - startNs));
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    for (auto& t : threads) t.join();
+    if (progress) *progress = 1000;
+
+    for (const auto& core : r.cores)
+        if (!core.pinned)
+        {
+            r.note += (r.note.empty() ? "" : "; ") + std::string("could not pin to CPU ") +
+                      std::to_string(core.cpu);
+            break;
+        }
+
+    r.ok = std::any_of(r.cores.begin(), r.cores.end(),
+                       [](const CoreResult& c) { return c.wakeup.Count() > 0; });
+    if (!r.ok) r.error = "no wake-ups recorded";
+    return r;
+}
+
+// ─── Heatmap ─────────────────────────────────────────────────────────────────
+
+const char* HeatmapBinLabel(int bin)
+{
+    static const char* kLabels[kHeatmapBins] = {
+        "<1us", "<2us", "<4us", "<8us", "<16us", "<32us", "<64us", "<128us",
+        "<256us", "<512us", "<1ms", "<2ms", "<4ms", ">=4ms",
+    };
+    return (bin >= 0 && bin < kHeatmapBins) ? kLabels[bin] : "?";
+}
+
+std::vector<double> HeatmapRow(const LatencyHistogram& h)
+{
+    std::vector<double> row(kHeatmapBins, 0.0);
+    if (h.Count() == 0) return row;
+
+    for (std::size_t i = 0; i < h.BucketCount(); ++i)
+    {
+        uint64_t n = h.BucketValue(i);
+        if (!n) continue;
+        uint64_t us = LatencyHistogram::BucketLower(i) / 1000;
+        int bin = 0;
+        while (bin < kHeatmapBins - 1 && us >= (1ULL << bin)) ++bin;
+        row[bin] += static_cast<double>(n);
+    }
+    for (double& v : row) v /= static_cast<double>(h.Count());
+    return row;
+}
+
+std::vector<uint32_t> RankByQuietness(const Result& r)
+{
+    std::vector<const CoreResult*> cores;
+    for (const auto& c : r.cores)
+        if (c.wakeup.Count()) cores.push_back(&c);
+
+    std::stable_sort(cores.begin(), cores.end(), [](const CoreResult* a, const CoreResult* b) {
+        uint64_t pa = a->wakeup.ValueAtPercentile(99.9), pb = b->wakeup.ValueAtPercentile(99.9);
+        if (pa != pb) return pa < pb;
+        return a->wakeup.Max() < b->wakeup.Max();
+    });
+
+    std::vector<uint32_t> out;
+    for (const auto* c : cores) out.push_back(c->cpu);
+    return out;
+}
+
+// Log-scale shade: each step is a factor of ten in share of wake-ups.
+static char Shade(double fraction)
+{
+    if (fraction <= 0.0)   return ' ';
+    if (fraction >= 0.5)   return '@';
+    if (fraction >= 0.1)   return '#';
+    if (fraction >= 0.01)  return '*';
+    if (fraction >= 0.001) return '+';
+    if (fraction >= 1e-4)  return '-';
+    return '.';
+}
+
+std::string RenderHeatmap(const Result& r)
+{
+    std::string out;
+    char buf[128];
+
+    out += "cpu   ";
+    for (int b = 0; b < kHeatmapBins; ++b)
+    {
+        std::snprintf(buf, sizeof(buf), "%-7s", HeatmapBinLabel(b));
+        out += buf;
+    }
+    out += "   p99 us  p99.9 us    max us\n";
+
+    for (const auto& c : r.cores)
+    {
+        std::snprintf(buf, sizeof(buf), "%-5u ", c.cpu);
+        out += buf;
+        for (double f : HeatmapRow(c.wakeup))
+        {
+            out += "  ";
+            out.append(3, Shade(f));
+            out += "  ";
+        }
+        std::snprintf(buf, sizeof(buf), " %8.1f  %8.1f  %8.1f%s\n",
+                      c.wakeup.ValueAtPercentile(99.0) / 1000.0,
+                      c.wakeup.ValueAtPercentile(99.9) / 1000.0,
+                      c.wakeup.Max() / 1000.0,
+                      c.pinned ? "" : "  (not pinned)");
+        out += buf;
+    }
+    out += "\nshade = share of wake-ups: @ >=50%  # >=10%  * >=1%  + >=0.1%  - >=0.01%  . <0.01%\n";
+    return out;
+}
+
+} // namespace core_latency
@@ -0,0 +1,61 @@
+#pragma once
+#include "histogram.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-core wake-up latency (cyclictest-style).  One pinned, real-time
+// priority thread per logical CPU sleeps on an OS timer with a fixed period,
+// all cores at once, and records how late each wake-up is.  Cores that
+// service busy interrupts/DPCs show up as hot rows in the heatmap, so
+// interrupt and game-thread placement can be chosen from data instead of
+// the hard-coded CPU 0 / CPU 1 masks.
+namespace core_latency {
+
+struct Config {
+    uint32_t              intervalUs = 1000;
+    uint32_t              durationMs = 10000;
+    std::vector<uint32_t> cpus;               // empty = every logical CPU
+    bool                  realTime   = true;
+};
+
+struct CoreResult {
+    uint32_t         cpu      = 0;
+    bool             pinned   = false;
+    bool             realTime = false;
+    LatencyHistogram wakeup;               // actual wake - scheduled wake
+};
+
+struct Result {
+    bool                    ok = false;
+    std::string             error;
+    std::string             note;          // e.g. real-time priority refused
+    uint32_t                intervalUs = 0;
+    std::vector<CoreResult> cores;
+};
+
+// Blocks for cfg.durationMs (or until `cancel`).  `progress`, if given, is
+// updated with the elapsed fraction in 1/1000 units for UI polling.
+Result Run(const Config& cfg, const std::atomic<bool>* cancel = nullptr,
+           std::atomic<uint32_t>* progress = nullptr);
+
+// ─── Heatmap ────────────────────────────────────────────────────────────────
+
+// Log2 latency bins: <1 us, <2 us, ... <4096 us, then >= 4096 us.
+constexpr int kHeatmapBins = 14;
+const char* HeatmapBinLabel(int bin);
+
+// Fraction of a core's wake-ups falling in each bin.
+std::vector<double> HeatmapRow(const LatencyHistogram& h);
+
+// CPUs ordered quietest first (by p99.9, then max).
+std::vector<uint32_t> RankByQuietness(const Result& r);
+
+// Text rendering for the console: one row per core, one shaded cell per
+// bin (log-scale shading so rare tail events remain visible), then p99 /
+// p99.9 / max.
+std::string RenderHeatmap(const Result& r);
+
+} // namespace core_latency
@@ -0,0 +1,667 @@
+#include "cpu_topology.h"
+#include "thread_util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+namespace cpu_topology {
+
+// ─── Model ───────────────────────────────────────────────────────────────────
+
+const Cpu* Topology::Find(uint32_t index) const
+{
+    auto it = std::lower_bound(cpus.begin(), cpus.end(), index,
+                               [](const Cpu& c, uint32_t i) { return c.index < i; });
+    return it != cpus.end() && it->index == index ? &*it : nullptr;
+}
+
+bool Topology::Smt() const
+{
+    return std::any_of(cores.begin(), cores.end(), [](const Core& c) { return c.cpus.size() > 1; });
+}
+
+bool Topology::Hybrid() const
+{
+    return std::any_of(cores.begin(), cores.end(),
+                       [&](const Core& c) { return c.efficiencyClass != maxEfficiencyClass; });
+}
+
+// Builders fill cpus (index, group, number, package, numaNode), the cores'
+// and caches' CPU lists and the cores' efficiency class; this derives the
+// rest so both decoders produce the same ordering.
+static void Finish(Topology& t)
+{
+    std::sort(t.cpus.begin(), t.cpus.end(), [](const Cpu& a, const Cpu& b) { return a.index < b.index; });
+
+    for (auto& c : t.cores) std::sort(c.cpus.begin(), c.cpus.end());
+    t.cores.erase(std::remove_if(t.cores.begin(), t.cores.end(), [](const Core& c) { return c.cpus.empty(); }),
+                  t.cores.end());
+    std::sort(t.cores.begin(), t.cores.end(), [](const Core& a, const Core& b) { return a.cpus[0] < b.cpus[0]; });
+
+    for (auto& c : t.caches) std::sort(c.cpus.begin(), c.cpus.end());
+    std::sort(t.caches.begin(), t.caches.end(), [](const Cache& a, const Cache& b) {
+        return std::tie(a.level, a.cpus) < std::tie(b.level, b.cpus);
+    });
+    t.caches.erase(std::unique(t.caches.begin(), t.caches.end(),
+                               [](const Cache& a, const Cache& b) { return a.level == b.level && a.cpus == b.cpus; }),
+                   t.caches.end());
+
+    t.maxEfficiencyClass = 0;
+    for (std::size_t i = 0; i < t.cores.size(); ++i)
+    {
+        Core& core = t.cores[i];
+        t.maxEfficiencyClass = std::max(t.maxEfficiencyClass, core.efficiencyClass);
+        for (uint32_t idx : core.cpus)
+            if (Cpu* cpu = const_cast<Cpu*>(t.Find(idx)))
+            {
+                cpu->core            = static_cast<uint32_t>(i);
+                cpu->efficiencyClass = core.efficiencyClass;
+                core.package         = cpu->package;
+            }
+    }
+    for (std::size_t i = 0; i < t.caches.size(); ++i)
+        for (uint32_t idx : t.caches[i].cpus)
+            if (Cpu* cpu = const_cast<Cpu*>(t.Find(idx)))
+                (t.caches[i].level == 2 ? cpu->l2 : cpu->l3) = static_cast<int>(i);
+
+    std::set<uint32_t> packages, nodes;
+    t.groups = 0;
+    for (const auto& c : t.cpus)
+    {
+        packages.insert(c.package);
+        nodes.insert(c.numaNode);
+        t.groups = std::max<uint16_t>(t.groups, static_cast<uint16_t>(c.group + 1));
+    }
+    t.packages  = static_cast<uint32_t>(packages.size());
+    t.numaNodes = static_cast<uint32_t>(nodes.size());
+}
+
+// ─── GetLogicalProcessorInformationEx decoder ────────────────────────────────
+
+// x64 layout of SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX, spelled out so the
+// buffer decodes on any host.  Each record: DWORD Relationship, DWORD Size,
+// then the union at offset 8.  GROUP_AFFINITY is { KAFFINITY Mask; WORD
+// Group; WORD Reserved[3] } = 16 bytes.
+namespace slpi {
+enum : uint32_t { kCore = 0, kNuma = 1, kCache = 2, kPackage = 3, kGroup = 4, kNumaEx = 6 };
+constexpr std::size_t kHeader        = 8;
+constexpr std::size_t kAffinitySize  = 16;
+constexpr std::size_t kCoreMasks     = 24;    // PROCESSOR_RELATIONSHIP.GroupMask
+constexpr std::size_t kCoreCount     = 22;    // .GroupCount
+constexpr std::size_t kNumaMasks     = 24;    // NUMA_NODE_RELATIONSHIP.GroupMask
+constexpr std::size_t kNumaCount     = 22;
+constexpr std::size_t kCacheMasks    = 32;    // CACHE_RELATIONSHIP.GroupMask
+constexpr std::size_t kCacheCount    = 30;
+constexpr std::size_t kGroupInfo     = 24;    // GROUP_RELATIONSHIP.GroupInfo
+constexpr std::size_t kGroupInfoSize = 48;    // PROCESSOR_GROUP_INFO
+constexpr std::size_t kGroupInfoMask = 40;    // .ActiveProcessorMask
+} // namespace slpi
+
+template <typename T>
+static T Load(const uint8_t* p)
+{
+    T v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static int PopCount(uint64_t v)
+{
+    int n = 0;
+    for (; v; v &= v - 1) ++n;
+    return n;
+}
+
+struct Affinity {
+    uint16_t group;
+    uint64_t mask;
+};
+
+// GROUP_AFFINITY array at `at` inside a record body of `size` bytes.
+static bool ReadMasks(const uint8_t* body, std::size_t size, std::size_t at, uint16_t count,
+                      std::vector<Affinity>& out)
+{
+    out.clear();
+    if (at + static_cast<std::size_t>(count) * slpi::kAffinitySize > size) return false;
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        const uint8_t* a = body + at + i * slpi::kAffinitySize;
+        out.push_back({ Load<uint16_t>(a + 8), Load<uint64_t>(a) });
+    }
+    return true;
+}
+
+bool DecodeProcessorInformation(const void* data, std::size_t size, Topology& out, std::string& error)
+{
+    struct Record {
+        uint32_t       relationship;
+        const uint8_t* body;
+        std::size_t    size;
+    };
+    std::vector<Record> records;
+    const uint8_t* base = static_cast<const uint8_t*>(data);
+    for (std::size_t off = 0; off < size;)
+    {
+        if (size - off < slpi::kHeader)
+        {
+            error = "truncated record header at offset " + std::to_string(off);
+            return false;
+        }
+        uint32_t rel = Load<uint32_t>(base + off);
+        uint32_t len = Load<uint32_t>(base + off + 4);
+        if (len < slpi::kHeader || len > size - off)
+        {
+            error = "bad record size " + std::to_string(len) + " at offset " + std::to_string(off);
+            return false;
+        }
+        records.push_back({ rel, base + off + slpi::kHeader, len - slpi::kHeader });
+        off += len;
+    }
+
+    // Active processors per group give the flat numbering.  Without a group
+    // record (partial dumps) the core records stand in.
+    std::vector<uint64_t> active;
+    std::vector<Affinity> masks;
+    for (const auto& r : records)
+    {
+        if (r.relationship != slpi::kGroup || r.size < slpi::kGroupInfo) continue;
+        uint16_t groups = Load<uint16_t>(r.body + 2);
+        if (slpi::kGroupInfo + groups * slpi::kGroupInfoSize > r.size)
+        {
+            error = "truncated group record";
+            return false;
+        }
+        active.assign(groups, 0);
+        for (uint16_t g = 0; g < groups; ++g)
+            active[g] = Load<uint64_t>(r.body + slpi::kGroupInfo + g * slpi::kGroupInfoSize + slpi::kGroupInfoMask);
+    }
+    if (active.empty())
+        for (const auto& r : records)
+            if (r.relationship == slpi::kCore && r.size >= slpi::kCoreMasks &&
+                ReadMasks(r.body, r.size, slpi::kCoreMasks, Load<uint16_t>(r.body + slpi::kCoreCount), masks))
+                for (const auto& m : masks)
+                {
+                    if (m.group >= active.size()) active.resize(m.group + 1u, 0);
+                    active[m.group] |= m.mask;
+                }
+    std::vector<uint32_t> first(active.size() + 1, 0);
+    for (std::size_t g = 0; g < active.size(); ++g)
+        first[g + 1] = first[g] + static_cast<uint32_t>(PopCount(active[g]));
+
+    // Visits every CPU named by `masks`; false when one is not active.
+    auto forEachCpu = [&](const std::vector<Affinity>& ms, auto&& fn) {
+        for (const auto& m : ms)
+            for (int bit = 0; bit < 64; ++bit)
+            {
+                uint64_t b = uint64_t(1) << bit;
+                if (!(m.mask & b)) continue;
+                if (m.group >= active.size() || !(active[m.group] & b)) return false;
+                fn(first[m.group] + static_cast<uint32_t>(PopCount(active[m.group] & (b - 1))), m.group,
+                   static_cast<uint8_t>(bit));
+            }
+        return true;
+    };
+
+    Topology t;
+    std::map<uint32_t, Cpu> cpus;
+    for (const auto& r : records)
+    {
+        if (r.relationship != slpi::kCore) continue;
+        if (r.size < slpi::kCoreMasks ||
+            !ReadMasks(r.body, r.size, slpi::kCoreMasks, Load<uint16_t>(r.body + slpi::kCoreCount), masks))
+        {
+            error = "truncated processor core record";
+            return false;
+        }
+        Core core;
+        core.efficiencyClass = r.body[1];
+        bool ok = forEachCpu(masks, [&](uint32_t idx, uint16_t group, uint8_t bit) {
+            Cpu& c   = cpus[idx];
+            c.index  = idx;
+            c.group  = group;
+            c.number = bit;
+            core.cpus.push_back(idx);
+        });
+        if (!ok)
+        {
+            error = "core record names an inactive processor";
+            return false;
+        }
+        t.cores.push_back(std::move(core));
+    }
+    if (cpus.empty())
+    {
+        error = "no processor core records";
+        return false;
+    }
+
+    uint32_t package = 0;
+    for (const auto& r : records)
+    {
+        bool ok = true;
+        switch (r.relationship) {
+        case slpi::kPackage:
+            ok = r.size >= slpi::kCoreMasks &&
+                 ReadMasks(r.body, r.size, slpi::kCoreMasks, Load<uint16_t>(r.body + slpi::kCoreCount), masks);
+            if (ok)
+            {
+                forEachCpu(masks, [&](uint32_t idx, uint16_t, uint8_t) { cpus[idx].package = package; });
+                ++package;
+            }
+            break;
+        case slpi::kNuma:
+        case slpi::kNumaEx: {
+            // GroupCount 0 (pre-Windows 11 layout) means one GroupMask.
+            ok = r.size >= slpi::kNumaMasks;
+            if (!ok) break;
+            uint16_t n = Load<uint16_t>(r.body + slpi::kNumaCount);
+            uint32_t node = Load<uint32_t>(r.body);
+            ok = ReadMasks(r.body, r.size, slpi::kNumaMasks, n ? n : 1, masks);
+            if (ok) forEachCpu(masks, [&](uint32_t idx, uint16_t, uint8_t) { cpus[idx].numaNode = node; });
+            break;
+        }
+        case slpi::kCache: {
+            ok = r.size >= slpi::kCacheMasks;
+            if (!ok) break;
+            uint8_t  level = r.body[0];
+            uint32_t type  = Load<uint32_t>(r.body + 8);          // 0 unified, 1 code, 2 data
+            uint16_t n     = Load<uint16_t>(r.body + slpi::kCacheCount);
+            ok = ReadMasks(r.body, r.size, slpi::kCacheMasks, n ? n : 1, masks);
+            if (!ok || (level != 2 && level != 3) || type == 1) break;
+            Cache cache;
+            cache.level = level;
+            cache.bytes = Load<uint32_t>(r.body + 4);
+            forEachCpu(masks, [&](uint32_t idx, uint16_t, uint8_t) {
+                if (cpus.count(idx)) cache.cpus.push_back(idx);
+            });
+            if (!cache.cpus.empty()) t.caches.push_back(std::move(cache));
+            break;
+        }
+        default:
+            break;
+        }
+        if (!ok)
+        {
+            error = "truncated record (relationship " + std::to_string(r.relationship) + ")";
+            return false;
+        }
+    }
+
+    for (auto& kv : cpus) t.cpus.push_back(kv.second);
+    Finish(t);
+    out = std::move(t);
+    return true;
+}
+
+bool ReadProcessorInformation(std::vector<uint8_t>& out, std::string& error)
+{
+#ifdef _WIN32
+    DWORD len = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &len);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+    {
+        error = "GetLogicalProcessorInformationEx failed (error " + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+    out.resize(len);
+    if (!GetLogicalProcessorInformationEx(
+            RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(out.data()), &len))
+    {
+        error = "GetLogicalProcessorInformationEx failed (error " + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+    out.resize(len);
+    return true;
+#else
+    out.clear();
+    error = "processor information buffers exist on Windows only";
+    return false;
+#endif
+}
+
+// ─── sysfs parser ────────────────────────────────────────────────────────────
+
+static bool ReadText(const std::string& path, std::string& out)
+{
+    std::ifstream f(path);
+    if (!f || !std::getline(f, out)) return false;
+    while (!out.empty() && (out.back() == '\r' || out.back() == ' ')) out.pop_back();
+    return true;
+}
+
+static bool ReadNumber(const std::string& path, long long& out)
+{
+    std::string s;
+    if (!ReadText(path, s)) return false;
+    char* end = nullptr;
+    out = std::strtoll(s.c_str(), &end, 10);
+    return end != s.c_str();
+}
+
+// "32K", "1024K", "32M" -> bytes
+static uint64_t ParseSize(const std::string& s)
+{
+    char* end = nullptr;
+    uint64_t v = std::strtoull(s.c_str(), &end, 10);
+    if (end && (*end == 'K' || *end == 'k')) v <<= 10;
+    if (end && (*end == 'M' || *end == 'm')) v <<= 20;
+    return v;
+}
+
+bool ParseSysfs(const std::string& root, Topology& out, std::string& error)
+{
+    namespace fs = std::filesystem;
+    const std::string base = root + "/sys/devices/system/cpu";
+
+    std::vector<uint32_t> online;
+    std::string text;
+    if (!ReadText(base + "/online", text) || !ParseCpuList(text, online))
+    {
+        std::error_code ec;
+        for (const auto& e : fs::directory_iterator(base, ec))
+        {
+            std::string n = e.path().filename().string();
+            if (n.size() > 3 && n.compare(0, 3, "cpu") == 0 &&
+                n.find_first_not_of("0123456789", 3) == std::string::npos)
+                online.push_back(static_cast<uint32_t>(std::stoul(n.substr(3))));
+        }
+        std::sort(online.begin(), online.end());
+    }
+    if (online.empty())
+    {
+        error = "no CPUs under " + base;
+        return false;
+    }
+
+    // Hybrid Intel parts expose one PMU per core type; ARM big.LITTLE
+    // reports a per-CPU capacity instead.
+    std::vector<uint32_t> bigCpus, littleCpus;
+    bool pmuHybrid = ReadText(root + "/sys/devices/cpu_core/cpus", text) && ParseCpuList(text, bigCpus);
+    if (pmuHybrid && ReadText(root + "/sys/devices/cpu_atom/cpus", text)) ParseCpuList(text, littleCpus);
+
+    Topology t;
+    std::map<std::tuple<long long, long long, long long>, std::size_t> coreOf;
+    std::map<std::pair<long long, std::string>, std::size_t> cacheOf;
+    std::map<uint32_t, long long> capacity;
+    for (uint32_t idx : online)
+    {
+        const std::string dir = base + "/cpu" + std::to_string(idx);
+        Cpu c;
+        c.index  = idx;
+        c.group  = static_cast<uint16_t>(idx / 64);
+        c.number = static_cast<uint8_t>(idx % 64);
+
+        long long pkg = 0, die = 0, core = -1 - static_cast<long long>(idx);   // unique when unknown
+        if (!ReadNumber(dir + "/topology/physical_package_id", pkg) || pkg < 0) pkg = 0;
+        if (!ReadNumber(dir + "/topology/die_id", die) || die < 0) die = 0;
+        ReadNumber(dir + "/topology/core_id", core);
+        c.package = static_cast<uint32_t>(pkg);
+
+        auto key = std::make_tuple(pkg, die, core);
+        auto it  = coreOf.find(key);
+        if (it == coreOf.end())
+        {
+            it = coreOf.emplace(key, t.cores.size()).first;
+            t.cores.emplace_back();
+        }
+        Core& owner = t.cores[it->second];
+        owner.cpus.push_back(idx);
+        if (pmuHybrid)
+            owner.efficiencyClass = std::find(littleCpus.begin(), littleCpus.end(), idx) != littleCpus.end() ? 0 : 1;
+
+        long long cap = 0;
+        if (ReadNumber(dir + "/cpu_capacity", cap)) capacity[idx] = cap;
+
+        for (int i = 0; i < 16; ++i)   // index0..; captures may keep only L2 / L3
+        {
+            const std::string cdir = dir + "/cache/index" + std::to_string(i);
+            long long level = 0;
+            if (!ReadNumber(cdir + "/level", level)) continue;
+            std::string type, shared, size;
+            ReadText(cdir + "/type", type);
+            if ((level != 2 && level != 3) || type == "Instruction") continue;
+            if (!ReadText(cdir + "/shared_cpu_list", shared)) shared = std::to_string(idx);
+            auto ck = std::make_pair(level, shared);
+            if (cacheOf.count(ck)) continue;
+            Cache cache;
+            cache.level = static_cast<uint8_t>(level);
+            if (ReadText(cdir + "/size", size)) cache.bytes = ParseSize(size);
+            ParseCpuList(shared, cache.cpus);
+            cache.cpus.erase(std::remove_if(cache.cpus.begin(), cache.cpus.end(),
+                                            [&](uint32_t x) {
+                                                return !std::binary_search(online.begin(), online.end(), x);
+                                            }),
+                             cache.cpus.end());
+            cacheOf.emplace(ck, t.caches.size());
+            t.caches.push_back(std::move(cache));
+        }
+        t.cpus.push_back(c);
+    }
+
+    if (!pmuHybrid && !capacity.empty())
+    {
+        std::set<long long> levels;
+        for (const auto& kv : capacity) levels.insert(kv.second);
+        for (auto& core : t.cores)
+        {
+            auto cap = capacity.find(core.cpus[0]);
+            if (cap != capacity.end())
+                core.efficiencyClass = static_cast<uint8_t>(std::distance(levels.begin(), levels.find(cap->second)));
+        }
+    }
+
+    std::error_code ec;
+    for (const auto& e : fs::directory_iterator(root + "/sys/devices/system/node", ec))
+    {
+        std::string n = e.path().filename().string();
+        std::vector<uint32_t> list;
+        if (n.size() <= 4 || n.compare(0, 4, "node") != 0 ||
+            n.find_first_not_of("0123456789", 4) != std::string::npos ||
+            !ReadText(e.path().string() + "/cpulist", text) || !ParseCpuList(text, list))
+            continue;
+        uint32_t node = static_cast<uint32_t>(std::stoul(n.substr(4)));
+        for (auto& c : t.cpus)
+            if (std::find(list.begin(), list.end(), c.index) != list.end()) c.numaNode = node;
+    }
+
+    Finish(t);
+    out = std::move(t);
+    return true;
+}
+
+bool CaptureSysfs(const std::string& root, const std::string& dest, std::string& error)
+{
+    namespace fs = std::filesystem;
+    static const char* kCpuFiles[] = {
+        "topology/physical_package_id", "topology/die_id", "topology/core_id",
+        "topology/thread_siblings_list", "cpu_capacity",
+    };
+    static const char* kCacheFiles[] = { "level", "type", "size", "shared_cpu_list" };
+
+    std::vector<std::string> files = { "/sys/devices/system/cpu/online", "/sys/devices/cpu_core/cpus",
+                                       "/sys/devices/cpu_atom/cpus" };
+    std::error_code ec;
+    for (const auto& e : fs::directory_iterator(root + "/sys/devices/system/cpu", ec))
+    {
+        std::string n = e.path().filename().string();
+        if (n.size() <= 3 || n.compare(0, 3, "cpu") != 0 || n.find_first_not_of("0123456789", 3) != std::string::npos)
+            continue;
+        const std::string dir = "/sys/devices/system/cpu/" + n;
+        for (const char* f : kCpuFiles) files.push_back(dir + "/" + f);
+        std::error_code cec;
+        for (const auto& c : fs::directory_iterator(root + dir + "/cache", cec))
+            for (const char* f : kCacheFiles)
+                files.push_back(dir + "/cache/" + c.path().filename().string() + "/" + f);
+    }
+    for (const auto& e : fs::directory_iterator(root + "/sys/devices/system/node", ec))
+        files.push_back("/sys/devices/system/node/" + e.path().filename().string() + "/cpulist");
+
+    std::size_t copied = 0;
+    for (const auto& f : files)
+    {
+        std::string content;
+        if (!ReadText(root + f, content)) continue;     // optional file
+        fs::create_directories(fs::path(dest + f).parent_path(), ec);
+        std::ofstream o(dest + f);
+        if (!(o << content << "\n"))
+        {
+            error = "cannot write " + dest + f;
+            return false;
+        }
+        ++copied;
+    }
+    if (copied == 0)
+    {
+        error = "nothing to capture under " + root + "/sys/devices/system/cpu";
+        return false;
+    }
+    return true;
+}
+
+// ─── Current machine ─────────────────────────────────────────────────────────
+
+static Topology Flat()
+{
+    Topology t;
+    for (uint32_t i = 0, n = thread_util::LogicalCpuCount(); i < n; ++i)
+    {
+        Cpu c;
+        c.index  = i;
+        c.group  = static_cast<uint16_t>(i / 64);
+        c.number = static_cast<uint8_t>(i % 64);
+        t.cpus.push_back(c);
+        t.cores.push_back({ 0, 0, { i } });
+    }
+    Finish(t);
+    return t;
+}
+
+const Topology& Current()
+{
+    static const Topology topology = [] {
+        Topology t;
+        std::string error;
+#ifdef _WIN32
+        std::vector<uint8_t> raw;
+        if (ReadProcessorInformation(raw, error) && DecodeProcessorInformation(raw.data(), raw.size(), t, error))
+            return t;
+#else
+        if (ParseSysfs("", t, error)) return t;
+#endif
+        return Flat();
+    }();
+    return topology;
+}
+
+// ─── Queries ─────────────────────────────────────────────────────────────────
+
+std::vector<uint32_t> PrimaryThreads(const Topology& t, bool performanceOnly)
+{
+    std::vector<uint32_t> out;
+    for (const auto& core : t.cores)
+        if (!performanceOnly || core.efficiencyClass == t.maxEfficiencyClass) out.push_back(core.cpus[0]);
+    return out;
+}
+
+std::vector<uint32_t> Siblings(const Topology& t, uint32_t cpu)
+{
+    std::vector<uint32_t> out;
+    const Cpu* c = t.Find(cpu);
+    if (!c) return out;
+    for (uint32_t other : t.cores[c->core].cpus)
+        if (other != cpu) out.push_back(other);
+    return out;
+}
+
+uint64_t GroupMask(const Topology& t, const std::vector<uint32_t>& cpus, uint16_t group)
+{
+    uint64_t mask = 0;
+    for (uint32_t idx : cpus)
+        if (const Cpu* c = t.Find(idx))
+            if (c->group == group) mask |= uint64_t(1) << c->number;
+    return mask;
+}
+
+std::string FormatCpuList(const std::vector<uint32_t>& cpus)
+{
+    std::vector<uint32_t> v(cpus);
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+
+    std::string out;
+    for (std::size_t i = 0; i < v.size();)
+    {
+        std::size_t j = i;
+        while (j + 1 < v.size() && v[j + 1] == v[j] + 1) ++j;
+        if (!out.empty()) out += ",";
+        out += std::to_string(v[i]);
+        if (j > i) out += "-" + std::to_string(v[j]);
+        i = j + 1;
+    }
+    return out;
+}
+
+bool ParseCpuList(const std::string& text, std::vector<uint32_t>& out)
+{
+    out.clear();
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (item.empty()) continue;
+        unsigned long lo = 0, hi = 0;
+        char tail = 0;
+        int n = std::sscanf(item.c_str(), "%lu-%lu%c", &lo, &hi, &tail);
+        if (n == 1) hi = lo;
+        else if (n != 2 || hi < lo || hi - lo > 65535) return false;
+        for (unsigned long i = lo; i <= hi; ++i) out.push_back(static_cast<uint32_t>(i));
+    }
+    return !out.empty();
+}
+
+std::string Describe(const Topology& t)
+{
+    std::ostringstream out;
+    out << t.cpus.size() << " logical CPUs, " << t.cores.size() << " cores" << (t.Smt() ? " (SMT)" : "")
+        << ", " << t.packages << " package(s), " << t.numaNodes << " NUMA node(s), " << t.groups
+        << " processor group(s)\n";
+    if (t.Hybrid())
+    {
+        std::size_t perf = PrimaryThreads(t, true).size();
+        out << "Hybrid: " << perf << " performance / " << t.cores.size() - perf << " efficiency cores\n";
+    }
+
+    char line[160];
+    for (std::size_t i = 0; i < t.cores.size(); ++i)
+    {
+        const Core& c = t.cores[i];
+        const Cpu*  p = t.Find(c.cpus[0]);
+        std::snprintf(line, sizeof(line), "  core %-3zu cpus %-10s pkg %u  node %u  class %u  L2 %s  L3 %s\n", i,
+                      FormatCpuList(c.cpus).c_str(), c.package, p ? p->numaNode : 0, c.efficiencyClass,
+                      p && p->l2 >= 0 ? std::to_string(p->l2).c_str() : "-",
+                      p && p->l3 >= 0 ? std::to_string(p->l3).c_str() : "-");
+        out << line;
+    }
+    for (std::size_t i = 0; i < t.caches.size(); ++i)
+    {
+        const Cache& c = t.caches[i];
+        std::snprintf(line, sizeof(line), "  cache %-3zu L%u %6llu KB  cpus %s\n", i, c.level,
+                      static_cast<unsigned long long>(c.bytes >> 10), FormatCpuList(c.cpus).c_str());
+        out << line;
+    }
+    return out.str();
+}
+
+} // namespace cpu_topology
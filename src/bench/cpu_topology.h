@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// CPU topology model: logical CPUs, physical cores with their SMT siblings,
+// L2 / L3 domains, packages, NUMA nodes, efficiency classes (hybrid P/E
+// parts) and processor groups.  Tweaks and planners pick CPUs from this
+// model instead of hard-coding affinity bits like 0x01 / 0x02, which on an
+// SMT part put two "dedicated" interrupts on one physical core.
+//
+// CPUs use the flat numbering of thread_util: 0..N-1 across all processor
+// groups, each group contributing its active processors in bit order.
+//
+// Both decoders are pure functions of captured data, so dumps from real
+// SKUs (the raw GetLogicalProcessorInformationEx buffer, or a copy of
+// /sys/devices/system/cpu) decode the same way on any host.
+namespace cpu_topology {
+
+struct Cpu {
+    uint32_t index    = 0;        // flat CPU number
+    uint16_t group    = 0;        // processor group (Linux: index / 64)
+    uint8_t  number   = 0;        // bit within the group
+    uint32_t core     = 0;        // Topology::cores index
+    uint32_t package  = 0;
+    uint32_t numaNode = 0;
+    int      l2       = -1;       // Topology::caches index, -1 = unknown
+    int      l3       = -1;
+    uint8_t  efficiencyClass = 0; // higher = faster core (Windows semantics)
+};
+
+struct Core {
+    uint32_t              package = 0;
+    uint8_t               efficiencyClass = 0;
+    std::vector<uint32_t> cpus;   // ascending; cpus[0] is the primary thread
+};
+
+struct Cache {
+    uint8_t               level = 0;   // 2 or 3
+    uint64_t              bytes = 0;
+    std::vector<uint32_t> cpus;
+};
+
+struct Topology {
+    std::vector<Cpu>   cpus;      // ascending index; may have gaps (offline CPUs)
+    std::vector<Core>  cores;     // ordered by primary thread
+    std::vector<Cache> caches;
+    uint32_t packages  = 0;
+    uint32_t numaNodes = 0;
+    uint16_t groups    = 0;
+    uint8_t  maxEfficiencyClass = 0;
+
+    const Cpu* Find(uint32_t index) const;
+    bool Smt() const;             // any core with more than one thread
+    bool Hybrid() const;          // cores of more than one efficiency class
+};
+
+// The running machine, decoded once and cached.  Falls back to a flat model
+// (one core per logical CPU) if the OS query fails.
+const Topology& Current();
+
+// Decodes a SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX buffer as returned by
+// GetLogicalProcessorInformationEx(RelationAll) on x64.
+bool DecodeProcessorInformation(const void* data, std::size_t size, Topology& out, std::string& error);
+
+// Reads <root>/sys/devices/system/cpu (plus .../node and the hybrid PMU
+// lists under /sys/devices/cpu_core, cpu_atom); root "" is the live system.
+bool ParseSysfs(const std::string& root, Topology& out, std::string& error);
+
+// Copies the files ParseSysfs reads from <root> into <dest>, preserving
+// paths, so `ParseSysfs(dest, ...)` reproduces this machine anywhere.
+bool CaptureSysfs(const std::string& root, const std::string& dest, std::string& error);
+
+// Raw GetLogicalProcessorInformationEx(RelationAll) buffer for capture.
+// Windows only; elsewhere it fails with an explanatory error.
+bool ReadProcessorInformation(std::vector<uint8_t>& out, std::string& error);
+
+// One logical CPU per physical core (its primary thread), in CPU order.
+// With `performanceOnly`, only cores of the highest efficiency class.
+std::vector<uint32_t> PrimaryThreads(const Topology& t, bool performanceOnly);
+
+// The other logical CPUs on the same physical core.
+std::vector<uint32_t> Siblings(const Topology& t, uint32_t cpu);
+
+// KAFFINITY-style mask of the `cpus` that live in processor `group`.
+uint64_t GroupMask(const Topology& t, const std::vector<uint32_t>& cpus, uint16_t group = 0);
+
+// "0-3,8,10-11" <-> CPU numbers (the Linux cpulist format).
+std::string FormatCpuList(const std::vector<uint32_t>& cpus);
+bool        ParseCpuList(const std::string& text, std::vector<uint32_t>& out);
+
+// Multi-line summary: counts, then one line per core and cache domain.
+std::string Describe(const Topology& t);
+
+} // namespace cpu_topology
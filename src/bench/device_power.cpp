@@ -0,0 +1,440 @@
+#include "device_power.h"
+#include "machine_profile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <cfgmgr32.h>
+#endif
+
+namespace device_power {
+
+static const char* kEnumRoot  = "SYSTEM\\CurrentControlSet\\Enum";
+static const char* kClassRoot = "SYSTEM\\CurrentControlSet\\Control\\Class";
+
+static std::string Lower(std::string s)
+{
+    for (char& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+static std::string Upper(std::string s)
+{
+    for (char& c : s) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return s;
+}
+
+static bool StartsWith(const std::string& s, const char* prefix)
+{
+    return Upper(s).rfind(prefix, 0) == 0;
+}
+
+// ─── Devices ─────────────────────────────────────────────────────────────────
+
+const char* RoleName(Role r)
+{
+    switch (r) {
+    case Role::Other:      return "other";
+    case Role::Input:      return "input";
+    case Role::Network:    return "network";
+    case Role::Hub:        return "hub";
+    case Role::Controller: return "controller";
+    }
+    return "?";
+}
+
+static std::string DeviceKey(const std::string& instanceId)
+{
+    return std::string(kEnumRoot) + "\\" + instanceId;
+}
+
+// "@oem42.inf,%dev_c539%;USB Receiver" -> "USB Receiver"
+static std::string StripInfReference(const std::string& desc)
+{
+    if (desc.empty() || desc[0] != '@') return desc;
+    std::size_t semi = desc.rfind(';');
+    return semi == std::string::npos ? desc : desc.substr(semi + 1);
+}
+
+static Role RoleOf(const DeviceInfo& d)
+{
+    std::string cls = Lower(d.className);
+    if (cls == "hidclass" || cls == "keyboard" || cls == "mouse" || cls == "xnacomposite") return Role::Input;
+    if (cls == "net") return Role::Network;
+    if (cls == "usb")
+    {
+        if (StartsWith(d.instanceId, "PCI\\")) return Role::Controller;
+        if (Lower(d.service).rfind("usbhub", 0) == 0 || Upper(d.instanceId).find("ROOT_HUB") != std::string::npos)
+            return Role::Hub;
+    }
+    return Role::Other;
+}
+
+bool ReadDevice(const registry_access::Registry& reg, const std::string& instanceId, DeviceInfo& out)
+{
+    std::string key = DeviceKey(instanceId);
+    if (!reg.KeyExists(key)) return false;
+
+    out = DeviceInfo{};
+    out.instanceId = instanceId;
+    auto desc = reg.ReadString(key, "FriendlyName");
+    if (!desc) desc = reg.ReadString(key, "DeviceDesc");
+    out.description    = StripInfReference(desc.value_or(""));
+    out.className      = reg.ReadString(key, "Class").value_or("");
+    out.service        = reg.ReadString(key, "Service").value_or("");
+    out.driverKey      = reg.ReadString(key, "Driver").value_or("");
+    out.parentIdPrefix = reg.ReadString(key, "ParentIdPrefix").value_or("");
+    out.present        = reg.KeyExists(key + "\\Control");
+    out.role           = RoleOf(out);
+    return true;
+}
+
+std::vector<DeviceInfo> ListDevices(const registry_access::Registry& reg)
+{
+    std::vector<DeviceInfo> out;
+    for (const char* bus : { "USB", "HID", "PCI" })
+    {
+        std::string root = std::string(kEnumRoot) + "\\" + bus;
+        for (const auto& hw : reg.SubKeys(root))
+            for (const auto& inst : reg.SubKeys(root + "\\" + hw))
+            {
+                DeviceInfo d;
+                if (ReadDevice(reg, std::string(bus) + "\\" + hw + "\\" + inst, d)) out.push_back(std::move(d));
+            }
+    }
+    LinkParents(out);
+    MarkPath(out);
+    return out;
+}
+
+// "HID\VID_046D&PID_C539&MI_01&COL02\..." -> "VID_046D&PID_C539&MI_01"
+static std::string HardwarePart(const std::string& instanceId)
+{
+    std::size_t a = instanceId.find('\\');
+    std::size_t b = instanceId.rfind('\\');
+    if (a == std::string::npos || b <= a) return "";
+    std::string hw = Upper(instanceId.substr(a + 1, b - a - 1));
+    std::size_t col = hw.find("&COL");
+    return col == std::string::npos ? hw : hw.substr(0, col);
+}
+
+void LinkParents(std::vector<DeviceInfo>& devices)
+{
+    std::map<std::string, std::size_t> byPrefix;   // upper-case ParentIdPrefix
+    std::map<std::string, std::size_t> usbByHw;    // USB hardware part, present first
+    for (std::size_t i = 0; i < devices.size(); ++i)
+    {
+        const DeviceInfo& d = devices[i];
+        if (!d.parentIdPrefix.empty()) byPrefix[Upper(d.parentIdPrefix)] = i;
+        if (StartsWith(d.instanceId, "USB\\"))
+        {
+            auto it = usbByHw.find(HardwarePart(d.instanceId));
+            if (it == usbByHw.end() || (!devices[it->second].present && d.present))
+                usbByHw[HardwarePart(d.instanceId)] = i;
+        }
+    }
+
+    for (auto& d : devices)
+    {
+        if (!d.parent.empty()) continue;
+
+        // Children without a serial number are named "<ParentIdPrefix>&<n>"
+        std::string last = Upper(d.instanceId.substr(d.instanceId.rfind('\\') + 1));
+        std::size_t best = 0;
+        for (const auto& [prefix, index] : byPrefix)
+            if (prefix.size() > best && last.rfind(prefix + "&", 0) == 0 && devices[index].instanceId != d.instanceId)
+            {
+                best     = prefix.size();
+                d.parent = devices[index].instanceId;
+            }
+
+        if (d.parent.empty() && StartsWith(d.instanceId, "HID\\"))
+        {
+            auto it = usbByHw.find(HardwarePart(d.instanceId));
+            if (it != usbByHw.end()) d.parent = devices[it->second].instanceId;
+        }
+    }
+}
+
+bool LinkLiveParents(std::vector<DeviceInfo>& devices, std::string& error)
+{
+#ifdef _WIN32
+    for (auto& d : devices)
+    {
+        DEVINST node = 0, parent = 0;
+        if (CM_Locate_DevNodeA(&node, const_cast<char*>(d.instanceId.c_str()), CM_LOCATE_DEVNODE_NORMAL) != CR_SUCCESS)
+            continue;   // not present; keep the registry link
+        if (CM_Get_Parent(&parent, node, 0) != CR_SUCCESS) continue;
+        char id[MAX_DEVICE_ID_LEN] = {};
+        if (CM_Get_Device_IDA(parent, id, MAX_DEVICE_ID_LEN, 0) == CR_SUCCESS) d.parent = id;
+    }
+    return true;
+#else
+    (void)devices;
+    error = "the PnP device tree is only available on Windows";
+    return false;
+#endif
+}
+
+void MarkPath(std::vector<DeviceInfo>& devices)
+{
+    std::map<std::string, std::size_t> byId;
+    for (std::size_t i = 0; i < devices.size(); ++i)
+    {
+        devices[i].onPath = false;
+        byId[Upper(devices[i].instanceId)] = i;
+    }
+
+    for (const auto& d : devices)
+    {
+        if (d.role != Role::Input && d.role != Role::Network) continue;
+        auto it = byId.find(Upper(d.instanceId));
+        // Bounded walk: a malformed export cannot loop forever
+        for (int depth = 0; it != byId.end() && depth < 32; ++depth)
+        {
+            DeviceInfo& cur = devices[it->second];
+            cur.onPath = true;
+            it = cur.parent.empty() ? byId.end() : byId.find(Upper(cur.parent));
+        }
+    }
+}
+
+std::vector<DeviceInfo> LiveDevices(const registry_access::Registry& reg)
+{
+    std::vector<DeviceInfo> devices = ListDevices(reg);
+    std::string error;
+    if (LinkLiveParents(devices, error)) MarkPath(devices);
+    return devices;
+}
+
+// ─── Settings and backup ─────────────────────────────────────────────────────
+
+static bool HasValue(const registry_access::Registry& reg, const std::string& key, const char* name)
+{
+    for (const auto& v : reg.ValueNames(key))
+        if (Lower(v) == Lower(name)) return true;
+    return false;
+}
+
+std::vector<Write> Plan(const registry_access::Registry& reg, const DeviceInfo& d)
+{
+    std::vector<Write> out;
+    auto add = [&](const std::string& key, const char* name, uint32_t value, bool create) {
+        auto current = reg.ReadDword(key, name);
+        // A value the driver keeps in another type (REG_BINARY) is left alone
+        if (!current && (!create || HasValue(reg, key, name))) return;
+        out.push_back({ key, name, value, current });
+    };
+
+    std::string params = DeviceKey(d.instanceId) + "\\Device Parameters";
+    bool usb = StartsWith(d.instanceId, "USB\\");
+    add(params, "EnhancedPowerManagementEnabled", 0, usb);
+    add(params, "AllowIdleIrpInD3",               0, usb);
+    add(params, "SelectiveSuspendEnabled",        0, usb);
+    add(params, "EnableSelectiveSuspend",         0, false);
+    add(params, "SelectiveSuspendOn",             0, false);
+    add(params, "D3ColdSupported",                0, StartsWith(d.instanceId, "PCI\\"));
+    if (reg.KeyExists(params + "\\WDF")) add(params + "\\WDF", "IdleInWorkingState", 0, true);
+
+    // "Allow the computer to turn off this device to save power" off
+    if (d.role == Role::Network && !d.driverKey.empty())
+        add(std::string(kClassRoot) + "\\" + d.driverKey, "PnPCapabilities", 24, true);
+    return out;
+}
+
+bool Matches(const std::vector<Write>& writes)
+{
+    for (const auto& w : writes)
+        if (!w.current || *w.current != w.value) return false;
+    return true;
+}
+
+std::string DefaultBackupPath()
+{
+    return machine_profile::DataDir() + "/power-backup.txt";
+}
+
+// One line per value: instance id, key, name, "=value" or "-" when absent
+bool LoadBackups(const std::string& path, BackupSet& out, std::string& error)
+{
+    out.clear();
+    std::ifstream f(path);
+    if (!f) return true;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(f, line))
+    {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> fields;
+        std::istringstream ls(line);
+        for (std::string field; std::getline(ls, field, '\t');) fields.push_back(field);
+
+        DeviceBackup::Entry e;
+        bool ok = fields.size() == 4 && (fields[3] == "-" || (fields[3].size() > 1 && fields[3][0] == '='));
+        if (ok && fields[3] != "-")
+        {
+            char* end = nullptr;
+            unsigned long v = std::strtoul(fields[3].c_str() + 1, &end, 10);
+            ok      = *end == '\0';
+            e.value = static_cast<uint32_t>(v);
+        }
+        if (!ok)
+        {
+            error = path + ":" + std::to_string(lineNo) + ": malformed backup entry";
+            return false;
+        }
+        e.key  = fields[1];
+        e.name = fields[2];
+        DeviceBackup& b = out[Upper(fields[0])];
+        b.instanceId = fields[0];
+        b.entries.push_back(std::move(e));
+    }
+    return true;
+}
+
+bool SaveBackups(const std::string& path, const BackupSet& set, std::string& error)
+{
+    std::ofstream f(path, std::ios::trunc);
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    f << "# instance id\tkey\tvalue name\t=original, or - when it did not exist\n";
+    for (const auto& [id, b] : set)
+        for (const auto& e : b.entries)
+            f << b.instanceId << '\t' << e.key << '\t' << e.name << '\t'
+              << (e.value ? "=" + std::to_string(*e.value) : std::string("-")) << '\n';
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool Apply(registry_access::Registry& reg, const DeviceInfo& d, BackupSet& backups, std::string& error)
+{
+    std::vector<Write> writes = Plan(reg, d);
+    if (Matches(writes)) return true;
+
+    DeviceBackup& b = backups[Upper(d.instanceId)];
+    b.instanceId = d.instanceId;
+    for (const auto& w : writes)
+    {
+        bool recorded = std::any_of(b.entries.begin(), b.entries.end(), [&](const DeviceBackup::Entry& e) {
+            return Lower(e.key) == Lower(w.key) && Lower(e.name) == Lower(w.name);
+        });
+        if (!recorded) b.entries.push_back({ w.key, w.name, w.current });
+
+        if (!reg.WriteDword(w.key, w.name, w.value))
+        {
+            error = "cannot write " + w.key + "\\" + w.name;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Restore(registry_access::Registry& reg, const std::string& instanceId, BackupSet& backups, std::string& error)
+{
+    auto it = backups.find(Upper(instanceId));
+    if (it == backups.end()) return true;
+
+    for (const auto& e : it->second.entries)
+    {
+        bool ok = e.value ? reg.WriteDword(e.key, e.name, *e.value) : reg.DeleteValue(e.key, e.name);
+        if (!ok)
+        {
+            error = "cannot write " + e.key + "\\" + e.name;
+            return false;
+        }
+    }
+    backups.erase(it);
+    return true;
+}
+
+bool ApplyPath(std::string& error)
+{
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return false;
+
+    std::vector<DeviceInfo> devices = LiveDevices(*reg);
+    BackupSet backups;
+    std::string path = DefaultBackupPath();
+    if (!LoadBackups(path, backups, error)) return false;
+
+    bool ok = true;
+    for (const auto& d : devices)
+        if (d.onPath && d.present && !Apply(*reg, d, backups, error)) ok = false;
+
+    std::string saveError;
+    if (!SaveBackups(path, backups, saveError) && ok)
+    {
+        error = saveError;
+        return false;
+    }
+    return ok;
+}
+
+bool RestoreAll(std::string& error)
+{
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return false;
+
+    BackupSet backups;
+    std::string path = DefaultBackupPath();
+    if (!LoadBackups(path, backups, error)) return false;
+
+    std::vector<std::string> ids;
+    for (const auto& [id, b] : backups) ids.push_back(b.instanceId);
+    bool ok = true;
+    for (const auto& id : ids)
+        if (!Restore(*reg, id, backups, error)) ok = false;
+
+    std::string saveError;
+    if (!SaveBackups(path, backups, saveError) && ok)
+    {
+        error = saveError;
+        return false;
+    }
+    return ok;
+}
+
+std::string Describe(const registry_access::Registry& reg, const std::vector<DeviceInfo>& devices,
+                     const BackupSet& backups)
+{
+    std::ostringstream os;
+    char line[256];
+    snprintf(line, sizeof(line), "%-10s %-4s %-8s %-9s %s\n", "role", "path", "state", "idle off", "device");
+    os << line;
+    for (const auto& d : devices)
+    {
+        std::vector<Write> writes = Plan(reg, d);
+        std::size_t off = 0;
+        for (const auto& w : writes)
+            if (w.current && *w.current == w.value) ++off;
+
+        std::string state = d.present ? "present" : "absent";
+        if (backups.count(Upper(d.instanceId))) state += "*";
+        std::string idle = writes.empty() ? "-" : std::to_string(off) + "/" + std::to_string(writes.size());
+        snprintf(line, sizeof(line), "%-10s %-4s %-8s %-9s ", RoleName(d.role), d.onPath ? "yes" : "-",
+                 state.c_str(), idle.c_str());
+        os << line << (d.description.empty() ? "(no description)" : d.description) << "\n"
+           << std::string(35, ' ') << d.instanceId << "\n";
+    }
+    return os.str();
+}
+
+} // namespace device_power
@@ -0,0 +1,133 @@
+#pragma once
+#include "registry_access.h"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Per-device idle power management on the input and network path.  USB
+// devices, hubs and HID collections keep their selective-suspend and idle
+// settings in the hardware key,
+//
+//   Enum\<instance id>\Device Parameters
+//     EnhancedPowerManagementEnabled, AllowIdleIrpInD3, SelectiveSuspendEnabled,
+//     EnableSelectiveSuspend, SelectiveSuspendOn, D3ColdSupported
+//   Enum\<instance id>\Device Parameters\WDF
+//     IdleInWorkingState                       (KMDF drivers: S0 idle)
+//
+// and network adapters keep "Allow the computer to turn off this device" as
+// PnPCapabilities in their driver key.  Instead of the system-wide switches
+// (Services\USB\DisableSelectiveSuspend, PCIe ASPM in the power plan), only
+// keyboards, mice, game controllers and network adapters are kept awake,
+// together with every device between them and the CPU: USB interfaces,
+// composite parents, hubs, root hubs and host controllers.  Everything else
+// keeps its power saving.
+//
+// Devices name no parent in the registry.  Offline, children are linked to
+// the parent whose ParentIdPrefix starts their instance id (and HID
+// collections to the USB interface with the same VID / PID / MI); on a live
+// system the PnP tree is used instead.
+namespace device_power {
+
+// ─── Devices ─────────────────────────────────────────────────────────────────
+
+enum class Role {
+    Other,
+    Input,        // HIDClass, Keyboard, Mouse
+    Network,      // Net
+    Hub,          // USB hub or root hub
+    Controller,   // USB host controller
+};
+
+const char* RoleName(Role r);
+
+struct DeviceInfo {
+    std::string instanceId;       // USB\VID_046D&PID_C539\5&2A8B1F3&0&2
+    std::string description;
+    std::string className;        // Class: HIDClass, Net, USB, ...
+    std::string service;          // Service: usbhub3, HidUsb, ...
+    std::string driverKey;        // Driver: {4d36e972-...}\0001
+    std::string parentIdPrefix;   // ParentIdPrefix given to children without a serial
+    std::string parent;           // instance id, empty = unknown
+    bool        present = false;  // has the volatile Control subkey
+    Role        role    = Role::Other;
+    bool        onPath  = false;  // input / network device or one of their ancestors
+};
+
+bool ReadDevice(const registry_access::Registry& reg, const std::string& instanceId, DeviceInfo& out);
+
+// Every instance under Enum\USB, Enum\HID and Enum\PCI, with parents linked
+// from the registry and the input / network path marked.
+std::vector<DeviceInfo> ListDevices(const registry_access::Registry& reg);
+
+// Links children to parents by ParentIdPrefix and HID collections to their
+// USB interface; parents already set are kept.
+void LinkParents(std::vector<DeviceInfo>& devices);
+
+// Fills `parent` from the live PnP tree (Windows only).
+bool LinkLiveParents(std::vector<DeviceInfo>& devices, std::string& error);
+
+// Sets onPath for input and network devices and all of their ancestors.
+void MarkPath(std::vector<DeviceInfo>& devices);
+
+// ListDevices with parents from the live PnP tree (Windows) where it has them.
+std::vector<DeviceInfo> LiveDevices(const registry_access::Registry& reg);
+
+// ─── Settings and backup ─────────────────────────────────────────────────────
+
+// One value that keeps a device from idling.
+struct Write {
+    std::string             key;       // full key path
+    std::string             name;
+    uint32_t                value = 0;
+    std::optional<uint32_t> current;   // unset = value absent
+};
+
+// The values to write for `d`.  USB devices get the selective-suspend values
+// created; on HID and PCI devices only values the driver already uses are
+// changed (plus D3ColdSupported for PCI), and KMDF idle only where a WDF key
+// exists.
+std::vector<Write> Plan(const registry_access::Registry& reg, const DeviceInfo& d);
+
+// Every planned value already in effect.
+bool Matches(const std::vector<Write>& writes);
+
+// Original values of one device, recorded on the first change.
+struct DeviceBackup {
+    std::string instanceId;
+    struct Entry {
+        std::string             key;
+        std::string             name;
+        std::optional<uint32_t> value;   // unset = the value did not exist
+    };
+    std::vector<Entry> entries;
+};
+
+using BackupSet = std::map<std::string, DeviceBackup>;   // by upper-case instance id
+
+// DataDir()/power-backup.txt
+std::string DefaultBackupPath();
+
+bool LoadBackups(const std::string& path, BackupSet& out, std::string& error);   // missing file = empty set
+bool SaveBackups(const std::string& path, const BackupSet& set, std::string& error);
+
+// Writes the plan for one device, recording each value's original once.
+bool Apply(registry_access::Registry& reg, const DeviceInfo& d, BackupSet& backups, std::string& error);
+
+// Puts the recorded values back (deleting those that did not exist) and
+// drops the device from `backups`.  A device without a backup is left alone.
+bool Restore(registry_access::Registry& reg, const std::string& instanceId, BackupSet& backups, std::string& error);
+
+// Live registry, live PnP tree and DefaultBackupPath() in one call, for
+// tweaks and the GUI: applies to every present device on the path, or
+// restores every device in the backup.
+bool ApplyPath(std::string& error);
+bool RestoreAll(std::string& error);
+
+// Table of devices: role, path, state, description, instance id.
+std::string Describe(const registry_access::Registry& reg, const std::vector<DeviceInfo>& devices,
+                     const BackupSet& backups);
+
+} // namespace device_power
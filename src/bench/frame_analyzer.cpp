@@ -0,0 +1,239 @@
+#include "frame_analyzer.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+namespace frame_analyzer {
+
+// ─── CSV scanning ────────────────────────────────────────────────────────────
+
+// Split one CSV line into fields (views into the mapped buffer).  Handles
+// double-quoted fields; PresentMon only quotes unusual application names.
+static void SplitFields(const char* p, const char* end, std::vector<std::string_view>& fields)
+{
+    fields.clear();
+    while (p <= end)
+    {
+        const char* start = p;
+        if (p < end && *p == '"')
+        {
+            ++start;
+            const char* close = static_cast<const char*>(std::memchr(start, '"', end - start));
+            if (!close) close = end;
+            fields.emplace_back(start, static_cast<std::size_t>(close - start));
+            p = close + 1;
+            while (p < end && *p != ',') ++p;
+        }
+        else
+        {
+            while (p < end && *p != ',') ++p;
+            fields.emplace_back(start, static_cast<std::size_t>(p - start));
+        }
+        ++p;   // skip the comma (or step past end)
+    }
+}
+
+static bool ParseFloat(std::string_view field, float& out)
+{
+    while (!field.empty() && field.front() == ' ') field.remove_prefix(1);
+    auto res = std::from_chars(field.data(), field.data() + field.size(), out);
+    return res.ec == std::errc();
+}
+
+static bool EqualsNoCase(std::string_view a, std::string_view b)
+{
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        if (std::tolower(static_cast<unsigned char>(a[i])) !=
+            std::tolower(static_cast<unsigned char>(b[i])))
+            return false;
+    return true;
+}
+
+static int FindColumn(const std::vector<std::string_view>& header,
+                      std::initializer_list<const char*> names)
+{
+    for (const char* name : names)
+        for (std::size_t i = 0; i < header.size(); ++i)
+            if (header[i] == name) return static_cast<int>(i);
+    return -1;
+}
+
+// ─── Parsing ─────────────────────────────────────────────────────────────────
+
+bool ParseCsv(const char* data, std::size_t size, const std::string& appFilter,
+              Capture& out, std::string& error)
+{
+    const char* p   = data;
+    const char* end = data + size;
+
+    auto nextLine = [&](const char*& lineBegin, const char*& lineEnd) {
+        while (p < end)
+        {
+            lineBegin = p;
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            lineEnd = nl ? nl : end;
+            p = nl ? nl + 1 : end;
+            if (lineEnd > lineBegin && lineEnd[-1] == '\r') --lineEnd;
+            if (lineEnd > lineBegin) return true;   // skip blank lines
+        }
+        return false;
+    };
+
+    std::vector<std::string_view> fields;
+    const char* lb = nullptr;
+    const char* le = nullptr;
+    if (!nextLine(lb, le)) { error = "empty file"; return false; }
+    SplitFields(lb, le, fields);
+
+    const int colApp     = FindColumn(fields, { "Application" });
+    const int colFrame   = FindColumn(fields, { "MsBetweenPresents", "FrameTime" });
+    const int colDisplay = FindColumn(fields, { "MsUntilDisplayed", "DisplayLatency" });
+    const int colDropped = FindColumn(fields, { "Dropped" });
+    if (colFrame < 0)
+    {
+        error = "no MsBetweenPresents/FrameTime column (not a PresentMon CSV?)";
+        return false;
+    }
+    const int maxCol = std::max({ colApp, colFrame, colDisplay, colDropped });
+
+    std::unordered_map<std::string, Capture> perApp;
+    Capture* current = nullptr;
+    std::string_view currentName;
+
+    while (nextLine(lb, le))
+    {
+        SplitFields(lb, le, fields);
+        if (static_cast<int>(fields.size()) <= maxCol) continue;
+
+        std::string_view app = colApp >= 0 ? fields[colApp] : std::string_view("(all)");
+        if (!current || app != currentName)
+        {
+            current     = &perApp[std::string(app)];
+            currentName = app;
+            if (current->application.empty()) current->application = std::string(app);
+        }
+
+        float frameMs = 0.0f;
+        if (!ParseFloat(fields[colFrame], frameMs)) continue;
+        current->frameTimeMs.push_back(frameMs);
+
+        // Classic logs have an explicit Dropped flag; 2.x logs write "NA"
+        // latency for frames that never reached the screen.
+        bool dropped = colDropped >= 0 && fields[colDropped] == "1";
+        float displayMs = 0.0f;
+        if (colDisplay >= 0 && !dropped && ParseFloat(fields[colDisplay], displayMs))
+            current->displayLatencyMs.push_back(displayMs);
+        else if (colDisplay >= 0 || dropped)
+            ++current->droppedFrames;
+    }
+
+    if (perApp.empty()) { error = "no frame rows"; return false; }
+
+    Capture* chosen = nullptr;
+    for (auto& kv : perApp)
+    {
+        if (!appFilter.empty())
+        {
+            if (EqualsNoCase(kv.first, appFilter)) { chosen = &kv.second; break; }
+            continue;
+        }
+        if (!chosen || kv.second.frameTimeMs.size() > chosen->frameTimeMs.size())
+            chosen = &kv.second;
+    }
+    if (!chosen) { error = "application '" + appFilter + "' not found"; return false; }
+
+    out = std::move(*chosen);
+    return true;
+}
+
+bool LoadCsv(const std::string& path, const std::string& appFilter,
+             Capture& out, std::string& error)
+{
+    MappedFile file;
+    if (!file.Open(path)) { error = "cannot open " + path; return false; }
+    if (!ParseCsv(file.Data(), file.Size(), appFilter, out, error))
+        return false;
+    out.source = path;
+    return true;
+}
+
+// ─── Analysis ────────────────────────────────────────────────────────────────
+
+Stats Analyze(const Capture& capture, double stutterFactor)
+{
+    Stats s;
+    const auto& ft = capture.frameTimeMs;
+    s.frames  = ft.size();
+    s.dropped = capture.droppedFrames;
+    if (ft.empty()) return s;
+
+    double totalMs = 0.0;
+    for (float v : ft) totalMs += v;
+    s.durationS = totalMs / 1000.0;
+    s.avgFps    = totalMs > 0.0 ? 1000.0 * static_cast<double>(ft.size()) / totalMs : 0.0;
+
+    std::vector<float> sorted(ft);
+    std::sort(sorted.begin(), sorted.end());
+    s.p50Ms  = stats::PercentileSorted(sorted, 50.0);
+    s.p90Ms  = stats::PercentileSorted(sorted, 90.0);
+    s.p99Ms  = stats::PercentileSorted(sorted, 99.0);
+    s.p999Ms = stats::PercentileSorted(sorted, 99.9);
+    s.maxMs  = sorted.back();
+
+    double worst1  = stats::TailMean(ft, 0.01);
+    double worst01 = stats::TailMean(ft, 0.001);
+    s.low1Fps  = worst1  > 0.0 ? 1000.0 / worst1  : 0.0;
+    s.low01Fps = worst01 > 0.0 ? 1000.0 / worst01 : 0.0;
+
+    // Stutter: a frame much slower than the local pace (mean of the previous
+    // kWindow frames), so slow-but-steady scenes do not count.
+    constexpr std::size_t kWindow = 30;
+    double windowSum = 0.0;
+    for (std::size_t i = 0; i < ft.size(); ++i)
+    {
+        if (i >= kWindow)
+        {
+            double localMean = windowSum / kWindow;
+            if (ft[i] > stutterFactor * localMean) ++s.stutters;
+            windowSum -= ft[i - kWindow];
+        }
+        windowSum += ft[i];
+    }
+
+    if (!capture.displayLatencyMs.empty())
+    {
+        std::vector<float> disp(capture.displayLatencyMs);
+        std::sort(disp.begin(), disp.end());
+        s.hasDisplay   = true;
+        s.displayP50Ms = stats::PercentileSorted(disp, 50.0);
+        s.displayP99Ms = stats::PercentileSorted(disp, 99.0);
+    }
+    return s;
+}
+
+Comparison Compare(const Capture& baseline, const Capture& candidate,
+                   double alpha, double minEffect)
+{
+    Comparison c;
+    c.frameTime = stats::MannWhitney(baseline.frameTimeMs, candidate.frameTimeMs);
+    c.frameTimeShift = c.frameTime.pValue < alpha &&
+                       std::fabs(c.frameTime.effect) >= minEffect;
+
+    if (!baseline.displayLatencyMs.empty() && !candidate.displayLatencyMs.empty())
+    {
+        c.displayLatency = stats::MannWhitney(baseline.displayLatencyMs,
+                                              candidate.displayLatencyMs);
+        c.displayLatencyShift = c.displayLatency.pValue < alpha &&
+                                std::fabs(c.displayLatency.effect) >= minEffect;
+    }
+    return c;
+}
+
+} // namespace frame_analyzer
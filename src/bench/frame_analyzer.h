@@ -0,0 +1,69 @@
+#pragma once
+#include "stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame-pacing analyzer for PresentMon CSV captures.
+//
+// Parses the classic (MsBetweenPresents / MsUntilDisplayed / Dropped) and the
+// PresentMon 2.x (FrameTime / DisplayLatency / DisplayedTime) column sets.
+// The parse is columnar: only the needed columns are decoded, straight out of
+// a memory-mapped file, so hour-long multi-million-row captures load quickly.
+namespace frame_analyzer {
+
+// One application's frames from one capture.
+struct Capture {
+    std::string        source;             // file path or label
+    std::string        application;
+    std::vector<float> frameTimeMs;        // present-to-present interval
+    std::vector<float> displayLatencyMs;   // present-to-display, displayed frames only
+    uint64_t           droppedFrames = 0;
+};
+
+struct Stats {
+    uint64_t frames        = 0;
+    double   durationS     = 0.0;
+    double   avgFps        = 0.0;
+    double   p50Ms         = 0.0;
+    double   p90Ms         = 0.0;
+    double   p99Ms         = 0.0;
+    double   p999Ms        = 0.0;
+    double   maxMs         = 0.0;
+    double   low1Fps       = 0.0;   // average FPS over the slowest 1% of frames
+    double   low01Fps      = 0.0;   // average FPS over the slowest 0.1% of frames
+    uint64_t stutters      = 0;     // frames > factor x mean of the previous 30
+    uint64_t dropped       = 0;
+    bool     hasDisplay    = false;
+    double   displayP50Ms  = 0.0;
+    double   displayP99Ms  = 0.0;
+};
+
+// Candidate vs. baseline shift, with a significance verdict.
+struct Comparison {
+    stats::ShiftTest frameTime;
+    stats::ShiftTest displayLatency;
+    bool             frameTimeShift      = false;
+    bool             displayLatencyShift = false;
+};
+
+// Parse PresentMon CSV text.  `appFilter` selects the application
+// (case-insensitive); empty picks the application with the most frames.
+bool ParseCsv(const char* data, std::size_t size, const std::string& appFilter,
+              Capture& out, std::string& error);
+
+// Memory-map and parse a PresentMon CSV file.
+bool LoadCsv(const std::string& path, const std::string& appFilter,
+             Capture& out, std::string& error);
+
+Stats Analyze(const Capture& capture, double stutterFactor = 2.0);
+
+// Frame captures are autocorrelated, so with millions of frames a p-value
+// alone flags trivial shifts; a shift is reported only when it is both
+// significant at `alpha` and at least `minEffect` in rank-biserial terms.
+Comparison Compare(const Capture& baseline, const Capture& candidate,
+                   double alpha = 0.01, double minEffect = 0.1);
+
+} // namespace frame_analyzer
@@ -0,0 +1,1006 @@
+#include "game_runtime.h"
+#include "affinity_planner.h"
+#include "machine_profile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <evntrace.h>
+#include <evntcons.h>
+#include <tlhelp32.h>
+#include <winternl.h>
+#endif
+
+namespace game_runtime {
+
+static std::string Lower(std::string s)
+{
+    for (auto& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+static std::string FileName(const std::string& path)
+{
+    std::size_t slash = path.find_last_of("\\/");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+// ─── Rules ───────────────────────────────────────────────────────────────────
+
+const char* PriorityName(Priority p)
+{
+    switch (p) {
+    case Priority::Keep:        return "keep";
+    case Priority::Idle:        return "idle";
+    case Priority::BelowNormal: return "belownormal";
+    case Priority::Normal:      return "normal";
+    case Priority::AboveNormal: return "abovenormal";
+    case Priority::High:        return "high";
+    }
+    return "?";
+}
+
+const char* IoPriorityName(IoPriority p)
+{
+    switch (p) {
+    case IoPriority::Keep:    return "keep";
+    case IoPriority::VeryLow: return "verylow";
+    case IoPriority::Low:     return "low";
+    case IoPriority::Normal:  return "normal";
+    case IoPriority::High:    return "high";
+    }
+    return "?";
+}
+
+const char* MemoryPriorityName(MemoryPriority p)
+{
+    switch (p) {
+    case MemoryPriority::Keep:        return "keep";
+    case MemoryPriority::VeryLow:     return "verylow";
+    case MemoryPriority::Low:         return "low";
+    case MemoryPriority::Medium:      return "medium";
+    case MemoryPriority::BelowNormal: return "belownormal";
+    case MemoryPriority::Normal:      return "normal";
+    }
+    return "?";
+}
+
+const char* ThrottlingName(Throttling t)
+{
+    switch (t) {
+    case Throttling::Keep: return "keep";
+    case Throttling::Off:  return "off";
+    case Throttling::On:   return "on";
+    }
+    return "?";
+}
+
+template <typename E>
+static bool ParseName(const std::string& text, std::initializer_list<E> values, const char* (*name)(E), E& out)
+{
+    std::string t = Lower(text);
+    for (E v : values)
+        if (t == name(v))
+        {
+            out = v;
+            return true;
+        }
+    return false;
+}
+
+bool ParsePriority(const std::string& text, Priority& out)
+{
+    return ParseName(text, { Priority::Keep, Priority::Idle, Priority::BelowNormal, Priority::Normal,
+                             Priority::AboveNormal, Priority::High }, PriorityName, out);
+}
+
+bool ParseIoPriority(const std::string& text, IoPriority& out)
+{
+    return ParseName(text, { IoPriority::Keep, IoPriority::VeryLow, IoPriority::Low, IoPriority::Normal,
+                             IoPriority::High }, IoPriorityName, out);
+}
+
+bool ParseMemoryPriority(const std::string& text, MemoryPriority& out)
+{
+    return ParseName(text, { MemoryPriority::Keep, MemoryPriority::VeryLow, MemoryPriority::Low,
+                             MemoryPriority::Medium, MemoryPriority::BelowNormal, MemoryPriority::Normal },
+                     MemoryPriorityName, out);
+}
+
+bool ParseThrottling(const std::string& text, Throttling& out)
+{
+    return ParseName(text, { Throttling::Keep, Throttling::Off, Throttling::On }, ThrottlingName, out);
+}
+
+static std::string FormatCpus(const Rule& r)
+{
+    switch (r.cpuChoice) {
+    case CpuChoice::Keep:       return "keep";
+    case CpuChoice::Game:       return "game";
+    case CpuChoice::List:       return cpu_topology::FormatCpuList(r.cpus);
+    case CpuChoice::NonGame:    return "nongame";
+    case CpuChoice::Efficiency: return "ecores";
+    }
+    return "?";
+}
+
+Rule BackgroundDefaults()
+{
+    Rule r;
+    r.priority   = Priority::BelowNormal;
+    r.io         = IoPriority::Low;
+    r.memory     = MemoryPriority::Low;
+    r.throttling = Throttling::On;
+    r.cpuChoice  = CpuChoice::Efficiency;
+    return r;
+}
+
+bool ParseRule(const std::string& line, Rule& out, std::string& error, const Rule& defaults)
+{
+    std::istringstream ls(line);
+    Rule r = defaults;
+    if (!(ls >> r.exe))
+    {
+        error = "missing executable name";
+        return false;
+    }
+    r.exe = Lower(r.exe);
+
+    for (std::string token; ls >> token;)
+    {
+        std::size_t eq = token.find('=');
+        std::string key   = Lower(token.substr(0, eq));
+        std::string value = eq == std::string::npos ? "" : token.substr(eq + 1);
+        bool ok = false;
+        if (key == "priority")        ok = ParsePriority(value, r.priority);
+        else if (key == "io")         ok = ParseIoPriority(value, r.io);
+        else if (key == "memory")     ok = ParseMemoryPriority(value, r.memory);
+        else if (key == "throttling") ok = ParseThrottling(value, r.throttling);
+        else if (key == "cpus")
+        {
+            std::string v = Lower(value);
+            r.cpus.clear();
+            if (v == "keep")         { r.cpuChoice = CpuChoice::Keep;       ok = true; }
+            else if (v == "game")    { r.cpuChoice = CpuChoice::Game;       ok = true; }
+            else if (v == "nongame") { r.cpuChoice = CpuChoice::NonGame;    ok = true; }
+            else if (v == "ecores")  { r.cpuChoice = CpuChoice::Efficiency; ok = true; }
+            else
+            {
+                r.cpuChoice = CpuChoice::List;
+                ok = cpu_topology::ParseCpuList(value, r.cpus) && !r.cpus.empty();
+            }
+        }
+        else
+        {
+            error = "unknown key '" + key + "'";
+            return false;
+        }
+        if (!ok)
+        {
+            error = "bad value for " + key + ": '" + value + "'";
+            return false;
+        }
+    }
+    out = r;
+    return true;
+}
+
+std::string FormatRule(const Rule& r)
+{
+    return r.exe + " priority=" + PriorityName(r.priority) + " io=" + IoPriorityName(r.io) +
+           " memory=" + MemoryPriorityName(r.memory) + " cpus=" + FormatCpus(r) +
+           " throttling=" + ThrottlingName(r.throttling);
+}
+
+std::string DefaultPath()
+{
+    return machine_profile::DataDir() + "/games.txt";
+}
+
+std::string DefaultBackgroundPath()
+{
+    return machine_profile::DataDir() + "/background.txt";
+}
+
+bool LoadRules(const std::string& path, std::vector<Rule>& out, std::string& error, const Rule& defaults)
+{
+    out.clear();
+    std::ifstream f(path);
+    if (!f) return true;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(f, line))
+    {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        Rule r;
+        if (!ParseRule(line, r, error, defaults))
+        {
+            error = path + ":" + std::to_string(lineNo) + ": " + error;
+            return false;
+        }
+        PutRule(out, r);
+    }
+    return true;
+}
+
+bool SaveRules(const std::string& path, const std::vector<Rule>& rules, std::string& error)
+{
+    std::ofstream f(path, std::ios::trunc);
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    f << "# LatencyOptimizer process rules: exe priority= io= memory= cpus= throttling=\n";
+    for (const auto& r : rules) f << FormatRule(r) << "\n";
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+const Rule* FindRule(const std::vector<Rule>& rules, const std::string& imagePath)
+{
+    std::string name = Lower(FileName(imagePath));
+    for (const auto& r : rules)
+        if (r.exe == name) return &r;
+    return nullptr;
+}
+
+void PutRule(std::vector<Rule>& rules, const Rule& r)
+{
+    for (auto& existing : rules)
+        if (existing.exe == r.exe)
+        {
+            existing = r;
+            return;
+        }
+    rules.push_back(r);
+}
+
+bool RemoveRule(std::vector<Rule>& rules, const std::string& exe)
+{
+    std::string name = Lower(exe);
+    auto it = std::remove_if(rules.begin(), rules.end(), [&](const Rule& r) { return r.exe == name; });
+    bool found = it != rules.end();
+    rules.erase(it, rules.end());
+    return found;
+}
+
+std::vector<uint32_t> ResolveCpus(const Rule& r, const cpu_topology::Topology& t,
+                                  const std::vector<uint32_t>& gameCpus)
+{
+    std::vector<uint32_t> out;
+    switch (r.cpuChoice) {
+    case CpuChoice::Keep:
+        return out;
+    case CpuChoice::List:
+    case CpuChoice::Game:
+        for (uint32_t cpu : r.cpuChoice == CpuChoice::List ? r.cpus : gameCpus)
+            if (t.Find(cpu)) out.push_back(cpu);
+        break;
+    case CpuChoice::NonGame:
+    case CpuChoice::Efficiency: {
+        auto add = [&](bool efficiencyOnly) {
+            for (const auto& c : t.cpus)
+                if (std::find(gameCpus.begin(), gameCpus.end(), c.index) == gameCpus.end() &&
+                    (!efficiencyOnly || c.efficiencyClass < t.maxEfficiencyClass))
+                    out.push_back(c.index);
+        };
+        add(r.cpuChoice == CpuChoice::Efficiency);
+        if (out.empty()) add(false);   // no efficiency cores outside the game CPUs
+        break;
+    }
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+std::vector<uint32_t> ConfiguredGameCpus(const cpu_topology::Topology& t)
+{
+    machine_profile::Profile profile;
+    std::string error;
+    if (!machine_profile::Load(machine_profile::DefaultPath(), profile, error))
+        profile = machine_profile::Current();
+    return affinity_planner::GameCpus(t, profile);
+}
+
+std::string Describe(const std::vector<Rule>& rules, const cpu_topology::Topology& t,
+                     const std::vector<uint32_t>& gameCpus)
+{
+    std::ostringstream os;
+    char line[256];
+    snprintf(line, sizeof(line), "%-12s %-8s %-12s %-10s %-18s %s\n", "priority", "io", "memory", "throttling",
+             "cpus", "executable");
+    os << line;
+    for (const auto& r : rules)
+    {
+        std::string cpus = FormatCpus(r);
+        if (r.cpuChoice != CpuChoice::Keep)
+        {
+            std::vector<uint32_t> resolved = ResolveCpus(r, t, gameCpus);
+            if (r.cpuChoice != CpuChoice::List) cpus += " " + cpu_topology::FormatCpuList(resolved);
+            if (resolved.empty()) cpus += " (none)";
+        }
+        snprintf(line, sizeof(line), "%-12s %-8s %-12s %-10s %-18s %s\n", PriorityName(r.priority),
+                 IoPriorityName(r.io), MemoryPriorityName(r.memory), ThrottlingName(r.throttling), cpus.c_str(),
+                 r.exe.c_str());
+        os << line;
+    }
+    return os.str();
+}
+
+// ─── Process settings (Windows) ──────────────────────────────────────────────
+
+#ifdef _WIN32
+
+// Microsoft-Windows-Kernel-Process; ProcessStart (1) and ProcessStop (2)
+// both begin with the ProcessID as UInt32.
+static const GUID kKernelProcessProvider = {
+    0x22fb2cd6, 0x0e7b, 0x422b, { 0xa0, 0xc7, 0x2f, 0xad, 0x1f, 0xd0, 0xe7, 0x16 } };
+static const ULONGLONG kProcessKeyword = 0x10;   // WINEVENT_KEYWORD_PROCESS
+static const wchar_t*  kSessionName    = L"LatencyOptimizer-GameRuntime";
+
+static const ULONG kProcessIoPriority = 33;      // PROCESSINFOCLASS
+static const DWORD kChangeAccess = PROCESS_QUERY_INFORMATION | PROCESS_SET_INFORMATION |
+                                  PROCESS_SET_LIMITED_INFORMATION;   // CPU Sets need the latter
+using NtProcessInfoFn = LONG(NTAPI*)(HANDLE, ULONG, PVOID, ULONG, PULONG);
+using NtSetProcessInfoFn = LONG(NTAPI*)(HANDLE, ULONG, PVOID, ULONG);
+
+static std::string Narrow(const wchar_t* text, int length = -1)
+{
+    int n = WideCharToMultiByte(CP_UTF8, 0, text, length, nullptr, 0, nullptr, nullptr);
+    if (n <= 0) return {};
+    std::string out(static_cast<std::size_t>(n), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, text, length, &out[0], n, nullptr, nullptr);
+    if (length < 0) out.pop_back();   // the terminator
+    return out;
+}
+
+static std::string ErrorText(const char* what, DWORD code)
+{
+    return std::string(what) + " (error " + std::to_string(code) + ")";
+}
+
+static bool EnablePrivilege(const wchar_t* name)
+{
+    HANDLE token = nullptr;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) return false;
+    TOKEN_PRIVILEGES tp{};
+    tp.PrivilegeCount           = 1;
+    tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    bool ok = LookupPrivilegeValueW(nullptr, name, &tp.Privileges[0].Luid) &&
+              AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr) && GetLastError() == ERROR_SUCCESS;
+    CloseHandle(token);
+    return ok;
+}
+
+static uint64_t CreateTime(HANDLE process)
+{
+    FILETIME created{}, exited{}, kernel{}, user{};
+    if (!GetProcessTimes(process, &created, &exited, &kernel, &user)) return 0;
+    return (static_cast<uint64_t>(created.dwHighDateTime) << 32) | created.dwLowDateTime;
+}
+
+static bool GetIoPriority(HANDLE process, ULONG& out)
+{
+    static auto query = reinterpret_cast<NtProcessInfoFn>(
+        GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQueryInformationProcess"));
+    return query && query(process, kProcessIoPriority, &out, sizeof(out), nullptr) >= 0;
+}
+
+static bool SetIoPriority(HANDLE process, ULONG value)
+{
+    static auto set = reinterpret_cast<NtSetProcessInfoFn>(
+        GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtSetInformationProcess"));
+    return set && set(process, kProcessIoPriority, &value, sizeof(value)) >= 0;
+}
+
+static DWORD PriorityClass(Priority p)
+{
+    switch (p) {
+    case Priority::Idle:        return IDLE_PRIORITY_CLASS;
+    case Priority::BelowNormal: return BELOW_NORMAL_PRIORITY_CLASS;
+    case Priority::Normal:      return NORMAL_PRIORITY_CLASS;
+    case Priority::AboveNormal: return ABOVE_NORMAL_PRIORITY_CLASS;
+    case Priority::High:        return HIGH_PRIORITY_CLASS;
+    case Priority::Keep:        break;
+    }
+    return 0;
+}
+
+// CPU Set ids of flat CPU numbers, matched on (group, number).
+static std::vector<ULONG> CpuSetIds(const std::vector<uint32_t>& cpus)
+{
+    ULONG length = 0;
+    GetSystemCpuSetInformation(nullptr, 0, &length, GetCurrentProcess(), 0);
+    std::vector<uint8_t> buffer(length);
+    if (!length || !GetSystemCpuSetInformation(reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data()),
+                                               length, &length, GetCurrentProcess(), 0))
+        return {};
+
+    const cpu_topology::Topology& t = cpu_topology::Current();
+    std::vector<ULONG> ids;
+    for (ULONG offset = 0; offset + sizeof(DWORD) * 2 <= length;)
+    {
+        const auto* e = reinterpret_cast<const SYSTEM_CPU_SET_INFORMATION*>(buffer.data() + offset);
+        if (!e->Size) break;
+        if (e->Type == CpuSetInformation)
+            for (uint32_t cpu : cpus)
+            {
+                const cpu_topology::Cpu* c = t.Find(cpu);
+                if (c && c->group == e->CpuSet.Group && c->number == e->CpuSet.LogicalProcessorIndex)
+                    ids.push_back(e->CpuSet.Id);
+            }
+        offset += e->Size;
+    }
+    return ids;
+}
+
+static bool GetCpuSets(HANDLE process, std::vector<uint32_t>& out)
+{
+    ULONG required = 0;
+    out.clear();
+    if (GetProcessDefaultCpuSets(process, nullptr, 0, &required)) return true;   // none assigned
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) return false;
+    std::vector<ULONG> ids(required);
+    if (!GetProcessDefaultCpuSets(process, ids.data(), required, &required)) return false;
+    out.assign(ids.begin(), ids.begin() + required);
+    return true;
+}
+
+static void ApplyRule(HANDLE h, const Rule& r, const std::vector<uint32_t>& cpus, Process& p,
+                      std::vector<std::string>& done, std::vector<std::string>& failed)
+{
+    if (DWORD cls = PriorityClass(r.priority))
+    {
+        DWORD previous = GetPriorityClass(h);
+        if (previous && SetPriorityClass(h, cls))
+        {
+            p.priorityClass = previous;
+            done.push_back(std::string("priority ") + PriorityName(r.priority));
+        }
+        else failed.push_back(ErrorText("priority class", GetLastError()));
+    }
+
+    if (!cpus.empty())
+    {
+        std::vector<ULONG> ids = CpuSetIds(cpus);
+        std::vector<uint32_t> previous;
+        if (ids.empty())
+            failed.push_back("no CPU Set matches CPUs " + cpu_topology::FormatCpuList(cpus));
+        else if (GetCpuSets(h, previous) && SetProcessDefaultCpuSets(h, ids.data(), static_cast<ULONG>(ids.size())))
+        {
+            p.cpuSetsChanged = true;
+            p.cpuSetIds      = previous;
+            done.push_back("CPUs " + cpu_topology::FormatCpuList(cpus));
+        }
+        else failed.push_back(ErrorText("CPU Sets", GetLastError()));
+    }
+
+    if (r.io != IoPriority::Keep)
+    {
+        ULONG previous = 0;
+        if (GetIoPriority(h, previous) && SetIoPriority(h, static_cast<ULONG>(r.io) - 1))
+        {
+            p.ioPriority = previous;
+            done.push_back(std::string("io ") + IoPriorityName(r.io));
+        }
+        else failed.push_back("I/O priority " + std::string(IoPriorityName(r.io)) + " refused");
+    }
+
+    if (r.memory != MemoryPriority::Keep)
+    {
+        MEMORY_PRIORITY_INFORMATION previous{}, wanted{};
+        wanted.MemoryPriority = static_cast<ULONG>(r.memory);
+        if (GetProcessInformation(h, ProcessMemoryPriority, &previous, sizeof(previous)) &&
+            SetProcessInformation(h, ProcessMemoryPriority, &wanted, sizeof(wanted)))
+        {
+            p.memoryPriority = previous.MemoryPriority;
+            done.push_back(std::string("memory ") + MemoryPriorityName(r.memory));
+        }
+        else failed.push_back(ErrorText("memory priority", GetLastError()));
+    }
+
+    if (r.throttling != Throttling::Keep)
+    {
+        // Off: execution speed (and, on Windows 11, timer resolution) always
+        // run unthrottled.  On: EcoQoS.  Reading the state back needs
+        // Windows 11; elsewhere the original is the system default.
+        PROCESS_POWER_THROTTLING_STATE previous{}, wanted{};
+        previous.Version = wanted.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+        if (!GetProcessInformation(h, ProcessPowerThrottling, &previous, sizeof(previous)))
+            previous.ControlMask = previous.StateMask = 0;
+        wanted.ControlMask = PROCESS_POWER_THROTTLING_EXECUTION_SPEED;
+#ifdef PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION
+        if (r.throttling == Throttling::Off) wanted.ControlMask |= PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION;
+#endif
+        wanted.StateMask = r.throttling == Throttling::On ? PROCESS_POWER_THROTTLING_EXECUTION_SPEED : 0;
+        if (SetProcessInformation(h, ProcessPowerThrottling, &wanted, sizeof(wanted)))
+        {
+            p.throttlingChanged = true;
+            p.throttlingControl = previous.ControlMask;
+            p.throttlingState   = previous.StateMask;
+            done.push_back(std::string("throttling ") + ThrottlingName(r.throttling));
+        }
+        else failed.push_back(ErrorText("power throttling", GetLastError()));
+    }
+}
+
+static bool RestoreProcess(HANDLE h, const Process& p, std::string& failed)
+{
+    auto fail = [&](const std::string& what) {
+        if (!failed.empty()) failed += ", ";
+        failed += what;
+    };
+    if (p.priorityClass && !SetPriorityClass(h, *p.priorityClass)) fail(ErrorText("priority class", GetLastError()));
+    if (p.cpuSetsChanged)
+    {
+        std::vector<ULONG> ids(p.cpuSetIds.begin(), p.cpuSetIds.end());
+        if (!SetProcessDefaultCpuSets(h, ids.empty() ? nullptr : ids.data(), static_cast<ULONG>(ids.size())))
+            fail(ErrorText("CPU Sets", GetLastError()));
+    }
+    if (p.ioPriority && !SetIoPriority(h, *p.ioPriority)) fail("I/O priority refused");
+    if (p.memoryPriority)
+    {
+        MEMORY_PRIORITY_INFORMATION info{};
+        info.MemoryPriority = *p.memoryPriority;
+        if (!SetProcessInformation(h, ProcessMemoryPriority, &info, sizeof(info)))
+            fail(ErrorText("memory priority", GetLastError()));
+    }
+    if (p.throttlingChanged)
+    {
+        PROCESS_POWER_THROTTLING_STATE state{};
+        state.Version     = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+        state.ControlMask = p.throttlingControl;
+        state.StateMask   = p.throttlingState;
+        if (!SetProcessInformation(h, ProcessPowerThrottling, &state, sizeof(state)))
+            fail(ErrorText("power throttling", GetLastError()));
+    }
+    return failed.empty();
+}
+
+// CPU time and context switches of every process from one
+// NtQuerySystemInformation(SystemProcessInformation) pass.  winternl.h
+// leaves the fields reserved: the process's UserTime and KernelTime sit at
+// bytes 32 and 40 of Reserved1, a thread's ContextSwitches is Reserved3.
+struct Usage {
+    std::string exe;
+    uint64_t    cpuTime         = 0;   // 100 ns units
+    uint64_t    contextSwitches = 0;   // threads alive now
+};
+
+static std::map<uint32_t, Usage> SnapshotUsage()
+{
+    using QueryFn = LONG(NTAPI*)(ULONG, PVOID, ULONG, PULONG);
+    static auto query = reinterpret_cast<QueryFn>(
+        GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation"));
+    const LONG kInfoLengthMismatch = static_cast<LONG>(0xC0000004);
+
+    std::map<uint32_t, Usage> out;
+    if (!query) return out;
+    std::vector<uint64_t> buffer(1 << 17);   // 1 MiB, 8-byte aligned
+    ULONG needed = 0;
+    LONG status;
+    while ((status = query(SystemProcessInformation, buffer.data(), static_cast<ULONG>(buffer.size() * 8),
+                           &needed)) == kInfoLengthMismatch)
+        buffer.resize((needed + 65536) / 8);
+    if (status < 0) return out;
+
+    const auto* base = reinterpret_cast<const uint8_t*>(buffer.data());
+    for (ULONG offset = 0;;)
+    {
+        const auto* p = reinterpret_cast<const SYSTEM_PROCESS_INFORMATION*>(base + offset);
+        Usage u;
+        if (p->ImageName.Buffer) u.exe = Lower(Narrow(p->ImageName.Buffer, p->ImageName.Length / 2));
+        int64_t user = 0, kernel = 0;
+        std::memcpy(&user, p->Reserved1 + 32, sizeof(user));
+        std::memcpy(&kernel, p->Reserved1 + 40, sizeof(kernel));
+        u.cpuTime = static_cast<uint64_t>(user + kernel);
+        const auto* threads = reinterpret_cast<const SYSTEM_THREAD_INFORMATION*>(p + 1);
+        for (ULONG i = 0; i < p->NumberOfThreads; ++i) u.contextSwitches += threads[i].Reserved3;
+        out[static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p->UniqueProcessId))] = u;
+
+        if (!p->NextEntryOffset) break;
+        offset += p->NextEntryOffset;
+    }
+    return out;
+}
+
+// ─── Trace session (Windows) ─────────────────────────────────────────────────
+
+struct Manager::Trace {
+    static std::vector<uint8_t> Properties()
+    {
+        std::vector<uint8_t> buffer(sizeof(EVENT_TRACE_PROPERTIES) + 256 * sizeof(wchar_t));
+        auto* p = reinterpret_cast<EVENT_TRACE_PROPERTIES*>(buffer.data());
+        p->Wnode.BufferSize    = static_cast<ULONG>(buffer.size());
+        p->Wnode.Flags         = WNODE_FLAG_TRACED_GUID;
+        p->Wnode.ClientContext = 1;   // QPC time stamps
+        p->LogFileMode         = EVENT_TRACE_REAL_TIME_MODE;
+        p->FlushTimer          = 1;   // seconds; bounds the delivery delay of a launch
+        p->LoggerNameOffset    = sizeof(EVENT_TRACE_PROPERTIES);
+        return buffer;
+    }
+
+    static EVENT_TRACE_PROPERTIES* Props(std::vector<uint8_t>& buffer)
+    {
+        return reinterpret_cast<EVENT_TRACE_PROPERTIES*>(buffer.data());
+    }
+
+    static void StopSession(TRACEHANDLE session)
+    {
+        std::vector<uint8_t> props = Properties();
+        ControlTraceW(session, session ? nullptr : kSessionName, Props(props), EVENT_TRACE_CONTROL_STOP);
+    }
+
+    static bool Open(Manager& m, std::string& error)
+    {
+        std::vector<uint8_t> props = Properties();
+        TRACEHANDLE session = 0;
+        ULONG status = StartTraceW(&session, kSessionName, Props(props));
+        if (status == ERROR_ALREADY_EXISTS)   // left behind by a run that did not stop
+        {
+            StopSession(0);
+            props  = Properties();
+            status = StartTraceW(&session, kSessionName, Props(props));
+        }
+        if (status != ERROR_SUCCESS)
+        {
+            error = ErrorText("StartTrace failed", status);
+            if (status == ERROR_ACCESS_DENIED) error += "; run as administrator";
+            return false;
+        }
+
+        status = EnableTraceEx2(session, &kKernelProcessProvider, EVENT_CONTROL_CODE_ENABLE_PROVIDER,
+                                TRACE_LEVEL_INFORMATION, kProcessKeyword, 0, 0, nullptr);
+        if (status != ERROR_SUCCESS)
+        {
+            StopSession(session);
+            error = ErrorText("EnableTraceEx2 failed", status);
+            return false;
+        }
+
+        EVENT_TRACE_LOGFILEW log{};
+        log.LoggerName          = const_cast<LPWSTR>(kSessionName);
+        log.ProcessTraceMode    = PROCESS_TRACE_MODE_REAL_TIME | PROCESS_TRACE_MODE_EVENT_RECORD;
+        log.EventRecordCallback = OnRecord;
+        log.Context             = &m;
+        TRACEHANDLE trace = OpenTraceW(&log);
+        if (trace == INVALID_PROCESSTRACE_HANDLE)
+        {
+            DWORD code = GetLastError();
+            StopSession(session);
+            error = ErrorText("OpenTrace failed", code);
+            return false;
+        }
+        m.m_session = session;
+        m.m_trace   = trace;
+        return true;
+    }
+
+    static void Close(Manager& m)
+    {
+        CloseTrace(m.m_trace);
+        StopSession(m.m_session);
+        m.m_trace = m.m_session = 0;
+    }
+
+    static void WINAPI OnRecord(PEVENT_RECORD r)
+    {
+        if (!IsEqualGUID(r->EventHeader.ProviderId, kKernelProcessProvider) || r->UserDataLength < sizeof(uint32_t))
+            return;
+        auto* m = static_cast<Manager*>(r->UserContext);
+        uint32_t pid = 0;
+        std::memcpy(&pid, r->UserData, sizeof(pid));
+        switch (r->EventHeader.EventDescriptor.Id) {
+        case 1: m->OnStart(pid); break;
+        case 2: m->OnExit(pid);  break;
+        }
+    }
+};
+
+#endif
+
+// ─── Manager ─────────────────────────────────────────────────────────────────
+
+const char* EventName(Event::Kind k)
+{
+    switch (k) {
+    case Event::Kind::Started:   return "started";
+    case Event::Kind::Applied:   return "applied";
+    case Event::Kind::Exited:    return "exited";
+    case Event::Kind::Restored:  return "restored";
+    case Event::Kind::Throttled: return "throttled";
+    case Event::Kind::Released:  return "released";
+    case Event::Kind::Error:     return "error";
+    }
+    return "?";
+}
+
+void AddUsage(Savings& s, uint64_t cpuStart, uint64_t cpuEnd, uint64_t switchesStart, uint64_t switchesEnd)
+{
+    ++s.processes;
+    if (cpuEnd > cpuStart) s.cpuTime += cpuEnd - cpuStart;
+    if (switchesEnd > switchesStart) s.contextSwitches += switchesEnd - switchesStart;
+}
+
+static std::string UsageText(uint64_t cpuTime, uint64_t contextSwitches)
+{
+    char text[96];
+    snprintf(text, sizeof(text), "%.2f s CPU, %llu context switches", cpuTime / 1e7,
+             static_cast<unsigned long long>(contextSwitches));
+    return text;
+}
+
+std::string Describe(const Savings& s)
+{
+    return std::to_string(s.processes) + " process(es), " + UsageText(s.cpuTime, s.contextSwitches);
+}
+
+Manager::Manager(std::vector<Rule> rules, std::vector<uint32_t> gameCpus, Callback callback)
+    : m_rules(std::move(rules)), m_gameCpus(std::move(gameCpus)), m_callback(std::move(callback))
+{
+}
+
+Manager::~Manager()
+{
+    Stop();
+}
+
+bool Manager::Start(std::string& error)
+{
+#ifdef _WIN32
+    if (m_running) return true;
+    EnablePrivilege(L"SeIncreaseBasePriorityPrivilege");   // I/O priority high
+    if (!Trace::Open(*this, error)) return false;
+    m_running = true;
+    m_thread  = std::thread([this] {
+        TRACEHANDLE trace = m_trace;
+        ProcessTrace(&trace, 1, nullptr, nullptr);
+    });
+
+    // Games launched before the session are found once; duplicates from the
+    // trace are ignored by OnStart.
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshot != INVALID_HANDLE_VALUE)
+    {
+        PROCESSENTRY32W entry{};
+        entry.dwSize = sizeof(entry);
+        for (BOOL more = Process32FirstW(snapshot, &entry); more; more = Process32NextW(snapshot, &entry))
+            if (FindRule(m_rules, Narrow(entry.szExeFile))) OnStart(entry.th32ProcessID);
+        CloseHandle(snapshot);
+    }
+    return true;
+#else
+    error = "the game runtime manager needs Windows";
+    return false;
+#endif
+}
+
+void Manager::Stop()
+{
+    if (!m_running.exchange(false)) return;
+#ifdef _WIN32
+    Trace::Close(*this);
+    if (m_thread.joinable()) m_thread.join();
+
+    std::vector<Event> events;
+    std::map<uint32_t, Process> processes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ReleaseBackground(events);
+        processes.swap(m_processes);
+    }
+    for (const auto& [pid, p] : processes)
+    {
+        HANDLE h = OpenProcess(kChangeAccess, FALSE, pid);
+        if (!h) continue;   // gone without a stop event
+        if (CreateTime(h) == p.createTime)
+        {
+            std::string failed;
+            if (RestoreProcess(h, p, failed))
+                events.push_back({ Event::Kind::Restored, pid, p.exe, "original settings" });
+            else
+                events.push_back({ Event::Kind::Error, pid, p.exe, "restore: " + failed });
+        }
+        CloseHandle(h);
+    }
+    for (const auto& e : events) Emit(e.kind, e.pid, e.exe, e.detail);
+#endif
+}
+
+std::vector<Process> Manager::Processes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Process> out;
+    for (const auto& [pid, p] : m_processes) out.push_back(p);
+    return out;
+}
+
+Savings Manager::BackgroundSavings() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_savings;
+}
+
+bool Manager::GameRunning() const
+{
+    for (const auto& [pid, p] : m_processes)
+        if (!p.background) return true;
+    return false;
+}
+
+void Manager::OnStart(uint32_t pid)
+{
+#ifdef _WIN32
+    // Every launch on the machine lands here; only the name is read until a
+    // rule matches.
+    HANDLE query = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!query) return;
+    wchar_t path[1024];
+    DWORD length = static_cast<DWORD>(sizeof(path) / sizeof(path[0]));
+    bool named = QueryFullProcessImageNameW(query, 0, path, &length) != 0;
+    CloseHandle(query);
+    if (!named) return;
+    std::string image = Narrow(path);
+    const Rule* game       = FindRule(m_rules, image);
+    const Rule* background = game ? nullptr : FindRule(m_background, image);
+    if (!game && !background) return;
+
+    std::vector<Event> events;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_processes.count(pid)) return;
+        if (game)
+        {
+            bool first = !GameRunning();
+            events.push_back({ Event::Kind::Started, pid, game->exe, image });
+            Track(pid, *game, false, events);
+            if (first && GameRunning()) ThrottleBackground(events);
+        }
+        else if (GameRunning())
+            Track(pid, *background, true, events);
+    }
+    for (const auto& e : events) Emit(e.kind, e.pid, e.exe, e.detail);
+#else
+    (void)pid;
+#endif
+}
+
+void Manager::OnExit(uint32_t pid)
+{
+    // Everything applied is per process and ends with it; only the record of
+    // the originals is dropped.  The last game to exit releases the
+    // background processes.
+    std::vector<Event> events;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_processes.find(pid);
+        if (it == m_processes.end()) return;
+        bool background = it->second.background;
+        events.push_back({ Event::Kind::Exited, pid, it->second.exe, "settings released with the process" });
+        m_processes.erase(it);
+        if (!background && !GameRunning()) ReleaseBackground(events);
+    }
+    for (const auto& e : events) Emit(e.kind, e.pid, e.exe, e.detail);
+}
+
+void Manager::Emit(Event::Kind kind, uint32_t pid, const std::string& exe, const std::string& detail)
+{
+    if (m_callback) m_callback({ kind, pid, exe, detail });
+}
+
+#ifdef _WIN32
+
+void Manager::Track(uint32_t pid, const Rule& rule, bool background, std::vector<Event>& events)
+{
+    HANDLE h = OpenProcess(kChangeAccess, FALSE, pid);
+    if (!h)
+    {
+        events.push_back({ Event::Kind::Error, pid, rule.exe,
+                           ErrorText(background ? "cannot open the process"
+                                                : "cannot open the process (protected by anti-cheat?)",
+                                     GetLastError()) });
+        return;
+    }
+
+    Process p;
+    p.pid        = pid;
+    p.exe        = rule.exe;
+    p.createTime = CreateTime(h);
+    p.background = background;
+    std::vector<std::string> done, failed;
+    ApplyRule(h, rule, ResolveCpus(rule, cpu_topology::Current(), m_gameCpus), p, done, failed);
+    CloseHandle(h);
+
+    for (const auto& d : done) p.applied += (p.applied.empty() ? "" : ", ") + d;
+    if (!done.empty())
+        events.push_back({ background ? Event::Kind::Throttled : Event::Kind::Applied, pid, p.exe, p.applied });
+    for (const auto& f : failed) events.push_back({ Event::Kind::Error, pid, p.exe, f });
+    m_processes[pid] = p;
+}
+
+void Manager::ThrottleBackground(std::vector<Event>& events)
+{
+    if (m_background.empty()) return;
+    ++m_savings.sessions;
+    for (const auto& [pid, u] : SnapshotUsage())
+    {
+        const Rule* rule = FindRule(m_background, u.exe);
+        if (!rule || m_processes.count(pid)) continue;
+        Track(pid, *rule, true, events);
+
+        // Baseline for the savings; processes launched later start from zero.
+        auto it = m_processes.find(pid);
+        if (it == m_processes.end()) continue;
+        it->second.cpuTimeAtStart  = u.cpuTime;
+        it->second.switchesAtStart = u.contextSwitches;
+    }
+}
+
+void Manager::ReleaseBackground(std::vector<Event>& events)
+{
+    bool any = false;
+    for (const auto& [pid, p] : m_processes) any = any || p.background;
+    if (!any) return;
+    std::map<uint32_t, Usage> usage = SnapshotUsage();
+
+    for (auto it = m_processes.begin(); it != m_processes.end();)
+    {
+        const Process& p = it->second;
+        if (!p.background)
+        {
+            ++it;
+            continue;
+        }
+        HANDLE h = OpenProcess(kChangeAccess, FALSE, p.pid);
+        if (h && CreateTime(h) == p.createTime)
+        {
+            std::string failed;
+            if (!RestoreProcess(h, p, failed))
+                events.push_back({ Event::Kind::Error, p.pid, p.exe, "restore: " + failed });
+
+            // Only CPU Sets keep the work off the game cores; the rest of
+            // the rule just makes it yield.
+            Savings one;
+            auto u = usage.find(p.pid);
+            if (u != usage.end())
+                AddUsage(one, p.cpuTimeAtStart, u->second.cpuTime, p.switchesAtStart, u->second.contextSwitches);
+            if (p.cpuSetsChanged)
+            {
+                AddUsage(m_savings, 0, one.cpuTime, 0, one.contextSwitches);
+                events.push_back({ Event::Kind::Released, p.pid, p.exe,
+                                   UsageText(one.cpuTime, one.contextSwitches) + " kept off the game cores" });
+            }
+            else events.push_back({ Event::Kind::Released, p.pid, p.exe, "original settings" });
+        }
+        if (h) CloseHandle(h);
+        it = m_processes.erase(it);
+    }
+}
+
+#else
+
+void Manager::Track(uint32_t, const Rule&, bool, std::vector<Event>&) {}
+void Manager::ThrottleBackground(std::vector<Event>&) {}
+void Manager::ReleaseBackground(std::vector<Event>&) {}
+
+#endif
+
+} // namespace game_runtime
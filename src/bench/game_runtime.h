@@ -0,0 +1,223 @@
+#pragma once
+#include "cpu_topology.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Runtime settings for configured game executables.  The Scheduler tweaks
+// only change the global MMCSS values; this acts on the game process itself
+// the moment it starts:
+//
+//   priority class          SetPriorityClass
+//   CPU Sets                SetProcessDefaultCpuSets (soft: the scheduler
+//                           keeps the threads there without hard affinity)
+//   I/O priority            NtSetInformationProcess(ProcessIoPriority)
+//   memory priority         SetProcessInformation(ProcessMemoryPriority)
+//   power throttling        SetProcessInformation(ProcessPowerThrottling),
+//                           opted out so EcoQoS never parks the game on
+//                           efficiency cores or lowers its clocks
+//
+// Launches and exits arrive as Microsoft-Windows-Kernel-Process events on a
+// real-time ETW session, so nothing polls.  The original settings are kept
+// per process: they are put back when the manager stops while the game
+// still runs, and dropped when the game exits.
+//
+// While at least one game runs, the background rules throttle updaters,
+// launchers, browsers and sync clients the other way: lower priority,
+// EcoQoS, and CPU Sets on the efficiency cores or whatever the game does
+// not use.  They are restored when the last game exits, with the CPU time
+// and context switches they spent away from the game cores.
+//
+// Rules are plain text, one executable per line, in DataDir()/games.txt
+// and DataDir()/background.txt:
+//
+//     # competitive shooters
+//     cs2.exe        priority=high io=high cpus=game throttling=off
+//     FortniteClient-Win64-Shipping.exe priority=abovenormal cpus=2-7
+//
+//     # background.txt
+//     steamwebhelper.exe priority=belownormal cpus=ecores throttling=on
+//     onedrive.exe       priority=idle io=verylow cpus=nongame
+namespace game_runtime {
+
+// ─── Rules ───────────────────────────────────────────────────────────────────
+
+enum class Priority { Keep, Idle, BelowNormal, Normal, AboveNormal, High };
+enum class IoPriority { Keep, VeryLow, Low, Normal, High };
+enum class MemoryPriority { Keep, VeryLow, Low, Medium, BelowNormal, Normal };   // 1..5 on Windows
+enum class Throttling { Keep, Off, On };   // Off = always full speed, On = EcoQoS
+
+// Game = the machine profile's game CPUs, NonGame = every other CPU,
+// Efficiency = non-game efficiency cores (NonGame on parts without them).
+enum class CpuChoice { Keep, Game, List, NonGame, Efficiency };
+
+const char* PriorityName(Priority p);
+const char* IoPriorityName(IoPriority p);
+const char* MemoryPriorityName(MemoryPriority p);
+const char* ThrottlingName(Throttling t);
+
+bool ParsePriority(const std::string& text, Priority& out);         // keep|idle|belownormal|normal|abovenormal|high
+bool ParseIoPriority(const std::string& text, IoPriority& out);     // keep|verylow|low|normal|high
+bool ParseMemoryPriority(const std::string& text, MemoryPriority& out);   // keep|verylow|low|medium|belownormal|normal
+bool ParseThrottling(const std::string& text, Throttling& out);     // keep|off|on
+
+struct Rule {
+    std::string           exe;                              // image file name, lower-case
+    Priority              priority   = Priority::High;
+    IoPriority            io         = IoPriority::High;
+    MemoryPriority        memory     = MemoryPriority::Normal;
+    Throttling            throttling = Throttling::Off;
+    CpuChoice             cpuChoice  = CpuChoice::Game;
+    std::vector<uint32_t> cpus;                             // CpuChoice::List
+};
+
+// Defaults for background rules: belownormal, io low, memory low, EcoQoS,
+// cpus=ecores.
+Rule BackgroundDefaults();
+
+// "cs2.exe priority=high io=high memory=normal cpus=game throttling=off";
+// omitted keys keep the values of `defaults`.  cpus takes keep, game,
+// nongame, ecores or a CPU list.
+bool        ParseRule(const std::string& line, Rule& out, std::string& error, const Rule& defaults = Rule());
+std::string FormatRule(const Rule& r);
+
+// DataDir()/games.txt and DataDir()/background.txt
+std::string DefaultPath();
+std::string DefaultBackgroundPath();
+
+bool LoadRules(const std::string& path, std::vector<Rule>& out, std::string& error,
+               const Rule& defaults = Rule());   // missing file = none
+bool SaveRules(const std::string& path, const std::vector<Rule>& rules, std::string& error);
+
+// Rule for an image path ("C:\Games\cs2.exe" or just "cs2.exe"), matched
+// on the file name without regard to case; nullptr when none applies.
+const Rule* FindRule(const std::vector<Rule>& rules, const std::string& imagePath);
+
+// Adds `r`, replacing a rule for the same executable.
+void PutRule(std::vector<Rule>& rules, const Rule& r);
+bool RemoveRule(std::vector<Rule>& rules, const std::string& exe);
+
+// CPUs the rule confines the process to, from its list, `gameCpus` or the
+// topology.  CPUs missing from the topology are dropped; empty means leave
+// the CPU sets alone.
+std::vector<uint32_t> ResolveCpus(const Rule& r, const cpu_topology::Topology& t,
+                                  const std::vector<uint32_t>& gameCpus);
+
+// affinity_planner::GameCpus from the machine profile at DefaultPath().
+std::vector<uint32_t> ConfiguredGameCpus(const cpu_topology::Topology& t);
+
+// One line per rule with the CPUs it resolves to.
+std::string Describe(const std::vector<Rule>& rules, const cpu_topology::Topology& t,
+                     const std::vector<uint32_t>& gameCpus);
+
+// ─── Manager ─────────────────────────────────────────────────────────────────
+
+struct Event {
+    enum class Kind { Started, Applied, Exited, Restored, Throttled, Released, Error };
+
+    Kind        kind = Kind::Started;
+    uint32_t    pid  = 0;
+    std::string exe;
+    std::string detail;   // what was applied, what it saved, or what failed
+};
+
+const char* EventName(Event::Kind k);
+
+// What background throttling kept away from the game cores: CPU time and
+// context switches of the throttled processes while their CPU Sets were on
+// other cores (switches of threads that ended in between are not counted).
+struct Savings {
+    uint32_t sessions        = 0;   // times the first game started throttling
+    uint32_t processes       = 0;   // background processes released
+    uint64_t cpuTime         = 0;   // 100 ns units
+    uint64_t contextSwitches = 0;
+};
+
+// Adds one released process; counters that went backwards count as zero.
+void AddUsage(Savings& s, uint64_t cpuStart, uint64_t cpuEnd, uint64_t switchesStart, uint64_t switchesEnd);
+
+// "3 process(es), 1.24 s CPU, 18342 context switches"
+std::string Describe(const Savings& s);
+
+// A process the manager changed, with its original settings.
+struct Process {
+    uint32_t    pid = 0;
+    std::string exe;
+    uint64_t    createTime = 0;   // FILETIME ticks; guards against pid reuse
+    std::string applied;          // summary of the changes
+    bool        background = false;
+
+    uint64_t    cpuTimeAtStart  = 0;   // 100 ns units, background processes
+    uint64_t    switchesAtStart = 0;   // context switches of live threads
+
+    std::optional<uint32_t> priorityClass;   // originals of what was changed
+    bool                    cpuSetsChanged = false;
+    std::vector<uint32_t>   cpuSetIds;       // previous default CPU Set ids, empty = none
+    std::optional<uint32_t> ioPriority;
+    std::optional<uint32_t> memoryPriority;
+    bool                    throttlingChanged = false;
+    uint32_t                throttlingControl = 0, throttlingState = 0;
+};
+
+// Watches for the rules' executables from Start() to Stop() (Windows only;
+// elevated, since real-time kernel sessions need administrator rights).
+// Callbacks run on the trace thread and must not call back into the manager.
+class Manager {
+public:
+    using Callback = std::function<void(const Event&)>;
+
+    Manager(std::vector<Rule> rules, std::vector<uint32_t> gameCpus, Callback callback = {});
+    ~Manager();
+
+    Manager(const Manager&)            = delete;
+    Manager& operator=(const Manager&) = delete;
+
+    // Processes to throttle while a game runs; set before Start().
+    void SetBackgroundRules(std::vector<Rule> rules) { m_background = std::move(rules); }
+
+    // Opens the trace session, then applies the rules to processes that are
+    // already running.
+    bool Start(std::string& error);
+
+    // Ends the session and restores every process still running.
+    void Stop();
+
+    bool                 Running() const { return m_running; }
+    std::vector<Process> Processes() const;
+    Savings              BackgroundSavings() const;
+
+private:
+    void OnStart(uint32_t pid);
+    void OnExit(uint32_t pid);
+    void Emit(Event::Kind kind, uint32_t pid, const std::string& exe, const std::string& detail);
+
+    // With m_mutex held; events are emitted by the caller after unlocking.
+    bool GameRunning() const;
+    void Track(uint32_t pid, const Rule& rule, bool background, std::vector<Event>& events);
+    void ThrottleBackground(std::vector<Event>& events);
+    void ReleaseBackground(std::vector<Event>& events);
+
+    struct Trace;   // ETW session plumbing (Windows)
+
+    std::vector<Rule>           m_rules;
+    std::vector<Rule>           m_background;
+    std::vector<uint32_t>       m_gameCpus;
+    Callback                    m_callback;
+    std::atomic<bool>           m_running{false};
+    uint64_t                    m_session = 0;   // TRACEHANDLE of the controller
+    uint64_t                    m_trace   = 0;   // TRACEHANDLE of the consumer
+    std::thread                 m_thread;
+    mutable std::mutex          m_mutex;
+    std::map<uint32_t, Process> m_processes;     // by pid
+    Savings                     m_savings;
+};
+
+} // namespace game_runtime
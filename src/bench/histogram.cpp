@@ -0,0 +1,220 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// ─── Bucket layout ───────────────────────────────────────────────────────────
+// Values below kSubBuckets map 1:1.  Above that, magnitude m (the index of the
+// highest set bit) selects a group of kSubBuckets buckets, each 2^(m-5) wide.
+
+static int HighestBit(uint64_t v)
+{
+    int bit = 0;
+    while (v >>= 1) ++bit;
+    return bit;
+}
+
+std::size_t LatencyHistogram::IndexOf(uint64_t ns)
+{
+    if (ns < static_cast<uint64_t>(kSubBuckets))
+        return static_cast<std::size_t>(ns);
+
+    int magnitude = HighestBit(ns);
+    if (magnitude > kMaxMagnitude)
+        return kSubBuckets + (kMaxMagnitude - kSubBucketBits + 1) * kSubBuckets - 1;
+
+    int shift = magnitude - kSubBucketBits;
+    std::size_t sub = static_cast<std::size_t>(ns >> shift) - kSubBuckets;
+    return kSubBuckets + static_cast<std::size_t>(shift) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::BucketLower(std::size_t index)
+{
+    if (index < static_cast<std::size_t>(kSubBuckets))
+        return index;
+
+    std::size_t shift = (index - kSubBuckets) / kSubBuckets;
+    std::size_t sub   = (index - kSubBuckets) % kSubBuckets;
+    return static_cast<uint64_t>(kSubBuckets + sub) << shift;
+}
+
+uint64_t LatencyHistogram::BucketUpper(std::size_t index)
+{
+    if (index < static_cast<std::size_t>(kSubBuckets))
+        return index;
+
+    std::size_t shift = (index - kSubBuckets) / kSubBuckets;
+    return BucketLower(index) + (uint64_t{1} << shift) - 1;
+}
+
+// ─── LatencyHistogram ────────────────────────────────────────────────────────
+
+LatencyHistogram::LatencyHistogram()
+    : m_buckets(kSubBuckets + (kMaxMagnitude - kSubBucketBits + 1) * kSubBuckets, 0)
+{
+}
+
+void LatencyHistogram::Record(uint64_t ns)
+{
+    ++m_buckets[IndexOf(ns)];
+    ++m_count;
+    m_min = std::min(m_min, ns);
+    m_max = std::max(m_max, ns);
+    double v = static_cast<double>(ns);
+    m_sum   += v;
+    m_sumSq += v * v;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+    for (std::size_t i = 0; i < m_buckets.size(); ++i)
+        m_buckets[i] += other.m_buckets[i];
+    m_count += other.m_count;
+    m_min    = std::min(m_min, other.m_min);
+    m_max    = std::max(m_max, other.m_max);
+    m_sum   += other.m_sum;
+    m_sumSq += other.m_sumSq;
+}
+
+void LatencyHistogram::Reset()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_min   = UINT64_MAX;
+    m_max   = 0;
+    m_sum   = 0.0;
+    m_sumSq = 0.0;
+}
+
+double LatencyHistogram::Mean() const
+{
+    return m_count ? m_sum / static_cast<double>(m_count) : 0.0;
+}
+
+double LatencyHistogram::StdDev() const
+{
+    if (m_count < 2) return 0.0;
+    double mean = Mean();
+    double var  = m_sumSq / static_cast<double>(m_count) - mean * mean;
+    return var > 0.0 ? std::sqrt(var) : 0.0;
+}
+
+uint64_t LatencyHistogram::ValueAtPercentile(double percentile) const
+{
+    if (m_count == 0) return 0;
+
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    uint64_t target = static_cast<uint64_t>(
+        std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        seen += m_buckets[i];
+        if (seen >= target)
+            return std::clamp(BucketUpper(i), Min(), m_max);
+    }
+    return m_max;
+}
+
+std::string LatencyHistogram::Summary() const
+{
+    auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+
+    char buf[256]{};
+    std::snprintf(buf, sizeof(buf),
+        "n=%llu  min=%.1f  p50=%.1f  p90=%.1f  p99=%.1f  p99.9=%.1f  max=%.1f  "
+        "mean=%.1f  sd=%.1f us",
+        static_cast<unsigned long long>(m_count),
+        us(Min()),
+        us(ValueAtPercentile(50.0)),
+        us(ValueAtPercentile(90.0)),
+        us(ValueAtPercentile(99.0)),
+        us(ValueAtPercentile(99.9)),
+        us(m_max),
+        Mean() / 1000.0,
+        StdDev() / 1000.0);
+    return buf;
+}
+
+void LatencyHistogram::WriteCsv(std::ostream& out) const
+{
+    out << "lower_ns,upper_ns,count\n";
+    for (std::size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        if (m_buckets[i] == 0) continue;
+        out << BucketLower(i) << ',' << BucketUpper(i) << ',' << m_buckets[i] << '\n';
+    }
+}
+
+// ─── Serialisation ───────────────────────────────────────────────────────────
+// u32 bucket entries, { u32 index, u64 count } each, then u64 min, u64 max,
+// f64 sum, f64 sumSq.  The count is the sum of the bucket counts.
+
+template <typename T>
+static void Put(std::string& out, T v)
+{
+    char raw[sizeof(T)];
+    std::memcpy(raw, &v, sizeof(T));
+    out.append(raw, sizeof(T));
+}
+
+template <typename T>
+static bool Take(const char* data, std::size_t size, std::size_t& pos, T& v)
+{
+    if (size - pos < sizeof(T)) return false;
+    std::memcpy(&v, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+void LatencyHistogram::Serialize(std::string& out) const
+{
+    uint32_t entries = 0;
+    for (uint64_t b : m_buckets)
+        if (b) ++entries;
+
+    Put(out, entries);
+    for (std::size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        if (!m_buckets[i]) continue;
+        Put(out, static_cast<uint32_t>(i));
+        Put(out, m_buckets[i]);
+    }
+    Put(out, m_min);
+    Put(out, m_max);
+    Put(out, m_sum);
+    Put(out, m_sumSq);
+}
+
+bool LatencyHistogram::Deserialize(const char* data, std::size_t size, std::size_t& consumed)
+{
+    Reset();
+    std::size_t pos = 0;
+    uint32_t entries = 0;
+    if (!Take(data, size, pos, entries) || entries > m_buckets.size()) return false;
+
+    for (uint32_t e = 0; e < entries; ++e)
+    {
+        uint32_t index = 0;
+        uint64_t count = 0;
+        if (!Take(data, size, pos, index) || !Take(data, size, pos, count) || index >= m_buckets.size())
+        {
+            Reset();
+            return false;
+        }
+        m_buckets[index] += count;
+        m_count          += count;
+    }
+    if (!Take(data, size, pos, m_min) || !Take(data, size, pos, m_max) ||
+        !Take(data, size, pos, m_sum) || !Take(data, size, pos, m_sumSq))
+    {
+        Reset();
+        return false;
+    }
+    consumed = pos;
+    return true;
+}
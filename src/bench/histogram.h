@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Log-linear latency histogram (HdrHistogram-style).
+//
+// Values are recorded in nanoseconds.  Each power-of-two range is split into
+// kSubBuckets linear buckets, so every reported value is within ~3% of the
+// true sample while the whole table stays a fixed ~11 KB regardless of how
+// many samples are recorded.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    // Record one sample (nanoseconds).  Values beyond the top bucket saturate.
+    void Record(uint64_t ns);
+
+    // Add every sample of another histogram into this one.
+    void Merge(const LatencyHistogram& other);
+
+    void Reset();
+
+    uint64_t Count()  const { return m_count; }
+    uint64_t Min()    const { return m_count ? m_min : 0; }
+    uint64_t Max()    const { return m_max; }
+    double   Mean()   const;
+    double   StdDev() const;
+
+    // Value (ns) at or below which `percentile` percent of samples fall.
+    uint64_t ValueAtPercentile(double percentile) const;
+
+    // One-line summary: n, min, p50, p90, p99, p99.9, max, mean, stddev in µs.
+    std::string Summary() const;
+
+    // Non-empty buckets as CSV: "lower_ns,upper_ns,count".
+    void WriteCsv(std::ostream& out) const;
+
+    // Raw bucket access (used for serialisation and plotting).
+    std::size_t BucketCount() const { return m_buckets.size(); }
+    uint64_t    BucketValue(std::size_t index) const { return m_buckets[index]; }
+    static uint64_t BucketLower(std::size_t index);
+    static uint64_t BucketUpper(std::size_t index);
+
+    // Compact binary form: non-empty buckets plus the moments, little-endian.
+    // Deserialize replaces the contents and reports the bytes consumed; it
+    // returns false (leaving the histogram empty) on malformed input.
+    void Serialize(std::string& out) const;
+    bool Deserialize(const char* data, std::size_t size, std::size_t& consumed);
+
+private:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr int kSubBuckets    = 1 << kSubBucketBits;
+    static constexpr int kMaxMagnitude  = 42;   // ~73 minutes in ns
+
+    static std::size_t IndexOf(uint64_t ns);
+
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count = 0;
+    uint64_t m_min   = UINT64_MAX;
+    uint64_t m_max   = 0;
+    double   m_sum   = 0.0;
+    double   m_sumSq = 0.0;
+};
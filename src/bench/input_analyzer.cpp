@@ -0,0 +1,146 @@
+#include "input_analyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+
+namespace input_analyzer {
+
+// ─── Analysis ────────────────────────────────────────────────────────────────
+
+Analysis Analyze(const Recording& rec, const Config& cfg)
+{
+    Analysis a;
+    a.sourceResolutionNs = rec.sourceResolutionNs;
+
+    // Pick the device: explicit, or the one that produced the most reports.
+    a.device = cfg.device;
+    if (a.device == 0)
+    {
+        std::map<uint64_t, uint64_t> counts;
+        for (const auto& r : rec.reports) ++counts[r.device];
+        uint64_t best = 0;
+        for (const auto& kv : counts)
+            if (kv.second > best) { best = kv.second; a.device = kv.first; }
+    }
+
+    std::vector<InputReport> reports;
+    for (const auto& r : rec.reports)
+        if (r.device == a.device) reports.push_back(r);
+    a.reports = reports.size();
+    if (reports.empty()) return a;
+
+    // A fine OS stamp on every report (evdev) times the reports themselves:
+    // one read() returns a batch that shares a receive time, which would
+    // read as coalesced delivery.  Otherwise the receive time is all there is.
+    const bool haveSource = rec.sourceResolutionNs <= kMaxSourceResolutionNs &&
+                            std::all_of(reports.begin(), reports.end(),
+                                        [](const InputReport& r) { return r.sourceNs != 0; });
+    auto stamp = [haveSource](const InputReport& r) { return haveSource ? r.sourceNs : r.receiveNs; };
+    std::sort(reports.begin(), reports.end(),
+              [&](const InputReport& x, const InputReport& y) { return stamp(x) < stamp(y); });
+
+    // In-burst intervals; an idle gap starts a new movement burst.
+    std::vector<uint64_t> intervals;
+    a.bursts = 1;
+    for (std::size_t i = 1; i < reports.size(); ++i)
+    {
+        uint64_t gap = stamp(reports[i]) - stamp(reports[i - 1]);
+        if (gap > cfg.idleGapNs) { ++a.bursts; continue; }
+        intervals.push_back(gap);
+        a.intervals.Record(gap);
+    }
+
+    if (!intervals.empty())
+    {
+        std::vector<uint64_t> sorted(intervals);
+        std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+        a.nominalNs = sorted[sorted.size() / 2];
+        if (a.nominalNs == 0)
+            a.nominalNs = static_cast<uint64_t>(a.intervals.Mean());
+    }
+
+    if (a.nominalNs > 0)
+    {
+        a.effectiveHz = 1e9 / static_cast<double>(a.nominalNs);
+        a.jitterNs    = a.intervals.StdDev();
+
+        const double nominal = static_cast<double>(a.nominalNs);
+        LatencyHistogram deviation;
+        for (uint64_t gap : intervals)
+        {
+            double g = static_cast<double>(gap);
+            if (g > cfg.dropFactor * nominal)
+                a.droppedReports += static_cast<uint64_t>(std::llround(g / nominal)) - 1;
+            else if (g < cfg.coalesceFraction * nominal)
+                ++a.coalesced;
+            deviation.Record(static_cast<uint64_t>(std::fabs(g - nominal)));
+        }
+        a.jitterP99Ns = deviation.ValueAtPercentile(99.0);
+    }
+
+    // Delivery delay: the two clocks have different epochs, so only the
+    // spread is meaningful.  Align the smallest observed delay to zero.
+    if (haveSource)
+    {
+        int64_t minDelay = INT64_MAX;
+        for (const auto& r : reports)
+            minDelay = std::min(minDelay, static_cast<int64_t>(r.receiveNs - r.sourceNs));
+        for (const auto& r : reports)
+            a.deliveryDelay.Record(static_cast<uint64_t>(
+                static_cast<int64_t>(r.receiveNs - r.sourceNs) - minDelay));
+    }
+    return a;
+}
+
+// ─── CSV persistence ─────────────────────────────────────────────────────────
+
+bool SaveCsv(const std::string& path, const Recording& rec)
+{
+    std::ofstream f(path);
+    if (!f.is_open()) return false;
+
+    f << "# source_resolution_ns=" << rec.sourceResolutionNs << "\n";
+    f << "receive_ns,source_ns,device,dx,dy\n";
+    for (const auto& r : rec.reports)
+        f << r.receiveNs << ',' << r.sourceNs << ',' << r.device << ','
+          << r.dx << ',' << r.dy << '\n';
+    return true;
+}
+
+bool LoadCsv(const std::string& path, Recording& rec, std::string& error)
+{
+    std::ifstream f(path);
+    if (!f.is_open()) { error = "cannot open " + path; return false; }
+
+    rec = Recording{};
+    std::string line;
+    while (std::getline(f, line))
+    {
+        if (line.empty()) continue;
+        if (line[0] == '#')
+        {
+            auto pos = line.find("source_resolution_ns=");
+            if (pos != std::string::npos)
+                rec.sourceResolutionNs = std::strtoull(line.c_str() + pos + 21, nullptr, 10);
+            continue;
+        }
+        if (line.compare(0, 10, "receive_ns") == 0) continue;   // header
+
+        InputReport r;
+        char* p = const_cast<char*>(line.c_str());
+        r.receiveNs = std::strtoull(p, &p, 10); if (*p == ',') ++p;
+        r.sourceNs  = std::strtoull(p, &p, 10); if (*p == ',') ++p;
+        r.device    = std::strtoull(p, &p, 10); if (*p == ',') ++p;
+        r.dx        = static_cast<int32_t>(std::strtol(p, &p, 10)); if (*p == ',') ++p;
+        r.dy        = static_cast<int32_t>(std::strtol(p, &p, 10));
+        rec.reports.push_back(r);
+    }
+
+    if (rec.reports.empty()) { error = "no input reports in " + path; return false; }
+    return true;
+}
+
+} // namespace input_analyzer
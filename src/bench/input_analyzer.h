@@ -0,0 +1,62 @@
+#pragma once
+#include "histogram.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pointer-input timing analysis.  Validates the Input category tweaks
+// (polling rate, acceleration, pointer precision) from a recorded stream of
+// per-report timestamps, so the analysis itself runs anywhere.
+namespace input_analyzer {
+
+// One device report as seen by the capture thread.
+struct InputReport {
+    uint64_t receiveNs = 0;   // bench_clock time the capture thread dequeued it
+    uint64_t sourceNs  = 0;   // time the OS stamped it (evdev time); 0 = none
+    uint64_t device    = 0;   // opaque device id
+    int32_t  dx        = 0;
+    int32_t  dy        = 0;
+};
+
+struct Recording {
+    std::vector<InputReport> reports;
+    // Granularity of sourceNs: 1 µs for evdev, 0 when there is none.
+    // Delivery delays below this resolution are not meaningful.
+    uint64_t sourceResolutionNs = 0;
+};
+
+// Coarser source stamps (older Windows recordings kept the ~15.6 ms message
+// time) give no delivery delay.
+constexpr uint64_t kMaxSourceResolutionNs = 1000000;
+
+struct Config {
+    uint64_t idleGapNs        = 50000000;   // gap that ends a movement burst
+    double   dropFactor       = 1.5;        // interval > factor x nominal = missed report(s)
+    double   coalesceFraction = 0.25;       // interval < fraction x nominal = coalesced
+    uint64_t device           = 0;          // 0 = device with most reports
+};
+
+struct Analysis {
+    uint64_t         device          = 0;
+    uint64_t         reports         = 0;
+    uint64_t         bursts          = 0;   // continuous movement segments
+    uint64_t         nominalNs       = 0;   // median in-burst report interval
+    double           effectiveHz     = 0.0;
+    double           jitterNs        = 0.0; // std-dev of in-burst intervals
+    uint64_t         jitterP99Ns     = 0;   // p99 |interval - nominal|
+    uint64_t         droppedReports  = 0;   // estimated missing reports
+    uint64_t         coalesced       = 0;   // reports delivered in a burst
+    LatencyHistogram intervals;             // on sourceNs when every report has a fine one, else receiveNs
+    LatencyHistogram deliveryDelay;         // relative: minimum delay aligned to 0; empty without usable source stamps
+    uint64_t         sourceResolutionNs = 0;
+};
+
+Analysis Analyze(const Recording& rec, const Config& cfg = Config{});
+
+// CSV persistence: "receive_ns,source_ns,device,dx,dy" with a
+// "# source_resolution_ns=N" comment line.
+bool SaveCsv(const std::string& path, const Recording& rec);
+bool LoadCsv(const std::string& path, Recording& rec, std::string& error);
+
+} // namespace input_analyzer
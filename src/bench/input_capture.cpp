@@ -0,0 +1,218 @@
+#include "input_capture.h"
+#include "bench_clock.h"
+
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace input_capture {
+
+#ifdef _WIN32
+
+// ─── Windows raw input ───────────────────────────────────────────────────────
+
+static void CaptureThread(const Config& cfg, input_analyzer::Recording& out,
+                          std::string& error, const std::atomic<bool>* cancel)
+{
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+
+    HINSTANCE inst = GetModuleHandleW(nullptr);
+    WNDCLASSEXW wc = {};
+    wc.cbSize        = sizeof(wc);
+    wc.lpfnWndProc   = DefWindowProcW;
+    wc.hInstance     = inst;
+    wc.lpszClassName = L"LatencyProbeRawInput";
+    RegisterClassExW(&wc);
+
+    HWND hwnd = CreateWindowExW(0, wc.lpszClassName, L"", 0, 0, 0, 0, 0,
+                                HWND_MESSAGE, nullptr, inst, nullptr);
+    if (!hwnd) { error = "CreateWindowEx failed"; return; }
+
+    RAWINPUTDEVICE rid = {};
+    rid.usUsagePage = 0x01;   // generic desktop
+    rid.usUsage     = 0x02;   // mouse
+    rid.dwFlags     = RIDEV_INPUTSINK;
+    rid.hwndTarget  = hwnd;
+    if (!RegisterRawInputDevices(&rid, 1, sizeof(rid)))
+    {
+        error = "RegisterRawInputDevices failed";
+        DestroyWindow(hwnd);
+        return;
+    }
+
+    // sourceNs stays 0: msg.time only ticks with the clock interrupt.
+    const uint64_t endNs = bench_clock::NowNs() + static_cast<uint64_t>(cfg.durationMs) * 1000000ULL;
+
+    for (;;)
+    {
+        uint64_t now = bench_clock::NowNs();
+        if (now >= endNs || (cancel && cancel->load())) break;
+        DWORD waitMs = static_cast<DWORD>((endNs - now) / 1000000ULL);
+        MsgWaitForMultipleObjects(0, nullptr, FALSE, waitMs < 100 ? waitMs : 100, QS_RAWINPUT);
+
+        MSG msg;
+        while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
+        {
+            uint64_t receiveNs = bench_clock::NowNs();   // stamp before any decoding
+            if (msg.message != WM_INPUT) { DispatchMessageW(&msg); continue; }
+
+            RAWINPUT raw;
+            UINT size = sizeof(raw);
+            if (GetRawInputData(reinterpret_cast<HRAWINPUT>(msg.lParam), RID_INPUT,
+                                &raw, &size, sizeof(RAWINPUTHEADER)) != static_cast<UINT>(-1) &&
+                raw.header.dwType == RIM_TYPEMOUSE)
+            {
+                input_analyzer::InputReport r;
+                r.receiveNs = receiveNs;
+                r.device    = reinterpret_cast<uint64_t>(raw.header.hDevice);
+                r.dx        = raw.data.mouse.lLastX;
+                r.dy        = raw.data.mouse.lLastY;
+                out.reports.push_back(r);
+            }
+            DefWindowProcW(msg.hwnd, msg.message, msg.wParam, msg.lParam);
+        }
+    }
+
+    rid.dwFlags    = RIDEV_REMOVE;
+    rid.hwndTarget = nullptr;
+    RegisterRawInputDevices(&rid, 1, sizeof(rid));
+    DestroyWindow(hwnd);
+    UnregisterClassW(wc.lpszClassName, inst);
+}
+
+#else
+
+// ─── Linux evdev ─────────────────────────────────────────────────────────────
+
+static bool HasRelativeMotion(int fd)
+{
+    unsigned long bits[(REL_MAX + 8 * sizeof(unsigned long)) / (8 * sizeof(unsigned long))] = {};
+    if (ioctl(fd, EVIOCGBIT(EV_REL, sizeof(bits)), bits) < 0) return false;
+    auto test = [&](int bit) {
+        return (bits[bit / (8 * sizeof(unsigned long))] >> (bit % (8 * sizeof(unsigned long)))) & 1;
+    };
+    return test(REL_X) && test(REL_Y);
+}
+
+static int OpenDevice(const std::string& requested, std::string& path, std::string& error)
+{
+    if (!requested.empty())
+    {
+        int fd = open(requested.c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd < 0) error = "cannot open " + requested + ": " + std::strerror(errno);
+        path = requested;
+        return fd;
+    }
+
+    DIR* dir = opendir("/dev/input");
+    if (!dir) { error = "cannot list /dev/input"; return -1; }
+    int found = -1;
+    while (dirent* e = readdir(dir))
+    {
+        if (std::strncmp(e->d_name, "event", 5) != 0) continue;
+        std::string candidate = std::string("/dev/input/") + e->d_name;
+        int fd = open(candidate.c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd < 0) continue;
+        if (HasRelativeMotion(fd)) { found = fd; path = candidate; break; }
+        close(fd);
+    }
+    closedir(dir);
+    if (found < 0) error = "no readable relative-motion device in /dev/input (try --device, or run as root)";
+    return found;
+}
+
+static void CaptureThread(const Config& cfg, input_analyzer::Recording& out,
+                          std::string& error, const std::atomic<bool>* cancel)
+{
+    // Best effort: SCHED_FIFO needs CAP_SYS_NICE.
+    sched_param sp{};
+    sp.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+
+    std::string path;
+    int fd = OpenDevice(cfg.device, path, error);
+    if (fd < 0) return;
+
+    int clockId = CLOCK_MONOTONIC;   // same clock as bench_clock
+    ioctl(fd, EVIOCSCLOCKID, &clockId);
+    out.sourceResolutionNs = 1000;
+
+    struct stat st{};
+    uint64_t device = fstat(fd, &st) == 0 ? static_cast<uint64_t>(st.st_rdev) : 1;
+
+    const uint64_t endNs = bench_clock::NowNs() + static_cast<uint64_t>(cfg.durationMs) * 1000000ULL;
+    input_analyzer::InputReport pending;
+    bool moved = false;
+
+    for (;;)
+    {
+        uint64_t now = bench_clock::NowNs();
+        if (now >= endNs || (cancel && cancel->load())) break;
+        int waitMs = static_cast<int>((endNs - now) / 1000000ULL);
+
+        pollfd pfd{ fd, POLLIN, 0 };
+        if (poll(&pfd, 1, waitMs < 100 ? waitMs : 100) <= 0) continue;
+
+        input_event events[64];
+        ssize_t n = read(fd, events, sizeof(events));
+        uint64_t receiveNs = bench_clock::NowNs();
+        if (n <= 0) continue;
+
+        for (ssize_t i = 0; i < n / static_cast<ssize_t>(sizeof(input_event)); ++i)
+        {
+            const input_event& ev = events[i];
+            if (ev.type == EV_REL && ev.code == REL_X) { pending.dx += ev.value; moved = true; }
+            else if (ev.type == EV_REL && ev.code == REL_Y) { pending.dy += ev.value; moved = true; }
+            else if (ev.type == EV_SYN && ev.code == SYN_REPORT && moved)
+            {
+#ifdef input_event_sec
+                uint64_t sec = static_cast<uint64_t>(ev.input_event_sec);
+                uint64_t usec = static_cast<uint64_t>(ev.input_event_usec);
+#else
+                uint64_t sec = static_cast<uint64_t>(ev.time.tv_sec);
+                uint64_t usec = static_cast<uint64_t>(ev.time.tv_usec);
+#endif
+                pending.receiveNs = receiveNs;
+                pending.sourceNs  = sec * 1000000000ULL + usec * 1000ULL;
+                pending.device    = device;
+                out.reports.push_back(pending);
+                pending = input_analyzer::InputReport{};
+                moved   = false;
+            }
+        }
+    }
+    close(fd);
+}
+
+#endif
+
+// ─── Public entry point ──────────────────────────────────────────────────────
+
+bool Record(const Config& cfg, input_analyzer::Recording& out, std::string& error,
+            const std::atomic<bool>* cancel)
+{
+    out = input_analyzer::Recording{};
+    error.clear();
+    out.reports.reserve(static_cast<std::size_t>(cfg.durationMs) * 8);   // 8 kHz headroom
+
+    std::thread worker(CaptureThread, std::cref(cfg), std::ref(out), std::ref(error), cancel);
+    worker.join();
+    return error.empty();
+}
+
+} // namespace input_capture
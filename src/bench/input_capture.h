@@ -0,0 +1,31 @@
+#pragma once
+#include "input_analyzer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Live pointer-report capture feeding input_analyzer.
+//
+// Windows: a dedicated time-critical thread owns a message-only window
+// registered for raw mouse input (RIDEV_INPUTSINK, so focus does not
+// matter) and stamps every WM_INPUT with the performance counter the moment
+// it is dequeued.  No source stamp is recorded: the only one raw input has
+// is the message time, a GetTickCount value with clock-interrupt (~15.6 ms)
+// granularity, far too coarse for a delay to the queue.
+//
+// Linux: reads an evdev node with the kernel event clock switched to
+// CLOCK_MONOTONIC; one report per SYN_REPORT that carried relative motion.
+namespace input_capture {
+
+struct Config {
+    uint32_t    durationMs = 10000;
+    std::string device;   // Linux: /dev/input/eventN; empty = first relative-motion device
+};
+
+// Blocks for `durationMs` (or until `cancel` is set) while the capture thread
+// runs.  Returns false with `error` set if capture could not start.
+bool Record(const Config& cfg, input_analyzer::Recording& out, std::string& error,
+            const std::atomic<bool>* cancel = nullptr);
+
+} // namespace input_capture
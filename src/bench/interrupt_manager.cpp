@@ -0,0 +1,367 @@
+#include "interrupt_manager.h"
+#include "machine_profile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace interrupt_manager {
+
+static const char* kEnumRoot = "SYSTEM\\CurrentControlSet\\Enum";
+
+static std::string Lower(std::string s)
+{
+    for (char& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+static std::string Upper(std::string s)
+{
+    for (char& c : s) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return s;
+}
+
+// ─── Devices ─────────────────────────────────────────────────────────────────
+
+const char* PriorityName(Priority p)
+{
+    switch (p) {
+    case Priority::Undefined: return "undefined";
+    case Priority::Low:       return "low";
+    case Priority::Normal:    return "normal";
+    case Priority::High:      return "high";
+    }
+    return "?";
+}
+
+bool ParsePriority(const std::string& text, Priority& out)
+{
+    std::string t = Lower(text);
+    for (Priority p : { Priority::Undefined, Priority::Low, Priority::Normal, Priority::High })
+        if (t == PriorityName(p) || t == std::to_string(static_cast<uint32_t>(p)))
+        {
+            out = p;
+            return true;
+        }
+    return false;
+}
+
+static std::string DeviceKey(const std::string& instanceId)
+{
+    return std::string(kEnumRoot) + "\\" + instanceId;
+}
+
+std::string MsiKey(const std::string& instanceId)
+{
+    return DeviceKey(instanceId) +
+           "\\Device Parameters\\Interrupt Management\\MessageSignaledInterruptProperties";
+}
+
+std::string PolicyKey(const std::string& instanceId)
+{
+    return DeviceKey(instanceId) + "\\Device Parameters\\Interrupt Management\\Affinity Policy";
+}
+
+std::string ModeName(const DeviceInfo& d)
+{
+    if (!d.msiEnabled) return "line-based";
+    if (d.messageLimit == 0) return "MSI";
+    return "MSI (limit " + std::to_string(d.messageLimit) + ")";
+}
+
+// "@oem42.inf,%dev_2684%;NVIDIA GeForce RTX 4090" -> "NVIDIA GeForce RTX 4090"
+static std::string StripInfReference(const std::string& desc)
+{
+    if (desc.empty() || desc[0] != '@') return desc;
+    std::size_t semi = desc.rfind(';');
+    return semi == std::string::npos ? desc : desc.substr(semi + 1);
+}
+
+bool ReadDevice(const registry_access::Registry& reg, const std::string& instanceId, DeviceInfo& out)
+{
+    std::string key = DeviceKey(instanceId);
+    if (!reg.KeyExists(key)) return false;
+
+    out = DeviceInfo{};
+    out.instanceId = instanceId;
+    auto desc = reg.ReadString(key, "FriendlyName");
+    if (!desc) desc = reg.ReadString(key, "DeviceDesc");
+    out.description = StripInfReference(desc.value_or(""));
+    out.className   = reg.ReadString(key, "Class").value_or("");
+
+    // Control is volatile: PnP creates it when the device starts
+    out.present      = reg.KeyExists(key + "\\Control");
+    out.msiCapable   = reg.KeyExists(MsiKey(instanceId));
+    out.msiEnabled   = reg.ReadDword(MsiKey(instanceId), "MSISupported").value_or(0) == 1;
+    out.messageLimit = reg.ReadDword(MsiKey(instanceId), "MessageNumberLimit").value_or(0);
+    uint32_t prio    = reg.ReadDword(PolicyKey(instanceId), "DevicePriority").value_or(0);
+    out.priority     = prio <= 3 ? static_cast<Priority>(prio) : Priority::Undefined;
+    return true;
+}
+
+std::vector<DeviceInfo> ListDevices(const registry_access::Registry& reg)
+{
+    std::vector<DeviceInfo> out;
+    std::string pci = std::string(kEnumRoot) + "\\PCI";
+    for (const auto& hw : reg.SubKeys(pci))
+        for (const auto& inst : reg.SubKeys(pci + "\\" + hw))
+        {
+            DeviceInfo d;
+            if (ReadDevice(reg, "PCI\\" + hw + "\\" + inst, d)) out.push_back(std::move(d));
+        }
+    return out;
+}
+
+// ─── Settings and backup ─────────────────────────────────────────────────────
+
+bool Matches(const DeviceInfo& d, const Setting& s)
+{
+    if (d.msiEnabled != s.msi) return false;
+    if (s.messageLimit && d.messageLimit != *s.messageLimit) return false;
+    if (s.priority && d.priority != *s.priority) return false;
+    return true;
+}
+
+DeviceBackup Snapshot(const registry_access::Registry& reg, const std::string& instanceId)
+{
+    DeviceBackup b;
+    b.instanceId   = instanceId;
+    b.msiKey       = reg.KeyExists(MsiKey(instanceId));
+    b.policyKey    = reg.KeyExists(PolicyKey(instanceId));
+    b.msiSupported = reg.ReadDword(MsiKey(instanceId), "MSISupported");
+    b.messageLimit = reg.ReadDword(MsiKey(instanceId), "MessageNumberLimit");
+    b.priority     = reg.ReadDword(PolicyKey(instanceId), "DevicePriority");
+    return b;
+}
+
+std::string DefaultBackupPath()
+{
+    return machine_profile::DataDir() + "/interrupt-backup.txt";
+}
+
+static std::string FormatOptional(const std::optional<uint32_t>& v)
+{
+    return v ? std::to_string(*v) : "-";
+}
+
+static bool ParseOptional(const std::string& text, std::optional<uint32_t>& out)
+{
+    if (text == "-") { out.reset(); return true; }
+    char* end = nullptr;
+    unsigned long v = std::strtoul(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0') return false;
+    out = static_cast<uint32_t>(v);
+    return true;
+}
+
+bool LoadBackups(const std::string& path, BackupSet& out, std::string& error)
+{
+    out.clear();
+    std::ifstream f(path);
+    if (!f) return true;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(f, line))
+    {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> fields;
+        std::istringstream ls(line);
+        for (std::string field; std::getline(ls, field, '\t');) fields.push_back(field);
+
+        DeviceBackup b;
+        bool ok = fields.size() == 6 && (fields[1] == "0" || fields[1] == "1") &&
+                  (fields[2] == "0" || fields[2] == "1") && ParseOptional(fields[3], b.msiSupported) &&
+                  ParseOptional(fields[4], b.messageLimit) && ParseOptional(fields[5], b.priority);
+        if (!ok)
+        {
+            error = path + ":" + std::to_string(lineNo) + ": malformed backup entry";
+            return false;
+        }
+        b.instanceId = fields[0];
+        b.msiKey     = fields[1] == "1";
+        b.policyKey  = fields[2] == "1";
+        out[Upper(b.instanceId)] = b;
+    }
+    return true;
+}
+
+bool SaveBackups(const std::string& path, const BackupSet& set, std::string& error)
+{
+    std::ofstream f(path, std::ios::trunc);
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    f << "# instance id\tMSI key\tpolicy key\tMSISupported\tMessageNumberLimit\tDevicePriority\n";
+    for (const auto& [id, b] : set)
+        f << b.instanceId << '\t' << (b.msiKey ? 1 : 0) << '\t' << (b.policyKey ? 1 : 0) << '\t'
+          << FormatOptional(b.msiSupported) << '\t' << FormatOptional(b.messageLimit) << '\t'
+          << FormatOptional(b.priority) << '\n';
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+// Writes `v` or, when unset, removes the value
+static bool Put(registry_access::Registry& reg, const std::string& key, const char* name,
+                const std::optional<uint32_t>& v, std::string& error)
+{
+    bool ok = v ? reg.WriteDword(key, name, *v) : reg.DeleteValue(key, name);
+    if (!ok) error = "cannot write " + key + "\\" + name;
+    return ok;
+}
+
+bool Apply(registry_access::Registry& reg, const DeviceInfo& d, const Setting& s, BackupSet& backups,
+           std::string& error)
+{
+    if (s.msi && !d.msiCapable && !s.force)
+    {
+        error = d.instanceId + ": the driver does not declare MSI support";
+        return false;
+    }
+
+    std::string id = Upper(d.instanceId);
+    if (backups.find(id) == backups.end()) backups[id] = Snapshot(reg, d.instanceId);
+
+    if (!Put(reg, MsiKey(d.instanceId), "MSISupported", s.msi ? 1u : 0u, error)) return false;
+    if (s.messageLimit)
+    {
+        std::optional<uint32_t> limit;
+        if (*s.messageLimit != 0) limit = *s.messageLimit;
+        if (!Put(reg, MsiKey(d.instanceId), "MessageNumberLimit", limit, error)) return false;
+    }
+    if (s.priority)
+    {
+        std::optional<uint32_t> prio;
+        if (*s.priority != Priority::Undefined) prio = static_cast<uint32_t>(*s.priority);
+        if (!Put(reg, PolicyKey(d.instanceId), "DevicePriority", prio, error)) return false;
+    }
+    return true;
+}
+
+bool Restore(registry_access::Registry& reg, const std::string& instanceId, BackupSet& backups, std::string& error)
+{
+    auto it = backups.find(Upper(instanceId));
+    if (it == backups.end()) return true;
+    const DeviceBackup& b = it->second;
+
+    std::string msi = MsiKey(b.instanceId), policy = PolicyKey(b.instanceId);
+    if (!Put(reg, msi, "MSISupported", b.msiSupported, error)) return false;
+    if (!Put(reg, msi, "MessageNumberLimit", b.messageLimit, error)) return false;
+    if (!Put(reg, policy, "DevicePriority", b.priority, error)) return false;
+
+    // Keys created by Apply go too, so the driver's MSI declaration reads as before
+    if (!b.msiKey && !reg.DeleteKey(msi))
+    {
+        error = "cannot remove " + msi;
+        return false;
+    }
+    if (!b.policyKey && !reg.DeleteKey(policy))
+    {
+        error = "cannot remove " + policy;
+        return false;
+    }
+    backups.erase(it);
+    return true;
+}
+
+std::vector<Result> ApplyAll(registry_access::Registry& reg, const std::vector<DeviceInfo>& devices,
+                             const Setting& s, BackupSet& backups)
+{
+    std::vector<Result> out;
+    for (const auto& d : devices)
+    {
+        Result r;
+        r.instanceId = d.instanceId;
+        r.ok         = Apply(reg, d, s, backups, r.error);
+        out.push_back(std::move(r));
+    }
+    return out;
+}
+
+std::vector<Result> RestoreAll(registry_access::Registry& reg, BackupSet& backups)
+{
+    std::vector<std::string> ids;
+    for (const auto& [id, b] : backups) ids.push_back(b.instanceId);
+
+    std::vector<Result> out;
+    for (const auto& id : ids)
+    {
+        Result r;
+        r.instanceId = id;
+        r.ok         = Restore(reg, id, backups, r.error);
+        out.push_back(std::move(r));
+    }
+    return out;
+}
+
+bool ApplyToDevice(const std::string& instanceId, const Setting& s, std::string& error)
+{
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return false;
+
+    DeviceInfo d;
+    if (!ReadDevice(*reg, instanceId, d))
+    {
+        error = instanceId + ": no such device";
+        return false;
+    }
+    BackupSet backups;
+    std::string path = DefaultBackupPath();
+    if (!LoadBackups(path, backups, error)) return false;
+
+    bool ok = Apply(*reg, d, s, backups, error);
+    std::string saveError;
+    if (!SaveBackups(path, backups, saveError) && ok)
+    {
+        error = saveError;
+        return false;
+    }
+    return ok;
+}
+
+bool RestoreDevice(const std::string& instanceId, std::string& error)
+{
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return false;
+
+    BackupSet backups;
+    std::string path = DefaultBackupPath();
+    if (!LoadBackups(path, backups, error)) return false;
+    if (!Restore(*reg, instanceId, backups, error)) return false;
+    return SaveBackups(path, backups, error);
+}
+
+std::string Describe(const std::vector<DeviceInfo>& devices, const BackupSet& backups)
+{
+    std::ostringstream os;
+    char line[256];
+    snprintf(line, sizeof(line), "%-16s %-9s %-10s %-8s %s\n", "mode", "priority", "class", "state", "device");
+    os << line;
+    for (const auto& d : devices)
+    {
+        std::string state = d.present ? "present" : "absent";
+        if (backups.count(Upper(d.instanceId))) state += "*";
+        std::string mode = ModeName(d);
+        if (!d.msiCapable) mode += "?";
+        snprintf(line, sizeof(line), "%-16s %-9s %-10s %-8s ", mode.c_str(), PriorityName(d.priority),
+                 d.className.empty() ? "-" : d.className.c_str(), state.c_str());
+        os << line << (d.description.empty() ? "(no description)" : d.description) << "\n"
+           << std::string(47, ' ') << d.instanceId << "\n";
+    }
+    os << "? = driver does not declare MSI support   * = original values backed up\n";
+    return os.str();
+}
+
+} // namespace interrupt_manager
@@ -0,0 +1,117 @@
+#pragma once
+#include "registry_access.h"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Per-device interrupt management for every PCI / PCIe function.  Windows
+// reads the interrupt mode and priority of a device from its hardware key,
+//
+//   Enum\<instance id>\Device Parameters\Interrupt Management
+//     \MessageSignaledInterruptProperties   MSISupported, MessageNumberLimit
+//     \Affinity Policy                      DevicePriority
+//
+// not from the driver class key.  The values take effect the next time the
+// device starts (reboot or disable / enable).  Whether the device ends up
+// with MSI or MSI-X is the PnP manager's choice; MSISupported only allows
+// message-signalled interrupts and MessageNumberLimit caps the vectors.
+//
+// All reads and writes go through registry_access, so a `reg export` of
+// HKLM\SYSTEM\CurrentControlSet\Enum\PCI can be inspected and edited anywhere.
+namespace interrupt_manager {
+
+// ─── Devices ─────────────────────────────────────────────────────────────────
+
+enum class Priority : uint32_t { Undefined = 0, Low = 1, Normal = 2, High = 3 };
+
+const char* PriorityName(Priority p);
+bool        ParsePriority(const std::string& text, Priority& out);   // undefined|low|normal|high
+
+// "SYSTEM\CurrentControlSet\Enum\<id>\Device Parameters\Interrupt Management\..."
+std::string MsiKey(const std::string& instanceId);
+std::string PolicyKey(const std::string& instanceId);
+
+struct DeviceInfo {
+    std::string instanceId;               // PCI\VEN_10DE&DEV_2684&...\4&...
+    std::string description;              // FriendlyName or DeviceDesc, INF prefix stripped
+    std::string className;                // Class: Display, Net, USB, ...
+    bool        present      = false;     // has the volatile Control subkey
+    bool        msiCapable   = false;     // driver created MessageSignaledInterruptProperties
+    bool        msiEnabled   = false;     // MSISupported = 1
+    uint32_t    messageLimit = 0;         // MessageNumberLimit, 0 = not set
+    Priority    priority     = Priority::Undefined;
+};
+
+// "line-based", "MSI" or "MSI (limit N)" – the configured mode.
+std::string ModeName(const DeviceInfo& d);
+
+bool ReadDevice(const registry_access::Registry& reg, const std::string& instanceId, DeviceInfo& out);
+
+// Every instance under Enum\PCI in key order; stale instances of removed
+// hardware are included with present = false.
+std::vector<DeviceInfo> ListDevices(const registry_access::Registry& reg);
+
+// ─── Settings and backup ─────────────────────────────────────────────────────
+
+struct Setting {
+    bool                    msi = true;
+    std::optional<uint32_t> messageLimit;   // 0 removes the cap; unset leaves it
+    std::optional<Priority> priority;       // unset leaves it
+    bool                    force = false;  // allow MSI without driver support
+};
+
+bool Matches(const DeviceInfo& d, const Setting& s);
+
+// The interrupt values of one device as they were before the first change.
+struct DeviceBackup {
+    std::string             instanceId;
+    bool                    msiKey    = false;   // MessageSignaledInterruptProperties existed
+    bool                    policyKey = false;   // Affinity Policy existed
+    std::optional<uint32_t> msiSupported;
+    std::optional<uint32_t> messageLimit;
+    std::optional<uint32_t> priority;
+};
+
+using BackupSet = std::map<std::string, DeviceBackup>;   // by upper-case instance id
+
+DeviceBackup Snapshot(const registry_access::Registry& reg, const std::string& instanceId);
+
+// DataDir()/interrupt-backup.txt
+std::string DefaultBackupPath();
+
+bool LoadBackups(const std::string& path, BackupSet& out, std::string& error);   // missing file = empty set
+bool SaveBackups(const std::string& path, const BackupSet& set, std::string& error);
+
+// Writes `s` to one device.  The first change of a device records its
+// previous values in `backups`; later changes keep that original.  Enabling
+// MSI on a device whose driver does not declare support fails unless
+// s.force – such a device may not start again.
+bool Apply(registry_access::Registry& reg, const DeviceInfo& d, const Setting& s, BackupSet& backups,
+           std::string& error);
+
+// Puts the recorded values back and drops the device from `backups`.  A
+// device without a backup is left alone.
+bool Restore(registry_access::Registry& reg, const std::string& instanceId, BackupSet& backups, std::string& error);
+
+struct Result {
+    std::string instanceId;
+    bool        ok = false;
+    std::string error;
+};
+
+// Bulk apply / restore; every device is attempted.
+std::vector<Result> ApplyAll(registry_access::Registry& reg, const std::vector<DeviceInfo>& devices,
+                             const Setting& s, BackupSet& backups);
+std::vector<Result> RestoreAll(registry_access::Registry& reg, BackupSet& backups);
+
+// Live registry plus DefaultBackupPath() in one call, for tweaks and the GUI.
+bool ApplyToDevice(const std::string& instanceId, const Setting& s, std::string& error);
+bool RestoreDevice(const std::string& instanceId, std::string& error);
+
+// Table of devices: id, class, mode, priority, description.
+std::string Describe(const std::vector<DeviceInfo>& devices, const BackupSet& backups);
+
+} // namespace interrupt_manager
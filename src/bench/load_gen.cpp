@@ -0,0 +1,459 @@
+#include "load_gen.h"
+#include "bench_clock.h"
+#include "socket_compat.h"
+#include "thread_util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace load_gen {
+
+static constexpr uint64_t kDefaultSize = 256ULL << 20;
+static constexpr uint64_t kSliceNs     = 10000000;   // duty-cycle slice
+static constexpr uint32_t kIoSize      = 4096;
+static constexpr uint32_t kPageSize    = 4096;
+
+const char* KindName(Kind kind)
+{
+    switch (kind) {
+        case Kind::Cpu:       return "cpu";
+        case Kind::Memory:    return "memory";
+        case Kind::Storage:   return "storage";
+        case Kind::Network:   return "network";
+        case Kind::PageFault: return "pagefault";
+    }
+    return "?";
+}
+
+// ─── Scenario parsing ────────────────────────────────────────────────────────
+
+static uint64_t ParseSize(const std::string& v)
+{
+    char* end = nullptr;
+    uint64_t n = std::strtoull(v.c_str(), &end, 0);
+    switch (end ? *end : '\0') {
+        case 'k': case 'K': return n << 10;
+        case 'm': case 'M': return n << 20;
+        case 'g': case 'G': return n << 30;
+    }
+    return n;
+}
+
+bool ParseWorkload(const std::string& line, Workload& out, std::string& error)
+{
+    std::istringstream in(line);
+    std::string kind;
+    in >> kind;
+
+    out = Workload{};
+    if      (kind == "cpu")       out.kind = Kind::Cpu;
+    else if (kind == "memory")    out.kind = Kind::Memory;
+    else if (kind == "storage")   out.kind = Kind::Storage;
+    else if (kind == "network")   out.kind = Kind::Network;
+    else if (kind == "pagefault") out.kind = Kind::PageFault;
+    else { error = "unknown workload '" + kind + "'"; return false; }
+
+    std::string token;
+    while (in >> token)
+    {
+        auto eq = token.find('=');
+        if (eq == std::string::npos) { error = "expected key=value, got '" + token + "'"; return false; }
+        std::string key = token.substr(0, eq);
+        std::string val = token.substr(eq + 1);
+
+        if      (key == "threads")   out.threads   = std::max(1UL, std::strtoul(val.c_str(), nullptr, 0));
+        else if (key == "intensity") out.intensity = std::clamp(std::strtod(val.c_str(), nullptr), 0.0, 1.0);
+        else if (key == "size")      out.sizeBytes = ParseSize(val);
+        else if (key == "path")      out.path      = val;
+        else if (key == "host")      out.host      = val;
+        else if (key == "port")      out.port      = static_cast<uint16_t>(std::strtoul(val.c_str(), nullptr, 0));
+        else if (key == "cpus")
+        {
+            std::stringstream list(val);
+            std::string cpu;
+            while (std::getline(list, cpu, ','))
+                out.cpus.push_back(static_cast<uint32_t>(std::strtoul(cpu.c_str(), nullptr, 0)));
+        }
+        else { error = "unknown option '" + key + "' for " + kind; return false; }
+    }
+    return true;
+}
+
+bool ParseScenario(const std::string& text, Scenario& out, std::string& error)
+{
+    out = Scenario{};
+    std::istringstream in(text);
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNo;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::stringstream entries(line);
+        std::string entry;
+        while (std::getline(entries, entry, ';'))
+        {
+            if (entry.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+            std::istringstream words(entry);
+            std::string first;
+            words >> first;
+            if (first == "seed")
+            {
+                words >> out.seed;
+                continue;
+            }
+
+            Workload w;
+            if (!ParseWorkload(entry, w, error))
+            {
+                error = "line " + std::to_string(lineNo) + ": " + error;
+                return false;
+            }
+            out.workloads.push_back(std::move(w));
+        }
+    }
+    if (out.workloads.empty()) { error = "scenario has no workloads"; return false; }
+    return true;
+}
+
+bool LoadScenario(const std::string& path, Scenario& out, std::string& error)
+{
+    std::ifstream f(path);
+    if (!f.is_open()) { error = "cannot open " + path; return false; }
+    std::stringstream ss;
+    ss << f.rdbuf();
+    if (!ParseScenario(ss.str(), out, error))
+    {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+std::string Describe(const Workload& w)
+{
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "%s x%u %.0f%%", KindName(w.kind), w.threads, w.intensity * 100.0);
+    std::string s = buf;
+    if (!w.cpus.empty())
+    {
+        s += " cpus=";
+        for (std::size_t i = 0; i < w.cpus.size(); ++i)
+            s += (i ? "," : "") + std::to_string(w.cpus[i]);
+    }
+    if (w.kind == Kind::Memory || w.kind == Kind::Storage || w.kind == Kind::PageFault)
+        s += " " + std::to_string((w.sizeBytes ? w.sizeBytes : kDefaultSize) >> 20) + "MiB";
+    if (w.kind == Kind::Network)
+        s += " -> " + w.host + ":" + std::to_string(w.port);
+    return s;
+}
+
+// ─── Platform helpers ────────────────────────────────────────────────────────
+
+static void* AllocPages(uint64_t bytes)
+{
+#ifdef _WIN32
+    return VirtualAlloc(nullptr, static_cast<SIZE_T>(bytes), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+#endif
+}
+
+static void FreePages(void* p, uint64_t bytes)
+{
+    if (!p) return;
+#ifdef _WIN32
+    (void)bytes;
+    VirtualFree(p, 0, MEM_RELEASE);
+#else
+    munmap(p, bytes);
+#endif
+}
+
+// Drop the backing pages so the next touch takes a demand-zero fault.
+static void DiscardPages(void* p, uint64_t bytes)
+{
+#ifdef _WIN32
+    VirtualFree(p, static_cast<SIZE_T>(bytes), MEM_DECOMMIT);
+    VirtualAlloc(p, static_cast<SIZE_T>(bytes), MEM_COMMIT, PAGE_READWRITE);
+#else
+    madvise(p, bytes, MADV_DONTNEED);
+#endif
+}
+
+// Unbuffered scratch file, deleted when closed.
+class ScratchFile {
+public:
+    ~ScratchFile() { Close(); }
+
+    bool Open(const std::string& path)
+    {
+#ifdef _WIN32
+        m_handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE |
+                               FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH |
+                               FILE_FLAG_RANDOM_ACCESS, nullptr);
+        return m_handle != INVALID_HANDLE_VALUE;
+#else
+        m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_DIRECT, 0600);
+        if (m_fd < 0 && errno == EINVAL)   // tmpfs and friends have no O_DIRECT
+            m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (m_fd >= 0) unlink(path.c_str());
+        return m_fd >= 0;
+#endif
+    }
+
+    void Close()
+    {
+#ifdef _WIN32
+        if (m_handle != INVALID_HANDLE_VALUE) CloseHandle(m_handle);
+        m_handle = INVALID_HANDLE_VALUE;
+#else
+        if (m_fd >= 0) close(m_fd);
+        m_fd = -1;
+#endif
+    }
+
+    bool Write(const void* buf, uint32_t len, uint64_t offset)
+    {
+#ifdef _WIN32
+        OVERLAPPED ov = {};
+        ov.Offset     = static_cast<DWORD>(offset);
+        ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD done = 0;
+        return WriteFile(m_handle, buf, len, &done, &ov) && done == len;
+#else
+        return pwrite(m_fd, buf, len, static_cast<off_t>(offset)) == static_cast<ssize_t>(len);
+#endif
+    }
+
+    bool Read(void* buf, uint32_t len, uint64_t offset)
+    {
+#ifdef _WIN32
+        OVERLAPPED ov = {};
+        ov.Offset     = static_cast<DWORD>(offset);
+        ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD done = 0;
+        return ReadFile(m_handle, buf, len, &done, &ov) && done == len;
+#else
+        return pread(m_fd, buf, len, static_cast<off_t>(offset)) == static_cast<ssize_t>(len);
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE m_handle = INVALID_HANDLE_VALUE;
+#else
+    int m_fd = -1;
+#endif
+};
+
+static std::string ScratchPath(const Workload& w, uint64_t seed, std::size_t workload, uint32_t thread)
+{
+    std::string dir = w.path.empty() ? "." : w.path;
+    char name[96];
+    std::snprintf(name, sizeof(name), "loadgen_%llu_%zu_%u.tmp",
+                  static_cast<unsigned long long>(seed), workload, thread);
+    char last = dir.back();
+    return (last == '/' || last == '\\') ? dir + name : dir + "/" + name;
+}
+
+// ─── Generator ───────────────────────────────────────────────────────────────
+
+LoadGenerator::LoadGenerator(Scenario scenario)
+    : m_scenario(std::move(scenario))
+    , m_ops(new std::atomic<uint64_t>[m_scenario.workloads.size()])
+{
+    for (std::size_t i = 0; i < m_scenario.workloads.size(); ++i)
+        m_ops[i] = 0;
+}
+
+LoadGenerator::~LoadGenerator()
+{
+    Stop();
+}
+
+bool LoadGenerator::Start()
+{
+    if (m_running) return true;
+
+    // Fail fast on the things a worker thread could only report silently.
+    for (const auto& w : m_scenario.workloads)
+    {
+        if (w.kind == Kind::Network)
+        {
+            sockaddr_storage addr{};
+            socklen_t len = 0;
+            if (!socket_compat::Startup() ||
+                !socket_compat::Resolve(w.host, w.port, SOCK_DGRAM, addr, len))
+            {
+                m_error = "cannot resolve network target " + w.host;
+                return false;
+            }
+        }
+        if (w.kind == Kind::Storage)
+        {
+            ScratchFile probe;
+            if (!probe.Open(ScratchPath(w, m_scenario.seed, 999, 999)))
+            {
+                m_error = "cannot create scratch file in " + (w.path.empty() ? std::string(".") : w.path);
+                return false;
+            }
+        }
+    }
+
+    m_running = true;
+    for (std::size_t i = 0; i < m_scenario.workloads.size(); ++i)
+        for (uint32_t t = 0; t < m_scenario.workloads[i].threads; ++t)
+            m_threads.emplace_back(&LoadGenerator::Worker, this, i, t);
+    return true;
+}
+
+void LoadGenerator::Stop()
+{
+    m_running = false;
+    for (auto& t : m_threads)
+        if (t.joinable()) t.join();
+    m_threads.clear();
+}
+
+uint64_t LoadGenerator::Operations(std::size_t workload) const
+{
+    return workload < m_scenario.workloads.size() ? m_ops[workload].load() : 0;
+}
+
+void LoadGenerator::Worker(std::size_t index, uint32_t thread)
+{
+    const Workload& w = m_scenario.workloads[index];
+    if (!w.cpus.empty())
+        thread_util::PinCurrentThread(w.cpus[thread % w.cpus.size()]);
+
+    // Per-thread stream derived from the scenario seed: same seed, same
+    // access pattern, regardless of thread start order.
+    std::mt19937_64 rng(m_scenario.seed * 0x9E3779B97F4A7C15ULL + (index << 16) + thread);
+
+    uint64_t size = w.sizeBytes ? w.sizeBytes : kDefaultSize;
+    if (w.kind == Kind::Memory || w.kind == Kind::PageFault)
+        size /= w.threads;
+    size = std::max<uint64_t>(size, 1ULL << 20);
+    size &= ~static_cast<uint64_t>(kPageSize - 1);
+
+    // Per-kind state and one unit of work (tens of microseconds at most).
+    char*       region  = nullptr;
+    char*       ioBuf   = nullptr;
+    ScratchFile file;
+    socket_t    sock    = kInvalidSocket;
+    sockaddr_storage target{};
+    socklen_t   targetLen = 0;
+    uint64_t    cursor  = 0;
+    uint64_t    spin    = rng();
+
+    switch (w.kind) {
+    case Kind::Memory:
+    case Kind::PageFault:
+        region = static_cast<char*>(AllocPages(size));
+        if (!region) return;
+        std::memset(region, 1, size);
+        break;
+    case Kind::Storage:
+        ioBuf = static_cast<char*>(AllocPages(1 << 20));   // page-aligned for unbuffered I/O
+        if (!ioBuf || !file.Open(ScratchPath(w, m_scenario.seed, index, thread)))
+        {
+            FreePages(ioBuf, 1 << 20);
+            return;
+        }
+        for (uint32_t i = 0; i < (1u << 20); ++i) ioBuf[i] = static_cast<char>(rng());
+        // Really allocate the file; reads past valid data would never hit the disk.
+        for (uint64_t off = 0; off < size && m_running; off += 1 << 20)
+            file.Write(ioBuf, 1 << 20, off);
+        break;
+    case Kind::Network:
+        socket_compat::Startup();
+        socket_compat::Resolve(w.host, w.port, SOCK_DGRAM, target, targetLen);
+        sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (sock == kInvalidSocket) return;
+        ioBuf = static_cast<char*>(AllocPages(kPageSize));
+        break;
+    case Kind::Cpu:
+        break;
+    }
+
+    auto step = [&]() -> uint64_t {
+        switch (w.kind) {
+        case Kind::Cpu:
+            for (int i = 0; i < 4096; ++i)
+                spin = spin * 6364136223846793005ULL + 1442695040888963407ULL;
+            return 4096;
+        case Kind::Memory: {
+            // Stream one 1 MiB block from one half of the region into the other.
+            const uint64_t half  = size / 2;
+            const uint64_t block = std::min<uint64_t>(1 << 20, half);
+            uint64_t off = cursor % (half - block + 1);
+            std::memcpy(region + half + off, region + off, block);
+            cursor += block;
+            return block;
+        }
+        case Kind::Storage: {
+            uint64_t blocks = size / kIoSize;
+            uint64_t off    = (rng() % blocks) * kIoSize;
+            bool ok = (rng() % 10 < 7) ? file.Read(ioBuf, kIoSize, off)
+                                       : file.Write(ioBuf, kIoSize, off);
+            return ok ? 1 : 0;
+        }
+        case Kind::Network: {
+            int sent = sendto(sock, ioBuf, 1400, 0, reinterpret_cast<const sockaddr*>(&target), targetLen);
+            return sent > 0 ? 1 : 0;
+        }
+        case Kind::PageFault: {
+            // Touch 64 random pages; once a region's worth has been touched,
+            // drop it so the next round faults again.
+            uint64_t pages = size / kPageSize;
+            for (int i = 0; i < 64; ++i)
+                region[(rng() % pages) * kPageSize] ^= 1;
+            cursor += 64;
+            if (cursor >= pages) { DiscardPages(region, size); cursor = 0; }
+            return 64;
+        }
+        }
+        return 0;
+    };
+
+    const uint64_t busyNs = static_cast<uint64_t>(static_cast<double>(kSliceNs) * w.intensity);
+    while (m_running)
+    {
+        uint64_t sliceStart = bench_clock::NowNs();
+        uint64_t ops = 0;
+        while (m_running && bench_clock::NowNs() - sliceStart < busyNs)
+            ops += step();
+        m_ops[index] += ops;
+        if (busyNs < kSliceNs)
+            bench_clock::SleepUntilNs(sliceStart + kSliceNs, 0);
+    }
+
+    volatile uint64_t sink = spin;   // keep the CPU spin from being optimized out
+    (void)sink;
+    if (region) FreePages(region, size);
+    if (w.kind == Kind::Storage) FreePages(ioBuf, 1 << 20);
+    if (w.kind == Kind::Network) { FreePages(ioBuf, kPageSize); socket_compat::Close(sock); }
+}
+
+} // namespace load_gen
@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Reproducible background load.  Latency measured on an idle desktop says
+// little; the tweaks matter under contention from indexing, updates,
+// downloads and memory pressure.  A scenario is a list of workloads, each
+// with its own thread count, duty-cycle intensity and CPU affinity, driven
+// from a fixed seed so every run issues the same access pattern.
+//
+// Scenario scripts are plain text, one workload per line, identical on
+// Windows and Linux:
+//
+//     # heavy desktop
+//     seed 42
+//     cpu       threads=2 intensity=0.5 cpus=2,3
+//     memory    threads=1 intensity=1.0 size=256M
+//     storage   intensity=0.3 size=512M path=D:\scratch
+//     network   intensity=1.0 host=192.168.1.20 port=9
+//     pagefault intensity=0.5 size=256M
+namespace load_gen {
+
+enum class Kind { Cpu, Memory, Storage, Network, PageFault };
+
+struct Workload {
+    Kind                  kind      = Kind::Cpu;
+    uint32_t              threads   = 1;
+    double                intensity = 1.0;   // busy share of every 10 ms slice (0..1)
+    std::vector<uint32_t> cpus;              // thread i pinned to cpus[i % n]; empty = any
+    uint64_t              sizeBytes = 0;     // working set / scratch file (0 = 256 MiB)
+    std::string           path;              // storage: scratch directory ("." default)
+    std::string           host = "127.0.0.1";// network: flood target
+    uint16_t              port = 9;          // network: discard port
+};
+
+struct Scenario {
+    uint64_t              seed = 1;
+    std::vector<Workload> workloads;
+};
+
+const char* KindName(Kind kind);
+
+// Parse one workload line ("cpu threads=2 intensity=0.5 cpus=0,1").
+bool ParseWorkload(const std::string& line, Workload& out, std::string& error);
+
+// Parse a whole script: lines as above, "seed N", '#' comments.  Workloads
+// may also be separated by ';' so a scenario fits on one command line.
+bool ParseScenario(const std::string& text, Scenario& out, std::string& error);
+bool LoadScenario(const std::string& path, Scenario& out, std::string& error);
+
+std::string Describe(const Workload& w);
+
+// Runs a scenario on background threads until Stop() or destruction.
+class LoadGenerator {
+public:
+    explicit LoadGenerator(Scenario scenario);
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator&)            = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    bool Start();
+    void Stop();
+
+    const Scenario&    GetScenario() const { return m_scenario; }
+    const std::string& LastError()   const { return m_error; }
+
+    // Work done so far by workload i: spin iterations, bytes copied, I/Os,
+    // datagrams or pages faulted, depending on the kind.
+    uint64_t Operations(std::size_t workload) const;
+
+private:
+    void Worker(std::size_t workload, uint32_t thread);
+
+    Scenario                                   m_scenario;
+    std::string                                m_error;
+    std::atomic<bool>                          m_running{false};
+    std::unique_ptr<std::atomic<uint64_t>[]>   m_ops;
+    std::vector<std::thread>                   m_threads;
+};
+
+} // namespace load_gen
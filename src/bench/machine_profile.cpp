@@ -0,0 +1,217 @@
+#include "machine_profile.h"
+#include "thread_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace machine_profile {
+
+// ─── Identity ────────────────────────────────────────────────────────────────
+
+static std::string Trim(const std::string& s)
+{
+    auto b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return "";
+    auto e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+static std::string HostName()
+{
+#ifdef _WIN32
+    char name[MAX_COMPUTERNAME_LENGTH + 1] = {};
+    DWORD len = sizeof(name);
+    return GetComputerNameA(name, &len) ? std::string(name, len) : "unknown";
+#else
+    char name[256] = {};
+    return gethostname(name, sizeof(name) - 1) == 0 ? std::string(name) : "unknown";
+#endif
+}
+
+static std::string CpuName()
+{
+#ifdef _WIN32
+    char  name[256] = {};
+    DWORD size = sizeof(name);
+    if (RegGetValueA(HKEY_LOCAL_MACHINE, "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+                     "ProcessorNameString", RRF_RT_REG_SZ, nullptr, name, &size) == ERROR_SUCCESS)
+        return Trim(name);
+#else
+    std::ifstream f("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(f, line))
+        if (line.compare(0, 10, "model name") == 0)
+        {
+            auto colon = line.find(':');
+            if (colon != std::string::npos) return Trim(line.substr(colon + 1));
+        }
+#endif
+    return "unknown";
+}
+
+Profile Current()
+{
+    Profile p;
+    p.hostName    = HostName();
+    p.cpuName     = CpuName();
+    p.logicalCpus = thread_util::LogicalCpuCount();
+    p.fingerprint = p.hostName + " | " + p.cpuName + " | " + std::to_string(p.logicalCpus);
+    return p;
+}
+
+// ─── Location ────────────────────────────────────────────────────────────────
+
+std::string DataDir()
+{
+    std::string dir;
+#ifdef _WIN32
+    const char* base = std::getenv("LOCALAPPDATA");
+    dir = std::string(base ? base : ".") + "\\LatencyOptimizer";
+#else
+    const char* xdg  = std::getenv("XDG_DATA_HOME");
+    const char* home = std::getenv("HOME");
+    if (xdg && *xdg)   dir = std::string(xdg) + "/latency-optimizer";
+    else if (home)     dir = std::string(home) + "/.local/share/latency-optimizer";
+    else               dir = "./latency-optimizer";
+#endif
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    return dir;
+}
+
+std::string DefaultPath()
+{
+    std::string host = HostName();
+    for (char& c : host)
+        if (c == '/' || c == '\\' || c == ':' || c == ' ') c = '_';
+#ifdef _WIN32
+    return DataDir() + "\\profile-" + host + ".txt";
+#else
+    return DataDir() + "/profile-" + host + ".txt";
+#endif
+}
+
+std::string NowIso8601()
+{
+    std::time_t t = std::time(nullptr);
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &t);
+#else
+    gmtime_r(&t, &utc);
+#endif
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return buf;
+}
+
+// ─── Persistence ─────────────────────────────────────────────────────────────
+
+template <typename T, typename Parse>
+static std::vector<T> ParseList(const std::string& v, Parse parse)
+{
+    std::vector<T> out;
+    std::stringstream ss(v);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty()) out.push_back(static_cast<T>(parse(item)));
+    return out;
+}
+
+template <typename T>
+static std::string JoinList(const std::vector<T>& values)
+{
+    std::ostringstream out;
+    for (std::size_t i = 0; i < values.size(); ++i)
+        out << (i ? "," : "") << values[i];
+    return out.str();
+}
+
+bool Load(const std::string& path, Profile& out, std::string& error)
+{
+    std::ifstream f(path);
+    if (!f.is_open()) { error = "cannot open " + path; return false; }
+
+    out = Profile{};
+    std::map<std::size_t, std::vector<float>> rows;
+    std::string line;
+    while (std::getline(f, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        auto eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        std::string key = line.substr(0, eq);
+        std::string val = Trim(line.substr(eq + 1));
+
+        if      (key == "fingerprint")  out.fingerprint   = val;
+        else if (key == "host")         out.hostName      = val;
+        else if (key == "cpu")          out.cpuName       = val;
+        else if (key == "logical_cpus") out.logicalCpus   = static_cast<uint32_t>(std::strtoul(val.c_str(), nullptr, 10));
+        else if (key == "c2c.measured") out.c2cMeasuredAt = val;
+        else if (key == "c2c.cpus")
+            out.c2cCpus = ParseList<uint32_t>(val, [](const std::string& s) { return std::strtoul(s.c_str(), nullptr, 10); });
+        else if (key == "c2c.domains")
+            out.c2cDomains = ParseList<int>(val, [](const std::string& s) { return std::strtol(s.c_str(), nullptr, 10); });
+        else if (key.compare(0, 8, "c2c.row.") == 0)
+            rows[std::strtoul(key.c_str() + 8, nullptr, 10)] =
+                ParseList<float>(val, [](const std::string& s) { return std::strtof(s.c_str(), nullptr); });
+        else
+            out.extra[key] = val;
+    }
+
+    for (auto& kv : rows)
+        if (kv.first == out.c2cRttNs.size()) out.c2cRttNs.push_back(std::move(kv.second));
+    if (out.c2cRttNs.size() != out.c2cCpus.size())
+    {
+        error = path + ": core-to-core matrix does not match its CPU list";
+        out.c2cRttNs.clear();
+        out.c2cCpus.clear();
+        out.c2cDomains.clear();
+        return false;
+    }
+    return true;
+}
+
+bool Save(const std::string& path, const Profile& p)
+{
+    // Write-then-rename so a crash never leaves a truncated profile.
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        if (!f.is_open()) return false;
+
+        f << "# LatencyOptimizer machine profile\n";
+        f << "fingerprint=" << p.fingerprint << "\n";
+        f << "host=" << p.hostName << "\n";
+        f << "cpu=" << p.cpuName << "\n";
+        f << "logical_cpus=" << p.logicalCpus << "\n";
+        if (!p.c2cCpus.empty())
+        {
+            f << "c2c.measured=" << p.c2cMeasuredAt << "\n";
+            f << "c2c.cpus=" << JoinList(p.c2cCpus) << "\n";
+            f << "c2c.domains=" << JoinList(p.c2cDomains) << "\n";
+            for (std::size_t i = 0; i < p.c2cRttNs.size(); ++i)
+                f << "c2c.row." << i << "=" << JoinList(p.c2cRttNs[i]) << "\n";
+        }
+        for (const auto& kv : p.extra)
+            f << kv.first << "=" << kv.second << "\n";
+        if (!f.good()) return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+} // namespace machine_profile
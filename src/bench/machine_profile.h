@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Per-machine profile: identity plus measured topology facts that planners
+// (interrupt affinity, RSS, game cores) read back instead of guessing.
+// Stored as a small "key=value" text file in DataDir(); unknown keys are kept
+// on load/save so other tools can add their own sections.
+namespace machine_profile {
+
+struct Profile {
+    std::string fingerprint;                   // host | cpu | logical count
+    std::string hostName;
+    std::string cpuName;
+    uint32_t    logicalCpus = 0;
+
+    // Core-to-core round-trip matrix (c2c_latency) and inferred domains.
+    std::string                     c2cMeasuredAt;   // ISO-8601 UTC
+    std::vector<uint32_t>           c2cCpus;
+    std::vector<std::vector<float>> c2cRttNs;
+    std::vector<int>                c2cDomains;
+
+    std::map<std::string, std::string> extra;        // keys this module does not own
+};
+
+// Identity of the running machine (fingerprint, host, CPU, logical count).
+Profile Current();
+
+// Per-user data directory, created on demand:
+// %LOCALAPPDATA%\LatencyOptimizer on Windows, $XDG_DATA_HOME (or
+// ~/.local/share)/latency-optimizer elsewhere.
+std::string DataDir();
+
+// DataDir()/profile-<host>.txt
+std::string DefaultPath();
+
+bool Load(const std::string& path, Profile& out, std::string& error);
+bool Save(const std::string& path, const Profile& profile);
+
+// Current UTC time as ISO-8601 ("2024-05-01T12:00:00Z").
+std::string NowIso8601();
+
+} // namespace machine_profile
@@ -0,0 +1,84 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) { CloseHandle(file); return false; }
+    if (size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        m_openEmpty = true;
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { CloseHandle(file); return false; }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+
+    m_file    = file;
+    m_mapping = mapping;
+    m_data    = static_cast<const char*>(view);
+    m_size    = static_cast<std::size_t>(size.QuadPart);
+    return true;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0) { close(fd); return false; }
+    if (st.st_size == 0)
+    {
+        close(fd);
+        m_openEmpty = true;
+        return true;
+    }
+
+    void* view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // the mapping keeps the file referenced
+    if (view == MAP_FAILED) return false;
+
+    madvise(view, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(view);
+    m_size = static_cast<std::size_t>(st.st_size);
+    return true;
+#endif
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (m_data)    UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file)    CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file    = nullptr;
+#else
+    if (m_data) munmap(const_cast<char*>(m_data), m_size);
+#endif
+    m_data      = nullptr;
+    m_size      = 0;
+    m_openEmpty = false;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only memory-mapped file (MapViewOfFile / mmap).  Lets the analyzers
+// walk multi-gigabyte captures without copying them into the heap.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    const char* Data() const { return m_data; }
+    std::size_t Size() const { return m_size; }
+    bool        IsOpen() const { return m_data != nullptr || m_openEmpty; }
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool        m_openEmpty = false;   // zero-length files cannot be mapped
+#ifdef _WIN32
+    void*       m_file    = nullptr;
+    void*       m_mapping = nullptr;
+#endif
+};
@@ -0,0 +1,349 @@
+#include "net_probe.h"
+#include "bench_clock.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/select.h>
+#endif
+
+namespace net_probe {
+
+// ─── helpers ─────────────────────────────────────────────────────────────────
+
+static constexpr uint32_t kHeaderBytes  = sizeof(uint64_t);   // sequence number
+static constexpr uint32_t kMaxUdpBytes  = 65507;
+static constexpr uint32_t kPollMs       = 200;                // responder stop latency
+
+static void WriteSeq(std::vector<char>& buf, uint64_t seq)
+{
+    std::memcpy(buf.data(), &seq, sizeof(seq));
+}
+
+static uint64_t ReadSeq(const char* buf)
+{
+    uint64_t seq = 0;
+    std::memcpy(&seq, buf, sizeof(seq));
+    return seq;
+}
+
+static std::string SocketError(const char* what)
+{
+    return std::string(what) + " failed (error " +
+           std::to_string(socket_compat::LastError()) + ")";
+}
+
+const char* ProtoName(Proto proto)
+{
+    return proto == Proto::Udp ? "udp" : "tcp";
+}
+
+std::string Describe(const Config& cfg)
+{
+    std::string s = std::string(ProtoName(cfg.proto)) + " " +
+                    std::to_string(cfg.messageSize) + "B " +
+                    (cfg.rateHz ? std::to_string(cfg.rateHz) + "Hz" : "flood");
+    if (cfg.proto == Proto::Tcp)
+        s += cfg.noDelay ? " nodelay=on" : " nodelay=off";
+    return s;
+}
+
+// ─── UDP client ──────────────────────────────────────────────────────────────
+
+static Result RunUdp(const Config& cfg)
+{
+    Result r;
+    sockaddr_storage addr{};
+    socklen_t addrLen = 0;
+    if (!socket_compat::Resolve(cfg.host, cfg.port, SOCK_DGRAM, addr, addrLen))
+    {
+        r.error = "cannot resolve " + cfg.host;
+        return r;
+    }
+
+    socket_t s = socket(addr.ss_family, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == kInvalidSocket) { r.error = SocketError("socket"); return r; }
+
+    // Connected UDP socket: recv() only sees the responder's datagrams.
+    if (connect(s, reinterpret_cast<sockaddr*>(&addr), addrLen) != 0)
+    {
+        r.error = SocketError("connect");
+        socket_compat::Close(s);
+        return r;
+    }
+    socket_compat::SetRecvTimeout(s, cfg.timeoutMs);
+
+    uint32_t size = std::clamp(cfg.messageSize, kHeaderBytes, kMaxUdpBytes);
+    std::vector<char> tx(size, 'x');
+    std::vector<char> rx(kMaxUdpBytes);
+
+    uint64_t total  = static_cast<uint64_t>(cfg.warmup) + cfg.count;
+    uint64_t period = cfg.rateHz ? 1000000000ull / cfg.rateHz : 0;
+    uint64_t start  = bench_clock::NowNs();
+
+    for (uint64_t seq = 0; seq < total; ++seq)
+    {
+        if (period) bench_clock::SleepUntilNs(start + seq * period);
+
+        WriteSeq(tx, seq);
+        uint64_t t0 = bench_clock::NowNs();
+        if (send(s, tx.data(), static_cast<int>(size), 0) < 0)
+        {
+            r.error = SocketError("send");
+            break;
+        }
+        if (seq >= cfg.warmup) ++r.sent;
+
+        // Drain until the matching reply arrives; late replies to earlier
+        // (already counted as lost) requests are discarded.
+        bool matched = false;
+        for (;;)
+        {
+            int n = recv(s, rx.data(), static_cast<int>(rx.size()), 0);
+            if (n < 0) break;
+            if (static_cast<uint32_t>(n) >= kHeaderBytes && ReadSeq(rx.data()) == seq)
+            {
+                matched = true;
+                break;
+            }
+        }
+        uint64_t t1 = bench_clock::NowNs();
+
+        if (seq < cfg.warmup) continue;
+        if (matched)
+        {
+            ++r.received;
+            r.rtt.Record(t1 - t0);
+        }
+        else
+        {
+            ++r.lost;
+        }
+    }
+
+    r.elapsedNs = bench_clock::NowNs() - start;
+    r.ok = r.error.empty();
+    socket_compat::Close(s);
+    return r;
+}
+
+// ─── TCP client ──────────────────────────────────────────────────────────────
+
+static Result RunTcp(const Config& cfg)
+{
+    Result r;
+    sockaddr_storage addr{};
+    socklen_t addrLen = 0;
+    if (!socket_compat::Resolve(cfg.host, cfg.port, SOCK_STREAM, addr, addrLen))
+    {
+        r.error = "cannot resolve " + cfg.host;
+        return r;
+    }
+
+    socket_t s = socket(addr.ss_family, SOCK_STREAM, IPPROTO_TCP);
+    if (s == kInvalidSocket) { r.error = SocketError("socket"); return r; }
+
+    socket_compat::SetNoDelay(s, cfg.noDelay);
+    if (connect(s, reinterpret_cast<sockaddr*>(&addr), addrLen) != 0)
+    {
+        r.error = SocketError("connect");
+        socket_compat::Close(s);
+        return r;
+    }
+    socket_compat::SetRecvTimeout(s, cfg.timeoutMs);
+
+    uint32_t size = std::max(cfg.messageSize, kHeaderBytes);
+    std::vector<char> tx(size, 'x');
+    std::vector<char> rx(size);
+
+    uint64_t total  = static_cast<uint64_t>(cfg.warmup) + cfg.count;
+    uint64_t period = cfg.rateHz ? 1000000000ull / cfg.rateHz : 0;
+    uint64_t start  = bench_clock::NowNs();
+
+    for (uint64_t seq = 0; seq < total; ++seq)
+    {
+        if (period) bench_clock::SleepUntilNs(start + seq * period);
+
+        WriteSeq(tx, seq);
+        uint64_t t0 = bench_clock::NowNs();
+
+        // Header and body go out as two writes (write-write-read), the
+        // pattern where Nagle + delayed ACK stalls show up without NODELAY.
+        bool ok = socket_compat::SendAll(s, tx.data(), kHeaderBytes);
+        if (ok && size > kHeaderBytes)
+            ok = socket_compat::SendAll(s, tx.data() + kHeaderBytes, size - kHeaderBytes);
+        if (seq >= cfg.warmup) ++r.sent;
+        ok = ok && socket_compat::RecvAll(s, rx.data(), size);
+        uint64_t t1 = bench_clock::NowNs();
+
+        if (!ok || ReadSeq(rx.data()) != seq)
+        {
+            // A TCP stream cannot resynchronise after a short read.
+            r.error = ok ? "reply out of sequence" : SocketError("send/recv");
+            break;
+        }
+        if (seq < cfg.warmup) continue;
+        ++r.received;
+        r.rtt.Record(t1 - t0);
+    }
+
+    r.elapsedNs = bench_clock::NowNs() - start;
+    r.ok = r.error.empty();
+    socket_compat::Close(s);
+    return r;
+}
+
+Result RunPingPong(const Config& cfg)
+{
+    if (!socket_compat::Startup())
+    {
+        Result r;
+        r.error = "socket startup failed";
+        return r;
+    }
+    return cfg.proto == Proto::Udp ? RunUdp(cfg) : RunTcp(cfg);
+}
+
+// ─── EchoResponder ───────────────────────────────────────────────────────────
+
+EchoResponder::EchoResponder(uint16_t port, bool tcpNoDelay)
+    : m_port(port), m_tcpNoDelay(tcpNoDelay)
+{
+}
+
+EchoResponder::~EchoResponder()
+{
+    Stop();
+}
+
+bool EchoResponder::Start()
+{
+    if (m_running) return true;
+    if (!socket_compat::Startup()) { m_error = "socket startup failed"; return false; }
+
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port        = htons(m_port);
+
+    m_udp = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    m_tcp = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (m_udp == kInvalidSocket || m_tcp == kInvalidSocket)
+    {
+        m_error = SocketError("socket");
+        Stop();
+        return false;
+    }
+
+    socket_compat::SetReuseAddr(m_tcp);
+    if (bind(m_udp, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        m_error = SocketError("bind udp");
+        Stop();
+        return false;
+    }
+
+    // Port 0: let the OS pick for UDP, then claim the same number for TCP.
+    sockaddr_in bound{};
+    socklen_t boundLen = sizeof(bound);
+    getsockname(m_udp, reinterpret_cast<sockaddr*>(&bound), &boundLen);
+    m_port        = ntohs(bound.sin_port);
+    addr.sin_port = bound.sin_port;
+
+    if (bind(m_tcp, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(m_tcp, 8) != 0)
+    {
+        m_error = SocketError("bind/listen tcp");
+        Stop();
+        return false;
+    }
+
+    socket_compat::SetRecvTimeout(m_udp, kPollMs);
+
+    m_running      = true;
+    m_udpThread    = std::thread(&EchoResponder::UdpLoop, this);
+    m_acceptThread = std::thread(&EchoResponder::TcpAcceptLoop, this);
+    return true;
+}
+
+void EchoResponder::Stop()
+{
+    m_running = false;
+    if (m_udpThread.joinable())    m_udpThread.join();
+    if (m_acceptThread.joinable()) m_acceptThread.join();
+
+    std::vector<std::thread> clients;
+    {
+        std::lock_guard<std::mutex> lock(m_clientMutex);
+        clients.swap(m_clientThreads);
+    }
+    for (auto& t : clients)
+        if (t.joinable()) t.join();
+
+    socket_compat::Close(m_udp);
+    socket_compat::Close(m_tcp);
+    m_udp = kInvalidSocket;
+    m_tcp = kInvalidSocket;
+}
+
+void EchoResponder::UdpLoop()
+{
+    std::vector<char> buf(kMaxUdpBytes);
+    while (m_running)
+    {
+        sockaddr_storage from{};
+        socklen_t fromLen = sizeof(from);
+        int n = recvfrom(m_udp, buf.data(), static_cast<int>(buf.size()), 0,
+                         reinterpret_cast<sockaddr*>(&from), &fromLen);
+        if (n < 0) continue;   // timeout or ICMP error; re-check m_running
+
+        sendto(m_udp, buf.data(), n, 0, reinterpret_cast<sockaddr*>(&from), fromLen);
+        ++m_echoed;
+    }
+}
+
+void EchoResponder::TcpAcceptLoop()
+{
+    while (m_running)
+    {
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(m_tcp, &readSet);
+        timeval tv{};
+        tv.tv_usec = kPollMs * 1000;
+
+        int ready = select(static_cast<int>(m_tcp) + 1, &readSet, nullptr, nullptr, &tv);
+        if (ready <= 0) continue;
+
+        socket_t client = accept(m_tcp, nullptr, nullptr);
+        if (client == kInvalidSocket) continue;
+
+        socket_compat::SetNoDelay(client, m_tcpNoDelay);
+        socket_compat::SetRecvTimeout(client, kPollMs);
+
+        std::lock_guard<std::mutex> lock(m_clientMutex);
+        m_clientThreads.emplace_back(&EchoResponder::TcpClientLoop, this, client);
+    }
+}
+
+void EchoResponder::TcpClientLoop(socket_t client)
+{
+    std::vector<char> buf(64 * 1024);
+    while (m_running)
+    {
+        int n = recv(client, buf.data(), static_cast<int>(buf.size()), 0);
+        if (n == 0) break;   // peer closed
+        if (n < 0)
+        {
+            if (socket_compat::IsTimeout(socket_compat::LastError())) continue;
+            break;
+        }
+        if (!socket_compat::SendAll(client, buf.data(), static_cast<std::size_t>(n)))
+            break;
+        ++m_echoed;
+    }
+    socket_compat::Close(client);
+}
+
+} // namespace net_probe
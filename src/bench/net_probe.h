@@ -0,0 +1,86 @@
+#pragma once
+#include "histogram.h"
+#include "socket_compat.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Network round-trip probe: UDP / TCP ping-pong client plus the matching
+// echo responder, so the same binary can sit on both ends of a loopback or
+// LAN link.  Used to verify the Network and Interrupts category claims
+// (Nagle, throttling index, timestamps, NIC affinity) with real RTT data.
+namespace net_probe {
+
+enum class Proto { Udp, Tcp };
+
+struct Config {
+    std::string host        = "127.0.0.1";
+    uint16_t    port        = 7777;
+    Proto       proto       = Proto::Udp;
+    uint32_t    messageSize = 64;      // bytes per request (>= 8)
+    uint32_t    rateHz      = 1000;    // 0 = back-to-back
+    uint32_t    count       = 10000;   // measured round trips
+    uint32_t    warmup      = 100;     // discarded round trips
+    bool        noDelay     = true;    // TCP_NODELAY on the client socket
+    uint32_t    timeoutMs   = 1000;    // per-reply timeout
+};
+
+struct Result {
+    bool             ok       = false;
+    std::string      error;
+    LatencyHistogram rtt;              // measured round trips only
+    uint32_t         sent     = 0;
+    uint32_t         received = 0;
+    uint32_t         lost     = 0;     // UDP replies that timed out
+    uint64_t         elapsedNs = 0;
+};
+
+const char* ProtoName(Proto proto);
+
+// Short human-readable label, e.g. "tcp 64B 1000Hz nodelay=on".
+std::string Describe(const Config& cfg);
+
+// Run one ping-pong session against an echo responder.
+Result RunPingPong(const Config& cfg);
+
+// UDP + TCP echo server bound to the same port number on all IPv4 interfaces.
+// TCP replies are echoed as they arrive; the responder sets TCP_NODELAY on its
+// side by default so only the client's setting is under test.
+class EchoResponder {
+public:
+    explicit EchoResponder(uint16_t port, bool tcpNoDelay = true);
+    ~EchoResponder();
+
+    EchoResponder(const EchoResponder&)            = delete;
+    EchoResponder& operator=(const EchoResponder&) = delete;
+
+    bool Start();
+    void Stop();
+
+    uint16_t           Port()      const { return m_port; }
+    const std::string& LastError() const { return m_error; }
+    uint64_t           Echoed()    const { return m_echoed.load(); }
+
+private:
+    void UdpLoop();
+    void TcpAcceptLoop();
+    void TcpClientLoop(socket_t client);
+
+    uint16_t              m_port;
+    bool                  m_tcpNoDelay;
+    std::string           m_error;
+    std::atomic<bool>     m_running{false};
+    std::atomic<uint64_t> m_echoed{0};
+    socket_t              m_udp = kInvalidSocket;
+    socket_t              m_tcp = kInvalidSocket;
+    std::thread           m_udpThread;
+    std::thread           m_acceptThread;
+    std::mutex            m_clientMutex;
+    std::vector<std::thread> m_clientThreads;
+};
+
+} // namespace net_probe
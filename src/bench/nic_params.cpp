@@ -0,0 +1,313 @@
+#include "nic_params.h"
+#include "machine_profile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace nic_params {
+
+const char* kNetClassKey = "SYSTEM\\CurrentControlSet\\Control\\Class\\{4d36e972-e325-11ce-bfc1-08002be10318}";
+
+static std::string Lower(std::string s)
+{
+    for (char& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+static bool ParseInt(const std::string& text, int64_t& out)
+{
+    if (text.empty()) return false;
+    char* end = nullptr;
+    long long v = std::strtoll(text.c_str(), &end, 10);
+    if (*end != '\0') return false;
+    out = v;
+    return true;
+}
+
+// ─── Keywords ────────────────────────────────────────────────────────────────
+
+bool Keyword::Allows(const std::string& v) const
+{
+    if (type == "enum")
+    {
+        for (const auto& o : options)
+            if (o.value == v) return true;
+        return false;
+    }
+    if (type == "edit") return true;
+
+    int64_t n = 0;
+    if (!ParseInt(v, n)) return false;
+    return !hasRange || (n >= min && n <= max);
+}
+
+const Keyword* Adapter::Find(const std::string& name) const
+{
+    std::string n = Lower(name);
+    for (const auto& k : keywords)
+        if (Lower(k.name) == n) return &k;
+    return nullptr;
+}
+
+// Ndi\params stores min / max / default as REG_SZ; some drivers use REG_DWORD
+static std::optional<std::string> ReadText(const registry_access::Registry& reg, const std::string& key,
+                                           const std::string& name)
+{
+    if (auto s = reg.ReadString(key, name)) return s;
+    if (auto d = reg.ReadDword(key, name)) return std::to_string(*d);
+    return std::nullopt;
+}
+
+static Keyword ReadKeyword(const registry_access::Registry& reg, const std::string& classKey,
+                           const std::string& name)
+{
+    std::string key = classKey + "\\Ndi\\params\\" + name;
+    Keyword k;
+    k.name         = name;
+    k.description  = reg.ReadString(key, "ParamDesc").value_or(name);
+    k.type         = Lower(reg.ReadString(key, "type").value_or(""));
+    k.defaultValue = ReadText(reg, key, "default").value_or("");
+    k.value        = ReadText(reg, classKey, name);
+
+    if (k.type == "enum")
+    {
+        for (const auto& v : reg.ValueNames(key + "\\enum"))
+            k.options.push_back({ v, reg.ReadString(key + "\\enum", v).value_or(v) });
+        // Numeric order when every value is a number
+        std::stable_sort(k.options.begin(), k.options.end(), [](const Option& a, const Option& b) {
+            int64_t x = 0, y = 0;
+            if (ParseInt(a.value, x) && ParseInt(b.value, y)) return x < y;
+            return false;
+        });
+    }
+    int64_t lo = 0, hi = 0;
+    if (ParseInt(ReadText(reg, key, "min").value_or(""), lo) && ParseInt(ReadText(reg, key, "max").value_or(""), hi))
+    {
+        k.hasRange = true;
+        k.min      = lo;
+        k.max      = hi;
+    }
+    return k;
+}
+
+bool ReadAdapter(const registry_access::Registry& reg, const std::string& classKey, Adapter& out)
+{
+    if (!reg.KeyExists(classKey)) return false;
+
+    out = Adapter{};
+    out.classKey         = classKey;
+    out.description      = reg.ReadString(classKey, "DriverDesc").value_or("");
+    out.matchingDeviceId = Lower(reg.ReadString(classKey, "MatchingDeviceId").value_or(""));
+    out.instanceId       = reg.ReadString(classKey, "DeviceInstanceID").value_or("");
+    out.present          = !out.instanceId.empty() &&
+                           reg.KeyExists("SYSTEM\\CurrentControlSet\\Enum\\" + out.instanceId + "\\Control");
+
+    for (const auto& name : reg.SubKeys(classKey + "\\Ndi\\params"))
+        out.keywords.push_back(ReadKeyword(reg, classKey, name));
+    std::sort(out.keywords.begin(), out.keywords.end(),
+              [](const Keyword& a, const Keyword& b) { return Lower(a.name) < Lower(b.name); });
+    return true;
+}
+
+std::vector<Adapter> ListAdapters(const registry_access::Registry& reg, bool presentOnly)
+{
+    std::vector<Adapter> out;
+    for (const auto& inst : reg.SubKeys(kNetClassKey))
+    {
+        // Skip "Properties", "Configuration"
+        if (inst.size() != 4 || !std::isdigit(static_cast<unsigned char>(inst[0]))) continue;
+
+        Adapter a;
+        if (!ReadAdapter(reg, std::string(kNetClassKey) + "\\" + inst, a)) continue;
+        if (a.matchingDeviceId.rfind("pci\\", 0) != 0 && a.matchingDeviceId.rfind("usb\\", 0) != 0) continue;
+        if (presentOnly && !a.present) continue;
+        out.push_back(std::move(a));
+    }
+    return out;
+}
+
+std::string Label(const Adapter& a)
+{
+    std::size_t slash = a.classKey.rfind('\\');
+    std::string inst  = slash == std::string::npos ? a.classKey : a.classKey.substr(slash + 1);
+    return (a.description.empty() ? std::string("Network adapter") : a.description) + " #" + inst;
+}
+
+// ─── Changes and backup ──────────────────────────────────────────────────────
+
+bool Matches(const Adapter& a, const Values& values)
+{
+    for (const auto& [name, value] : values)
+    {
+        const Keyword* k = a.Find(name);
+        if (!k || k->Effective() != value) return false;
+    }
+    return true;
+}
+
+std::string DefaultBackupPath()
+{
+    return machine_profile::DataDir() + "/nic-backup.txt";
+}
+
+// One line per keyword: class key, keyword, "=value" or "-" for unset
+bool LoadBackups(const std::string& path, BackupSet& out, std::string& error)
+{
+    out.clear();
+    std::ifstream f(path);
+    if (!f) return true;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(f, line))
+    {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::size_t a = line.find('\t');
+        std::size_t b = a == std::string::npos ? a : line.find('\t', a + 1);
+        std::string field = b == std::string::npos ? "" : line.substr(b + 1);
+        if (b == std::string::npos || (field != "-" && (field.empty() || field[0] != '=')))
+        {
+            error = path + ":" + std::to_string(lineNo) + ": malformed backup entry";
+            return false;
+        }
+        std::string classKey = line.substr(0, a);
+        AdapterBackup& backup = out[Lower(classKey)];
+        backup.classKey = classKey;
+        std::optional<std::string> value;
+        if (field != "-") value = field.substr(1);
+        backup.values.emplace_back(line.substr(a + 1, b - a - 1), value);
+    }
+    return true;
+}
+
+bool SaveBackups(const std::string& path, const BackupSet& set, std::string& error)
+{
+    std::ofstream f(path, std::ios::trunc);
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    f << "# class key\tkeyword\t=original value, or - when it was unset\n";
+    for (const auto& [key, backup] : set)
+        for (const auto& [name, value] : backup.values)
+            f << backup.classKey << '\t' << name << '\t' << (value ? "=" + *value : std::string("-")) << '\n';
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool SetValues(registry_access::Registry& reg, const Adapter& a, const Values& values, BackupSet& backups,
+               std::string& error)
+{
+    for (const auto& [name, value] : values)
+    {
+        const Keyword* k = a.Find(name);
+        if (!k)
+        {
+            error = Label(a) + ": no keyword " + name;
+            return false;
+        }
+        if (!k->Allows(value))
+        {
+            error = Label(a) + ": " + name + " does not accept " + value;
+            return false;
+        }
+    }
+
+    AdapterBackup& backup = backups[Lower(a.classKey)];
+    backup.classKey = a.classKey;
+    for (const auto& [name, value] : values)
+    {
+        const Keyword* k = a.Find(name);
+        bool recorded = std::any_of(backup.values.begin(), backup.values.end(),
+                                    [&](const auto& v) { return Lower(v.first) == Lower(k->name); });
+        if (!recorded) backup.values.emplace_back(k->name, k->value);
+
+        if (!reg.WriteString(a.classKey, k->name, value))
+        {
+            error = "cannot write " + a.classKey + "\\" + k->name;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Restore(registry_access::Registry& reg, const std::string& classKey, BackupSet& backups, std::string& error,
+             const std::vector<std::string>& keywords)
+{
+    auto it = backups.find(Lower(classKey));
+    if (it == backups.end()) return true;
+
+    auto selected = [&](const std::string& name) {
+        return keywords.empty() || std::any_of(keywords.begin(), keywords.end(),
+                                               [&](const std::string& k) { return Lower(k) == Lower(name); });
+    };
+    auto& values = it->second.values;
+    for (auto v = values.begin(); v != values.end();)
+    {
+        if (!selected(v->first))
+        {
+            ++v;
+            continue;
+        }
+        bool ok = v->second ? reg.WriteString(it->second.classKey, v->first, *v->second)
+                            : reg.DeleteValue(it->second.classKey, v->first);
+        if (!ok)
+        {
+            error = "cannot write " + it->second.classKey + "\\" + v->first;
+            return false;
+        }
+        v = values.erase(v);
+    }
+    if (values.empty()) backups.erase(it);
+    return true;
+}
+
+bool SetAdapterValues(const std::string& classKey, const Values& values, std::string& error)
+{
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return false;
+
+    Adapter a;
+    if (!ReadAdapter(*reg, classKey, a))
+    {
+        error = classKey + ": no such adapter";
+        return false;
+    }
+    BackupSet backups;
+    std::string path = DefaultBackupPath();
+    if (!LoadBackups(path, backups, error)) return false;
+
+    bool ok = SetValues(*reg, a, values, backups, error);
+    std::string saveError;
+    if (!SaveBackups(path, backups, saveError) && ok)
+    {
+        error = saveError;
+        return false;
+    }
+    return ok;
+}
+
+bool RestoreAdapter(const std::string& classKey, const std::vector<std::string>& keywords, std::string& error)
+{
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return false;
+
+    BackupSet backups;
+    std::string path = DefaultBackupPath();
+    if (!LoadBackups(path, backups, error)) return false;
+    if (!Restore(*reg, classKey, backups, error, keywords)) return false;
+    return SaveBackups(path, backups, error);
+}
+
+} // namespace nic_params
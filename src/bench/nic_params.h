@@ -0,0 +1,101 @@
+#pragma once
+#include "registry_access.h"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// NDIS advanced properties of network adapters.  Each net-class instance
+// describes its keywords under <class key>\Ndi\params\<keyword> (ParamDesc,
+// type, default, min / max or an enum subkey of allowed values) and keeps
+// the values the user changed as REG_SZ in the class key itself; a keyword
+// without a value runs at the driver default.  Adapters read the keywords
+// when they start, so changes apply after a disable / enable or a reboot.
+namespace nic_params {
+
+extern const char* kNetClassKey;   // SYSTEM\CurrentControlSet\Control\Class\{4d36e972-...}
+
+struct Option {
+    std::string value;             // "4"
+    std::string label;             // "4 Queues"
+};
+
+struct Keyword {
+    std::string                name;          // "*NumRssQueues"
+    std::string                description;   // ParamDesc
+    std::string                type;          // enum, int, long, dword, word, edit (lower-case)
+    std::string                defaultValue;
+    std::optional<std::string> value;         // set in the class key; unset = driver default
+    std::vector<Option>        options;       // enum only
+    bool                       hasRange = false;
+    int64_t                    min = 0;
+    int64_t                    max = 0;
+
+    const std::string& Effective() const { return value ? *value : defaultValue; }
+
+    // Enum: one of the options; numeric: an integer within min / max.
+    bool Allows(const std::string& v) const;
+};
+
+struct Adapter {
+    std::string          classKey;           // ...\{4d36e972-...}\0001
+    std::string          description;        // DriverDesc
+    std::string          matchingDeviceId;   // lower-case, e.g. pci\ven_8086&dev_15f3
+    std::string          instanceId;         // DeviceInstanceID
+    bool                 present = false;    // hardware key has the volatile Control subkey
+    std::vector<Keyword> keywords;           // sorted by name
+
+    const Keyword* Find(const std::string& name) const;   // case-insensitive
+};
+
+bool ReadAdapter(const registry_access::Registry& reg, const std::string& classKey, Adapter& out);
+
+// Numbered instances backed by PCI or USB hardware (MatchingDeviceId pci\ or
+// usb\); WAN miniports, VPN and virtual switches are skipped.
+std::vector<Adapter> ListAdapters(const registry_access::Registry& reg, bool presentOnly = true);
+
+// "Intel(R) Ethernet Controller I225-V #0001"
+std::string Label(const Adapter& a);
+
+// ─── Changes and backup ──────────────────────────────────────────────────────
+
+using Values = std::vector<std::pair<std::string, std::string>>;   // keyword, value
+
+// Every value in effect (an unset keyword counts with its default).
+bool Matches(const Adapter& a, const Values& values);
+
+// Keyword values of one adapter as they were before the first change.
+struct AdapterBackup {
+    std::string classKey;
+    std::vector<std::pair<std::string, std::optional<std::string>>> values;   // keyword, original
+};
+
+using BackupSet = std::map<std::string, AdapterBackup>;   // by lower-case class key
+
+// DataDir()/nic-backup.txt
+std::string DefaultBackupPath();
+
+bool LoadBackups(const std::string& path, BackupSet& out, std::string& error);   // missing file = empty set
+bool SaveBackups(const std::string& path, const BackupSet& set, std::string& error);
+
+// Checks every value against the adapter's keyword definitions, then
+// writes them.  The first change of each keyword records its previous value
+// in `backups`; later changes keep that original.
+bool SetValues(registry_access::Registry& reg, const Adapter& a, const Values& values, BackupSet& backups,
+               std::string& error);
+
+// Puts the recorded values back (deleting keywords that were unset) and
+// drops them from `backups`.  `keywords` limits the restore to those names,
+// so tools sharing an adapter undo only their own changes; empty restores
+// everything.  An adapter without a backup is left alone.
+bool Restore(registry_access::Registry& reg, const std::string& classKey, BackupSet& backups, std::string& error,
+             const std::vector<std::string>& keywords = {});
+
+// Live registry plus DefaultBackupPath() in one call, for tweaks and the GUI.
+bool SetAdapterValues(const std::string& classKey, const Values& values, std::string& error);
+bool RestoreAdapter(const std::string& classKey, const std::vector<std::string>& keywords, std::string& error);
+
+} // namespace nic_params
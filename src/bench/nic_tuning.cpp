@@ -0,0 +1,212 @@
+#include "nic_tuning.h"
+
+#include <cctype>
+#include <optional>
+#include <sstream>
+
+namespace nic_tuning {
+
+static std::string Lower(std::string s)
+{
+    for (char& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+const char* PresetName(Preset p)
+{
+    return p == Preset::Latency ? "latency" : "throughput";
+}
+
+bool ParsePreset(const std::string& text, Preset& out)
+{
+    std::string t = Lower(text);
+    if (t == "latency")    { out = Preset::Latency;    return true; }
+    if (t == "throughput") { out = Preset::Throughput; return true; }
+    return false;
+}
+
+// ─── Rules ───────────────────────────────────────────────────────────────────
+
+enum class Intent {
+    Keep,       // leave as is
+    Off,        // the "Disabled" / "Off" option, or 0
+    On,         // the "Enabled" option, or 1
+    Max,        // the last option, or the top of the range
+    Adaptive,   // the option labelled adaptive
+};
+
+struct Rule {
+    const char* keyword;       // standardized name, or nullptr
+    const char* description;   // lower-case ParamDesc fragment for vendor keywords
+    Intent      latency;
+    Intent      throughput;
+};
+
+static const Rule kRules[] = {
+    // Interrupt moderation batches packets per interrupt: fewer DPCs, more delay
+    { "*InterruptModeration", nullptr, Intent::Off, Intent::On },
+    { nullptr, "interrupt moderation rate", Intent::Off, Intent::Adaptive },
+
+    // Link power saving adds wake-up time to the first packet of a burst
+    { "*EEE",              nullptr, Intent::Off, Intent::Keep },
+    { "*SelectiveSuspend", nullptr, Intent::Off, Intent::Keep },
+    { nullptr, "energy efficient",           Intent::Off, Intent::Keep },
+    { nullptr, "advanced eee",               Intent::Off, Intent::Keep },
+    { nullptr, "green ethernet",             Intent::Off, Intent::Keep },
+    { nullptr, "gigalite",                   Intent::Off, Intent::Keep },
+    { nullptr, "power saving mode",          Intent::Off, Intent::Keep },
+    { nullptr, "ultra low power",            Intent::Off, Intent::Keep },
+    { nullptr, "system idle power saver",    Intent::Off, Intent::Keep },
+    { nullptr, "link speed battery saver",   Intent::Off, Intent::Keep },
+    { nullptr, "reduce speed on power down", Intent::Off, Intent::Keep },
+
+    // Pause frames stall the link while the peer drains
+    { "*FlowControl", nullptr, Intent::Off, Intent::Max },
+
+    // Segmentation and receive coalescing trade per-packet delay for CPU
+    { "*LsoV1IPv4",        nullptr, Intent::Off, Intent::On },
+    { "*LsoV2IPv4",        nullptr, Intent::Off, Intent::On },
+    { "*LsoV2IPv6",        nullptr, Intent::Off, Intent::On },
+    { "*UsoIPv4",          nullptr, Intent::Off, Intent::On },
+    { "*UsoIPv6",          nullptr, Intent::Off, Intent::On },
+    { "*RscIPv4",          nullptr, Intent::Off, Intent::On },
+    { "*RscIPv6",          nullptr, Intent::Off, Intent::On },
+    { "*PacketCoalescing", nullptr, Intent::Off, Intent::On },
+
+    // Receive rings drain every interrupt, so a large one costs no delay and
+    // avoids drops without moderation; a large transmit ring only queues.
+    { "*ReceiveBuffers",  nullptr, Intent::Max,  Intent::Max },
+    { "*TransmitBuffers", nullptr, Intent::Keep, Intent::Max },
+};
+
+static const Rule* RuleFor(const nic_params::Keyword& k)
+{
+    std::string name = Lower(k.name);
+    std::string desc = Lower(k.description);
+    for (const auto& r : kRules)
+    {
+        if (r.keyword && Lower(r.keyword) == name) return &r;
+        // Standardized keywords are matched by name only
+        if (!r.keyword && name[0] != '*' && desc.find(r.description) != std::string::npos) return &r;
+    }
+    return nullptr;
+}
+
+static bool IsOff(const std::string& label)
+{
+    std::string l = Lower(label);
+    return l.find("disabl") != std::string::npos || l == "off" || l.rfind("off ", 0) == 0;
+}
+
+static std::optional<std::string> Resolve(const nic_params::Keyword& k, Intent intent)
+{
+    bool isEnum = k.type == "enum";
+    switch (intent) {
+    case Intent::Keep:
+        return std::nullopt;
+    case Intent::Off:
+        for (const auto& o : k.options)
+            if (IsOff(o.label)) return o.value;
+        break;
+    case Intent::On:
+        for (const auto& o : k.options)
+            if (Lower(o.label).find("enabl") != std::string::npos || Lower(o.label) == "on") return o.value;
+        break;
+    case Intent::Max:
+        if (isEnum && !k.options.empty()) return k.options.back().value;
+        if (!isEnum && k.hasRange) return std::to_string(k.max);
+        return std::nullopt;
+    case Intent::Adaptive:
+        for (const auto& o : k.options)
+            if (Lower(o.label).find("adaptive") != std::string::npos) return o.value;
+        return std::nullopt;
+    }
+    // Off / On without a matching label: the 0 / 1 convention, if accepted
+    std::string v = intent == Intent::Off ? "0" : "1";
+    if (k.type != "edit" && k.Allows(v)) return v;
+    return std::nullopt;
+}
+
+static std::string LabelOf(const nic_params::Keyword& k, const std::string& value)
+{
+    for (const auto& o : k.options)
+        if (o.value == value) return o.label;
+    return value;
+}
+
+// ─── Plan ────────────────────────────────────────────────────────────────────
+
+Plan Build(const nic_params::Adapter& a, Preset preset)
+{
+    Plan plan;
+    plan.preset = preset;
+    for (const auto& k : a.keywords)
+    {
+        const Rule* r = RuleFor(k);
+        if (!r) continue;
+        Intent intent = preset == Preset::Latency ? r->latency : r->throughput;
+        if (intent == Intent::Keep) continue;
+
+        auto value = Resolve(k, intent);
+        if (!value)
+        {
+            plan.notes.push_back(k.name + " (" + k.description + "): no matching value offered");
+            continue;
+        }
+        plan.values.emplace_back(k.name, *value);
+        if (k.Effective() != *value)
+            plan.changes.push_back({ k.name, k.description, k.Effective(), *value, LabelOf(k, *value) });
+    }
+    return plan;
+}
+
+std::vector<std::string> Keywords(const nic_params::Adapter& a)
+{
+    std::vector<std::string> out;
+    for (const auto& k : a.keywords)
+        if (RuleFor(k)) out.push_back(k.name);
+    return out;
+}
+
+// ─── Reports ─────────────────────────────────────────────────────────────────
+
+std::string DescribeKeywords(const nic_params::Adapter& a)
+{
+    std::ostringstream os;
+    for (const auto& k : a.keywords)
+    {
+        os << "  " << k.name << "  " << k.description << ": " << LabelOf(k, k.Effective())
+           << (k.value ? "" : " (default)");
+        if (!k.options.empty())
+        {
+            os << "  [";
+            for (std::size_t i = 0; i < k.options.size(); ++i)
+                os << (i ? ", " : "") << k.options[i].value << " " << k.options[i].label;
+            os << "]";
+        }
+        else if (k.hasRange)
+        {
+            os << "  [" << k.min << ".." << k.max << "]";
+        }
+        os << (RuleFor(k) ? "  *\n" : "\n");
+    }
+    return os.str();
+}
+
+std::string Describe(const Plan& p)
+{
+    std::ostringstream os;
+    os << "Preset " << PresetName(p.preset) << ": ";
+    if (p.changes.empty()) os << (p.values.empty() ? "nothing to tune\n" : "in effect\n");
+    else os << p.changes.size() << " change(s)\n";
+    for (const auto& c : p.changes)
+    {
+        os << "  " << c.keyword << "  " << c.description << ": " << c.from << " -> " << c.to;
+        if (c.label != c.to) os << " (" << c.label << ")";
+        os << "\n";
+    }
+    for (const auto& n : p.notes) os << "  note: " << n << "\n";
+    return os.str();
+}
+
+} // namespace nic_tuning
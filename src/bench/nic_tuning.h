@@ -0,0 +1,52 @@
+#pragma once
+#include "nic_params.h"
+
+#include <string>
+#include <vector>
+
+// Latency / throughput presets for NIC advanced properties.  Nothing here
+// is a per-vendor value table: each rule names an intent ("off", "on", the
+// largest allowed value, the adaptive setting) and the value is resolved
+// from the options and ranges the driver publishes in Ndi\params.
+// Standardized keywords (*InterruptModeration, *EEE, *FlowControl, *LsoV2IPv4,
+// *RscIPv4, *ReceiveBuffers, ...) are matched by name; vendor keywords with no
+// standard name (Intel "Interrupt Moderation Rate", Realtek "Green Ethernet",
+// "Advanced EEE", ...) by their ParamDesc.  A keyword the adapter does not
+// expose, or an intent its options cannot express, is skipped with a note.
+//
+// Pure: the same adapter metadata and preset give the same plan.
+namespace nic_tuning {
+
+enum class Preset {
+    Latency,      // interrupt per packet, no coalescing, no link power saving
+    Throughput,   // moderation, offloads and coalescing on, large rings
+};
+
+const char* PresetName(Preset p);
+bool ParsePreset(const std::string& text, Preset& out);   // "latency" / "throughput"
+
+struct Change {
+    std::string keyword;
+    std::string description;   // ParamDesc
+    std::string from;          // effective value now
+    std::string to;
+    std::string label;         // option label of `to`, or `to`
+};
+
+struct Plan {
+    Preset                   preset = Preset::Latency;
+    nic_params::Values       values;    // every target, including those already in effect
+    std::vector<Change>      changes;   // targets not yet in effect
+    std::vector<std::string> notes;     // rules that could not be resolved
+};
+
+Plan Build(const nic_params::Adapter& a, Preset preset);
+
+// Keywords a preset may touch on this adapter (for a selective restore).
+std::vector<std::string> Keywords(const nic_params::Adapter& a);
+
+// Every keyword with its effective value and the allowed values.
+std::string DescribeKeywords(const nic_params::Adapter& a);
+std::string Describe(const Plan& plan);
+
+} // namespace nic_tuning
@@ -0,0 +1,353 @@
+#include "page_fault_bench.h"
+#include "bench_clock.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <cerrno>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef MADV_PAGEOUT
+#define MADV_PAGEOUT 21
+#endif
+#endif
+
+namespace page_fault_bench {
+
+static constexpr uint64_t kPage = 4096;
+
+// ─── Fault counters ──────────────────────────────────────────────────────────
+
+enum class FaultKind { None, Soft, Compressed, Disk };
+
+#ifdef _WIN32
+
+// Leading fields of SYSTEM_PERFORMANCE_INFORMATION (stable since NT 4).
+struct SysPerfPrefix {
+    LARGE_INTEGER IdleProcessTime;
+    LARGE_INTEGER IoReadTransferCount;
+    LARGE_INTEGER IoWriteTransferCount;
+    LARGE_INTEGER IoOtherTransferCount;
+    ULONG IoReadOperationCount;
+    ULONG IoWriteOperationCount;
+    ULONG IoOtherOperationCount;
+    ULONG AvailablePages;
+    ULONG CommittedPages;
+    ULONG CommitLimit;
+    ULONG PeakCommitment;
+    ULONG PageFaultCount;
+    ULONG CopyOnWriteCount;
+    ULONG TransitionCount;
+    ULONG CacheTransitionCount;
+    ULONG DemandZeroCount;
+    ULONG PageReadCount;
+    ULONG PageReadIoCount;
+};
+
+using NtQuerySystemInformationFn = LONG (WINAPI*)(ULONG, PVOID, ULONG, PULONG);
+
+struct Counters {
+    DWORD processFaults = 0;
+    ULONG pageReads     = 0;   // hard faults resolved by a paging read (store or disk)
+    ULONG pageReadIos   = 0;   // paging reads that went to a device
+};
+
+class FaultProbe {
+public:
+    FaultProbe()
+    {
+        m_query = reinterpret_cast<NtQuerySystemInformationFn>(
+            GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation"));
+    }
+
+    bool Available() const { return m_query != nullptr; }
+
+    Counters Snapshot()
+    {
+        Counters c;
+        PROCESS_MEMORY_COUNTERS pmc = {};
+        pmc.cb = sizeof(pmc);
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+            c.processFaults = pmc.PageFaultCount;
+
+        // SystemPerformanceInformation = 2; the struct grows between
+        // releases, so hand the kernel a generous buffer.
+        if (m_query && m_query(2, m_buffer, sizeof(m_buffer), nullptr) >= 0)
+        {
+            const auto* perf = reinterpret_cast<const SysPerfPrefix*>(m_buffer);
+            c.pageReads   = perf->PageReadCount;
+            c.pageReadIos = perf->PageReadIoCount;
+        }
+        return c;
+    }
+
+    // System-wide paging counters: other processes faulting at the same
+    // moment can be misattributed, so run on an otherwise idle machine.
+    static FaultKind Classify(const Counters& a, const Counters& b)
+    {
+        if (b.processFaults == a.processFaults) return FaultKind::None;
+        if (b.pageReadIos != a.pageReadIos)     return FaultKind::Disk;
+        if (b.pageReads != a.pageReads)         return FaultKind::Compressed;
+        return FaultKind::Soft;
+    }
+
+private:
+    NtQuerySystemInformationFn m_query = nullptr;
+    alignas(8) unsigned char   m_buffer[4096] = {};
+};
+
+#else
+
+struct Counters {
+    long     minor = 0;
+    long     major = 0;
+    uint64_t zswpin = 0;   // swap-ins served by zswap (compressed RAM)
+};
+
+class FaultProbe {
+public:
+    FaultProbe()
+    {
+        Counters c;
+        m_hasZswap = ReadZswpin(c.zswpin);
+    }
+
+    bool HasZswapCounters() const { return m_hasZswap; }
+
+    Counters Snapshot()
+    {
+        Counters c;
+        rusage ru{};
+        getrusage(RUSAGE_THREAD, &ru);
+        c.minor = ru.ru_minflt;
+        c.major = ru.ru_majflt;
+        if (m_hasZswap) ReadZswpin(c.zswpin);
+        return c;
+    }
+
+    static FaultKind Classify(const Counters& a, const Counters& b)
+    {
+        if (b.major != a.major) return b.zswpin != a.zswpin ? FaultKind::Compressed : FaultKind::Disk;
+        if (b.minor != a.minor) return FaultKind::Soft;
+        return FaultKind::None;
+    }
+
+private:
+    static bool ReadZswpin(uint64_t& out)
+    {
+        std::ifstream f("/proc/vmstat");
+        std::string key;
+        uint64_t value = 0;
+        while (f >> key >> value)
+            if (key == "zswpin") { out = value; return true; }
+        return false;
+    }
+
+    bool m_hasZswap = false;
+};
+
+#endif
+
+// ─── Platform memory operations ──────────────────────────────────────────────
+
+static unsigned char* Alloc(uint64_t bytes)
+{
+#ifdef _WIN32
+    return static_cast<unsigned char*>(
+        VirtualAlloc(nullptr, static_cast<SIZE_T>(bytes), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return p == MAP_FAILED ? nullptr : static_cast<unsigned char*>(p);
+#endif
+}
+
+static void Free(unsigned char* p, uint64_t bytes)
+{
+    if (!p) return;
+#ifdef _WIN32
+    (void)bytes;
+    VirtualFree(p, 0, MEM_RELEASE);
+#else
+    munmap(p, bytes);
+#endif
+}
+
+// Push the working set out of memory.  Windows: empty the process working
+// set, so pages move to the modified list and on to the compression store or
+// pagefile.  Linux: MADV_PAGEOUT reclaims them to swap / zswap directly.
+static void Trim(unsigned char* region, uint64_t bytes, std::string& note)
+{
+#ifdef _WIN32
+    (void)region;
+    (void)bytes;
+    if (!SetProcessWorkingSetSize(GetCurrentProcess(), static_cast<SIZE_T>(-1), static_cast<SIZE_T>(-1)) &&
+        note.empty())
+        note = "working-set trim failed (error " + std::to_string(GetLastError()) + ")";
+#else
+    if (madvise(region, bytes, MADV_PAGEOUT) != 0 && note.empty())
+        note = errno == EINVAL ? "MADV_PAGEOUT unsupported (kernel < 5.4); relying on --pressure / cgroup limit"
+                               : std::string("MADV_PAGEOUT failed: ") + std::strerror(errno);
+#endif
+}
+
+// Touch (and release) extra memory so the trimmed pages are evicted from the
+// standby list / page cache instead of being soft-faulted straight back.
+static void Balloon(uint64_t bytes)
+{
+    if (!bytes) return;
+    unsigned char* p = Alloc(bytes);
+    if (!p) return;
+    for (uint64_t off = 0; off < bytes; off += kPage) p[off] = 1;
+    Free(p, bytes);
+}
+
+#ifndef _WIN32
+
+// ─── Linux cgroup limit ──────────────────────────────────────────────────────
+
+// Moves the process into a child cgroup with memory.max set; the destructor
+// moves it back and removes the child.  Needs cgroup v2 with the memory
+// controller delegated to the current group (typically root).
+class CgroupLimit {
+public:
+    bool Apply(uint64_t limit, std::string& error)
+    {
+        std::ifstream self("/proc/self/cgroup");
+        std::string line, path;
+        while (std::getline(self, line))
+            if (line.compare(0, 3, "0::") == 0) path = line.substr(3);
+        if (path.empty()) { error = "cgroup v2 not mounted"; return false; }
+
+        m_parent = "/sys/fs/cgroup" + (path == "/" ? std::string() : path);
+        m_child  = m_parent + "/latency-probe-" + std::to_string(getpid());
+        if (mkdir(m_child.c_str(), 0755) != 0)
+        {
+            error = "cannot create " + m_child + ": " + std::strerror(errno);
+            m_child.clear();
+            return false;
+        }
+        if (!WriteFile(m_child + "/memory.max", std::to_string(limit)) ||
+            !WriteFile(m_child + "/cgroup.procs", std::to_string(getpid())))
+        {
+            error = "cannot apply memory.max in " + m_child + " (memory controller not delegated?)";
+            return false;
+        }
+        m_active = true;
+        return true;
+    }
+
+    ~CgroupLimit()
+    {
+        if (m_active) WriteFile(m_parent + "/cgroup.procs", std::to_string(getpid()));
+        if (!m_child.empty()) rmdir(m_child.c_str());
+    }
+
+private:
+    static bool WriteFile(const std::string& path, const std::string& value)
+    {
+        std::ofstream f(path);
+        f << value;
+        f.flush();
+        return f.good();
+    }
+
+    std::string m_parent;
+    std::string m_child;
+    bool        m_active = false;
+};
+
+static bool HasSwap()
+{
+    std::ifstream f("/proc/swaps");
+    std::string line;
+    int lines = 0;
+    while (std::getline(f, line)) ++lines;
+    return lines > 1;   // header only = no swap
+}
+
+#endif
+
+// ─── Benchmark ───────────────────────────────────────────────────────────────
+
+Result Run(const Config& cfg, const std::atomic<bool>* cancel)
+{
+    Result r;
+    const uint64_t bytes = (cfg.workingSetBytes / kPage) * kPage;
+    const uint64_t pages = bytes / kPage;
+    if (pages == 0) { r.error = "working set too small"; return r; }
+
+    FaultProbe probe;
+#ifdef _WIN32
+    if (!probe.Available()) { r.error = "NtQuerySystemInformation unavailable"; return r; }
+#else
+    CgroupLimit cgroup;
+    if (cfg.cgroupLimit)
+    {
+        std::string why;
+        if (!cgroup.Apply(cfg.cgroupLimit, why)) r.note = why;
+    }
+    if (!HasSwap())
+        r.note += (r.note.empty() ? "" : "; ") +
+                  std::string("no swap configured: anonymous pages cannot leave RAM, expect soft faults only");
+    else if (!probe.HasZswapCounters())
+        r.note += (r.note.empty() ? "" : "; ") +
+                  std::string("no zswpin counter: compressed swap-ins are reported as disk");
+#endif
+
+    unsigned char* region = Alloc(bytes);
+    if (!region) { r.error = "cannot allocate working set"; return r; }
+
+    // Half random, half zero per page: roughly the 2:1 ratio the compression
+    // store sees on typical application data.
+    std::mt19937_64 rng(cfg.seed);
+    for (uint64_t p = 0; p < pages; ++p)
+    {
+        auto* words = reinterpret_cast<uint64_t*>(region + p * kPage);
+        for (uint64_t w = 0; w < kPage / 16; ++w) words[w] = rng();
+    }
+
+    for (uint32_t round = 0; round < cfg.rounds; ++round)
+    {
+        if (cancel && cancel->load()) break;
+
+        Trim(region, bytes, r.note);
+        Balloon(cfg.pressureBytes);
+        std::this_thread::sleep_for(std::chrono::milliseconds(cfg.settleMs));
+
+        for (uint32_t s = 0; s < cfg.samples && !(cancel && cancel->load()); ++s)
+        {
+            volatile unsigned char* page = region + (rng() % pages) * kPage;
+
+            Counters before = probe.Snapshot();
+            uint64_t t0 = bench_clock::NowNs();
+            unsigned char v = page[0];
+            uint64_t t1 = bench_clock::NowNs();
+            Counters after = probe.Snapshot();
+            (void)v;
+
+            switch (FaultProbe::Classify(before, after)) {
+                case FaultKind::None:       ++r.resident; break;
+                case FaultKind::Soft:       r.soft.Record(t1 - t0); break;
+                case FaultKind::Compressed: r.compressed.Record(t1 - t0); break;
+                case FaultKind::Disk:       r.disk.Record(t1 - t0); break;
+            }
+        }
+    }
+
+    Free(region, bytes);
+    r.ok = true;
+    return r;
+}
+
+} // namespace page_fault_bench
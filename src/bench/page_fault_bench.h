@@ -0,0 +1,39 @@
+#pragma once
+#include "histogram.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Page-fault service latency under memory pressure.  Fills a working set,
+// pushes it out of memory (working-set trim + optional pressure balloon on
+// Windows, MADV_PAGEOUT and an optional cgroup memory.max on Linux), then
+// touches random pages and times each touch.  Faults are classified from
+// OS counters sampled around every touch, so the DisablePagingExecutive,
+// LargeSystemCache and memory-compression tweaks can be judged by the
+// fault path they actually change.
+namespace page_fault_bench {
+
+struct Config {
+    uint64_t workingSetBytes = 512ULL << 20;
+    uint64_t pressureBytes   = 0;        // extra memory touched after the trim (evicts standby)
+    uint64_t cgroupLimit     = 0;        // Linux: memory.max for a child cgroup (0 = none)
+    uint32_t settleMs        = 2000;     // let the modified writer / compressor catch up
+    uint32_t samples         = 20000;    // random page touches per round
+    uint32_t rounds          = 3;        // trim -> touch cycles
+    uint64_t seed            = 1;
+};
+
+struct Result {
+    bool             ok = false;
+    std::string      error;
+    std::string      note;
+    uint64_t         resident = 0;     // touches that did not fault
+    LatencyHistogram soft;             // standby / modified / swap-cache (no I/O)
+    LatencyHistogram compressed;       // served from the compression store / zswap
+    LatencyHistogram disk;             // paging read from the pagefile / swap device
+};
+
+Result Run(const Config& cfg, const std::atomic<bool>* cancel = nullptr);
+
+} // namespace page_fault_bench
@@ -0,0 +1,50 @@
+#include "period_timer.h"
+#include "bench_clock.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <cerrno>
+#include <time.h>
+#endif
+
+PeriodTimer::PeriodTimer()
+{
+#ifdef _WIN32
+    m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                     TIMER_ALL_ACCESS);
+    if (!m_timer)   // pre-1803: classic timer, bounded by the timer resolution
+        m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+#endif
+}
+
+PeriodTimer::~PeriodTimer()
+{
+#ifdef _WIN32
+    if (m_timer) CloseHandle(m_timer);
+#endif
+}
+
+void PeriodTimer::WaitUntil(uint64_t deadlineNs)
+{
+#ifdef _WIN32
+    uint64_t now = bench_clock::NowNs();
+    if (now >= deadlineNs) return;
+    LARGE_INTEGER due;
+    due.QuadPart = -static_cast<LONGLONG>((deadlineNs - now) / 100);   // relative, 100 ns units
+    if (m_timer && SetWaitableTimer(m_timer, &due, 0, nullptr, nullptr, FALSE))
+        WaitForSingleObject(m_timer, INFINITE);
+    else
+        Sleep(static_cast<DWORD>((deadlineNs - now) / 1000000));
+#else
+    // bench_clock is CLOCK_MONOTONIC, so the deadline is usable directly.
+    timespec ts;
+    ts.tv_sec  = static_cast<time_t>(deadlineNs / 1000000000ULL);
+    ts.tv_nsec = static_cast<long>(deadlineNs % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+#endif
+}
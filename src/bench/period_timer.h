@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+
+// Blocking wait on an OS timer -- never a spin -- so wake-up latency is what
+// a timer- or driver-signalled thread would see.  Windows uses a
+// high-resolution waitable timer (1803+, falling back to a classic one);
+// Linux uses clock_nanosleep(TIMER_ABSTIME) on CLOCK_MONOTONIC.
+class PeriodTimer {
+public:
+    PeriodTimer();
+    ~PeriodTimer();
+
+    PeriodTimer(const PeriodTimer&)            = delete;
+    PeriodTimer& operator=(const PeriodTimer&) = delete;
+
+    // Sleep until `deadlineNs` (bench_clock::NowNs() time base).
+    void WaitUntil(uint64_t deadlineNs);
+
+private:
+#ifdef _WIN32
+    void* m_timer = nullptr;
+#endif
+};
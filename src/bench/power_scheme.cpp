@@ -0,0 +1,627 @@
+#include "power_scheme.h"
+#include "machine_profile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <powrprof.h>
+#endif
+
+namespace power_scheme {
+
+static std::string Lower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+static std::string Trim(const std::string& s)
+{
+    size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return "";
+    size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+static bool ParseU32(const std::string& text, uint32_t& out)
+{
+    if (text.empty()) return false;
+    char* end = nullptr;
+    unsigned long v = std::strtoul(text.c_str(), &end, 0);
+    if (*end != '\0' || v > 0xFFFFFFFFUL) return false;
+    out = static_cast<uint32_t>(v);
+    return true;
+}
+
+// ─── Settings ────────────────────────────────────────────────────────────────
+
+static const char* kSubProcessor = "54533251-82be-4824-96c1-47b60b740d00";
+static const char* kSubPcie      = "501a4d13-42af-4429-9fd1-a8218c268e20";
+static const char* kSubUsb       = "2a737441-1930-4402-8d77-b2bebba308a3";
+
+const std::vector<Setting>& Catalog()
+{
+    static const std::vector<Setting> kCatalog = {
+        // 2 = aggressive: boost whenever the OS asks for more performance
+        { "boost",          kSubProcessor, "be337238-0d82-4146-a960-4f3749d470c7", "Processor boost mode",                 2 },
+        { "minstate",       kSubProcessor, "893dee8e-2bef-41e0-89c6-b55d0929964c", "Minimum processor state (%)",        100 },
+        { "maxstate",       kSubProcessor, "bc5038f7-23e0-4960-96da-33abaf5935ec", "Maximum processor state (%)",        100 },
+        // 0 = maximum performance, 100 = maximum efficiency
+        { "epp",            kSubProcessor, "36687f9e-e3a5-4dbf-b1dc-15eb381c6863", "Energy performance preference",        0 },
+        { "epp1",           kSubProcessor, "36687f9e-e3a5-4dbf-b1dc-15eb381c6864", "Energy performance preference, class 1", 0 },
+        { "idledisable",    kSubProcessor, "5d76a2ca-e8c0-402f-a133-2158492d58ad", "Processor idle disable",               1, true },
+        { "cpmincores",     kSubProcessor, "0cc5b647-c1df-4637-891a-dec35c318583", "Core parking min cores (%)",         100 },
+        { "cpmincores1",    kSubProcessor, "0cc5b647-c1df-4637-891a-dec35c318584", "Core parking min cores, class 1 (%)", 100 },
+        { "cpmaxcores",     kSubProcessor, "ea062031-0e34-4ff1-9b6d-eb1059334028", "Core parking max cores (%)",         100 },
+        { "cpmaxcores1",    kSubProcessor, "ea062031-0e34-4ff1-9b6d-eb1059334029", "Core parking max cores, class 1 (%)", 100 },
+        // Check intervals before a core is unparked / parked
+        { "cpincreasetime", kSubProcessor, "2ddd5a84-5a71-437e-912a-db0b8c788732", "Core parking increase time",           1 },
+        { "cpdecreasetime", kSubProcessor, "dfd10d17-d5eb-45dd-877a-9a34ddd15c82", "Core parking decrease time",         100 },
+        // Applied while a latency-sensitive event (input, app launch) is in flight
+        { "latencyperf",    kSubProcessor, "619b7505-003b-4e82-b7a6-4dd29c300971", "Latency hint min performance (%)",   100 },
+        { "latencyperf1",   kSubProcessor, "619b7505-003b-4e82-b7a6-4dd29c300972", "Latency hint min performance, class 1 (%)", 100 },
+        { "latencyunpark",  kSubProcessor, "616cdaa5-695e-4545-97ad-97dc2d1bdd88", "Latency hint min unparked cores (%)", 100 },
+        { "latencyunpark1", kSubProcessor, "616cdaa5-695e-4545-97ad-97dc2d1bdd89", "Latency hint min unparked cores, class 1 (%)", 100 },
+        // 0 = off, 1 = moderate, 2 = maximum power savings
+        { "aspm",           kSubPcie,      "ee12f906-d277-404b-b6da-e5fa1a576df5", "PCIe link state power management",     0 },
+        // 0 = disabled, 1 = enabled
+        { "usbsuspend",     kSubUsb,       "48e6b7a6-50f5-4782-a5d4-53bb8f07e226", "USB selective suspend",                0 },
+    };
+    return kCatalog;
+}
+
+const Setting* Find(const std::string& key)
+{
+    std::string k = Lower(Trim(key));
+    for (const auto& s : Catalog())
+        if (k == s.key) return &s;
+    return nullptr;
+}
+
+std::string NormalizeGuid(const std::string& text)
+{
+    std::string s = Lower(Trim(text));
+    if (s.size() == 38 && s.front() == '{' && s.back() == '}') s = s.substr(1, 36);
+    if (s.size() != 36) return "";
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+        bool dash = i == 8 || i == 13 || i == 18 || i == 23;
+        if (dash ? s[i] != '-' : !std::isxdigit(static_cast<unsigned char>(s[i]))) return "";
+    }
+    return s;
+}
+
+// ─── Plan ────────────────────────────────────────────────────────────────────
+
+bool Plan(const Options& o, std::vector<Planned>& out, std::string& error)
+{
+    out.clear();
+    for (const auto& [key, value] : o.overrides)
+    {
+        if (!Find(key))
+        {
+            error = "unknown power setting '" + key + "'";
+            return false;
+        }
+    }
+    for (const auto& s : Catalog())
+    {
+        auto it = o.overrides.find(s.key);
+        if (s.optIn && !o.idleDisable && it == o.overrides.end()) continue;
+        out.push_back({ &s, it != o.overrides.end() ? it->second : s.latency });
+    }
+    return true;
+}
+
+bool ParseOverrides(const std::string& text, std::map<std::string, uint32_t>& out, std::string& error)
+{
+    std::istringstream ss(text);
+    for (std::string item; std::getline(ss, item, ',');)
+    {
+        item = Trim(item);
+        if (item.empty()) continue;
+        size_t eq = item.find('=');
+        uint32_t value = 0;
+        const Setting* s = eq == std::string::npos ? nullptr : Find(item.substr(0, eq));
+        if (!s || !ParseU32(Trim(item.substr(eq + 1)), value))
+        {
+            error = "bad power setting '" + item + "' (expected key=value)";
+            return false;
+        }
+        out[s->key] = value;
+    }
+    return true;
+}
+
+// ─── State ───────────────────────────────────────────────────────────────────
+
+std::string DefaultStatePath()
+{
+    return machine_profile::DataDir() + "/power-scheme.txt";
+}
+
+static bool ParseOptional(const std::string& text, std::optional<uint32_t>& out)
+{
+    out.reset();
+    if (text == "-") return true;
+    uint32_t v = 0;
+    if (!ParseU32(text, v)) return false;
+    out = v;
+    return true;
+}
+
+static std::string FormatOptional(const std::optional<uint32_t>& v)
+{
+    return v ? std::to_string(*v) : std::string("-");
+}
+
+// Tab-separated lines: "original <guid>", "scheme <guid>" and
+// "value <scheme> <key> <ac> <dc>" with "-" for a value that was unreadable
+bool LoadState(const std::string& path, State& out, std::string& error)
+{
+    out = State{};
+    std::ifstream f(path);
+    if (!f) return true;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(f, line))
+    {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> fields;
+        std::istringstream ls(line);
+        for (std::string field; std::getline(ls, field, '\t');) fields.push_back(field);
+
+        bool ok = false;
+        if (fields.size() == 2 && (fields[0] == "original" || fields[0] == "scheme"))
+        {
+            std::string guid = NormalizeGuid(fields[1]);
+            ok = !guid.empty();
+            (fields[0] == "original" ? out.original : out.generated) = guid;
+        }
+        else if (fields.size() == 5 && fields[0] == "value")
+        {
+            State::Saved v;
+            v.scheme = NormalizeGuid(fields[1]);
+            v.key    = fields[2];
+            ok = !v.scheme.empty() && Find(v.key) && ParseOptional(fields[3], v.ac) && ParseOptional(fields[4], v.dc);
+            if (ok) out.values.push_back(std::move(v));
+        }
+        if (!ok)
+        {
+            error = path + ":" + std::to_string(lineNo) + ": malformed power scheme entry";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SaveState(const std::string& path, const State& s, std::string& error)
+{
+    std::ofstream f(path, std::ios::trunc);
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    f << "# original <guid> | scheme <guid> | value <scheme> <key> <ac> <dc> (- = unreadable)\n";
+    if (!s.original.empty())  f << "original\t" << s.original << '\n';
+    if (!s.generated.empty()) f << "scheme\t" << s.generated << '\n';
+    for (const auto& v : s.values)
+        f << "value\t" << v.scheme << '\t' << v.key << '\t' << FormatOptional(v.ac) << '\t' << FormatOptional(v.dc) << '\n';
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+// ─── Live system ─────────────────────────────────────────────────────────────
+
+#ifdef _WIN32
+
+static bool ToGuid(const std::string& text, GUID& g)
+{
+    std::string s = NormalizeGuid(text);
+    if (s.empty()) return false;
+    unsigned long d1 = 0;
+    unsigned int  d2 = 0, d3 = 0, b[8] = {};
+    if (std::sscanf(s.c_str(), "%8lx-%4x-%4x-%2x%2x-%2x%2x%2x%2x%2x%2x", &d1, &d2, &d3,
+                    &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &b[6], &b[7]) != 11)
+        return false;
+    g.Data1 = d1;
+    g.Data2 = static_cast<unsigned short>(d2);
+    g.Data3 = static_cast<unsigned short>(d3);
+    for (int i = 0; i < 8; ++i) g.Data4[i] = static_cast<unsigned char>(b[i]);
+    return true;
+}
+
+static std::string FromGuid(const GUID& g)
+{
+    char buf[40];
+    std::snprintf(buf, sizeof(buf), "%08lx-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+                  static_cast<unsigned long>(g.Data1), g.Data2, g.Data3, g.Data4[0], g.Data4[1],
+                  g.Data4[2], g.Data4[3], g.Data4[4], g.Data4[5], g.Data4[6], g.Data4[7]);
+    return buf;
+}
+
+static std::string ApiError(const char* what, DWORD rc)
+{
+    return std::string(what) + " failed: error " + std::to_string(rc);
+}
+
+struct SettingGuids {
+    GUID subgroup, setting;
+};
+
+static SettingGuids GuidsOf(const Setting& s)
+{
+    SettingGuids g{};
+    ToGuid(s.subgroup, g.subgroup);
+    ToGuid(s.guid, g.setting);
+    return g;
+}
+
+static bool ReadValue(const GUID& scheme, const Setting& s, std::optional<uint32_t>& ac, std::optional<uint32_t>& dc)
+{
+    SettingGuids g = GuidsOf(s);
+    DWORD v = 0;
+    ac.reset();
+    dc.reset();
+    if (PowerReadACValueIndex(nullptr, &scheme, &g.subgroup, &g.setting, &v) == ERROR_SUCCESS) ac = v;
+    if (PowerReadDCValueIndex(nullptr, &scheme, &g.subgroup, &g.setting, &v) == ERROR_SUCCESS) dc = v;
+    return ac.has_value();
+}
+
+// ERROR_FILE_NOT_FOUND: the setting does not exist on this system
+static DWORD WriteValue(const GUID& scheme, const Setting& s, uint32_t ac, const std::optional<uint32_t>& dc)
+{
+    SettingGuids g = GuidsOf(s);
+    DWORD rc = PowerWriteACValueIndex(nullptr, &scheme, &g.subgroup, &g.setting, ac);
+    if (rc == ERROR_SUCCESS && dc) rc = PowerWriteDCValueIndex(nullptr, &scheme, &g.subgroup, &g.setting, *dc);
+    return rc;
+}
+
+bool ActiveScheme(std::string& guid, std::string& error)
+{
+    GUID* active = nullptr;
+    DWORD rc = PowerGetActiveScheme(nullptr, &active);
+    if (rc != ERROR_SUCCESS || !active)
+    {
+        error = ApiError("PowerGetActiveScheme", rc);
+        return false;
+    }
+    guid = FromGuid(*active);
+    LocalFree(active);
+    return true;
+}
+
+std::string SchemeName(const std::string& scheme)
+{
+    GUID g{};
+    if (!ToGuid(scheme, g)) return "";
+    DWORD size = 0;
+    if (PowerReadFriendlyName(nullptr, &g, nullptr, nullptr, nullptr, &size) != ERROR_SUCCESS || size == 0) return "";
+    std::wstring name(size / sizeof(wchar_t), L'\0');
+    if (PowerReadFriendlyName(nullptr, &g, nullptr, nullptr, reinterpret_cast<UCHAR*>(&name[0]), &size) != ERROR_SUCCESS)
+        return "";
+    name.resize(wcsnlen(name.c_str(), name.size()));
+    int n = WideCharToMultiByte(CP_UTF8, 0, name.c_str(), static_cast<int>(name.size()), nullptr, 0, nullptr, nullptr);
+    std::string out(static_cast<size_t>(n), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, name.c_str(), static_cast<int>(name.size()), &out[0], n, nullptr, nullptr);
+    return out;
+}
+
+bool ReadScheme(const std::string& scheme, std::vector<Value>& out, std::string& error)
+{
+    out.clear();
+    GUID g{};
+    if (!ToGuid(scheme, g))
+    {
+        error = "bad scheme GUID '" + scheme + "'";
+        return false;
+    }
+    for (const auto& s : Catalog())
+    {
+        Value v;
+        v.setting = &s;
+        ReadValue(g, s, v.ac, v.dc);
+        out.push_back(v);
+    }
+    return true;
+}
+
+static bool Activate(const std::string& scheme, std::string& error)
+{
+    GUID g{};
+    DWORD rc = ToGuid(scheme, g) ? PowerSetActiveScheme(nullptr, &g) : ERROR_INVALID_PARAMETER;
+    if (rc != ERROR_SUCCESS)
+    {
+        error = ApiError("PowerSetActiveScheme", rc);
+        return false;
+    }
+    return true;
+}
+
+bool ApplyValues(const std::vector<Planned>& plan, bool dc, std::string& error)
+{
+    State state;
+    std::string path = DefaultStatePath();
+    if (!LoadState(path, state, error)) return false;
+
+    std::string scheme;
+    if (!ActiveScheme(scheme, error)) return false;
+    GUID g{};
+    ToGuid(scheme, g);
+
+    bool ok = true;
+    for (const auto& p : plan)
+    {
+        bool recorded = std::any_of(state.values.begin(), state.values.end(), [&](const State::Saved& v) {
+            return v.scheme == scheme && v.key == p.setting->key;
+        });
+        State::Saved saved{ scheme, p.setting->key, std::nullopt, std::nullopt };
+        if (!ReadValue(g, *p.setting, saved.ac, saved.dc)) continue;   // not on this system
+
+        DWORD rc = WriteValue(g, *p.setting, p.value, dc ? std::optional<uint32_t>(p.value) : std::nullopt);
+        if (rc != ERROR_SUCCESS)
+        {
+            error = ApiError("PowerWriteACValueIndex", rc) + " (" + p.setting->key + ")";
+            ok = false;
+            continue;
+        }
+        if (!recorded) state.values.push_back(std::move(saved));
+    }
+
+    std::string saveError;
+    if (!SaveState(path, state, saveError) && ok)
+    {
+        error = saveError;
+        ok = false;
+    }
+    std::string activateError;
+    if (!Activate(scheme, activateError) && ok)
+    {
+        error = activateError;
+        ok = false;
+    }
+    return ok;
+}
+
+bool RestoreValues(const std::vector<std::string>& keys, std::string& error)
+{
+    State state;
+    std::string path = DefaultStatePath();
+    if (!LoadState(path, state, error)) return false;
+
+    std::string active, activeError;
+    ActiveScheme(active, activeError);   // unknown: nothing to re-activate
+
+    bool ok = true, touchedActive = false;
+    std::vector<State::Saved> kept;
+    for (auto& v : state.values)
+    {
+        bool wanted = keys.empty() || std::find(keys.begin(), keys.end(), v.key) != keys.end();
+        const Setting* s = Find(v.key);
+        GUID g{};
+        if (!wanted || !s || !v.ac || !ToGuid(v.scheme, g))
+        {
+            if (wanted && s && v.ac) ok = false;
+            kept.push_back(std::move(v));
+            continue;
+        }
+        if (SchemeName(v.scheme).empty()) continue;   // scheme deleted since: nothing to restore
+        DWORD rc = WriteValue(g, *s, *v.ac, v.dc);
+        if (rc != ERROR_SUCCESS)
+        {
+            error = ApiError("PowerWriteACValueIndex", rc) + " (" + v.key + ")";
+            ok = false;
+            kept.push_back(std::move(v));
+            continue;
+        }
+        touchedActive |= v.scheme == active;
+    }
+    state.values = std::move(kept);
+
+    std::string saveError;
+    if (!SaveState(path, state, saveError) && ok)
+    {
+        error = saveError;
+        ok = false;
+    }
+    if (touchedActive && !Activate(active, activeError) && ok)
+    {
+        error = activeError;
+        ok = false;
+    }
+    return ok;
+}
+
+static bool Duplicate(const std::string& source, std::string& out, std::string& error)
+{
+    GUID src{};
+    GUID* dest = nullptr;
+    DWORD rc = ToGuid(source, src) ? PowerDuplicateScheme(nullptr, &src, &dest) : ERROR_INVALID_PARAMETER;
+    if (rc != ERROR_SUCCESS || !dest)
+    {
+        error = ApiError("PowerDuplicateScheme", rc) + " (" + source + ")";
+        return false;
+    }
+    out = FromGuid(*dest);
+    LocalFree(dest);
+    return true;
+}
+
+bool BuildLatencyScheme(const Options& o, BuildResult& out, std::string& error)
+{
+    out = BuildResult{};
+    std::vector<Planned> plan;
+    if (!Plan(o, plan, error)) return false;
+
+    State state;
+    std::string path = DefaultStatePath();
+    if (!LoadState(path, state, error)) return false;
+
+    std::string active;
+    if (!ActiveScheme(active, error)) return false;
+
+    // The scheme to return to: keep the one recorded by an earlier build
+    // while its latency scheme is still the active one.
+    bool haveGenerated = !state.generated.empty() && !SchemeName(state.generated).empty();
+    if (state.original.empty() || !haveGenerated || active != state.generated)
+        state.original = active;
+    out.original = state.original;
+
+    if (haveGenerated)
+    {
+        out.scheme = state.generated;
+        out.base   = "earlier build";
+        out.reused = true;
+    }
+    else
+    {
+        std::string base = o.base.empty() ? state.original : o.base, dupError;
+        if (!Duplicate(base, out.scheme, dupError))
+        {
+            // The Ultimate Performance template is missing on some editions
+            if (base == state.original || !Duplicate(state.original, out.scheme, error))
+            {
+                error = dupError;
+                return false;
+            }
+            base = state.original;
+        }
+        out.base = base;
+    }
+    state.generated = out.scheme;
+
+    GUID g{};
+    ToGuid(out.scheme, g);
+    for (const auto& p : plan)
+    {
+        DWORD rc = WriteValue(g, *p.setting, p.value, o.dc ? std::optional<uint32_t>(p.value) : std::nullopt);
+        if (rc == ERROR_FILE_NOT_FOUND)
+        {
+            out.missing.push_back(p.setting->key);
+            continue;
+        }
+        if (rc != ERROR_SUCCESS)
+        {
+            error = ApiError("PowerWriteACValueIndex", rc) + " (" + p.setting->key + ")";
+            std::string saveError;
+            SaveState(path, state, saveError);   // the scheme exists now: revert must know about it
+            return false;
+        }
+    }
+
+    std::string name = kLatencySchemeName;
+    std::wstring wname(name.begin(), name.end());
+    PowerWriteFriendlyName(nullptr, &g, nullptr, nullptr, reinterpret_cast<UCHAR*>(&wname[0]),
+                           static_cast<DWORD>((wname.size() + 1) * sizeof(wchar_t)));
+
+    if (!SaveState(path, state, error)) return false;
+    return Activate(out.scheme, error);
+}
+
+bool RestoreOriginalScheme(std::string& error)
+{
+    State state;
+    std::string path = DefaultStatePath();
+    if (!LoadState(path, state, error)) return false;
+    if (state.generated.empty()) return true;
+
+    std::string active;
+    if (!ActiveScheme(active, error)) return false;
+
+    // The original may have been deleted meanwhile: Balanced always exists
+    std::string target = !state.original.empty() && !SchemeName(state.original).empty() ? state.original : kBalanced;
+    if (active == state.generated && !Activate(target, error)) return false;
+
+    GUID g{};
+    if (ToGuid(state.generated, g) && !SchemeName(state.generated).empty())
+    {
+        DWORD rc = PowerDeleteScheme(nullptr, &g);
+        if (rc != ERROR_SUCCESS)
+        {
+            error = ApiError("PowerDeleteScheme", rc);
+            return false;
+        }
+    }
+    state.original.clear();
+    state.generated.clear();
+    return SaveState(path, state, error);
+}
+
+bool LatencySchemeActive()
+{
+    State state;
+    std::string error, active;
+    return LoadState(DefaultStatePath(), state, error) && !state.generated.empty() &&
+           ActiveScheme(active, error) && active == state.generated;
+}
+
+#else
+
+static const char* kNeedsWindows = "power schemes need Windows";
+
+bool ActiveScheme(std::string&, std::string& error)                            { error = kNeedsWindows; return false; }
+std::string SchemeName(const std::string&)                                      { return ""; }
+bool ReadScheme(const std::string&, std::vector<Value>&, std::string& error)    { error = kNeedsWindows; return false; }
+bool ApplyValues(const std::vector<Planned>&, bool, std::string& error)         { error = kNeedsWindows; return false; }
+bool RestoreValues(const std::vector<std::string>&, std::string& error)         { error = kNeedsWindows; return false; }
+bool BuildLatencyScheme(const Options&, BuildResult&, std::string& error)       { error = kNeedsWindows; return false; }
+bool RestoreOriginalScheme(std::string& error)                                  { error = kNeedsWindows; return false; }
+bool LatencySchemeActive()                                                      { return false; }
+
+#endif
+
+// ─── Describe ────────────────────────────────────────────────────────────────
+
+std::string Describe(const std::vector<Value>& values, const std::vector<Planned>& plan)
+{
+    std::ostringstream os;
+    char line[160];
+    std::snprintf(line, sizeof(line), "  %-15s %-10s %-10s %-9s %s\n", "setting", "AC", "DC", "latency", "name");
+    os << line;
+    for (const auto& v : values)
+    {
+        auto p = std::find_if(plan.begin(), plan.end(), [&](const Planned& x) { return x.setting == v.setting; });
+        std::string target = p != plan.end() ? std::to_string(p->value) : std::string("-");
+        bool at = p != plan.end() && v.ac && *v.ac == p->value;
+        std::snprintf(line, sizeof(line), "%s %-15s %-10s %-10s %-9s %s\n", at ? "*" : " ", v.setting->key,
+                      v.ac ? std::to_string(*v.ac).c_str() : "missing", FormatOptional(v.dc).c_str(),
+                      target.c_str(), v.setting->name);
+        os << line;
+    }
+    return os.str();
+}
+
+std::string Describe(const BuildResult& r)
+{
+    std::ostringstream os;
+    os << (r.reused ? "Rewrote " : "Built ") << kLatencySchemeName << " " << r.scheme << " (from " << r.base << ")\n";
+    os << "Active now; revert returns to " << r.original;
+    std::string name = SchemeName(r.original);
+    if (!name.empty()) os << " (" << name << ")";
+    os << "\n";
+    if (!r.missing.empty())
+    {
+        os << "Not on this system:";
+        for (const auto& k : r.missing) os << " " << k;
+        os << "\n";
+    }
+    return os.str();
+}
+
+} // namespace power_scheme
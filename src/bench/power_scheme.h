@@ -0,0 +1,146 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Power settings read and written in-process through powrprof
+// (PowerReadACValueIndex / PowerWriteACValueIndex and their DC twins)
+// instead of one powercfg.exe per value.  Two uses:
+//
+//   latency scheme  a dedicated scheme duplicated from the Ultimate
+//                   Performance template (or the active scheme), with every
+//                   setting in Catalog() written in one pass, named and
+//                   activated; the scheme that was active before is recorded
+//                   and restored on revert, and the generated one deleted
+//   single values   settings written into an existing scheme (the active one)
+//                   with their AC and DC originals recorded once, so a revert
+//                   puts back what the user had rather than a guessed default
+//
+// Both record their state in DataDir()/power-scheme.txt.  GUIDs are passed
+// as lower-case text without braces.  Off Windows only the pure parts work:
+// the catalog, the plan and the state file.
+namespace power_scheme {
+
+// ─── Settings ────────────────────────────────────────────────────────────────
+
+// One power setting and the value the latency scheme gives it.
+struct Setting {
+    const char* key;            // short name used on the command line: "boost", "cpmincores"
+    const char* subgroup;       // GUID of the subgroup (processor, PCI Express, USB)
+    const char* guid;           // GUID of the setting
+    const char* name;
+    uint32_t    latency;        // value in the latency scheme
+    bool        optIn = false;  // only planned when asked for (Options::idleDisable)
+};
+
+// Processor boost, minimum / maximum state, EPP, idle disable, core-parking
+// cores and timing, latency-sensitivity hints, PCIe ASPM, USB selective
+// suspend.  The "...1" keys are the second processor class (the efficiency
+// cores of a hybrid CPU); systems without one report them missing.
+const std::vector<Setting>& Catalog();
+
+// nullptr when `key` is not in the catalog (case-insensitive).
+const Setting* Find(const std::string& key);
+
+// "{54533251-82BE-...}" or "54533251-82be-..." to lower case without
+// braces; "" when malformed.
+std::string NormalizeGuid(const std::string& text);
+
+static constexpr const char* kUltimatePerformance = "e9a42b02-d5df-448d-aa00-03f14749eb61";
+static constexpr const char* kHighPerformance     = "8c5e7fda-e8bf-4a96-9a85-a6e23a8c635c";
+static constexpr const char* kBalanced            = "381b4222-f694-41f0-9685-ff5bb260df2e";
+static constexpr const char* kLatencySchemeName   = "LatencyOptimizer Low Latency";
+
+// ─── Plan ────────────────────────────────────────────────────────────────────
+
+struct Planned {
+    const Setting* setting = nullptr;
+    uint32_t       value   = 0;
+};
+
+struct Options {
+    std::string base = kUltimatePerformance;   // scheme to duplicate, "" = the active one
+    bool idleDisable = false;                  // also disable processor idle (C-states); hot and loud
+    bool dc          = true;                   // write the battery (DC) values too
+    std::map<std::string, uint32_t> overrides; // key -> value, replaces the catalog's
+};
+
+// The catalog's values with opt-in settings left out unless asked for and
+// the overrides applied.  `error` names an unknown override key.
+bool Plan(const Options& o, std::vector<Planned>& out, std::string& error);
+
+// "key=value,key=value" into Options::overrides.
+bool ParseOverrides(const std::string& text, std::map<std::string, uint32_t>& out, std::string& error);
+
+// ─── State ───────────────────────────────────────────────────────────────────
+
+struct State {
+    std::string original;    // scheme active before the latency scheme, "" = none recorded
+    std::string generated;   // the latency scheme, "" = none
+
+    // Originals of a value written into an existing scheme.
+    struct Saved {
+        std::string             scheme;
+        std::string             key;
+        std::optional<uint32_t> ac, dc;   // unset = could not be read
+    };
+    std::vector<Saved> values;
+};
+
+// DataDir()/power-scheme.txt
+std::string DefaultStatePath();
+
+bool LoadState(const std::string& path, State& out, std::string& error);   // missing file = empty state
+bool SaveState(const std::string& path, const State& s, std::string& error);
+
+// ─── Live system ─────────────────────────────────────────────────────────────
+
+bool ActiveScheme(std::string& guid, std::string& error);
+
+// Friendly name, "" when the scheme does not exist.
+std::string SchemeName(const std::string& scheme);
+
+struct Value {
+    const Setting*          setting = nullptr;
+    std::optional<uint32_t> ac, dc;   // unset = not present on this system
+};
+
+// Every catalog setting of `scheme`.
+bool ReadScheme(const std::string& scheme, std::vector<Value>& out, std::string& error);
+
+// Writes `plan` into the active scheme, recording each setting's originals
+// in the state file the first time, and re-activates the scheme so the
+// values take effect.
+bool ApplyValues(const std::vector<Planned>& plan, bool dc, std::string& error);
+
+// Puts the recorded originals of `keys` back (every recorded value when
+// empty) and forgets them.  Keys without a record are left alone.
+bool RestoreValues(const std::vector<std::string>& keys, std::string& error);
+
+struct BuildResult {
+    std::string              scheme;     // the latency scheme, now active
+    std::string              base;       // what it was duplicated from
+    std::string              original;   // the scheme to return to
+    bool                     reused = false;   // an earlier latency scheme was rewritten
+    std::vector<std::string> missing;    // keys this system does not have
+};
+
+// Duplicates the base (falling back to the active scheme when the template
+// is not available), or reuses the scheme built last time, writes the plan,
+// names it kLatencySchemeName and activates it.
+bool BuildLatencyScheme(const Options& o, BuildResult& out, std::string& error);
+
+// Activates the recorded original scheme and deletes the latency scheme.
+// Nothing to do (true) when no latency scheme was built.
+bool RestoreOriginalScheme(std::string& error);
+
+// The latency scheme recorded in the state file is the active one.
+bool LatencySchemeActive();
+
+// Table of key, AC, DC and the latency value; `*` marks settings already at it.
+std::string Describe(const std::vector<Value>& values, const std::vector<Planned>& plan);
+std::string Describe(const BuildResult& r);
+
+} // namespace power_scheme
@@ -0,0 +1,510 @@
+#include "registry_access.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+namespace registry_access {
+
+static std::string Lower(std::string s)
+{
+    for (char& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+// Drops a hive prefix and stray separators: "HKEY_LOCAL_MACHINE\A\B\" -> "A\B"
+static std::string NormalizeKey(std::string key)
+{
+    for (const char* hive : { "HKEY_LOCAL_MACHINE\\", "HKLM\\" })
+    {
+        std::size_t n = std::char_traits<char>::length(hive);
+        if (key.size() >= n && Lower(key.substr(0, n)) == Lower(hive)) key.erase(0, n);
+    }
+    while (!key.empty() && key.front() == '\\') key.erase(0, 1);
+    while (!key.empty() && key.back() == '\\') key.pop_back();
+    return key;
+}
+
+// ─── System registry ─────────────────────────────────────────────────────────
+
+#ifdef _WIN32
+
+static std::wstring Wide(const std::string& s)
+{
+    if (s.empty()) return {};
+    int n = MultiByteToWideChar(CP_UTF8, 0, s.c_str(), static_cast<int>(s.size()), nullptr, 0);
+    std::wstring out(static_cast<std::size_t>(n), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, s.c_str(), static_cast<int>(s.size()), &out[0], n);
+    return out;
+}
+
+static std::string Utf8(const std::wstring& w)
+{
+    if (w.empty()) return {};
+    int n = WideCharToMultiByte(CP_UTF8, 0, w.c_str(), static_cast<int>(w.size()), nullptr, 0, nullptr, nullptr);
+    std::string out(static_cast<std::size_t>(n), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, w.c_str(), static_cast<int>(w.size()), &out[0], n, nullptr, nullptr);
+    return out;
+}
+
+class WinRegistry : public Registry {
+public:
+    bool KeyExists(const std::string& key) const override
+    {
+        HKEY h = nullptr;
+        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, Wide(key).c_str(), 0, KEY_READ, &h) != ERROR_SUCCESS) return false;
+        RegCloseKey(h);
+        return true;
+    }
+
+    std::vector<std::string> SubKeys(const std::string& key) const override
+    {
+        std::vector<std::string> out;
+        HKEY h = nullptr;
+        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, Wide(key).c_str(), 0, KEY_READ, &h) != ERROR_SUCCESS) return out;
+        wchar_t name[256];
+        for (DWORD i = 0;; ++i)
+        {
+            DWORD len = 256;
+            if (RegEnumKeyExW(h, i, name, &len, nullptr, nullptr, nullptr, nullptr) != ERROR_SUCCESS) break;
+            out.push_back(Utf8(std::wstring(name, len)));
+        }
+        RegCloseKey(h);
+        return out;
+    }
+
+    std::vector<std::string> ValueNames(const std::string& key) const override
+    {
+        std::vector<std::string> out;
+        HKEY h = nullptr;
+        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, Wide(key).c_str(), 0, KEY_READ, &h) != ERROR_SUCCESS) return out;
+        wchar_t name[16384];
+        for (DWORD i = 0;; ++i)
+        {
+            DWORD len = 16384;
+            if (RegEnumValueW(h, i, name, &len, nullptr, nullptr, nullptr, nullptr) != ERROR_SUCCESS) break;
+            out.push_back(Utf8(std::wstring(name, len)));
+        }
+        RegCloseKey(h);
+        return out;
+    }
+
+    std::optional<uint32_t> ReadDword(const std::string& key, const std::string& name) const override
+    {
+        DWORD data = 0, size = sizeof(data);
+        if (RegGetValueW(HKEY_LOCAL_MACHINE, Wide(key).c_str(), Wide(name).c_str(), RRF_RT_REG_DWORD,
+                         nullptr, &data, &size) != ERROR_SUCCESS)
+            return std::nullopt;
+        return static_cast<uint32_t>(data);
+    }
+
+    std::optional<std::string> ReadString(const std::string& key, const std::string& name) const override
+    {
+        std::wstring k = Wide(key), n = Wide(name);
+        DWORD size = 0;
+        if (RegGetValueW(HKEY_LOCAL_MACHINE, k.c_str(), n.c_str(), RRF_RT_REG_SZ, nullptr, nullptr, &size) != ERROR_SUCCESS)
+            return std::nullopt;
+        std::wstring buf(size / sizeof(wchar_t) + 1, L'\0');
+        if (RegGetValueW(HKEY_LOCAL_MACHINE, k.c_str(), n.c_str(), RRF_RT_REG_SZ, nullptr, &buf[0], &size) != ERROR_SUCCESS)
+            return std::nullopt;
+        buf.resize(wcslen(buf.c_str()));
+        return Utf8(buf);
+    }
+
+    bool WriteDword(const std::string& key, const std::string& name, uint32_t data) override
+    {
+        HKEY h = nullptr;
+        if (RegCreateKeyExW(HKEY_LOCAL_MACHINE, Wide(key).c_str(), 0, nullptr, 0, KEY_SET_VALUE, nullptr,
+                            &h, nullptr) != ERROR_SUCCESS)
+            return false;
+        DWORD v = data;
+        LONG rc = RegSetValueExW(h, Wide(name).c_str(), 0, REG_DWORD, reinterpret_cast<const BYTE*>(&v), sizeof(v));
+        RegCloseKey(h);
+        return rc == ERROR_SUCCESS;
+    }
+
+    bool WriteString(const std::string& key, const std::string& name, const std::string& data) override
+    {
+        HKEY h = nullptr;
+        if (RegCreateKeyExW(HKEY_LOCAL_MACHINE, Wide(key).c_str(), 0, nullptr, 0, KEY_SET_VALUE, nullptr,
+                            &h, nullptr) != ERROR_SUCCESS)
+            return false;
+        std::wstring w = Wide(data);
+        LONG rc = RegSetValueExW(h, Wide(name).c_str(), 0, REG_SZ, reinterpret_cast<const BYTE*>(w.c_str()),
+                                 static_cast<DWORD>((w.size() + 1) * sizeof(wchar_t)));
+        RegCloseKey(h);
+        return rc == ERROR_SUCCESS;
+    }
+
+    bool DeleteValue(const std::string& key, const std::string& name) override
+    {
+        HKEY h = nullptr;
+        LONG rc = RegOpenKeyExW(HKEY_LOCAL_MACHINE, Wide(key).c_str(), 0, KEY_SET_VALUE, &h);
+        if (rc == ERROR_FILE_NOT_FOUND) return true;
+        if (rc != ERROR_SUCCESS) return false;
+        rc = RegDeleteValueW(h, Wide(name).c_str());
+        RegCloseKey(h);
+        return rc == ERROR_SUCCESS || rc == ERROR_FILE_NOT_FOUND;
+    }
+
+    bool DeleteKey(const std::string& key) override
+    {
+        std::wstring k = Wide(key);
+        HKEY h = nullptr;
+        LONG rc = RegOpenKeyExW(HKEY_LOCAL_MACHINE, k.c_str(), 0, KEY_READ, &h);
+        if (rc == ERROR_FILE_NOT_FOUND) return true;
+        if (rc != ERROR_SUCCESS) return false;
+        DWORD subKeys = 0, values = 0;
+        rc = RegQueryInfoKeyW(h, nullptr, nullptr, nullptr, &subKeys, nullptr, nullptr, &values,
+                              nullptr, nullptr, nullptr, nullptr);
+        RegCloseKey(h);
+        if (rc != ERROR_SUCCESS || subKeys != 0 || values != 0) return false;
+        return RegDeleteKeyW(HKEY_LOCAL_MACHINE, k.c_str()) == ERROR_SUCCESS;
+    }
+};
+
+std::unique_ptr<Registry> SystemRegistry(std::string& error)
+{
+    error.clear();
+    return std::make_unique<WinRegistry>();
+}
+
+#else
+
+std::unique_ptr<Registry> SystemRegistry(std::string& error)
+{
+    error = "the system registry is only available on Windows; load a `reg export` file instead";
+    return nullptr;
+}
+
+#endif
+
+// ─── Memory registry ─────────────────────────────────────────────────────────
+
+MemoryRegistry::Key& MemoryRegistry::Ensure(const std::string& key)
+{
+    std::string path = NormalizeKey(key);
+    Key& k = m_keys[Lower(path)];
+    if (k.path.empty()) k.path = path;
+    return k;
+}
+
+void MemoryRegistry::AddKey(const std::string& key)
+{
+    Ensure(key);
+}
+
+bool MemoryRegistry::WriteString(const std::string& key, const std::string& name, const std::string& data)
+{
+    Value& v   = Ensure(key).values[Lower(name)];
+    v.name     = name;
+    v.isString = true;
+    v.text     = data;
+    v.raw.clear();
+    return true;
+}
+
+bool MemoryRegistry::KeyExists(const std::string& key) const
+{
+    std::string k = Lower(NormalizeKey(key));
+    if (m_keys.count(k)) return true;
+    std::string prefix = k + "\\";          // implied by a subkey
+    auto it = m_keys.lower_bound(prefix);
+    return it != m_keys.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+}
+
+std::vector<std::string> MemoryRegistry::SubKeys(const std::string& key) const
+{
+    std::string prefix = Lower(NormalizeKey(key)) + "\\";
+    std::vector<std::string> out;
+    std::set<std::string>    seen;
+    for (auto it = m_keys.lower_bound(prefix); it != m_keys.end(); ++it)
+    {
+        if (it->first.compare(0, prefix.size(), prefix) != 0) break;
+        std::string rest = it->second.path.substr(prefix.size());
+        rest = rest.substr(0, rest.find('\\'));
+        if (seen.insert(Lower(rest)).second) out.push_back(rest);
+    }
+    return out;
+}
+
+std::vector<std::string> MemoryRegistry::ValueNames(const std::string& key) const
+{
+    std::vector<std::string> out;
+    auto k = m_keys.find(Lower(NormalizeKey(key)));
+    if (k != m_keys.end())
+        for (const auto& [lname, v] : k->second.values) out.push_back(v.name);
+    return out;
+}
+
+std::optional<uint32_t> MemoryRegistry::ReadDword(const std::string& key, const std::string& name) const
+{
+    auto k = m_keys.find(Lower(NormalizeKey(key)));
+    if (k == m_keys.end()) return std::nullopt;
+    auto v = k->second.values.find(Lower(name));
+    if (v == k->second.values.end() || v->second.isString || !v->second.raw.empty()) return std::nullopt;
+    return v->second.dword;
+}
+
+std::optional<std::string> MemoryRegistry::ReadString(const std::string& key, const std::string& name) const
+{
+    auto k = m_keys.find(Lower(NormalizeKey(key)));
+    if (k == m_keys.end()) return std::nullopt;
+    auto v = k->second.values.find(Lower(name));
+    if (v == k->second.values.end() || !v->second.isString) return std::nullopt;
+    return v->second.text;
+}
+
+bool MemoryRegistry::WriteDword(const std::string& key, const std::string& name, uint32_t data)
+{
+    Value& v   = Ensure(key).values[Lower(name)];
+    v.name     = name;
+    v.isString = false;
+    v.dword    = data;
+    v.raw.clear();
+    return true;
+}
+
+bool MemoryRegistry::DeleteValue(const std::string& key, const std::string& name)
+{
+    auto k = m_keys.find(Lower(NormalizeKey(key)));
+    if (k != m_keys.end()) k->second.values.erase(Lower(name));
+    return true;
+}
+
+bool MemoryRegistry::DeleteKey(const std::string& key)
+{
+    if (!KeyExists(key)) return true;
+    if (!SubKeys(key).empty()) return false;
+    auto k = m_keys.find(Lower(NormalizeKey(key)));
+    if (k != m_keys.end())
+    {
+        if (!k->second.values.empty()) return false;
+        m_keys.erase(k);
+    }
+    return true;
+}
+
+// UTF-16LE (reg.exe's default) to UTF-8
+static std::string FromUtf16(const std::string& bytes)
+{
+    std::string out;
+    for (std::size_t i = 0; i + 1 < bytes.size(); i += 2)
+    {
+        uint32_t c = static_cast<uint8_t>(bytes[i]) | (static_cast<uint8_t>(bytes[i + 1]) << 8);
+        if (c >= 0xD800 && c < 0xDC00 && i + 3 < bytes.size())
+        {
+            uint32_t lo = static_cast<uint8_t>(bytes[i + 2]) | (static_cast<uint8_t>(bytes[i + 3]) << 8);
+            c = 0x10000 + ((c - 0xD800) << 10) + (lo - 0xDC00);
+            i += 2;
+        }
+        if (c < 0x80)
+            out += static_cast<char>(c);
+        else if (c < 0x800)
+        {
+            out += static_cast<char>(0xC0 | (c >> 6));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000)
+        {
+            out += static_cast<char>(0xE0 | (c >> 12));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            out += static_cast<char>(0xF0 | (c >> 18));
+            out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return out;
+}
+
+// Reads a "quoted" .reg token at `pos`, undoing \\ and \" escapes
+static bool ReadQuoted(const std::string& line, std::size_t& pos, std::string& out)
+{
+    if (pos >= line.size() || line[pos] != '"') return false;
+    out.clear();
+    for (++pos; pos < line.size(); ++pos)
+    {
+        if (line[pos] == '\\' && pos + 1 < line.size()) out += line[++pos];
+        else if (line[pos] == '"') { ++pos; return true; }
+        else out += line[pos];
+    }
+    return false;
+}
+
+static std::string Quote(const std::string& s)
+{
+    std::string out = "\"";
+    for (char c : s)
+    {
+        if (c == '\\' || c == '"') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+bool MemoryRegistry::Parse(const std::string& text, std::string& error)
+{
+    std::istringstream in(text);
+    std::string line, pending;
+    Key*        current = nullptr;
+    int         lineNo  = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        // Binary values continue on the next line after a trailing backslash
+        if (!pending.empty() || (!line.empty() && line.back() == '\\' && line.front() != '['))
+        {
+            pending += pending.empty() ? line : line.substr(std::min(line.find_first_not_of(" \t"), line.size()));
+            if (!pending.empty() && pending.back() == '\\') { pending.pop_back(); continue; }
+            line.swap(pending);
+            pending.clear();
+        }
+
+        std::size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == ';') continue;
+        line.erase(0, start);
+
+        if (line[0] == '[')
+        {
+            std::size_t end = line.rfind(']');
+            if (end == std::string::npos)
+            {
+                error = "line " + std::to_string(lineNo) + ": unterminated key";
+                return false;
+            }
+            // [-key] deletes a key on import; nothing to load
+            current = line[1] == '-' ? nullptr : &Ensure(line.substr(1, end - 1));
+            continue;
+        }
+        if (line[0] != '"' && line[0] != '@') continue;   // "Windows Registry Editor ..." header
+        if (!current)
+        {
+            error = "line " + std::to_string(lineNo) + ": value outside a key";
+            return false;
+        }
+
+        std::string name;
+        std::size_t pos = 0;
+        if (line[0] == '@') pos = 1;
+        else if (!ReadQuoted(line, pos, name))
+        {
+            error = "line " + std::to_string(lineNo) + ": bad value name";
+            return false;
+        }
+        if (pos >= line.size() || line[pos] != '=')
+        {
+            error = "line " + std::to_string(lineNo) + ": expected '='";
+            return false;
+        }
+        ++pos;
+
+        std::string data;
+        if (ReadQuoted(line, pos, data))
+        {
+            WriteString(current->path, name, data);
+        }
+        else if (line.compare(pos, 6, "dword:") == 0)
+        {
+            char* end = nullptr;
+            unsigned long v = std::strtoul(line.c_str() + pos + 6, &end, 16);
+            if (end == line.c_str() + pos + 6)
+            {
+                error = "line " + std::to_string(lineNo) + ": bad dword";
+                return false;
+            }
+            WriteDword(current->path, name, static_cast<uint32_t>(v));
+        }
+        else if (line.compare(pos, 3, "hex") == 0)
+        {
+            // Binary and multi-string data are only carried through to Save
+            Value& v   = current->values[Lower(name)];
+            v.name     = name;
+            v.isString = false;
+            v.raw      = line.substr(pos);
+        }
+    }
+    return true;
+}
+
+std::string MemoryRegistry::Format() const
+{
+    std::string out = "Windows Registry Editor Version 5.00\r\n";
+    for (const auto& [lower, key] : m_keys)
+    {
+        out += "\r\n[HKEY_LOCAL_MACHINE\\" + key.path + "]\r\n";
+        for (const auto& [lname, v] : key.values)
+        {
+            out += v.name.empty() ? "@" : Quote(v.name);
+            if (v.isString)
+                out += "=" + Quote(v.text) + "\r\n";
+            else if (!v.raw.empty())
+                out += "=" + v.raw + "\r\n";
+            else
+            {
+                char buf[32];
+                snprintf(buf, sizeof(buf), "=dword:%08x\r\n", v.dword);
+                out += buf;
+            }
+        }
+    }
+    return out;
+}
+
+bool MemoryRegistry::Load(const std::string& path, std::string& error)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    std::string bytes = ss.str();
+
+    if (bytes.size() >= 2 && static_cast<uint8_t>(bytes[0]) == 0xFF && static_cast<uint8_t>(bytes[1]) == 0xFE)
+        bytes = FromUtf16(bytes.substr(2));
+    else if (bytes.size() >= 3 && bytes.compare(0, 3, "\xEF\xBB\xBF") == 0)
+        bytes.erase(0, 3);
+
+    if (!Parse(bytes, error))
+    {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+bool MemoryRegistry::Save(const std::string& path, std::string& error) const
+{
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    f << Format();
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+} // namespace registry_access
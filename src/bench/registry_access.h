@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Registry access behind an interface, so device managers (interrupt
+// settings, NIC keywords) run against the live HKLM on Windows or against
+// a MemoryRegistry loaded from a `reg export` file on any host.
+namespace registry_access {
+
+// Keys are paths below HKEY_LOCAL_MACHINE, UTF-8, backslash-separated and
+// case-insensitive.
+class Registry {
+public:
+    virtual ~Registry() = default;
+
+    virtual bool KeyExists(const std::string& key) const = 0;
+    virtual std::vector<std::string> SubKeys(const std::string& key) const = 0;
+    virtual std::vector<std::string> ValueNames(const std::string& key) const = 0;
+    virtual std::optional<uint32_t>    ReadDword(const std::string& key, const std::string& name) const = 0;
+    virtual std::optional<std::string> ReadString(const std::string& key, const std::string& name) const = 0;
+
+    virtual bool WriteDword(const std::string& key, const std::string& name, uint32_t data) = 0;  // creates the key
+    virtual bool WriteString(const std::string& key, const std::string& name, const std::string& data) = 0;
+    virtual bool DeleteValue(const std::string& key, const std::string& name) = 0;                // true when absent
+    virtual bool DeleteKey(const std::string& key) = 0;                                           // empty keys only
+};
+
+// HKEY_LOCAL_MACHINE.  Windows only; elsewhere it returns nullptr with an
+// explanatory error.
+std::unique_ptr<Registry> SystemRegistry(std::string& error);
+
+// In-memory stand-in.  Load() takes the .reg text written by `reg export`
+// (UTF-16 or UTF-8; REG_SZ and REG_DWORD values are kept, other types are
+// skipped) with or without the HKEY_LOCAL_MACHINE\ prefix; Save() writes
+// the same format back.
+class MemoryRegistry : public Registry {
+public:
+    bool Load(const std::string& path, std::string& error);
+    bool Save(const std::string& path, std::string& error) const;
+    bool Parse(const std::string& text, std::string& error);
+    std::string Format() const;
+
+    void AddKey(const std::string& key);
+
+    bool KeyExists(const std::string& key) const override;
+    std::vector<std::string> SubKeys(const std::string& key) const override;
+    std::vector<std::string> ValueNames(const std::string& key) const override;
+    std::optional<uint32_t>    ReadDword(const std::string& key, const std::string& name) const override;
+    std::optional<std::string> ReadString(const std::string& key, const std::string& name) const override;
+
+    bool WriteDword(const std::string& key, const std::string& name, uint32_t data) override;
+    bool WriteString(const std::string& key, const std::string& name, const std::string& data) override;
+    bool DeleteValue(const std::string& key, const std::string& name) override;
+    bool DeleteKey(const std::string& key) override;
+
+private:
+    struct Value {
+        std::string name;          // original case
+        bool        isString = false;
+        uint32_t    dword    = 0;
+        std::string text;
+        std::string raw;           // hex / hex(n) data after '=', kept verbatim
+    };
+    struct Key {
+        std::string                  path;     // original case
+        std::map<std::string, Value> values;   // by lower-case name
+    };
+    std::map<std::string, Key> m_keys;         // by lower-case path
+
+    Key& Ensure(const std::string& key);
+};
+
+} // namespace registry_access
@@ -0,0 +1,416 @@
+#include "regression_sentinel.h"
+#include "core_latency.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cctype>
+#endif
+
+namespace regression_sentinel {
+
+// ─── Inventory ───────────────────────────────────────────────────────────────
+
+#ifdef _WIN32
+
+static std::string Utf8(const std::wstring& w)
+{
+    if (w.empty()) return {};
+    int n = WideCharToMultiByte(CP_UTF8, 0, w.c_str(), static_cast<int>(w.size()), nullptr, 0, nullptr, nullptr);
+    std::string out(static_cast<std::size_t>(n), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, w.c_str(), static_cast<int>(w.size()), &out[0], n, nullptr, nullptr);
+    return out;
+}
+
+static std::wstring RegString(HKEY key, const wchar_t* value)
+{
+    wchar_t buf[512] = {};
+    DWORD size = sizeof(buf);
+    if (RegGetValueW(key, nullptr, value, RRF_RT_REG_SZ, nullptr, buf, &size) != ERROR_SUCCESS) return {};
+    return buf;
+}
+
+// Numbered instances (0000, 0001, ...) of a device class backed by real
+// hardware; software adapters (WAN miniports, VPN, Hyper-V) are skipped.
+static void CollectClass(const wchar_t* classGuid, const char* kind, Inventory& out)
+{
+    std::wstring path = std::wstring(L"SYSTEM\\CurrentControlSet\\Control\\Class\\") + classGuid;
+    HKEY cls = nullptr;
+    if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, path.c_str(), 0, KEY_READ, &cls) != ERROR_SUCCESS) return;
+
+    wchar_t name[64];
+    for (DWORD i = 0;; ++i)
+    {
+        DWORD len = 64;
+        if (RegEnumKeyExW(cls, i, name, &len, nullptr, nullptr, nullptr, nullptr) != ERROR_SUCCESS) break;
+        if (len != 4 || !iswdigit(name[0])) continue;   // skip "Properties", "Configuration"
+
+        HKEY inst = nullptr;
+        if (RegOpenKeyExW(cls, name, 0, KEY_READ, &inst) != ERROR_SUCCESS) continue;
+        std::wstring match   = RegString(inst, L"MatchingDeviceId");
+        std::wstring desc    = RegString(inst, L"DriverDesc");
+        std::wstring version = RegString(inst, L"DriverVersion");
+        RegCloseKey(inst);
+
+        for (auto& c : match) c = static_cast<wchar_t>(towlower(c));
+        bool hardware = match.rfind(L"pci\\", 0) == 0 || match.rfind(L"usb\\", 0) == 0;
+        if (!hardware || version.empty()) continue;
+        out.push_back({ kind, Utf8(desc) + " #" + Utf8(name), Utf8(version) });
+    }
+    RegCloseKey(cls);
+}
+
+static Component OsBuild()
+{
+    HKEY key = nullptr;
+    Component c{ "os", "Windows", "" };
+    if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, L"SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion", 0, KEY_READ, &key) !=
+        ERROR_SUCCESS)
+        return c;
+
+    DWORD major = 0, minor = 0, ubr = 0, size = sizeof(DWORD);
+    RegGetValueW(key, nullptr, L"CurrentMajorVersionNumber", RRF_RT_REG_DWORD, nullptr, &major, &size);
+    size = sizeof(DWORD);
+    RegGetValueW(key, nullptr, L"CurrentMinorVersionNumber", RRF_RT_REG_DWORD, nullptr, &minor, &size);
+    size = sizeof(DWORD);
+    RegGetValueW(key, nullptr, L"UBR", RRF_RT_REG_DWORD, nullptr, &ubr, &size);
+    std::string build = Utf8(RegString(key, L"CurrentBuild"));
+    std::string shown = Utf8(RegString(key, L"DisplayVersion"));
+    RegCloseKey(key);
+
+    c.version = std::to_string(major) + "." + std::to_string(minor) + "." + build + "." + std::to_string(ubr);
+    if (!shown.empty()) c.name += " " + shown;
+    return c;
+}
+
+Inventory Collect(const std::string&)
+{
+    Inventory inv;
+    CollectClass(L"{4d36e968-e325-11ce-bfc1-08002be10318}", "gpu", inv);   // Display
+    CollectClass(L"{4d36e972-e325-11ce-bfc1-08002be10318}", "nic", inv);   // Net
+    inv.push_back(OsBuild());
+    return inv;
+}
+
+#else
+
+static std::string ReadLine(const std::string& path)
+{
+    std::ifstream f(path);
+    std::string line;
+    std::getline(f, line);
+    return line;
+}
+
+// "<driver>@<device>" and the module version; in-tree modules without a
+// version file move with the kernel, so they take the kernel release.
+static void CollectDevices(const std::string& root, const std::string& classDir, const char* kind,
+                           bool (*wanted)(const std::string&), const std::string& kernel, Inventory& out)
+{
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    std::vector<std::string> names;
+    for (const auto& e : fs::directory_iterator(root + classDir, ec))
+        names.push_back(e.path().filename().string());
+    std::sort(names.begin(), names.end());
+
+    for (const auto& n : names)
+    {
+        if (!wanted(n)) continue;
+        fs::path dev = fs::path(root + classDir) / n / "device";
+        fs::path driver = fs::read_symlink(dev / "driver", ec);
+        if (ec) continue;                                  // virtual interface / no bound driver
+        fs::path device = fs::read_symlink(dev, ec);
+        std::string module  = driver.filename().string();
+        std::string version = ReadLine(root + "/sys/module/" + module + "/version");
+        out.push_back({ kind, module + "@" + (ec ? n : device.filename().string()),
+                        version.empty() ? kernel : version });
+    }
+}
+
+static bool IsDrmCard(const std::string& n)
+{
+    return n.size() > 4 && n.compare(0, 4, "card") == 0 &&
+           std::all_of(n.begin() + 4, n.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+}
+
+static bool AnyInterface(const std::string&) { return true; }
+
+Inventory Collect(const std::string& sysRoot)
+{
+    Inventory inv;
+    std::string kernel = ReadLine(sysRoot + "/proc/sys/kernel/osrelease");
+    CollectDevices(sysRoot, "/sys/class/drm", "gpu", IsDrmCard, kernel, inv);
+    CollectDevices(sysRoot, "/sys/class/net", "nic", AnyInterface, kernel, inv);
+    inv.push_back({ "os", "Linux", kernel });
+    return inv;
+}
+
+#endif
+
+std::vector<Change> Diff(const Inventory& stored, const Inventory& current)
+{
+    auto key = [](const Component& c) { return c.kind + "|" + c.name; };
+    std::map<std::string, const Component*> before;
+    for (const auto& c : stored) before[key(c)] = &c;
+
+    std::vector<Change> out;
+    for (const auto& c : current)
+    {
+        auto it = before.find(key(c));
+        if (it == before.end())
+            out.push_back({ Component{}, c });
+        else
+        {
+            if (it->second->version != c.version) out.push_back({ *it->second, c });
+            before.erase(it);
+        }
+    }
+    for (const auto& kv : before) out.push_back({ *kv.second, Component{} });
+    return out;
+}
+
+std::string Describe(const Change& c)
+{
+    if (c.before.kind.empty()) return c.after.kind + " added: " + c.after.name + " " + c.after.version;
+    if (c.after.kind.empty())  return c.before.kind + " removed: " + c.before.name + " " + c.before.version;
+    return c.after.kind + " " + c.after.name + ": " + c.before.version + " -> " + c.after.version;
+}
+
+// ─── Profile keys ────────────────────────────────────────────────────────────
+
+static std::vector<std::string> Split(const std::string& v, char sep)
+{
+    std::vector<std::string> out;
+    std::stringstream ss(v);
+    std::string item;
+    while (std::getline(ss, item, sep))
+        if (!item.empty()) out.push_back(item);
+    return out;
+}
+
+Inventory LoadInventory(const machine_profile::Profile& p)
+{
+    Inventory inv;
+    for (const auto& kv : p.extra)
+    {
+        if (kv.first.compare(0, 19, "sentinel.component.") != 0) continue;
+        std::vector<std::string> f = Split(kv.second, '|');
+        if (f.size() == 3) inv.push_back({ f[0], f[1], f[2] });
+    }
+    return inv;
+}
+
+void StoreInventory(machine_profile::Profile& p, const Inventory& inv)
+{
+    for (auto it = p.extra.begin(); it != p.extra.end();)
+        it = it->first.compare(0, 19, "sentinel.component.") == 0 ? p.extra.erase(it) : std::next(it);
+    for (std::size_t i = 0; i < inv.size(); ++i)
+        p.extra["sentinel.component." + std::to_string(i)] = inv[i].kind + "|" + inv[i].name + "|" + inv[i].version;
+    p.extra["sentinel.checked"] = machine_profile::NowIso8601();
+}
+
+std::vector<std::string> LoadAppliedTweaks(const machine_profile::Profile& p)
+{
+    auto it = p.extra.find("sentinel.applied");
+    return it == p.extra.end() ? std::vector<std::string>{} : Split(it->second, '|');
+}
+
+void StoreAppliedTweaks(machine_profile::Profile& p, const std::vector<std::string>& names)
+{
+    std::string joined;
+    for (const auto& n : names) joined += (joined.empty() ? "" : "|") + n;
+    p.extra["sentinel.applied"] = joined;
+}
+
+bool ReapplyAllowed(const machine_profile::Profile& p)
+{
+    auto it = p.extra.find("sentinel.reapply");
+    return it != p.extra.end() && it->second == "on";
+}
+
+void SetReapplyAllowed(machine_profile::Profile& p, bool allowed)
+{
+    p.extra["sentinel.reapply"] = allowed ? "on" : "off";
+}
+
+// ─── Probe suite ─────────────────────────────────────────────────────────────
+
+bool RunSuite(const SuiteConfig& cfg, results_store::Record& out, std::string& error,
+              const std::atomic<bool>* cancel)
+{
+    core_latency::Config cl;
+    cl.durationMs = cfg.coreLatencyMs;
+    core_latency::Result r = core_latency::Run(cl, cancel);
+    if (!r.ok)
+    {
+        error = r.error;
+        return false;
+    }
+
+    out = results_store::Record{};
+    out.probe = "sentinel";
+    LatencyHistogram all;
+    for (const auto& core : r.cores)
+    {
+        all.Merge(core.wakeup);
+        out.histograms.emplace_back("cpu " + std::to_string(core.cpu), core.wakeup);
+    }
+    out.histograms.insert(out.histograms.begin(), std::make_pair(std::string("all cpus"), all));
+    return true;
+}
+
+// ─── Comparison ──────────────────────────────────────────────────────────────
+
+// Expand a histogram into bucket-midpoint samples (us) for the rank test,
+// thinned proportionally to at most `cap` values.
+static std::vector<float> Samples(const LatencyHistogram& h, std::size_t cap = 20000)
+{
+    std::vector<float> out;
+    if (h.Count() == 0) return out;
+    const double keep = std::min(1.0, static_cast<double>(cap) / static_cast<double>(h.Count()));
+    double carry = 0.0;
+    for (std::size_t i = 0; i < h.BucketCount(); ++i)
+    {
+        uint64_t n = h.BucketValue(i);
+        if (!n) continue;
+        carry += n * keep;
+        const float mid = static_cast<float>((LatencyHistogram::BucketLower(i) + LatencyHistogram::BucketUpper(i)) / 2000.0);
+        for (; carry >= 1.0; carry -= 1.0) out.push_back(mid);
+    }
+    return out;
+}
+
+Verdict Compare(const results_store::Record& baseline, const results_store::Record& candidate,
+                double alpha, double minEffect, double tailRatio)
+{
+    Verdict v;
+    for (const auto& c : candidate.histograms)
+    {
+        auto b = std::find_if(baseline.histograms.begin(), baseline.histograms.end(),
+                              [&](const auto& h) { return h.first == c.first; });
+        if (b == baseline.histograms.end() || b->second.Count() == 0 || c.second.Count() == 0) continue;
+        v.compared.push_back(c.first);
+
+        Regression r;
+        r.label      = c.first;
+        r.baseP999Us = b->second.ValueAtPercentile(99.9) / 1000.0;
+        r.nowP999Us  = c.second.ValueAtPercentile(99.9) / 1000.0;
+        r.shift      = stats::MannWhitney(Samples(b->second), Samples(c.second));
+
+        bool shifted = r.shift.pValue < alpha && r.shift.effect >= minEffect;
+        bool tail    = r.nowP999Us >= r.baseP999Us * tailRatio && r.nowP999Us - r.baseP999Us >= 50.0;
+        if (shifted || tail) v.regressions.push_back(r);
+    }
+    return v;
+}
+
+// ─── Sentinel pass ───────────────────────────────────────────────────────────
+
+static std::string Alert(const std::vector<Change>& changes, const Verdict& v,
+                         const std::vector<std::string>& dropped)
+{
+    std::ostringstream out;
+    if (changes.empty())
+        out << "REGRESSION against the stored baseline\n";
+    else
+        out << (v.Regressed() ? "REGRESSION after a driver / OS change" : "Driver / OS change detected") << "\n";
+    for (const auto& c : changes) out << "  " << Describe(c) << "\n";
+
+    if (v.compared.empty())
+        out << "No baseline to compare against; this run is the new baseline.\n";
+    else if (!v.Regressed())
+        out << "Probe suite matches the baseline (" << v.compared.size() << " series).\n";
+    char line[160];
+    for (const auto& r : v.regressions)
+    {
+        std::snprintf(line, sizeof(line), "  %-10s p99.9 %.1f -> %.1f us  (effect %+.2f, p=%.3g)\n",
+                      r.label.c_str(), r.baseP999Us, r.nowP999Us, r.shift.effect, r.shift.pValue);
+        out << line;
+    }
+    if (!dropped.empty())
+    {
+        out << "Tweaks no longer applied:\n";
+        for (const auto& d : dropped) out << "  " << d << "\n";
+    }
+    return out.str();
+}
+
+Outcome Check(const Options& opt, const std::atomic<bool>* cancel)
+{
+    Outcome o;
+    const std::string profilePath = opt.profilePath.empty() ? machine_profile::DefaultPath() : opt.profilePath;
+    machine_profile::Profile profile;
+    std::string ignored;
+    if (!machine_profile::Load(profilePath, profile, ignored)) profile = machine_profile::Current();
+    machine_profile::Profile now = machine_profile::Current();
+    profile.fingerprint = now.fingerprint;
+    profile.hostName    = now.hostName;
+    profile.cpuName     = now.cpuName;
+    profile.logicalCpus = now.logicalCpus;
+
+    const Inventory stored  = LoadInventory(profile);
+    const Inventory current = Collect();
+    o.firstCheck     = stored.empty();
+    o.changes        = o.firstCheck ? std::vector<Change>{} : Diff(stored, current);
+    o.reapplyAllowed = ReapplyAllowed(profile);
+
+    if (opt.trackTweaks && !o.changes.empty())
+        for (const auto& name : LoadAppliedTweaks(profile))
+            if (std::find(opt.appliedTweaks.begin(), opt.appliedTweaks.end(), name) == opt.appliedTweaks.end())
+                o.droppedTweaks.push_back(name);
+
+    if (o.firstCheck || !o.changes.empty() || opt.force)
+    {
+        results_store::Store store;
+        if (!store.Open(opt.storeDir.empty() ? results_store::DefaultDirectory() : opt.storeDir, o.error))
+            return o;
+
+        results_store::Record run;
+        if (!RunSuite(opt.suite, run, o.error, cancel)) return o;
+        o.ranSuite = true;
+        run.fingerprint = profile.fingerprint;
+        run.tweaks      = opt.appliedTweaks;
+        for (const auto& c : current) run.tags.push_back(c.kind + ":" + c.name + "=" + c.version);
+
+        // Last good reference on this machine.
+        results_store::Query q;
+        q.probe       = "sentinel";
+        q.fingerprint = profile.fingerprint;
+        q.tags        = { "baseline" };
+        std::vector<results_store::Point> base = store.Find(q);
+        results_store::Record reference;
+        if (!base.empty() && store.Read(base.back().offset, reference, ignored))
+            o.verdict = Compare(reference, run);
+
+        o.baselineCreated = !o.verdict.Regressed();
+        run.tags.push_back(o.baselineCreated ? "baseline" : "regressed");
+        if (!o.changes.empty()) run.tags.push_back("after-change");
+        if (!store.Append(run, o.error)) return o;
+    }
+
+    // Report each change once; keep the pre-change tweak list while tweaks
+    // are missing so the caller can still re-apply them.
+    StoreInventory(profile, current);
+    if (opt.trackTweaks && o.droppedTweaks.empty()) StoreAppliedTweaks(profile, opt.appliedTweaks);
+    if (!machine_profile::Save(profilePath, profile))
+    {
+        o.error = "cannot write " + profilePath;
+        return o;
+    }
+
+    if (!o.changes.empty() || o.verdict.Regressed())
+        o.alert = Alert(o.changes, o.verdict, o.droppedTweaks);
+    o.ok = true;
+    return o;
+}
+
+} // namespace regression_sentinel
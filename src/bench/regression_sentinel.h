@@ -0,0 +1,109 @@
+#pragma once
+#include "machine_profile.h"
+#include "results_store.h"
+#include "stats.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Driver / OS update regression sentinel.  Keeps an inventory of the GPU
+// and NIC driver versions plus the OS build in the machine profile.  When
+// the inventory changes, it re-runs a short probe suite and compares it
+// against the last good baseline in the results store.  The caller gets the
+// changed components, the regressed metrics and the tweaks that were active
+// before the update but are not any more (driver packages routinely rewrite
+// their class keys).
+namespace regression_sentinel {
+
+struct Component {
+    std::string kind;      // "gpu", "nic" or "os"
+    std::string name;      // DriverDesc / driver@device / OS name
+    std::string version;   // DriverVersion / module version / build
+};
+
+using Inventory = std::vector<Component>;
+
+// Windows: every display- and net-class instance backed by real hardware
+// (MatchingDeviceId pci\ or usb\) with its DriverVersion, plus the build
+// from CurrentVersion (CurrentBuild.UBR).  Linux: DRM cards and physical
+// network interfaces with their driver module version, plus the kernel
+// release.  `sysRoot` prefixes /sys and /proc (Linux) so a captured tree can
+// be inspected.
+Inventory Collect(const std::string& sysRoot = "");
+
+// `before` is empty for an added component, `after` for a removed one.
+struct Change {
+    Component before;
+    Component after;
+};
+
+std::vector<Change> Diff(const Inventory& stored, const Inventory& current);
+std::string         Describe(const Change& change);
+
+// Inventory, tweak list and policy live in the machine profile ("sentinel.*").
+Inventory                LoadInventory(const machine_profile::Profile& p);
+void                     StoreInventory(machine_profile::Profile& p, const Inventory& inv);
+std::vector<std::string> LoadAppliedTweaks(const machine_profile::Profile& p);
+void                     StoreAppliedTweaks(machine_profile::Profile& p, const std::vector<std::string>& names);
+bool                     ReapplyAllowed(const machine_profile::Profile& p);   // "sentinel.reapply=on"
+void                     SetReapplyAllowed(machine_profile::Profile& p, bool allowed);
+
+// Short probe suite: per-core wake-up latency, which is where ISR/DPC
+// regressions in GPU and NIC drivers show up.  Produces a results-store
+// record (probe "sentinel", one histogram per CPU plus "all cpus").
+struct SuiteConfig {
+    uint32_t coreLatencyMs = 5000;
+};
+
+bool RunSuite(const SuiteConfig& cfg, results_store::Record& out, std::string& error,
+              const std::atomic<bool>* cancel = nullptr);
+
+struct Regression {
+    std::string      label;
+    double           baseP999Us = 0.0;
+    double           nowP999Us  = 0.0;
+    stats::ShiftTest shift;
+};
+
+struct Verdict {
+    std::vector<std::string> compared;      // labels present in both runs
+    std::vector<Regression>  regressions;
+    bool Regressed() const { return !regressions.empty(); }
+};
+
+// A label regresses when its distribution shifts up (Mann-Whitney significant
+// at `alpha` with effect >= `minEffect`) or its p99.9 grows by `tailRatio`
+// and at least 50 us.
+Verdict Compare(const results_store::Record& baseline, const results_store::Record& candidate,
+                double alpha = 0.01, double minEffect = 0.1, double tailRatio = 1.5);
+
+struct Options {
+    SuiteConfig              suite;
+    std::string              storeDir;          // empty = results_store::DefaultDirectory()
+    std::string              profilePath;       // empty = machine_profile::DefaultPath()
+    bool                     force = false;     // run the suite even without a change
+    bool                     trackTweaks = false;
+    std::vector<std::string> appliedTweaks;     // currently active (when trackTweaks)
+};
+
+struct Outcome {
+    bool                     ok = false;
+    std::string              error;
+    bool                     firstCheck = false;       // no stored inventory yet
+    bool                     baselineCreated = false;
+    bool                     ranSuite = false;
+    std::vector<Change>      changes;
+    Verdict                  verdict;
+    std::vector<std::string> droppedTweaks;     // active before the change, inactive now
+    bool                     reapplyAllowed = false;
+    std::string              alert;             // empty when there is nothing to report
+};
+
+// One sentinel pass: collect, diff, run and compare if needed, record the
+// run (tagged "baseline" when it becomes the new reference), and update the
+// stored inventory so each change is reported once.
+Outcome Check(const Options& opt, const std::atomic<bool>* cancel = nullptr);
+
+} // namespace regression_sentinel
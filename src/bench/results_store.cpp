@@ -0,0 +1,737 @@
+#include "results_store.h"
+#include "machine_profile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace results_store {
+
+static_assert(sizeof(Store::IndexEntry) == 128, "results.idx entries are 128 bytes");
+
+// ─── File layout ─────────────────────────────────────────────────────────────
+// results.log: 16-byte header, then records of
+//     u32 magic, u32 payload bytes, u32 payload CRC, u32 CRC of those 12 bytes
+//     payload, zero-padded to 8 bytes
+// results.idx: 16-byte header, then IndexEntry[] (CRC over the first 124 bytes).
+
+static const char     kLogMagic[8]   = { 'L', 'O', 'R', 'S', 'L', 'O', 'G', '1' };
+static const char     kIndexMagic[8] = { 'L', 'O', 'R', 'S', 'I', 'D', 'X', '1' };
+static constexpr uint32_t kFileHeader  = 16;
+static constexpr uint32_t kRecordMagic = 0x31434552;   // "REC1"
+static constexpr uint32_t kRecordHead  = 16;
+static constexpr uint32_t kMaxPayload  = 64u << 20;
+
+static uint64_t Pad8(uint64_t n) { return (n + 7) & ~uint64_t{7}; }
+
+// ─── Checksums and hashes ────────────────────────────────────────────────────
+
+// CRC-32 (IEEE 802.3, reflected), table built on first use.
+static uint32_t Crc32(const void* data, std::size_t size)
+{
+    static const auto table = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// FNV-1a, 64 bit.
+static uint64_t Hash(const std::string& s)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : s) { h ^= c; h *= 0x100000001b3ULL; }
+    return h;
+}
+
+// Two bits of a 64-bit Bloom mask per tag ("t:") or tweak ("w:").
+static uint64_t BloomBits(const std::string& kind, const std::string& value)
+{
+    uint64_t h = Hash(kind + value);
+    return (uint64_t{1} << (h & 63)) | (uint64_t{1} << ((h >> 6) & 63));
+}
+
+static uint64_t BloomOf(const std::vector<std::string>& tags, const std::vector<std::string>& tweaks)
+{
+    uint64_t mask = 0;
+    for (const auto& t : tags)   mask |= BloomBits("t:", t);
+    for (const auto& w : tweaks) mask |= BloomBits("w:", w);
+    return mask;
+}
+
+// ─── Record encoding ─────────────────────────────────────────────────────────
+
+template <typename T>
+static void Put(std::string& out, T v)
+{
+    char raw[sizeof(T)];
+    std::memcpy(raw, &v, sizeof(T));
+    out.append(raw, sizeof(T));
+}
+
+static void PutString(std::string& out, const std::string& s)
+{
+    Put(out, static_cast<uint32_t>(s.size()));
+    out += s;
+}
+
+static void PutList(std::string& out, const std::vector<std::string>& list)
+{
+    Put(out, static_cast<uint32_t>(list.size()));
+    for (const auto& s : list) PutString(out, s);
+}
+
+static std::string Encode(const Record& r)
+{
+    std::string out;
+    Put(out, r.timestamp);
+    PutString(out, r.fingerprint);
+    PutString(out, r.probe);
+    PutList(out, r.tweaks);
+    PutList(out, r.tags);
+    Put(out, static_cast<uint32_t>(r.histograms.size()));
+    for (const auto& h : r.histograms)
+    {
+        PutString(out, h.first);
+        h.second.Serialize(out);
+    }
+    return out;
+}
+
+class Decoder {
+public:
+    Decoder(const char* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    bool Get(T& v)
+    {
+        if (m_size - m_pos < sizeof(T)) return false;
+        std::memcpy(&v, m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool GetString(std::string& s)
+    {
+        uint32_t n = 0;
+        if (!Get(n) || m_size - m_pos < n) return false;
+        s.assign(m_data + m_pos, n);
+        m_pos += n;
+        return true;
+    }
+
+    bool GetList(std::vector<std::string>& list)
+    {
+        uint32_t n = 0;
+        if (!Get(n) || n > m_size - m_pos) return false;
+        list.resize(n);
+        for (auto& s : list)
+            if (!GetString(s)) return false;
+        return true;
+    }
+
+    bool GetHistogram(LatencyHistogram& h)
+    {
+        std::size_t used = 0;
+        if (!h.Deserialize(m_data + m_pos, m_size - m_pos, used)) return false;
+        m_pos += used;
+        return true;
+    }
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+    std::size_t m_pos = 0;
+};
+
+static bool Decode(const char* data, std::size_t size, Record& r)
+{
+    Decoder d(data, size);
+    uint32_t histograms = 0;
+    if (!d.Get(r.timestamp) || !d.GetString(r.fingerprint) || !d.GetString(r.probe) ||
+        !d.GetList(r.tweaks) || !d.GetList(r.tags) || !d.Get(histograms) || histograms > size)
+        return false;
+
+    r.histograms.resize(histograms);
+    for (auto& h : r.histograms)
+        if (!d.GetString(h.first) || !d.GetHistogram(h.second)) return false;
+    return true;
+}
+
+// Header + payload + padding, ready to write.
+static std::string Frame(const std::string& payload)
+{
+    std::string out;
+    Put(out, kRecordMagic);
+    Put(out, static_cast<uint32_t>(payload.size()));
+    Put(out, Crc32(payload.data(), payload.size()));
+    Put(out, Crc32(out.data(), 12));
+    out += payload;
+    out.resize(static_cast<std::size_t>(kRecordHead + Pad8(payload.size())), '\0');
+    return out;
+}
+
+// Length of the valid record at `pos`, or 0 if it is torn / corrupt.
+static uint64_t ValidRecordAt(const char* base, uint64_t size, uint64_t pos)
+{
+    if (size - pos < kRecordHead) return 0;
+    uint32_t head[4];
+    std::memcpy(head, base + pos, sizeof(head));
+    if (head[0] != kRecordMagic || head[3] != Crc32(base + pos, 12) || head[1] > kMaxPayload) return 0;
+
+    uint64_t length = kRecordHead + Pad8(head[1]);
+    if (size - pos < length) return 0;
+    if (Crc32(base + pos + kRecordHead, head[1]) != head[2]) return 0;
+    return length;
+}
+
+// ─── Index entries ───────────────────────────────────────────────────────────
+
+static void CopyField(char* dst, std::size_t size, const std::string& s)
+{
+    std::memset(dst, 0, size);
+    std::memcpy(dst, s.data(), std::min(s.size(), size - 1));
+}
+
+static std::string Field(const char* src, std::size_t size)
+{
+    return std::string(src, strnlen(src, size));
+}
+
+static void Seal(Store::IndexEntry& e)
+{
+    e.crc = Crc32(&e, offsetof(Store::IndexEntry, crc));
+}
+
+static bool Sealed(const Store::IndexEntry& e)
+{
+    return e.crc == Crc32(&e, offsetof(Store::IndexEntry, crc));
+}
+
+static std::vector<Store::IndexEntry> EntriesFor(const Record& r, uint64_t offset)
+{
+    Store::IndexEntry base;
+    std::memset(&base, 0, sizeof(base));
+    base.offset          = offset;
+    base.timestamp       = r.timestamp;
+    base.tagBloom        = BloomOf(r.tags, r.tweaks);
+    base.fingerprintHash = static_cast<uint32_t>(Hash(r.fingerprint));
+    base.histogramCount  = static_cast<uint16_t>(r.histograms.size());
+    CopyField(base.probe, sizeof(base.probe), r.probe);
+
+    std::vector<Store::IndexEntry> out;
+    if (r.histograms.empty())
+    {
+        Seal(base);
+        out.push_back(base);
+        return out;
+    }
+
+    auto us = [](uint64_t ns) { return static_cast<float>(ns / 1000.0); };
+    for (std::size_t i = 0; i < r.histograms.size(); ++i)
+    {
+        const LatencyHistogram& h = r.histograms[i].second;
+        Store::IndexEntry e = base;
+        e.histogramIndex = static_cast<uint16_t>(i);
+        e.count          = h.Count();
+        e.p50Us          = us(h.ValueAtPercentile(50.0));
+        e.p99Us          = us(h.ValueAtPercentile(99.0));
+        e.p999Us         = us(h.ValueAtPercentile(99.9));
+        e.maxUs          = us(h.Max());
+        CopyField(e.label, sizeof(e.label), r.histograms[i].first);
+        Seal(e);
+        out.push_back(e);
+    }
+    return out;
+}
+
+// ─── Platform file access ────────────────────────────────────────────────────
+
+#ifdef _WIN32
+
+static HANDLE AsHandle(void* h) { return static_cast<HANDLE>(h); }
+
+static uint64_t FileSize(void* h)
+{
+    LARGE_INTEGER size{};
+    return GetFileSizeEx(AsHandle(h), &size) ? static_cast<uint64_t>(size.QuadPart) : 0;
+}
+
+static bool WriteAt(void* h, const std::string& data, uint64_t offset)
+{
+    OVERLAPPED ov = {};
+    ov.Offset     = static_cast<DWORD>(offset);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD done = 0;
+    return WriteFile(AsHandle(h), data.data(), static_cast<DWORD>(data.size()), &done, &ov) &&
+           done == data.size();
+}
+
+static bool Sync(void* h) { return FlushFileBuffers(AsHandle(h)) != 0; }
+
+static bool Truncate(void* h, uint64_t size)
+{
+    LARGE_INTEGER pos{};
+    pos.QuadPart = static_cast<LONGLONG>(size);
+    return SetFilePointerEx(AsHandle(h), pos, nullptr, FILE_BEGIN) && SetEndOfFile(AsHandle(h));
+}
+
+// Windows byte-range locks are mandatory, so lock one byte far past any data
+// instead of the records themselves; readers are never blocked.
+class FileLock {
+public:
+    explicit FileLock(void* h) : m_handle(AsHandle(h))
+    {
+        OVERLAPPED ov = {};
+        ov.OffsetHigh = 0x7FFFFFFF;
+        m_locked = LockFileEx(m_handle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &ov) != 0;
+    }
+    ~FileLock()
+    {
+        if (!m_locked) return;
+        OVERLAPPED ov = {};
+        ov.OffsetHigh = 0x7FFFFFFF;
+        UnlockFileEx(m_handle, 0, 1, 0, &ov);
+    }
+
+private:
+    HANDLE m_handle;
+    bool   m_locked = false;
+};
+
+#else
+
+static uint64_t FileSize(int fd)
+{
+    struct stat st{};
+    return fstat(fd, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+}
+
+static bool WriteAt(int fd, const std::string& data, uint64_t offset)
+{
+    return pwrite(fd, data.data(), data.size(), static_cast<off_t>(offset)) == static_cast<ssize_t>(data.size());
+}
+
+static bool Sync(int fd) { return fdatasync(fd) == 0; }
+
+static bool Truncate(int fd, uint64_t size) { return ftruncate(fd, static_cast<off_t>(size)) == 0; }
+
+class FileLock {
+public:
+    explicit FileLock(int fd) : m_fd(fd) { m_locked = flock(m_fd, LOCK_EX) == 0; }
+    ~FileLock()
+    {
+        if (m_locked) flock(m_fd, LOCK_UN);
+    }
+
+private:
+    int  m_fd;
+    bool m_locked = false;
+};
+
+#endif
+
+// ─── Store ───────────────────────────────────────────────────────────────────
+
+Store::~Store()
+{
+    Close();
+}
+
+bool Store::Open(const std::string& directory, std::string& error)
+{
+    Close();
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    const char* sep = (!directory.empty() && (directory.back() == '/' || directory.back() == '\\')) ? "" : "/";
+    m_logPath   = directory + sep + "results.log";
+    m_indexPath = directory + sep + "results.idx";
+
+#ifdef _WIN32
+    HANDLE h = CreateFileA(m_logPath.c_str(), GENERIC_READ | GENERIC_WRITE,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+    {
+        error = "cannot open " + m_logPath + " (error " + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+    m_log = h;
+#else
+    m_log = open(m_logPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (m_log < 0)
+    {
+        error = "cannot open " + m_logPath + ": " + std::strerror(errno);
+        return false;
+    }
+#endif
+
+    FileLock lock(m_log);
+    if (!Load(error))
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void Store::Close()
+{
+    m_view.Close();
+    m_viewStale = true;
+#ifdef _WIN32
+    if (m_log) CloseHandle(AsHandle(m_log));
+    m_log = nullptr;
+#else
+    if (m_log >= 0) close(m_log);
+    m_log = -1;
+#endif
+    m_index.clear();
+    m_logEnd = m_idxEnd = 0;
+    m_runs   = 0;
+    m_note.clear();
+}
+
+bool Store::Refresh(std::string& error)
+{
+    FileLock lock(m_log);
+    return Load(error);
+}
+
+const MappedFile& Store::LogView() const
+{
+    if (m_viewStale)
+    {
+        m_view.Open(m_logPath);
+        m_viewStale = false;
+    }
+    return m_view;
+}
+
+// Called with the append lock held: validate the log, cut off a torn tail,
+// then bring the index up to date with it.
+bool Store::Load(std::string& error)
+{
+    uint64_t size = FileSize(m_log);
+    if (size < kFileHeader)
+    {
+        std::string header(kLogMagic, sizeof(kLogMagic));
+        header.resize(kFileHeader, '\0');
+        if (!Truncate(m_log, 0) || !WriteAt(m_log, header, 0) || !Sync(m_log))
+        {
+            error = "cannot initialise " + m_logPath;
+            return false;
+        }
+        size = kFileHeader;
+    }
+
+    m_viewStale = true;
+    const MappedFile& view = LogView();
+    if (!view.Data() || view.Size() < kFileHeader || std::memcmp(view.Data(), kLogMagic, sizeof(kLogMagic)) != 0)
+    {
+        error = m_logPath + " is not a results log";
+        return false;
+    }
+
+    // A bad record followed by good ones is bit rot: skip it.  A bad record
+    // with nothing valid after it is a torn append: cut it off.
+    std::vector<uint64_t> offsets;
+    uint64_t pos = kFileHeader;
+    std::size_t skipped = 0;
+    while (pos < view.Size())
+    {
+        if (uint64_t length = ValidRecordAt(view.Data(), view.Size(), pos))
+        {
+            offsets.push_back(pos);
+            pos += length;
+            continue;
+        }
+        uint64_t next = pos + 8;
+        while (next < view.Size() && !ValidRecordAt(view.Data(), view.Size(), next)) next += 8;
+        if (next >= view.Size()) break;
+        ++skipped;
+        pos = next;
+    }
+    if (skipped)
+        m_note = "skipped " + std::to_string(skipped) + " corrupt record(s)";
+    if (pos < view.Size())
+    {
+        m_note += (m_note.empty() ? "" : "; ") + std::string("discarded ") +
+                  std::to_string(view.Size() - pos) + " byte(s) of torn record data";
+        m_view.Close();
+        m_viewStale = true;
+        Truncate(m_log, pos);   // best effort: appends overwrite the tail anyway
+    }
+    m_logEnd = pos;
+    m_runs   = offsets.size();
+
+    // Keep the index prefix that matches the log record for record.
+    std::vector<IndexEntry> entries;
+    std::size_t indexed = 0;
+    {
+        MappedFile idx;
+        if (idx.Open(m_indexPath) && idx.Size() >= kFileHeader &&
+            std::memcmp(idx.Data(), kIndexMagic, sizeof(kIndexMagic)) == 0)
+        {
+            const std::size_t n = (idx.Size() - kFileHeader) / sizeof(IndexEntry);
+            std::size_t i = 0;
+            while (i < n && indexed < offsets.size())
+            {
+                IndexEntry first;
+                std::memcpy(&first, idx.Data() + kFileHeader + i * sizeof(IndexEntry), sizeof(first));
+                const std::size_t group = std::max<std::size_t>(1, first.histogramCount);
+                if (i + group > n) break;
+
+                std::vector<IndexEntry> run(group);
+                std::memcpy(run.data(), idx.Data() + kFileHeader + i * sizeof(IndexEntry), group * sizeof(IndexEntry));
+                bool ok = true;
+                for (std::size_t g = 0; g < group && ok; ++g)
+                    ok = Sealed(run[g]) && run[g].offset == offsets[indexed] &&
+                         run[g].histogramCount == first.histogramCount && run[g].histogramIndex == g;
+                if (!ok) break;
+
+                entries.insert(entries.end(), run.begin(), run.end());
+                i += group;
+                ++indexed;
+            }
+        }
+    }
+
+    m_idxEnd = kFileHeader + entries.size() * sizeof(IndexEntry);
+    std::error_code ec;
+    if (entries.empty())
+    {
+        std::ofstream f(m_indexPath, std::ios::binary | std::ios::trunc);
+        std::string header(kIndexMagic, sizeof(kIndexMagic));
+        header.resize(kFileHeader, '\0');
+        f.write(header.data(), static_cast<std::streamsize>(header.size()));
+        if (!f.good())
+        {
+            error = "cannot write " + m_indexPath;
+            return false;
+        }
+    }
+    else if (std::filesystem::file_size(m_indexPath, ec) != m_idxEnd)
+    {
+        std::filesystem::resize_file(m_indexPath, m_idxEnd, ec);   // drop the unmatched tail
+    }
+    m_index = std::move(entries);
+
+    if (indexed < offsets.size())
+    {
+        std::vector<IndexEntry> missing;
+        for (std::size_t k = indexed; k < offsets.size(); ++k)
+        {
+            Record r;
+            if (!Read(offsets[k], r, error)) return false;
+            std::vector<IndexEntry> e = EntriesFor(r, offsets[k]);
+            missing.insert(missing.end(), e.begin(), e.end());
+        }
+        if (!AppendIndex(missing, error)) return false;
+        std::string what = "re-indexed " + std::to_string(offsets.size() - indexed) + " run(s)";
+        m_note += (m_note.empty() ? "" : "; ") + what;
+    }
+    return true;
+}
+
+bool Store::AppendIndex(const std::vector<IndexEntry>& entries, std::string& error)
+{
+    std::ofstream f(m_indexPath, std::ios::binary | std::ios::in | std::ios::out);
+    if (f.is_open()) f.seekp(static_cast<std::streamoff>(m_idxEnd));
+    if (f.is_open()) f.write(reinterpret_cast<const char*>(entries.data()),
+                             static_cast<std::streamsize>(entries.size() * sizeof(IndexEntry)));
+    if (!f.is_open() || !f.good())
+    {
+        error = "cannot write " + m_indexPath;
+        return false;
+    }
+    m_idxEnd += entries.size() * sizeof(IndexEntry);
+    m_index.insert(m_index.end(), entries.begin(), entries.end());
+    return true;
+}
+
+bool Store::Append(const Record& record, std::string& error)
+{
+#ifdef _WIN32
+    if (!m_log) { error = "store not open"; return false; }
+#else
+    if (m_log < 0) { error = "store not open"; return false; }
+#endif
+    if (record.histograms.size() > 0xFFFF) { error = "too many histograms in one run"; return false; }
+
+    Record r = record;
+    if (r.timestamp == 0) r.timestamp = static_cast<int64_t>(std::time(nullptr));
+    std::string payload = Encode(r);
+    if (payload.size() > kMaxPayload) { error = "run record too large"; return false; }
+
+    FileLock lock(m_log);
+    if (FileSize(m_log) != m_logEnd && !Load(error)) return false;   // another writer got in first
+
+    std::string framed = Frame(payload);
+    const uint64_t offset = m_logEnd;
+    if (!WriteAt(m_log, framed, offset) || !Sync(m_log))
+    {
+        error = "cannot append to " + m_logPath;
+        return false;
+    }
+    m_logEnd += framed.size();
+    ++m_runs;
+    m_viewStale = true;
+    return AppendIndex(EntriesFor(r, offset), error);
+}
+
+bool Store::Read(uint64_t offset, Record& out, std::string& error) const
+{
+    const MappedFile& view = LogView();
+    if (!view.Data() || offset < kFileHeader || offset >= view.Size())
+    {
+        error = "no run at offset " + std::to_string(offset);
+        return false;
+    }
+    uint64_t length = ValidRecordAt(view.Data(), view.Size(), offset);
+    uint32_t payload = 0;
+    if (length) std::memcpy(&payload, view.Data() + offset + 4, sizeof(payload));
+    out = Record{};
+    if (!length || !Decode(view.Data() + offset + kRecordHead, payload, out))
+    {
+        error = "corrupt run at offset " + std::to_string(offset);
+        return false;
+    }
+    return true;
+}
+
+std::vector<Point> Store::Find(const Query& q) const
+{
+    const uint64_t need     = BloomOf(q.tags, q.tweaks);
+    const uint32_t machine  = static_cast<uint32_t>(Hash(q.fingerprint));
+    const std::string probe = q.probe.substr(0, sizeof(IndexEntry::probe) - 1);
+    const std::string label = q.label.substr(0, sizeof(IndexEntry::label) - 1);
+
+    std::map<uint64_t, bool> confirmed;   // record offset -> tags/tweaks present
+    auto contains = [](const std::vector<std::string>& have, const std::vector<std::string>& want) {
+        return std::all_of(want.begin(), want.end(), [&](const std::string& w) {
+            return std::find(have.begin(), have.end(), w) != have.end();
+        });
+    };
+
+    std::vector<Point> out;
+    for (const IndexEntry& e : m_index)
+    {
+        if (e.histogramCount == 0 || e.timestamp < q.from || e.timestamp > q.to) continue;
+        if ((e.tagBloom & need) != need) continue;
+        if (!q.fingerprint.empty() && e.fingerprintHash != machine) continue;
+        if (!probe.empty() && Field(e.probe, sizeof(e.probe)) != probe) continue;
+        if (!label.empty() && Field(e.label, sizeof(e.label)) != label) continue;
+
+        if (need)
+        {
+            auto it = confirmed.find(e.offset);
+            if (it == confirmed.end())
+            {
+                Record r;
+                std::string ignored;
+                bool match = Read(e.offset, r, ignored) && contains(r.tags, q.tags) && contains(r.tweaks, q.tweaks);
+                it = confirmed.emplace(e.offset, match).first;
+            }
+            if (!it->second) continue;
+        }
+
+        Point p;
+        p.timestamp = e.timestamp;
+        p.offset    = e.offset;
+        p.probe     = Field(e.probe, sizeof(e.probe));
+        p.label     = Field(e.label, sizeof(e.label));
+        p.count     = e.count;
+        p.p50Us     = e.p50Us;
+        p.p99Us     = e.p99Us;
+        p.p999Us    = e.p999Us;
+        p.maxUs     = e.maxUs;
+        out.push_back(std::move(p));
+    }
+    std::stable_sort(out.begin(), out.end(), [](const Point& a, const Point& b) { return a.timestamp < b.timestamp; });
+    return out;
+}
+
+std::vector<std::pair<std::string, std::string>> Store::Series() const
+{
+    std::vector<std::pair<std::string, std::string>> out;
+    for (const IndexEntry& e : m_index)
+    {
+        if (e.histogramCount == 0) continue;
+        std::pair<std::string, std::string> key(Field(e.probe, sizeof(e.probe)), Field(e.label, sizeof(e.label)));
+        if (std::find(out.begin(), out.end(), key) == out.end()) out.push_back(std::move(key));
+    }
+    return out;
+}
+
+// ─── Time helpers ────────────────────────────────────────────────────────────
+
+std::string FormatTime(int64_t unixSeconds)
+{
+    std::time_t t = static_cast<std::time_t>(unixSeconds);
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &t);
+#else
+    gmtime_r(&t, &utc);
+#endif
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return buf;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant).
+static int64_t DaysFromCivil(int64_t y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const int64_t  era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+bool ParseTime(const std::string& text, int64_t& unixSeconds)
+{
+    int y = 0, mo = 0, d = 0, h = 0, mi = 0, s = 0;
+    int fields = std::sscanf(text.c_str(), "%d-%d-%dT%d:%d:%d", &y, &mo, &d, &h, &mi, &s);
+    if ((fields != 3 && fields != 6) || mo < 1 || mo > 12 || d < 1 || d > 31 ||
+        h < 0 || h > 23 || mi < 0 || mi > 59 || s < 0 || s > 60)
+        return false;
+    unixSeconds = DaysFromCivil(y, static_cast<unsigned>(mo), static_cast<unsigned>(d)) * 86400 +
+                  h * 3600 + mi * 60 + s;
+    return true;
+}
+
+std::string DefaultDirectory()
+{
+    return machine_profile::DataDir();
+}
+
+} // namespace results_store
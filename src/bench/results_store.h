@@ -0,0 +1,130 @@
+#pragma once
+#include "histogram.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Append-only results store.  Every probe run becomes one record in
+// results.log (machine fingerprint, active tweaks, tags, probe name and its
+// histograms), framed with a CRC so a torn write is detected and cut off on
+// the next open.  results.idx holds one fixed-size entry per histogram with
+// the headline percentiles, so trend queries never decode the log; it is a
+// cache and is rebuilt from the log whenever it lags or fails its CRCs.
+//
+// Readers map the log; appends take an OS file lock, so the GUI and
+// LatencyProbe can share one store.
+namespace results_store {
+
+struct Record {
+    int64_t                  timestamp = 0;   // Unix seconds, UTC
+    std::string              fingerprint;     // machine_profile fingerprint
+    std::string              probe;           // e.g. "core-latency", "storage"
+    std::vector<std::string> tweaks;          // tweaks active during the run (TweakBase::Id())
+    std::vector<std::string> tags;            // free-form: "baseline", "nv-552.22"
+    std::vector<std::pair<std::string, LatencyHistogram>> histograms;
+};
+
+struct Query {
+    std::string              probe;           // empty = any (prefix of 31 chars compared)
+    std::string              label;           // histogram label, empty = any
+    std::string              fingerprint;     // empty = any machine
+    std::vector<std::string> tags;            // every one must be present
+    std::vector<std::string> tweaks;          // every one must have been active
+    int64_t                  from = 0;
+    int64_t                  to   = std::numeric_limits<int64_t>::max();
+};
+
+// One histogram of one run, answered from the index.
+struct Point {
+    int64_t     timestamp = 0;
+    uint64_t    offset    = 0;   // record offset, for Store::Read
+    std::string probe;
+    std::string label;
+    uint64_t    count  = 0;
+    double      p50Us  = 0.0;
+    double      p99Us  = 0.0;
+    double      p999Us = 0.0;
+    double      maxUs  = 0.0;
+};
+
+class Store {
+public:
+    Store() = default;
+    ~Store();
+
+    Store(const Store&)            = delete;
+    Store& operator=(const Store&) = delete;
+
+    // Opens (creating if needed) results.log / results.idx in `directory`,
+    // recovering from a torn tail and re-indexing as required.
+    bool Open(const std::string& directory, std::string& error);
+    void Close();
+
+    // Picks up records appended by other processes since Open.
+    bool Refresh(std::string& error);
+
+    // Durable (flushed to disk) when it returns true.  A zero timestamp is
+    // replaced by the current time.
+    bool Append(const Record& record, std::string& error);
+
+    // Matching points in time order.  Tag / tweak filters are pre-screened
+    // by a per-entry Bloom mask and confirmed against the record.
+    std::vector<Point> Find(const Query& query) const;
+
+    // Distinct (probe, label) pairs, in first-seen order.
+    std::vector<std::pair<std::string, std::string>> Series() const;
+
+    bool Read(uint64_t offset, Record& out, std::string& error) const;
+
+    std::size_t        Runs() const { return m_runs; }
+    const std::string& Note() const { return m_note; }   // recovery actions taken on open
+
+    // Entry layout of results.idx; public for the static_assert in the .cpp.
+    struct IndexEntry {
+        uint64_t offset;
+        int64_t  timestamp;
+        uint64_t count;
+        uint64_t tagBloom;
+        float    p50Us, p99Us, p999Us, maxUs;
+        uint32_t fingerprintHash;
+        uint16_t histogramIndex;
+        uint16_t histogramCount;   // 0 = record without histograms
+        char     probe[32];
+        char     label[36];
+        uint32_t crc;
+    };
+
+private:
+    bool Load(std::string& error);
+    bool AppendIndex(const std::vector<IndexEntry>& entries, std::string& error);
+    const MappedFile& LogView() const;
+
+    std::string             m_logPath;
+    std::string             m_indexPath;
+    std::vector<IndexEntry> m_index;
+    uint64_t                m_logEnd = 0;    // end of the last valid record
+    uint64_t                m_idxEnd = 0;    // end of the last valid index entry
+    std::size_t             m_runs   = 0;
+    std::string             m_note;
+    mutable MappedFile      m_view;
+    mutable bool            m_viewStale = true;
+#ifdef _WIN32
+    void*                   m_log = nullptr;   // HANDLE, also the append lock
+#else
+    int                     m_log = -1;
+#endif
+};
+
+// Unix seconds <-> "2024-05-01T12:00:00Z".  ParseTime also accepts a bare
+// date ("2024-05-01").
+std::string FormatTime(int64_t unixSeconds);
+bool        ParseTime(const std::string& text, int64_t& unixSeconds);
+
+// machine_profile::DataDir()
+std::string DefaultDirectory();
+
+} // namespace results_store
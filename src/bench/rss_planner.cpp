@@ -0,0 +1,280 @@
+#include "rss_planner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+
+namespace rss_planner {
+
+static uint32_t ToU32(const std::string& text)
+{
+    return static_cast<uint32_t>(std::strtoul(text.c_str(), nullptr, 10));
+}
+
+// ─── Capabilities ────────────────────────────────────────────────────────────
+
+Capabilities ReadCapabilities(const nic_params::Adapter& a)
+{
+    Capabilities c;
+    if (const auto* k = a.Find("*RSS"))
+    {
+        c.supported = true;
+        c.enabled   = k->Effective() == "1";
+    }
+    if (const auto* k = a.Find("*NumRssQueues"))
+    {
+        c.hasQueues = true;
+        c.queues    = ToU32(k->Effective());
+        for (const auto& o : k->options) c.queueOptions.push_back(ToU32(o.value));
+        std::sort(c.queueOptions.begin(), c.queueOptions.end());
+    }
+    if (const auto* k = a.Find("*MaxRssProcessors"))
+    {
+        c.hasMaxProcessors   = true;
+        c.maxProcessors      = ToU32(k->Effective());
+        c.maxProcessorsLimit = k->hasRange ? static_cast<uint32_t>(std::max<int64_t>(k->max, 0)) : 0;
+        for (const auto& o : k->options)   // some drivers make it an enum
+            c.maxProcessorsLimit = std::max(c.maxProcessorsLimit, ToU32(o.value));
+    }
+    if (const auto* k = a.Find("*RSSBaseProcNumber"))
+    {
+        c.hasBase  = true;
+        c.baseProc = ToU32(k->Effective());
+    }
+    if (const auto* k = a.Find("*RssMaxProcNumber"))
+    {
+        c.hasMaxProcNumber = true;
+        c.maxProcNumber    = ToU32(k->Effective());
+    }
+    if (const auto* k = a.Find("*RSSProfile"))
+    {
+        c.hasProfile = true;
+        c.profile    = ToU32(k->Effective());
+        for (const auto& o : k->options) c.profiles.push_back(ToU32(o.value));
+    }
+    return c;
+}
+
+const char* ProfileName(uint32_t profile)
+{
+    switch (profile) {
+    case 1: return "ClosestProcessor";
+    case 2: return "ClosestProcessorStatic";
+    case 3: return "NUMAScaling";
+    case 4: return "NUMAScalingStatic";
+    case 5: return "ConservativeScaling";
+    }
+    return "default";
+}
+
+// ─── Plan ────────────────────────────────────────────────────────────────────
+
+Plan Build(const cpu_topology::Topology& t, const Capabilities& caps, const Request& req)
+{
+    Plan plan;
+    if (!caps.supported)
+    {
+        plan.notes.push_back("the driver does not expose RSS");
+        return plan;
+    }
+
+    // RSS keywords address processor group 0 unless the group keywords are
+    // used; keep the window there.
+    std::vector<uint32_t> cores;
+    for (uint32_t i = 0; i < t.cores.size(); ++i)
+    {
+        const cpu_topology::Cpu* first = t.Find(t.cores[i].cpus.front());
+        if (first && first->group == 0) cores.push_back(i);
+    }
+    if (t.groups > 1) plan.notes.push_back("planned within processor group 0");
+
+    std::set<uint32_t> gameCores;
+    for (uint32_t cpu : req.gameCpus)
+        if (const cpu_topology::Cpu* c = t.Find(cpu)) gameCores.insert(c->core);
+    const cpu_topology::Cpu* cpu0 = t.Find(0);
+    int core0 = cpu0 ? static_cast<int>(cpu0->core) : -1;
+
+    uint32_t wanted = std::max<uint32_t>(req.maxQueues, 1);
+    if (caps.maxProcessorsLimit) wanted = std::min(wanted, caps.maxProcessorsLimit);
+    if (!caps.queueOptions.empty()) wanted = std::min(wanted, caps.queueOptions.back());
+    wanted = std::max<uint32_t>(wanted, 1);
+
+    // Longest (up to `wanted`) run of consecutive free cores; ties go to more
+    // performance cores, then to the highest start.
+    auto pick = [&](bool allowCore0, std::size_t& bestStart) {
+        std::size_t bestLen = 0, bestPerf = 0;
+        for (std::size_t start = 0; start < cores.size(); ++start)
+        {
+            std::size_t len = 0, perf = 0;
+            while (start + len < cores.size() && len < wanted)
+            {
+                uint32_t c = cores[start + len];
+                if (gameCores.count(c) || (!allowCore0 && static_cast<int>(c) == core0)) break;
+                if (t.cores[c].efficiencyClass == t.maxEfficiencyClass) ++perf;
+                ++len;
+            }
+            if (len > bestLen || (len == bestLen && len > 0 && perf >= bestPerf))
+            {
+                bestLen   = len;
+                bestPerf  = perf;
+                bestStart = start;
+            }
+        }
+        return bestLen;
+    };
+
+    std::size_t start = 0;
+    std::size_t len   = 0;
+    if (caps.hasBase)
+    {
+        len = pick(false, start);
+        if (len == 0)
+        {
+            len = pick(true, start);
+            if (len) plan.notes.push_back("only the core of CPU 0 is free of game threads");
+        }
+        if (len == 0)
+        {
+            plan.notes.push_back("every core runs game threads; leave RSS at the driver defaults");
+            return plan;
+        }
+    }
+    else
+    {
+        // The driver keeps its window at the current base; all a plan can do
+        // is stop it before the first game core.
+        plan.notes.push_back("*RSSBaseProcNumber is not exposed; the window stays at CPU " +
+                             std::to_string(caps.baseProc));
+        if (!caps.hasQueues && !caps.hasMaxProcessors)
+        {
+            plan.notes.push_back("no queue or processor limit is exposed; RSS cannot be kept off the game cores");
+            return plan;
+        }
+        const cpu_topology::Cpu* base = nullptr;
+        for (const auto& c : t.cpus)
+            if (c.group == 0 && c.number == caps.baseProc) base = &c;
+        start = base ? static_cast<std::size_t>(std::find(cores.begin(), cores.end(), base->core) - cores.begin())
+                     : cores.size();
+        while (start + len < cores.size() && len < wanted && !gameCores.count(cores[start + len])) ++len;
+        if (len == 0)
+        {
+            plan.notes.push_back("the driver's base CPU runs game threads; leave RSS at the driver defaults");
+            return plan;
+        }
+    }
+    if (len < wanted)
+        plan.notes.push_back("only " + std::to_string(len) + " consecutive free core(s) for " +
+                             std::to_string(wanted) + " wanted");
+
+    bool efficiency = false;
+    for (std::size_t i = start; i < start + len; ++i)
+    {
+        const cpu_topology::Core& core = t.cores[cores[i]];
+        plan.cpus.push_back(core.cpus.front());
+        if (core.efficiencyClass != t.maxEfficiencyClass) efficiency = true;
+    }
+    if (efficiency) plan.notes.push_back("the window includes efficiency cores");
+
+    const cpu_topology::Core& last = t.cores[cores[start + len - 1]];
+    plan.ok            = true;
+    plan.base          = t.Find(plan.cpus.front())->number;
+    plan.maxProcNumber = t.Find(last.cpus.back())->number;
+    plan.maxProcessors = static_cast<uint32_t>(len);
+
+    plan.queues = plan.maxProcessors;
+    if (!caps.queueOptions.empty())
+    {
+        plan.queues = caps.queueOptions.front();
+        for (uint32_t q : caps.queueOptions)
+            if (q <= plan.maxProcessors) plan.queues = q;
+        if (plan.queues > plan.maxProcessors)
+            plan.notes.push_back("the smallest queue count the driver allows exceeds the window");
+    }
+    if (!caps.hasBase && !caps.hasMaxProcessors && plan.queues > plan.maxProcessors)
+    {
+        // Only the queue count limits the window, and it would spill onto
+        // game cores.
+        plan.notes.push_back("leave RSS at the driver defaults");
+        plan.ok = false;
+        return plan;
+    }
+
+    // Static profiles keep each queue on its processor instead of moving
+    // queues around at run time.
+    auto allowed = [&](uint32_t p) {
+        return caps.profiles.empty() ||
+               std::find(caps.profiles.begin(), caps.profiles.end(), p) != caps.profiles.end();
+    };
+    if (caps.hasProfile)
+    {
+        if (allowed(2))      plan.profile = 2;
+        else if (allowed(4)) plan.profile = 4;
+        else plan.notes.push_back("no static RSS profile offered; the profile is left as is");
+    }
+
+    auto add = [&](const char* name, uint32_t value) { plan.values.emplace_back(name, std::to_string(value)); };
+    if (!caps.enabled)         add("*RSS", 1);
+    if (caps.hasBase)          add("*RSSBaseProcNumber", plan.base);
+    if (caps.hasMaxProcNumber) add("*RssMaxProcNumber", plan.maxProcNumber);
+    if (caps.hasMaxProcessors) add("*MaxRssProcessors", plan.maxProcessors);
+    if (caps.hasQueues)        add("*NumRssQueues", plan.queues);
+    if (plan.profile)          add("*RSSProfile", plan.profile);
+    return plan;
+}
+
+const std::vector<std::string>& Keywords()
+{
+    static const std::vector<std::string> kKeywords = {
+        "*RSS", "*RSSBaseProcNumber", "*RssMaxProcNumber", "*MaxRssProcessors", "*NumRssQueues", "*RSSProfile",
+    };
+    return kKeywords;
+}
+
+// ─── Reports ─────────────────────────────────────────────────────────────────
+
+std::string Describe(const Capabilities& c)
+{
+    if (!c.supported) return "RSS: not supported\n";
+
+    std::ostringstream os;
+    os << "RSS: " << (c.enabled ? "enabled" : "disabled");
+    if (c.hasQueues)
+    {
+        os << ", " << c.queues << " queue(s)";
+        if (!c.queueOptions.empty())
+        {
+            os << " (allowed";
+            for (uint32_t q : c.queueOptions) os << ' ' << q;
+            os << ')';
+        }
+    }
+    if (c.hasMaxProcessors)
+    {
+        os << ", up to " << c.maxProcessors << " processor(s)";
+        if (c.maxProcessorsLimit) os << " (max " << c.maxProcessorsLimit << ')';
+    }
+    if (c.hasBase) os << ", base CPU " << c.baseProc;
+    if (c.hasMaxProcNumber) os << ", last CPU " << c.maxProcNumber;
+    if (c.hasProfile) os << ", profile " << ProfileName(c.profile);
+    os << "\n";
+    return os.str();
+}
+
+std::string Describe(const Plan& p)
+{
+    std::ostringstream os;
+    if (p.ok)
+    {
+        os << "Plan: CPUs " << cpu_topology::FormatCpuList(p.cpus) << " (base " << p.base << ", last "
+           << p.maxProcNumber << "), " << p.maxProcessors << " processor(s), " << p.queues << " queue(s)";
+        if (p.profile) os << ", " << ProfileName(p.profile);
+        os << "\n";
+        for (const auto& [name, value] : p.values) os << "  " << name << " = " << value << "\n";
+    }
+    for (const auto& n : p.notes) os << "  note: " << n << "\n";
+    return os.str();
+}
+
+} // namespace rss_planner
@@ -0,0 +1,77 @@
+#pragma once
+#include "cpu_topology.h"
+#include "nic_params.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Receive Side Scaling planner.  RSS spreads receive processing (the NIC's
+// DPCs) over the cores from *RSSBaseProcNumber upwards, one thread per
+// physical core, up to *MaxRssProcessors; the defaults start at CPU 0 and
+// readily land on the cores the game runs on.  The planner picks a window
+// of consecutive physical cores that holds no game thread and avoids the
+// core of CPU 0, preferring performance cores and the top of the CPU range,
+// and derives the keywords that confine RSS to it:
+//
+//   *RSSBaseProcNumber   first CPU of the window
+//   *RssMaxProcNumber    last CPU of the window (when the driver exposes it)
+//   *MaxRssProcessors    cores in the window
+//   *NumRssQueues        the largest allowed queue count that fits
+//   *RSSProfile          ClosestProcessorStatic, so queues are not moved
+//
+// A driver without *RSSBaseProcNumber keeps its window at the current base,
+// so the plan is that window cut short before the first game core, and the
+// queue / processor limits are sized to it; when no limit is exposed, or the
+// base core itself runs game threads, the adapter is left alone.
+//
+// Pure: the same topology, capabilities and game CPUs give the same plan.
+namespace rss_planner {
+
+// The RSS keywords an adapter exposes, decoded from its Ndi\params.
+struct Capabilities {
+    bool                  supported = false;         // *RSS keyword present
+    bool                  enabled   = false;
+    bool                  hasBase = false, hasMaxProcessors = false, hasQueues = false;
+    bool                  hasProfile = false, hasMaxProcNumber = false;
+    std::vector<uint32_t> queueOptions;              // allowed *NumRssQueues, ascending
+    uint32_t              queues = 0;                // effective values
+    uint32_t              maxProcessorsLimit = 0;    // upper bound of *MaxRssProcessors, 0 = none
+    uint32_t              maxProcessors = 0;
+    uint32_t              baseProc = 0;
+    uint32_t              maxProcNumber = 0;
+    std::vector<uint32_t> profiles;                  // allowed *RSSProfile
+    uint32_t              profile = 0;
+};
+
+Capabilities ReadCapabilities(const nic_params::Adapter& a);
+
+// 1 ClosestProcessor ... 5 ConservativeScaling
+const char* ProfileName(uint32_t profile);
+
+struct Request {
+    std::vector<uint32_t> gameCpus;     // reserved; their whole cores are avoided
+    uint32_t              maxQueues = 4;
+};
+
+struct Plan {
+    bool                     ok = false;      // false: leave the adapter at its defaults
+    std::vector<uint32_t>    cpus;            // one thread per core of the window
+    uint32_t                 base = 0;
+    uint32_t                 maxProcNumber = 0;
+    uint32_t                 maxProcessors = 0;
+    uint32_t                 queues = 0;
+    uint32_t                 profile = 0;     // 0 = keep the current one
+    nic_params::Values       values;          // keywords to write
+    std::vector<std::string> notes;           // relaxed rules and other caveats
+};
+
+Plan Build(const cpu_topology::Topology& t, const Capabilities& caps, const Request& req);
+
+// Keywords a plan may write (for a selective restore).
+const std::vector<std::string>& Keywords();
+
+std::string Describe(const Capabilities& caps);
+std::string Describe(const Plan& plan);
+
+} // namespace rss_planner
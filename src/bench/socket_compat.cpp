@@ -0,0 +1,173 @@
+#include "socket_compat.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <mstcpip.h>
+#else
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/tcp.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace socket_compat {
+
+bool Startup()
+{
+#ifdef _WIN32
+    static bool started = false;
+    if (started) return true;
+    WSADATA wsa{};
+    started = WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+    return started;
+#else
+    return true;
+#endif
+}
+
+void Close(socket_t s)
+{
+    if (s == kInvalidSocket) return;
+#ifdef _WIN32
+    closesocket(s);
+#else
+    close(s);
+#endif
+}
+
+int LastError()
+{
+#ifdef _WIN32
+    return WSAGetLastError();
+#else
+    return errno;
+#endif
+}
+
+bool IsTimeout(int err)
+{
+#ifdef _WIN32
+    return err == WSAETIMEDOUT || err == WSAEWOULDBLOCK;
+#else
+    return err == EAGAIN || err == EWOULDBLOCK;
+#endif
+}
+
+bool Resolve(const std::string& host, uint16_t port, int socktype,
+             sockaddr_storage& out, socklen_t& outLen)
+{
+    addrinfo hints{};
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = socktype;
+
+    addrinfo* res = nullptr;
+    std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &res) != 0 || !res)
+        return false;
+
+    std::memcpy(&out, res->ai_addr, res->ai_addrlen);
+    outLen = static_cast<socklen_t>(res->ai_addrlen);
+    freeaddrinfo(res);
+    return true;
+}
+
+bool SetNoDelay(socket_t s, bool enable)
+{
+    int flag = enable ? 1 : 0;
+    return setsockopt(s, IPPROTO_TCP, TCP_NODELAY,
+                      reinterpret_cast<const char*>(&flag), sizeof(flag)) == 0;
+}
+
+bool SetReuseAddr(socket_t s)
+{
+    int flag = 1;
+    return setsockopt(s, SOL_SOCKET, SO_REUSEADDR,
+                      reinterpret_cast<const char*>(&flag), sizeof(flag)) == 0;
+}
+
+bool SetRecvTimeout(socket_t s, uint32_t timeoutMs)
+{
+#ifdef _WIN32
+    DWORD tv = timeoutMs;
+#else
+    timeval tv{};
+    tv.tv_sec  = static_cast<time_t>(timeoutMs / 1000);
+    tv.tv_usec = static_cast<suseconds_t>((timeoutMs % 1000) * 1000);
+#endif
+    return setsockopt(s, SOL_SOCKET, SO_RCVTIMEO,
+                      reinterpret_cast<const char*>(&tv), sizeof(tv)) == 0;
+}
+
+bool SetBufferSizes(socket_t s, int sendBytes, int recvBytes)
+{
+    bool ok = true;
+    if (sendBytes > 0)
+        ok &= setsockopt(s, SOL_SOCKET, SO_SNDBUF,
+                         reinterpret_cast<const char*>(&sendBytes), sizeof(sendBytes)) == 0;
+    if (recvBytes > 0)
+        ok &= setsockopt(s, SOL_SOCKET, SO_RCVBUF,
+                         reinterpret_cast<const char*>(&recvBytes), sizeof(recvBytes)) == 0;
+    return ok;
+}
+
+bool BindLocal(socket_t s, const std::string& localAddress)
+{
+    sockaddr_storage addr{};
+    socklen_t addrLen = 0;
+    if (!Resolve(localAddress, 0, SOCK_STREAM, addr, addrLen))
+        return false;
+    return bind(s, reinterpret_cast<sockaddr*>(&addr), addrLen) == 0;
+}
+
+bool QueryTcpStats(socket_t s, TcpStats& out)
+{
+#ifdef _WIN32
+    // SIO_TCP_INFO (Windows 10 1703+) reports retransmitted bytes, not
+    // segments; divide by the MSS to get a comparable segment count.
+    DWORD version = 0;
+    TCP_INFO_v0 info{};
+    DWORD bytes = 0;
+    if (WSAIoctl(s, SIO_TCP_INFO, &version, sizeof(version), &info, sizeof(info),
+                 &bytes, nullptr, nullptr) != 0)
+        return false;
+    out.retransSegments = info.Mss ? info.BytesRetrans / info.Mss : 0;
+    out.rttUs           = info.RttUs;
+    return true;
+#else
+    tcp_info info{};
+    socklen_t len = sizeof(info);
+    if (getsockopt(s, IPPROTO_TCP, TCP_INFO, &info, &len) != 0)
+        return false;
+    out.retransSegments = info.tcpi_total_retrans;
+    out.rttUs           = info.tcpi_rtt;
+    return true;
+#endif
+}
+
+bool SendAll(socket_t s, const char* data, std::size_t len)
+{
+    while (len > 0)
+    {
+        int n = send(s, data, static_cast<int>(len), 0);
+        if (n <= 0) return false;
+        data += n;
+        len  -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool RecvAll(socket_t s, char* data, std::size_t len)
+{
+    while (len > 0)
+    {
+        int n = recv(s, data, static_cast<int>(len), 0);
+        if (n <= 0) return false;
+        data += n;
+        len  -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+} // namespace socket_compat
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using socket_t = SOCKET;
+static constexpr socket_t kInvalidSocket = INVALID_SOCKET;
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+using socket_t = int;
+static constexpr socket_t kInvalidSocket = -1;
+#endif
+
+// Thin Winsock / BSD sockets shim so the network probes build on both
+// Windows and Linux from the same source.
+namespace socket_compat {
+
+// WSAStartup on Windows; no-op elsewhere.  Safe to call more than once.
+bool Startup();
+
+// Close a socket handle (closesocket / close).
+void Close(socket_t s);
+
+// Last socket error code (WSAGetLastError / errno).
+int LastError();
+
+// True if `err` means a receive timed out (SO_RCVTIMEO expired).
+bool IsTimeout(int err);
+
+// Resolve host:port into an IPv4 sockaddr (the responders bind IPv4 only).
+// `socktype` is SOCK_DGRAM or SOCK_STREAM.
+bool Resolve(const std::string& host, uint16_t port, int socktype,
+             sockaddr_storage& out, socklen_t& outLen);
+
+// Socket options
+bool SetNoDelay(socket_t s, bool enable);
+bool SetReuseAddr(socket_t s);
+bool SetRecvTimeout(socket_t s, uint32_t timeoutMs);
+
+// Fixed SO_SNDBUF / SO_RCVBUF sizes.  0 leaves that side at the OS default,
+// which keeps receive-window autotuning in charge.
+bool SetBufferSizes(socket_t s, int sendBytes, int recvBytes);
+
+// Bind to a local IPv4 address before connect(), selecting the interface.
+bool BindLocal(socket_t s, const std::string& localAddress);
+
+// Per-connection TCP counters (TCP_INFO on Linux, SIO_TCP_INFO on Windows).
+struct TcpStats {
+    uint64_t retransSegments = 0;
+    uint32_t rttUs           = 0;
+};
+bool QueryTcpStats(socket_t s, TcpStats& out);
+
+// Loop until all bytes are sent / received.  Returns false on error, timeout
+// or orderly shutdown by the peer.
+bool SendAll(socket_t s, const char* data, std::size_t len);
+bool RecvAll(socket_t s, char* data, std::size_t len);
+
+} // namespace socket_compat
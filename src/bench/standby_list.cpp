@@ -0,0 +1,399 @@
+#include "standby_list.h"
+#include "bench_clock.h"
+#include "machine_profile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+namespace standby_list {
+
+// ─── Memory state ────────────────────────────────────────────────────────────
+
+#ifdef _WIN32
+static const int kSystemMemoryListInformation = 80;
+static const int kMemoryPurgeStandbyList            = 4;   // SYSTEM_MEMORY_LIST_COMMAND
+static const int kMemoryPurgeLowPriorityStandbyList = 5;
+
+// SYSTEM_MEMORY_LIST_INFORMATION; counts are pages.
+struct MemoryListInformation {
+    ULONG_PTR zeroPageCount;
+    ULONG_PTR freePageCount;
+    ULONG_PTR modifiedPageCount;
+    ULONG_PTR modifiedNoWritePageCount;
+    ULONG_PTR badPageCount;
+    ULONG_PTR pageCountByPriority[8];   // standby list by priority
+    ULONG_PTR repurposedPagesByPriority[8];
+    ULONG_PTR modifiedPageCountPageFile;
+};
+
+typedef LONG (NTAPI* NtQuerySystemInformationFn)(int cls, void* info, ULONG length, ULONG* returned);
+typedef LONG (NTAPI* NtSetSystemInformationFn)(int cls, void* info, ULONG length);
+
+static FARPROC Ntdll(const char* name)
+{
+    return GetProcAddress(GetModuleHandleW(L"ntdll.dll"), name);
+}
+
+static bool EnableProfilePrivilege()
+{
+    static const bool enabled = [] {
+        HANDLE token = nullptr;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) return false;
+        TOKEN_PRIVILEGES tp{};
+        tp.PrivilegeCount           = 1;
+        tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        bool ok = LookupPrivilegeValueW(nullptr, SE_PROF_SINGLE_PROCESS_NAME, &tp.Privileges[0].Luid) &&
+                  AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr) && GetLastError() == ERROR_SUCCESS;
+        CloseHandle(token);
+        return ok;
+    }();
+    return enabled;
+}
+
+static std::string NtError(const char* what, LONG status)
+{
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "%s failed (0x%08lX)%s", what, static_cast<unsigned long>(status),
+                  static_cast<unsigned long>(status) == 0xC0000061UL ? "; run as administrator" : "");
+    return buf;
+}
+#endif
+
+bool Query(MemoryState& out, std::string& error)
+{
+#ifdef _WIN32
+    static auto query = reinterpret_cast<NtQuerySystemInformationFn>(Ntdll("NtQuerySystemInformation"));
+    if (!query)
+    {
+        error = "NtQuerySystemInformation is not available";
+        return false;
+    }
+    EnableProfilePrivilege();
+    MemoryListInformation info{};
+    LONG status = query(kSystemMemoryListInformation, &info, sizeof(info), nullptr);
+    if (status < 0)
+    {
+        error = NtError("NtQuerySystemInformation(SystemMemoryListInformation)", status);
+        return false;
+    }
+
+    SYSTEM_INFO si{};
+    GetSystemInfo(&si);
+    uint64_t page = si.dwPageSize;
+    MEMORYSTATUSEX ms{};
+    ms.dwLength = sizeof(ms);
+    GlobalMemoryStatusEx(&ms);
+
+    uint64_t standby = 0;
+    for (ULONG_PTR pages : info.pageCountByPriority) standby += pages;
+    out.total    = ms.ullTotalPhys;
+    out.free     = (static_cast<uint64_t>(info.freePageCount) + info.zeroPageCount) * page;
+    out.standby  = standby * page;
+    out.modified = static_cast<uint64_t>(info.modifiedPageCount) * page;
+    return true;
+#else
+    std::ifstream f("/proc/meminfo");
+    std::stringstream text;
+    text << f.rdbuf();
+    if (!ParseMeminfo(text.str(), out))
+    {
+        error = "cannot read /proc/meminfo";
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool ParseMeminfo(const std::string& text, MemoryState& out)
+{
+    std::map<std::string, uint64_t> kb;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        kb[line.substr(0, colon)] = std::strtoull(line.c_str() + colon + 1, nullptr, 10);
+    }
+    if (!kb.count("MemTotal") || !kb.count("MemFree")) return false;
+
+    out.total    = kb["MemTotal"] * 1024;
+    out.free     = kb["MemFree"] * 1024;
+    out.standby  = (kb["Active(file)"] + kb["Inactive(file)"]) * 1024;
+    out.modified = kb["Dirty"] * 1024;
+    return true;
+}
+
+std::string FormatMiB(uint64_t bytes)
+{
+    return std::to_string(bytes >> 20) + " MiB";
+}
+
+std::string Describe(const MemoryState& m)
+{
+    return "total " + FormatMiB(m.total) + ", free " + FormatMiB(m.free) + ", standby " + FormatMiB(m.standby) +
+           ", modified " + FormatMiB(m.modified);
+}
+
+// ─── Purge policy ────────────────────────────────────────────────────────────
+
+const char* CommandName(Command c)
+{
+    switch (c) {
+    case Command::Standby:            return "standby";
+    case Command::LowPriorityStandby: return "low-priority";
+    }
+    return "?";
+}
+
+bool Purge(Command c, std::string& error)
+{
+#ifdef _WIN32
+    static auto set = reinterpret_cast<NtSetSystemInformationFn>(Ntdll("NtSetSystemInformation"));
+    if (!set)
+    {
+        error = "NtSetSystemInformation is not available";
+        return false;
+    }
+    EnableProfilePrivilege();
+    int command = c == Command::Standby ? kMemoryPurgeStandbyList : kMemoryPurgeLowPriorityStandbyList;
+    LONG status = set(kSystemMemoryListInformation, &command, sizeof(command));
+    if (status < 0)
+    {
+        error = NtError("NtSetSystemInformation(MemoryPurgeStandbyList)", status);
+        return false;
+    }
+    return true;
+#else
+    // Only clean page-cache pages go, as with the standby list; there is no
+    // low-priority subset.
+    (void)c;
+    std::ofstream f("/proc/sys/vm/drop_caches");
+    if (!(f << "1\n") || !f.flush())
+    {
+        error = "cannot write /proc/sys/vm/drop_caches (needs root)";
+        return false;
+    }
+    return true;
+#endif
+}
+
+const char* DecisionName(Decision d)
+{
+    switch (d) {
+    case Decision::Wait:           return "wait";
+    case Decision::Purge:          return "purge";
+    case Decision::RateLimited:    return "rate-limited";
+    case Decision::NothingToPurge: return "nothing to purge";
+    }
+    return "?";
+}
+
+Decision Decide(const Policy& p, const MemoryState& m, double sinceLastS)
+{
+    if (m.free >= p.freeBelow) return Decision::Wait;
+    if (m.standby < p.standbyAbove) return Decision::NothingToPurge;   // the pressure is working sets
+    if (sinceLastS >= 0 && sinceLastS < p.minGapS) return Decision::RateLimited;
+    return Decision::Purge;
+}
+
+// ─── Trace ───────────────────────────────────────────────────────────────────
+
+static const char* kTraceHeader =
+    "time,command,ok,free_before,standby_before,free_after,standby_after,reclaimed,ms,error";
+
+std::string DefaultTracePath()
+{
+    return machine_profile::DataDir() + "/purges.csv";
+}
+
+std::string FormatRecord(const PurgeRecord& r)
+{
+    std::string error = r.error;
+    std::replace(error.begin(), error.end(), ',', ';');
+    char ms[32];
+    std::snprintf(ms, sizeof(ms), "%.2f", r.durationMs);
+    return results_store::FormatTime(r.timestamp) + "," + CommandName(r.command) + "," + (r.ok ? "1" : "0") + "," +
+           std::to_string(r.before.free) + "," + std::to_string(r.before.standby) + "," +
+           std::to_string(r.after.free) + "," + std::to_string(r.after.standby) + "," +
+           std::to_string(r.Reclaimed()) + "," + ms + "," + error;
+}
+
+bool ParseRecord(const std::string& line, PurgeRecord& out)
+{
+    std::vector<std::string> f;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) f.push_back(field);
+    if (f.size() < 9) return false;
+
+    PurgeRecord r;
+    if (!results_store::ParseTime(f[0], r.timestamp)) return false;
+    if (f[1] == "standby")           r.command = Command::Standby;
+    else if (f[1] == "low-priority") r.command = Command::LowPriorityStandby;
+    else return false;
+    r.ok             = f[2] == "1";
+    r.before.free    = std::strtoull(f[3].c_str(), nullptr, 10);
+    r.before.standby = std::strtoull(f[4].c_str(), nullptr, 10);
+    r.after.free     = std::strtoull(f[5].c_str(), nullptr, 10);
+    r.after.standby  = std::strtoull(f[6].c_str(), nullptr, 10);
+    r.durationMs     = std::strtod(f[8].c_str(), nullptr);   // f[7] is derived
+    if (f.size() > 9) r.error = f[9];
+    out = r;
+    return true;
+}
+
+bool AppendTrace(const std::string& path, const PurgeRecord& r, std::string& error)
+{
+    bool fresh = !std::ifstream(path).good();
+    std::ofstream f(path, std::ios::app);
+    if (!f)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    if (fresh) f << kTraceHeader << "\n";
+    f << FormatRecord(r) << "\n";
+    if (!f.flush())
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool LoadTrace(const std::string& path, std::vector<PurgeRecord>& out, std::string& error)
+{
+    out.clear();
+    std::ifstream f(path);
+    if (!f) return true;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(f, line))
+    {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line.rfind("time,", 0) == 0) continue;
+        PurgeRecord r;
+        if (!ParseRecord(line, r))
+        {
+            error = path + ":" + std::to_string(lineNo) + ": not a purge record";
+            return false;
+        }
+        out.push_back(r);
+    }
+    return true;
+}
+
+// ─── Monitor ─────────────────────────────────────────────────────────────────
+
+PurgeRecord Monitor::PurgeNow(const MemoryState& before)
+{
+    PurgeRecord r;
+    r.timestamp = static_cast<int64_t>(std::time(nullptr));
+    r.command   = m_policy.command;
+    r.before    = before;
+
+    uint64_t start = bench_clock::NowNs();
+    r.ok           = Purge(m_policy.command, r.error);
+    r.durationMs   = (bench_clock::NowNs() - start) / 1e6;
+
+    std::string error;
+    if (!Query(r.after, error)) r.after = before;
+    m_lastNs = bench_clock::NowNs();
+    ++m_purges;
+    return r;
+}
+
+Decision Monitor::Poll(MemoryState& now, PurgeRecord& purged, std::string& error)
+{
+    if (!Query(now, error)) return Decision::Wait;
+    double sinceLastS = m_lastNs ? (bench_clock::NowNs() - m_lastNs) / 1e9 : -1.0;
+    Decision d = Decide(m_policy, now, sinceLastS);
+    if (d == Decision::Purge) purged = PurgeNow(now);
+    return d;
+}
+
+// ─── Correlation ─────────────────────────────────────────────────────────────
+
+static double Median(std::vector<float> v)
+{
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return stats::PercentileSorted(v, 50);
+}
+
+std::vector<Correlation> Correlate(const std::vector<results_store::Point>& points,
+                                   const std::vector<PurgeRecord>& purges, int64_t windowS)
+{
+    std::vector<int64_t> times;
+    for (const auto& p : purges)
+        if (p.ok) times.push_back(p.timestamp);
+    std::sort(times.begin(), times.end());
+
+    // Series in first-seen order, p99 samples split by purge.
+    std::vector<Correlation> out;
+    std::vector<std::pair<std::vector<float>, std::vector<float>>> samples;
+    for (const auto& pt : points)
+    {
+        std::size_t i = 0;
+        while (i < out.size() && (out[i].probe != pt.probe || out[i].label != pt.label)) ++i;
+        if (i == out.size())
+        {
+            Correlation c;
+            c.probe = pt.probe;
+            c.label = pt.label;
+            out.push_back(c);
+            samples.emplace_back();
+        }
+
+        auto first = std::upper_bound(times.begin(), times.end(), pt.timestamp - windowS);
+        bool purged = first != times.end() && *first <= pt.timestamp;
+        (purged ? samples[i].first : samples[i].second).push_back(static_cast<float>(pt.p99Us));
+    }
+
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        Correlation& c = out[i];
+        c.withPurge  = static_cast<uint32_t>(samples[i].first.size());
+        c.without    = static_cast<uint32_t>(samples[i].second.size());
+        c.p99With    = Median(samples[i].first);
+        c.p99Without = Median(samples[i].second);
+        if (c.withPurge && c.without) c.shift = stats::MannWhitney(samples[i].second, samples[i].first);
+    }
+    return out;
+}
+
+std::string Describe(const std::vector<Correlation>& cs)
+{
+    std::ostringstream os;
+    char line[200];
+    std::snprintf(line, sizeof(line), "  %-16s %-20s %5s %5s %12s %12s %8s %8s\n", "probe", "histogram", "purge",
+                  "none", "p99 purge us", "p99 none us", "effect", "p");
+    os << line;
+    for (const auto& c : cs)
+    {
+        if (c.withPurge && c.without)
+            std::snprintf(line, sizeof(line), "  %-16s %-20s %5u %5u %12.1f %12.1f %+8.2f %8.4f\n", c.probe.c_str(),
+                          c.label.c_str(), c.withPurge, c.without, c.p99With, c.p99Without, c.shift.effect,
+                          c.shift.pValue);
+        else
+            std::snprintf(line, sizeof(line), "  %-16s %-20s %5u %5u   (needs runs with and without a purge)\n",
+                          c.probe.c_str(), c.label.c_str(), c.withPurge, c.without);
+        os << line;
+    }
+    return os.str();
+}
+
+} // namespace standby_list
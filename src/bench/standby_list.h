@@ -0,0 +1,139 @@
+#pragma once
+#include "results_store.h"
+#include "stats.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Standby-list management for machines short on RAM.  The Memory tweaks
+// only set static knobs; on a 16 GB machine the standby list (clean cached
+// pages that belong to no working set) can grow until a game's allocations
+// have to repurpose standby pages one by one, which shows up as hitches.
+// This watches free and standby memory and, when free memory drops below a
+// threshold while the standby list is large, purges it:
+//
+//   query   NtQuerySystemInformation(SystemMemoryListInformation)
+//   purge   NtSetSystemInformation(SystemMemoryListInformation,
+//           MemoryPurgeStandbyList / MemoryPurgeLowPriorityStandbyList)
+//
+// Both need SeProfileSingleProcessPrivilege (administrator).  Purges are
+// rate limited and each one is appended to DataDir()/purges.csv with the
+// memory it gave back.  Correlate() sets that trace against the results
+// store, so runs with a purge can be compared with runs without one.
+//
+// On Linux /proc/meminfo stands in (the file-backed page cache for the
+// standby list) and a purge writes 1 to /proc/sys/vm/drop_caches.
+namespace standby_list {
+
+// ─── Memory state ────────────────────────────────────────────────────────────
+
+// Bytes.
+struct MemoryState {
+    uint64_t total    = 0;
+    uint64_t free     = 0;   // free + zeroed pages          (Linux: MemFree)
+    uint64_t standby  = 0;   // standby list, all priorities (Linux: Active(file) + Inactive(file))
+    uint64_t modified = 0;   // modified list                (Linux: Dirty)
+};
+
+bool Query(MemoryState& out, std::string& error);
+
+// /proc/meminfo text; false when MemTotal or MemFree is missing.
+bool ParseMeminfo(const std::string& text, MemoryState& out);
+
+// "1234 MiB"
+std::string FormatMiB(uint64_t bytes);
+
+// "total 16384 MiB, free 812 MiB, standby 6120 MiB, modified 95 MiB"
+std::string Describe(const MemoryState& m);
+
+// ─── Purge policy ────────────────────────────────────────────────────────────
+
+enum class Command {
+    Standby,              // the whole standby list
+    LowPriorityStandby,   // priorities 0..1 only: prefetch and low-priority I/O
+};
+
+const char* CommandName(Command c);   // "standby" / "low-priority"
+
+bool Purge(Command c, std::string& error);
+
+struct Policy {
+    uint64_t freeBelow    = 1024ULL << 20;   // purge once free memory is below this
+    uint64_t standbyAbove = 1024ULL << 20;   // and the standby list holds at least this
+    uint32_t minGapS      = 60;              // seconds between purges
+    Command  command      = Command::Standby;
+};
+
+enum class Decision { Wait, Purge, RateLimited, NothingToPurge };
+
+const char* DecisionName(Decision d);
+
+// `sinceLastS` is the time since the previous purge, negative when there
+// has been none.
+Decision Decide(const Policy& p, const MemoryState& m, double sinceLastS);
+
+// ─── Trace ───────────────────────────────────────────────────────────────────
+
+struct PurgeRecord {
+    int64_t     timestamp = 0;   // Unix seconds, UTC
+    Command     command   = Command::Standby;
+    bool        ok        = false;
+    MemoryState before, after;
+    double      durationMs = 0;
+    std::string error;
+
+    // Free memory gained (negative when something else allocated meanwhile).
+    int64_t Reclaimed() const { return static_cast<int64_t>(after.free) - static_cast<int64_t>(before.free); }
+};
+
+// DataDir()/purges.csv
+std::string DefaultTracePath();
+
+// One CSV line without the newline; ParseRecord accepts what it writes.
+std::string FormatRecord(const PurgeRecord& r);
+bool        ParseRecord(const std::string& line, PurgeRecord& out);
+
+bool AppendTrace(const std::string& path, const PurgeRecord& r, std::string& error);   // writes the header once
+bool LoadTrace(const std::string& path, std::vector<PurgeRecord>& out, std::string& error);   // missing file = none
+
+// ─── Monitor ─────────────────────────────────────────────────────────────────
+
+// Samples memory on each Poll() and purges when the policy says so.
+class Monitor {
+public:
+    explicit Monitor(const Policy& p) : m_policy(p) {}
+
+    // Fills `now`; when it purged, fills `purged` too and returns
+    // Decision::Purge (whether or not the purge succeeded).
+    Decision Poll(MemoryState& now, PurgeRecord& purged, std::string& error);
+
+    // Purges regardless of the thresholds (still recorded).
+    PurgeRecord PurgeNow(const MemoryState& before);
+
+    uint32_t Purges() const { return m_purges; }
+
+private:
+    Policy   m_policy;
+    uint64_t m_lastNs = 0;   // bench_clock time of the last purge, 0 = none
+    uint32_t m_purges = 0;
+};
+
+// ─── Correlation ─────────────────────────────────────────────────────────────
+
+// One probe series split by whether a purge fell inside the run: the
+// `windowS` seconds before the record's timestamp (the end of the run).
+struct Correlation {
+    std::string      probe;
+    std::string      label;
+    uint32_t         withPurge = 0, without = 0;
+    double           p99With = 0, p99Without = 0;   // median of the runs' p99, microseconds
+    stats::ShiftTest shift;                         // positive effect = purges made p99 worse
+};
+
+std::vector<Correlation> Correlate(const std::vector<results_store::Point>& points,
+                                   const std::vector<PurgeRecord>& purges, int64_t windowS);
+
+std::string Describe(const std::vector<Correlation>& c);
+
+} // namespace standby_list
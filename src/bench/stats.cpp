@@ -0,0 +1,80 @@
+#include "stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+
+namespace stats {
+
+double PercentileSorted(const std::vector<float>& sorted, double percentile)
+{
+    if (sorted.empty()) return 0.0;
+    percentile = std::clamp(percentile, 0.0, 100.0);
+
+    double pos = percentile / 100.0 * static_cast<double>(sorted.size() - 1);
+    std::size_t lo = static_cast<std::size_t>(pos);
+    std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+    double frac = pos - static_cast<double>(lo);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+}
+
+double TailMean(std::vector<float> values, double fraction)
+{
+    if (values.empty()) return 0.0;
+
+    std::size_t n = static_cast<std::size_t>(std::ceil(values.size() * fraction));
+    n = std::clamp<std::size_t>(n, 1, values.size());
+    std::nth_element(values.begin(), values.begin() + (n - 1), values.end(),
+                     std::greater<float>());
+    double sum = std::accumulate(values.begin(), values.begin() + n, 0.0);
+    return sum / static_cast<double>(n);
+}
+
+ShiftTest MannWhitney(std::vector<float> baseline, std::vector<float> candidate)
+{
+    ShiftTest t;
+    const double na = static_cast<double>(candidate.size());
+    const double nb = static_cast<double>(baseline.size());
+    if (na == 0 || nb == 0) return t;
+
+    std::sort(baseline.begin(), baseline.end());
+    std::sort(candidate.begin(), candidate.end());
+
+    // Merge the two sorted samples, assigning average ranks to tie groups.
+    double rankSum = 0.0;   // rank sum of `candidate`
+    double tieSum  = 0.0;   // sum of (t^3 - t) over tie groups
+    double rank    = 0.0;   // ranks handed out so far
+    std::size_t i = 0, j = 0;
+    while (i < candidate.size() || j < baseline.size())
+    {
+        float v;
+        if (j >= baseline.size())        v = candidate[i];
+        else if (i >= candidate.size())  v = baseline[j];
+        else                             v = std::min(candidate[i], baseline[j]);
+
+        double ca = 0, cb = 0;
+        while (i < candidate.size() && candidate[i] == v) { ++i; ++ca; }
+        while (j < baseline.size()  && baseline[j]  == v) { ++j; ++cb; }
+
+        double tieCount = ca + cb;
+        double avgRank  = rank + (tieCount + 1.0) / 2.0;
+        rankSum += ca * avgRank;
+        tieSum  += tieCount * tieCount * tieCount - tieCount;
+        rank    += tieCount;
+    }
+
+    const double n     = na + nb;
+    const double u     = rankSum - na * (na + 1.0) / 2.0;
+    const double mean  = na * nb / 2.0;
+    const double var   = na * nb / 12.0 * ((n + 1.0) - tieSum / (n * (n - 1.0)));
+
+    t.effect = 2.0 * u / (na * nb) - 1.0;
+    if (var <= 0.0) return t;
+
+    t.z      = (u - mean) / std::sqrt(var);
+    t.pValue = std::erfc(std::fabs(t.z) / std::sqrt(2.0));
+    return t;
+}
+
+} // namespace stats
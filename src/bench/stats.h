@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Small statistics helpers shared by the analyzers.
+namespace stats {
+
+// Linear-interpolated percentile (0..100) of an ascending-sorted sample.
+double PercentileSorted(const std::vector<float>& sorted, double percentile);
+
+// Mean of the largest `fraction` (0..1] of an unsorted sample, e.g. the
+// slowest 1% of frame times.  Returns 0 for an empty sample.
+double TailMean(std::vector<float> values, double fraction);
+
+// Result of a two-sample location-shift test.
+struct ShiftTest {
+    double z       = 0.0;
+    double pValue  = 1.0;
+    // Rank-biserial effect size in -1..1: positive when `candidate` tends
+    // to be larger than `baseline`, 0 when neither dominates.
+    double effect  = 0.0;
+};
+
+// Mann-Whitney U test (normal approximation with tie correction).  Makes no
+// normality assumption, which matters for long-tailed latency data.
+ShiftTest MannWhitney(std::vector<float> baseline, std::vector<float> candidate);
+
+} // namespace stats
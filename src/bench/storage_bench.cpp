@@ -0,0 +1,696 @@
+#include "storage_bench.h"
+#include "bench_clock.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__linux__) && defined(__NR_io_uring_setup) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define STORAGE_BENCH_URING 1
+#endif
+#endif
+
+namespace storage_bench {
+
+// ─── Aligned buffers ─────────────────────────────────────────────────────────
+
+// Unbuffered I/O needs sector-aligned memory; page alignment covers every
+// sector size in use.
+class AlignedBuffer {
+public:
+    explicit AlignedBuffer(std::size_t bytes) : m_bytes(bytes)
+    {
+#ifdef _WIN32
+        m_data = static_cast<unsigned char*>(VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+        void* p = nullptr;
+        if (posix_memalign(&p, 4096, bytes) == 0) m_data = static_cast<unsigned char*>(p);
+#endif
+    }
+
+    ~AlignedBuffer()
+    {
+        if (!m_data) return;
+#ifdef _WIN32
+        VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+        std::free(m_data);
+#endif
+    }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    unsigned char* Data() const { return m_data; }
+    std::size_t    Size() const { return m_bytes; }
+
+private:
+    unsigned char* m_data  = nullptr;
+    std::size_t    m_bytes = 0;
+};
+
+// Incompressible fill, so SSD controllers that compress or dedupe cannot
+// short-circuit the writes.
+static void FillRandom(AlignedBuffer& buf, std::mt19937_64& rng)
+{
+    auto* words = reinterpret_cast<uint64_t*>(buf.Data());
+    for (std::size_t i = 0; i < buf.Size() / sizeof(uint64_t); ++i) words[i] = rng();
+}
+
+// ─── Scratch file ────────────────────────────────────────────────────────────
+
+// Unbuffered scratch file, deleted when closed.  Overlapped on Windows when
+// it will be driven through a completion port.
+class ScratchFile {
+public:
+    ~ScratchFile() { Close(); }
+
+    bool Create(const std::string& path, bool overlapped, std::string& error, std::string& note)
+    {
+#ifdef _WIN32
+        (void)note;
+        m_overlapped = overlapped;
+        m_handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE | FILE_FLAG_NO_BUFFERING |
+                               FILE_FLAG_RANDOM_ACCESS | (overlapped ? FILE_FLAG_OVERLAPPED : 0), nullptr);
+        if (m_handle == INVALID_HANDLE_VALUE)
+        {
+            error = "cannot create " + path + " (error " + std::to_string(GetLastError()) + ")";
+            return false;
+        }
+        m_event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        return true;
+#else
+        (void)overlapped;
+        m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_DIRECT, 0600);
+        if (m_fd < 0 && errno == EINVAL)   // tmpfs and friends have no O_DIRECT
+        {
+            m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+            if (m_fd >= 0 && note.empty())
+                note = "filesystem does not support O_DIRECT: latencies include the page cache";
+        }
+        if (m_fd < 0)
+        {
+            error = "cannot create " + path + ": " + std::strerror(errno);
+            return false;
+        }
+        unlink(path.c_str());
+        return true;
+#endif
+    }
+
+    void Close()
+    {
+#ifdef _WIN32
+        if (m_event) CloseHandle(m_event);
+        if (m_handle != INVALID_HANDLE_VALUE) CloseHandle(m_handle);
+        m_event  = nullptr;
+        m_handle = INVALID_HANDLE_VALUE;
+#else
+        if (m_fd >= 0) close(m_fd);
+        m_fd = -1;
+#endif
+    }
+
+    bool Transfer(bool write, void* buf, uint32_t len, uint64_t offset)
+    {
+#ifdef _WIN32
+        OVERLAPPED ov = {};
+        ov.Offset     = static_cast<DWORD>(offset);
+        ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        ov.hEvent     = m_event;
+        DWORD done = 0;
+        BOOL ok = write ? WriteFile(m_handle, buf, len, m_overlapped ? nullptr : &done, &ov)
+                        : ReadFile(m_handle, buf, len, m_overlapped ? nullptr : &done, &ov);
+        if (!ok && GetLastError() == ERROR_IO_PENDING)
+            ok = GetOverlappedResult(m_handle, &ov, &done, TRUE);
+        else if (ok && m_overlapped)
+            ok = GetOverlappedResult(m_handle, &ov, &done, TRUE);
+        return ok && done == len;
+#else
+        ssize_t n = write ? pwrite(m_fd, buf, len, static_cast<off_t>(offset))
+                          : pread(m_fd, buf, len, static_cast<off_t>(offset));
+        return n == static_cast<ssize_t>(len);
+#endif
+    }
+
+    // Write the whole file once so random reads hit allocated blocks.
+    bool Fill(uint64_t bytes, uint64_t seed)
+    {
+        AlignedBuffer chunk(1u << 20);
+        if (!chunk.Data()) return false;
+        std::mt19937_64 rng(seed);
+        for (uint64_t off = 0; off < bytes; off += chunk.Size())
+        {
+            FillRandom(chunk, rng);
+            uint32_t len = static_cast<uint32_t>(std::min<uint64_t>(chunk.Size(), bytes - off));
+            if (!Transfer(true, chunk.Data(), len, off)) return false;
+        }
+        return true;
+    }
+
+#ifdef _WIN32
+    HANDLE Handle() const { return m_handle; }
+#else
+    int Fd() const { return m_fd; }
+#endif
+
+private:
+#ifdef _WIN32
+    HANDLE m_handle     = INVALID_HANDLE_VALUE;
+    HANDLE m_event      = nullptr;
+    bool   m_overlapped = false;
+#else
+    int m_fd = -1;
+#endif
+};
+
+static std::string ScratchPath(const std::string& dir, const char* name)
+{
+    std::string d = dir.empty() ? "." : dir;
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    char leaf[64];
+    std::snprintf(leaf, sizeof(leaf), "storage_bench_%s_%lu.tmp", name, pid);
+    char last = d.back();
+    return (last == '/' || last == '\\') ? d + leaf : d + "/" + leaf;
+}
+
+// ─── Queue slots ─────────────────────────────────────────────────────────────
+
+struct Slot {
+#ifdef _WIN32
+    OVERLAPPED ov;             // first member: completions map back to the slot
+#else
+    iovec      iov;
+#endif
+    unsigned char* buf      = nullptr;
+    uint64_t       submitNs = 0;
+    bool           write    = false;
+};
+
+// Slots and their buffers; owned by Run() so they outlive the queue, which
+// must drain in-flight transfers before the memory goes away.
+struct SlotPool {
+    std::vector<std::unique_ptr<AlignedBuffer>> buffers;
+    std::vector<Slot>                           slots;
+
+    bool Allocate(uint32_t depth, uint32_t blockBytes, uint64_t seed)
+    {
+        slots.resize(depth);
+        std::mt19937_64 fill(seed);
+        for (Slot& s : slots)
+        {
+            buffers.push_back(std::make_unique<AlignedBuffer>(blockBytes));
+            if (!buffers.back()->Data()) return false;
+            FillRandom(*buffers.back(), fill);
+            s.buf = buffers.back()->Data();
+        }
+        return true;
+    }
+};
+
+// Random op and block offset for the next I/O.
+class OpPicker {
+public:
+    OpPicker(const Config& cfg, uint64_t blocks, uint64_t seed)
+        : m_rng(seed), m_blocks(blocks), m_block(cfg.blockBytes), m_readPercent(cfg.readPercent) {}
+
+    uint64_t Next(bool& write)
+    {
+        write = (m_rng() % 100) >= m_readPercent;
+        return (m_rng() % m_blocks) * m_block;
+    }
+
+private:
+    std::mt19937_64 m_rng;
+    uint64_t        m_blocks;
+    uint64_t        m_block;
+    uint32_t        m_readPercent;
+};
+
+// ─── Windows: overlapped I/O on a completion port ────────────────────────────
+
+#ifdef _WIN32
+
+class AsyncQueue {
+public:
+    ~AsyncQueue()
+    {
+        // Never free slot buffers under an in-flight transfer.
+        if (m_inflight && m_file != INVALID_HANDLE_VALUE)
+        {
+            CancelIoEx(m_file, nullptr);
+            DWORD bytes = 0;
+            ULONG_PTR key = 0;
+            OVERLAPPED* ov = nullptr;
+            while (m_inflight && (GetQueuedCompletionStatus(m_port, &bytes, &key, &ov, 5000) || ov))
+                --m_inflight;
+        }
+        if (m_port) CloseHandle(m_port);
+    }
+
+    static const char* Name() { return "overlapped (IOCP)"; }
+
+    bool Open(ScratchFile& file, uint32_t, uint32_t blockBytes, std::string& error)
+    {
+        m_file  = file.Handle();
+        m_block = blockBytes;
+        m_port  = CreateIoCompletionPort(m_file, nullptr, 0, 1);
+        if (!m_port) error = "CreateIoCompletionPort failed (error " + std::to_string(GetLastError()) + ")";
+        return m_port != nullptr;
+    }
+
+    bool Submit(Slot& s, uint64_t offset, std::string& error)
+    {
+        std::memset(&s.ov, 0, sizeof(s.ov));
+        s.ov.Offset     = static_cast<DWORD>(offset);
+        s.ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        s.submitNs      = bench_clock::NowNs();
+        BOOL ok = s.write ? WriteFile(m_file, s.buf, m_block, nullptr, &s.ov)
+                          : ReadFile(m_file, s.buf, m_block, nullptr, &s.ov);
+        if (!ok && GetLastError() != ERROR_IO_PENDING)
+        {
+            error = std::string(s.write ? "WriteFile" : "ReadFile") + " failed (error " +
+                    std::to_string(GetLastError()) + ")";
+            return false;
+        }
+        ++m_inflight;
+        return true;
+    }
+
+    // Next completed slot; nullptr only if the port itself failed.
+    Slot* Wait(std::string& error)
+    {
+        DWORD bytes = 0;
+        ULONG_PTR key = 0;
+        OVERLAPPED* ov = nullptr;
+        BOOL ok = GetQueuedCompletionStatus(m_port, &bytes, &key, &ov, INFINITE);
+        if (!ov)
+        {
+            error = "GetQueuedCompletionStatus failed (error " + std::to_string(GetLastError()) + ")";
+            return nullptr;
+        }
+        --m_inflight;
+        if ((!ok || bytes != m_block) && error.empty())
+            error = "I/O failed (error " + std::to_string(GetLastError()) + ")";
+        return reinterpret_cast<Slot*>(ov);
+    }
+
+private:
+    HANDLE   m_file     = INVALID_HANDLE_VALUE;
+    HANDLE   m_port     = nullptr;
+    uint32_t m_block    = 0;
+    uint32_t m_inflight = 0;
+};
+
+#elif defined(STORAGE_BENCH_URING)
+
+// ─── Linux: io_uring via raw syscalls ────────────────────────────────────────
+
+// Minimal ring: READV/WRITEV (kernel 5.1+), one iovec per slot, submissions
+// batched into the io_uring_enter call that waits for the next completion.
+class AsyncQueue {
+public:
+    ~AsyncQueue()
+    {
+        if (m_sqes) munmap(m_sqes, m_sqesBytes);
+        if (m_cqRing && m_cqRing != m_sqRing) munmap(m_cqRing, m_cqBytes);
+        if (m_sqRing) munmap(m_sqRing, m_sqBytes);
+        if (m_ring >= 0) close(m_ring);   // waits for in-flight requests
+    }
+
+    static const char* Name() { return "io_uring"; }
+
+    bool Open(ScratchFile& file, uint32_t depth, uint32_t blockBytes, std::string& error)
+    {
+        m_fd    = file.Fd();
+        m_block = blockBytes;
+
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        m_ring = static_cast<int>(syscall(__NR_io_uring_setup, depth, &p));
+        if (m_ring < 0)
+        {
+            error = std::string("io_uring_setup: ") + std::strerror(errno);
+            return false;
+        }
+
+        m_sqBytes = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+        m_cqBytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        if (p.features & IORING_FEAT_SINGLE_MMAP)
+            m_sqBytes = m_cqBytes = std::max(m_sqBytes, m_cqBytes);
+
+        m_sqRing = Map(m_sqBytes, IORING_OFF_SQ_RING);
+        m_cqRing = (p.features & IORING_FEAT_SINGLE_MMAP) ? m_sqRing : Map(m_cqBytes, IORING_OFF_CQ_RING);
+        m_sqesBytes = p.sq_entries * sizeof(io_uring_sqe);
+        m_sqes = Map(m_sqesBytes, IORING_OFF_SQES);
+        if (!m_sqRing || !m_cqRing || !m_sqes)
+        {
+            error = std::string("io_uring mmap: ") + std::strerror(errno);
+            return false;
+        }
+
+        auto* sq = static_cast<unsigned char*>(m_sqRing);
+        auto* cq = static_cast<unsigned char*>(m_cqRing);
+        m_sqTail  = reinterpret_cast<uint32_t*>(sq + p.sq_off.tail);
+        m_sqMask  = *reinterpret_cast<uint32_t*>(sq + p.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<uint32_t*>(sq + p.sq_off.array);
+        m_cqHead  = reinterpret_cast<uint32_t*>(cq + p.cq_off.head);
+        m_cqTail  = reinterpret_cast<uint32_t*>(cq + p.cq_off.tail);
+        m_cqMask  = *reinterpret_cast<uint32_t*>(cq + p.cq_off.ring_mask);
+        m_cqes    = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    bool Submit(Slot& s, uint64_t offset, std::string&)
+    {
+        uint32_t tail  = *m_sqTail;
+        uint32_t index = tail & m_sqMask;
+        auto* sqe = static_cast<io_uring_sqe*>(m_sqes) + index;
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode    = s.write ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->fd        = m_fd;
+        sqe->addr      = reinterpret_cast<uint64_t>(&s.iov);
+        sqe->len       = 1;
+        sqe->off       = offset;
+        sqe->user_data = reinterpret_cast<uint64_t>(&s);
+        m_sqArray[index] = index;
+
+        s.iov.iov_base = s.buf;
+        s.iov.iov_len  = m_block;
+        s.submitNs     = bench_clock::NowNs();
+        __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++m_pending;
+        return true;
+    }
+
+    Slot* Wait(std::string& error)
+    {
+        for (;;)
+        {
+            uint32_t head = *m_cqHead;
+            if (head != __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+            {
+                const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+                Slot* s = reinterpret_cast<Slot*>(cqe.user_data);
+                if (cqe.res != static_cast<int32_t>(m_block) && error.empty())
+                    error = cqe.res < 0 ? std::string("I/O failed: ") + std::strerror(-cqe.res)
+                                        : std::string("short transfer");
+                __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+                return s;
+            }
+
+            long n = syscall(__NR_io_uring_enter, m_ring, m_pending, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (n < 0)
+            {
+                if (errno == EINTR) continue;
+                error = std::string("io_uring_enter: ") + std::strerror(errno);
+                return nullptr;
+            }
+            m_pending -= static_cast<uint32_t>(n);
+        }
+    }
+
+private:
+    void* Map(std::size_t bytes, off_t offset)
+    {
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    int           m_ring      = -1;
+    int           m_fd        = -1;
+    uint32_t      m_block     = 0;
+    uint32_t      m_pending   = 0;
+    void*         m_sqRing    = nullptr;
+    void*         m_cqRing    = nullptr;
+    void*         m_sqes      = nullptr;
+    std::size_t   m_sqBytes   = 0;
+    std::size_t   m_cqBytes   = 0;
+    std::size_t   m_sqesBytes = 0;
+    uint32_t*     m_sqTail    = nullptr;
+    uint32_t*     m_sqArray   = nullptr;
+    uint32_t      m_sqMask    = 0;
+    uint32_t*     m_cqHead    = nullptr;
+    uint32_t*     m_cqTail    = nullptr;
+    uint32_t      m_cqMask    = 0;
+    io_uring_cqe* m_cqes      = nullptr;
+};
+
+#endif
+
+// ─── Engines ─────────────────────────────────────────────────────────────────
+
+struct Window {
+    uint64_t measureFrom = 0;   // submissions before this are warm-up
+    uint64_t stopAt      = 0;
+};
+
+static bool Stopped(const Window& w, const std::atomic<bool>* cancel)
+{
+    return bench_clock::NowNs() >= w.stopAt || (cancel && cancel->load());
+}
+
+#if defined(_WIN32) || defined(STORAGE_BENCH_URING)
+
+// Keeps cfg.queueDepth I/Os in flight: every completion is recorded and
+// immediately replaced by a new random I/O until the window closes.
+static bool RunAsync(AsyncQueue& queue, SlotPool& pool, const Config& cfg, uint64_t blocks,
+                     const Window& w, const std::atomic<bool>* cancel, Result& r)
+{
+    OpPicker pick(cfg, blocks, cfg.seed);
+    uint32_t inflight = 0;
+    for (Slot& s : pool.slots)
+    {
+        uint64_t offset = pick.Next(s.write);
+        if (!queue.Submit(s, offset, r.error)) break;
+        ++inflight;
+    }
+
+    while (inflight)
+    {
+        Slot* s = queue.Wait(r.error);
+        if (!s) return false;
+        uint64_t now = bench_clock::NowNs();
+        --inflight;
+
+        if (s->submitNs >= w.measureFrom)
+            (s->write ? r.writes : r.reads).Record(now - s->submitNs);
+
+        if (r.error.empty() && !Stopped(w, cancel))
+        {
+            uint64_t offset = pick.Next(s->write);
+            if (queue.Submit(*s, offset, r.error)) ++inflight;
+        }
+    }
+    return r.error.empty();
+}
+
+#endif
+
+#ifndef _WIN32
+
+// Fallback: one blocking pread/pwrite thread per queue slot, which holds the
+// same number of I/Os in flight without an async interface.
+static bool RunThreads(ScratchFile& file, const Config& cfg, uint64_t blocks, const Window& w,
+                       const std::atomic<bool>* cancel, Result& r)
+{
+    struct Worker {
+        LatencyHistogram reads;
+        LatencyHistogram writes;
+        std::string      error;
+    };
+    std::vector<Worker> workers(cfg.queueDepth);
+    std::vector<std::thread> threads;
+
+    for (uint32_t i = 0; i < cfg.queueDepth; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            Worker& me = workers[i];
+            AlignedBuffer buf(cfg.blockBytes);
+            if (!buf.Data()) { me.error = "cannot allocate I/O buffer"; return; }
+            std::mt19937_64 fill(cfg.seed + i);
+            FillRandom(buf, fill);
+
+            OpPicker pick(cfg, blocks, cfg.seed * 1000003ULL + i);
+            while (!Stopped(w, cancel))
+            {
+                bool write = false;
+                uint64_t offset = pick.Next(write);
+                uint64_t t0 = bench_clock::NowNs();
+                if (!file.Transfer(write, buf.Data(), cfg.blockBytes, offset))
+                {
+                    me.error = std::string("I/O failed: ") + std::strerror(errno);
+                    return;
+                }
+                uint64_t t1 = bench_clock::NowNs();
+                if (t0 >= w.measureFrom) (write ? me.writes : me.reads).Record(t1 - t0);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    for (const Worker& wk : workers)
+    {
+        r.reads.Merge(wk.reads);
+        r.writes.Merge(wk.writes);
+        if (!wk.error.empty() && r.error.empty()) r.error = wk.error;
+    }
+    return r.error.empty();
+}
+
+#endif
+
+// ─── Background scanner ──────────────────────────────────────────────────────
+
+// Indexer / prefetcher stand-in: streams sequentially through its own file
+// in large unbuffered reads, optionally rate limited.
+class Scanner {
+public:
+    bool Prepare(const Config& cfg, std::string& error, std::string& note)
+    {
+        m_cfg   = cfg;
+        m_bytes = ((cfg.scanBytes ? cfg.scanBytes : cfg.fileBytes) / cfg.scanChunk) * cfg.scanChunk;
+        if (m_bytes == 0) { error = "scanner file smaller than one chunk"; return false; }
+        if (!m_file.Create(ScratchPath(cfg.directory, "scan"), false, error, note)) return false;
+        if (!m_file.Fill(m_bytes, cfg.seed + 7)) { error = "cannot write scanner file"; return false; }
+        return true;
+    }
+
+    void Start(uint64_t measureFrom)
+    {
+        m_thread = std::thread([this, measureFrom]() {
+            AlignedBuffer chunk(m_cfg.scanChunk);
+            if (!chunk.Data()) return;
+            const uint64_t start = bench_clock::NowNs();
+            uint64_t total = 0;
+            for (uint64_t off = 0; !m_stop.load(); off = (off + m_cfg.scanChunk) % m_bytes)
+            {
+                if (!m_file.Transfer(false, chunk.Data(), m_cfg.scanChunk, off)) return;
+                total += m_cfg.scanChunk;
+                if (bench_clock::NowNs() >= measureFrom) m_measured += m_cfg.scanChunk;
+                if (m_cfg.scanMBps)
+                    bench_clock::SleepUntilNs(start + total * 1000 / m_cfg.scanMBps);
+            }
+        });
+    }
+
+    uint64_t Stop()
+    {
+        m_stop = true;
+        if (m_thread.joinable()) m_thread.join();
+        return m_measured.load();
+    }
+
+    ~Scanner() { Stop(); }
+
+private:
+    Config                m_cfg;
+    ScratchFile           m_file;
+    uint64_t              m_bytes = 0;
+    std::thread           m_thread;
+    std::atomic<bool>     m_stop{false};
+    std::atomic<uint64_t> m_measured{0};
+};
+
+// ─── Benchmark ───────────────────────────────────────────────────────────────
+
+Result Run(const Config& cfg, const std::atomic<bool>* cancel)
+{
+    Result r;
+    if (cfg.blockBytes < 512 || cfg.blockBytes % 512 != 0) { r.error = "block size must be a multiple of 512"; return r; }
+    if (cfg.queueDepth == 0 || cfg.queueDepth > 4096)    { r.error = "queue depth must be 1..4096"; return r; }
+    if (cfg.readPercent > 100)                           { r.error = "read percentage must be 0..100"; return r; }
+    if (cfg.scanner && (cfg.scanChunk < 4096 || cfg.scanChunk % 4096 != 0))
+    {
+        r.error = "scanner chunk must be a multiple of 4K";
+        return r;
+    }
+
+    const uint64_t blocks = cfg.fileBytes / cfg.blockBytes;
+    if (blocks == 0) { r.error = "file smaller than one block"; return r; }
+
+    ScratchFile file;
+#ifdef _WIN32
+    const bool overlapped = true;
+#else
+    const bool overlapped = false;
+#endif
+    if (!file.Create(ScratchPath(cfg.directory, "io"), overlapped, r.error, r.note)) return r;
+    if (!file.Fill(blocks * cfg.blockBytes, cfg.seed)) { r.error = "cannot write scratch file"; return r; }
+
+    Scanner scanner;
+    if (cfg.scanner && !scanner.Prepare(cfg, r.error, r.note)) return r;
+
+    Window w;
+    const uint64_t start = bench_clock::NowNs();
+    w.measureFrom = start + static_cast<uint64_t>(cfg.warmupMs) * 1000000ULL;
+    w.stopAt      = w.measureFrom + static_cast<uint64_t>(cfg.durationMs) * 1000000ULL;
+    if (cfg.scanner) scanner.Start(w.measureFrom);
+
+    bool ok = false;
+    std::string why;
+#if defined(_WIN32) || defined(STORAGE_BENCH_URING)
+    SlotPool   pool;
+    AsyncQueue queue;
+    if (!pool.Allocate(cfg.queueDepth, cfg.blockBytes, cfg.seed ^ 0x5bd1e995ULL))
+    {
+        r.error = "cannot allocate I/O buffers";
+        return r;
+    }
+    if (!cfg.forceThreads && queue.Open(file, cfg.queueDepth, cfg.blockBytes, why))
+    {
+        r.engine = AsyncQueue::Name();
+        ok = RunAsync(queue, pool, cfg, blocks, w, cancel, r);
+    }
+    else
+#endif
+    {
+#ifdef _WIN32
+        r.error = why.empty() ? "the threads engine is Linux-only" : why;
+#else
+        if (!cfg.forceThreads)
+            r.note += (r.note.empty() ? "" : "; ") +
+                      (why.empty() ? std::string("io_uring not available in this build") : why) +
+                      ": using blocking threads";
+        r.engine = "threads (pread/pwrite)";
+        ok = RunThreads(file, cfg, blocks, w, cancel, r);
+#endif
+    }
+
+    const uint64_t end = bench_clock::NowNs();
+    r.scanBytes = cfg.scanner ? scanner.Stop() : 0;
+    r.seconds   = end > w.measureFrom ? static_cast<double>(end - w.measureFrom) / 1e9 : 0.0;
+    r.ok        = ok;
+    return r;
+}
+
+std::string Describe(const Config& cfg, const Result& r)
+{
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "%s  QD%u  %u%% read  %u KiB%s", r.engine.c_str(), cfg.queueDepth,
+                  cfg.readPercent, cfg.blockBytes / 1024, cfg.scanner ? "  + scanner" : "");
+    return buf;
+}
+
+} // namespace storage_bench
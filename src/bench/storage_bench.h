@@ -0,0 +1,55 @@
+#pragma once
+#include "histogram.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Storage tail latency.  Issues unbuffered random reads and writes at a fixed
+// queue depth against a scratch file and records the latency of every I/O,
+// optionally while a synthetic "indexer" thread streams sequentially through
+// a second file.  Quantifies the disk-contention argument behind the
+// SysMain / Windows Search tweaks.
+//
+// Engines: overlapped I/O on an I/O completion port (Windows), io_uring via
+// raw syscalls with O_DIRECT (Linux), or one blocking thread per queue slot
+// where io_uring is unavailable.
+namespace storage_bench {
+
+struct Config {
+    std::string directory    = ".";         // where the scratch files go
+    uint64_t    fileBytes    = 1ULL << 30;  // random-I/O target, written once up front
+    uint32_t    blockBytes   = 4096;        // multiple of the sector size
+    uint32_t    queueDepth   = 32;
+    uint32_t    readPercent  = 70;          // remainder are writes
+    uint32_t    warmupMs     = 1000;        // completions in this window are discarded
+    uint32_t    durationMs   = 10000;
+    uint64_t    seed         = 1;
+    bool        forceThreads = false;       // Linux: skip io_uring
+
+    // Background scanner: sequential unbuffered reads of its own file.
+    bool        scanner      = false;
+    uint64_t    scanBytes    = 0;           // 0 = fileBytes
+    uint32_t    scanChunk    = 1u << 20;
+    uint32_t    scanMBps     = 0;           // 0 = unthrottled
+};
+
+struct Result {
+    bool             ok = false;
+    std::string      error;
+    std::string      note;              // e.g. O_DIRECT not supported by the filesystem
+    std::string      engine;
+    double           seconds = 0.0;     // measured window
+    LatencyHistogram reads;
+    LatencyHistogram writes;
+    uint64_t         scanBytes = 0;     // read by the scanner during the measured window
+};
+
+// Creates and fills the scratch file(s), then blocks for warm-up + duration
+// (or until `cancel`).  Scratch files are deleted on return.
+Result Run(const Config& cfg, const std::atomic<bool>* cancel = nullptr);
+
+// "io_uring  QD32  70% read  4 KiB" style one-liner for reports.
+std::string Describe(const Config& cfg, const Result& r);
+
+} // namespace storage_bench
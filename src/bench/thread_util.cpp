@@ -0,0 +1,71 @@
+#include "thread_util.h"
+
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace thread_util {
+
+uint32_t LogicalCpuCount()
+{
+#ifdef _WIN32
+    DWORD n = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    return n ? static_cast<uint32_t>(n) : 1;
+#else
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+#endif
+}
+
+bool PinCurrentThread(uint32_t cpu)
+{
+#ifdef _WIN32
+    // Translate the flat index into (group, bit); groups may be uneven.
+    WORD groups = GetActiveProcessorGroupCount();
+    for (WORD g = 0; g < groups; ++g)
+    {
+        DWORD inGroup = GetActiveProcessorCount(g);
+        if (cpu < inGroup)
+        {
+            GROUP_AFFINITY ga = {};
+            ga.Group = g;
+            ga.Mask  = static_cast<KAFFINITY>(1) << cpu;
+            return SetThreadGroupAffinity(GetCurrentThread(), &ga, nullptr) != 0;
+        }
+        cpu -= inGroup;
+    }
+    return false;
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
+
+bool RaiseToRealtime(std::string& note)
+{
+#ifdef _WIN32
+    if (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL))
+        return true;
+    note = "SetThreadPriority failed (error " + std::to_string(GetLastError()) + ")";
+    return false;
+#else
+    sched_param sp{};
+    sp.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+    if (err == 0) return true;
+    note = std::string("SCHED_FIFO denied (") + std::strerror(err) +
+           "; needs CAP_SYS_NICE or an rtprio limit)";
+    return false;
+#endif
+}
+
+} // namespace thread_util
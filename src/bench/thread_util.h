@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Thread placement helpers shared by the probes and the load generator.
+// CPUs are numbered 0..LogicalCpuCount()-1 across all processor groups.
+namespace thread_util {
+
+uint32_t LogicalCpuCount();
+
+// Restrict the calling thread to one logical CPU.
+bool PinCurrentThread(uint32_t cpu);
+
+// Highest ordinary real-time priority for the calling thread:
+// THREAD_PRIORITY_TIME_CRITICAL on Windows, SCHED_FIFO (max - 1) on Linux.
+// On failure `note` explains why and the thread keeps its priority.
+bool RaiseToRealtime(std::string& note);
+
+} // namespace thread_util
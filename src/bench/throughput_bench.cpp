@@ -0,0 +1,285 @@
+#include "throughput_bench.h"
+#include "bench_clock.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/select.h>
+#endif
+
+namespace throughput_bench {
+
+// ─── Wire format ─────────────────────────────────────────────────────────────
+// Request header sent by the client on every connection (host byte order;
+// both ends are little-endian x86/ARM in practice).
+
+static constexpr uint32_t kMagic  = 0x4C4F4254;   // "TBOL"
+static constexpr uint32_t kPollMs = 200;
+
+// A client that stops sending or reading for this long is dropped, so a
+// stalled peer cannot pin a server thread (and Stop()) forever.
+static constexpr uint32_t kServerTimeoutMs = 10000;
+
+struct RequestHeader {
+    uint32_t magic;
+    uint32_t direction;
+    uint64_t bytes;
+};
+
+static std::string SocketError(const char* what)
+{
+    return std::string(what) + " failed (error " +
+           std::to_string(socket_compat::LastError()) + ")";
+}
+
+// Push `bytes` bytes in chunkSize pieces.
+static bool SendBulk(socket_t s, uint64_t bytes, uint32_t chunkSize)
+{
+    std::vector<char> buf(chunkSize, 'b');
+    while (bytes > 0)
+    {
+        std::size_t n = static_cast<std::size_t>(std::min<uint64_t>(bytes, chunkSize));
+        if (!socket_compat::SendAll(s, buf.data(), n)) return false;
+        bytes -= n;
+    }
+    return true;
+}
+
+// Drain exactly `bytes` bytes.
+static bool RecvBulk(socket_t s, uint64_t bytes, uint32_t chunkSize)
+{
+    std::vector<char> buf(chunkSize);
+    while (bytes > 0)
+    {
+        int want = static_cast<int>(std::min<uint64_t>(bytes, chunkSize));
+        int n = recv(s, buf.data(), want, 0);
+        if (n <= 0) return false;
+        bytes -= static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+static std::string FormatBytes(uint64_t bytes)
+{
+    if (bytes == 0)                  return "auto";
+    if (bytes % (1ull << 20) == 0)   return std::to_string(bytes >> 20) + "MiB";
+    if (bytes % (1ull << 10) == 0)   return std::to_string(bytes >> 10) + "KiB";
+    return std::to_string(bytes) + "B";
+}
+
+std::string Describe(const Config& cfg)
+{
+    return std::string(cfg.direction == Direction::Upload ? "upload " : "download ") +
+           std::to_string(cfg.streams) + "x" + FormatBytes(cfg.bytesPerStream) +
+           " buf=" + FormatBytes(cfg.bufferSize);
+}
+
+// ─── Client ──────────────────────────────────────────────────────────────────
+
+static void RunStream(socket_t s, const Config& cfg, StreamResult& out, bool& ok)
+{
+    RequestHeader hdr{ kMagic, static_cast<uint32_t>(cfg.direction), cfg.bytesPerStream };
+    uint64_t t0 = bench_clock::NowNs();
+
+    ok = socket_compat::SendAll(s, reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    if (ok)
+    {
+        ok = (cfg.direction == Direction::Upload)
+            ? SendBulk(s, cfg.bytesPerStream, cfg.chunkSize)
+            : RecvBulk(s, cfg.bytesPerStream, cfg.chunkSize);
+    }
+
+    // Trailer: the server's retransmit count.  For uploads it doubles as the
+    // "all bytes drained" acknowledgement that ends the timed section.
+    uint64_t serverRetrans = 0;
+    ok = ok && socket_compat::RecvAll(s, reinterpret_cast<char*>(&serverRetrans),
+                                      sizeof(serverRetrans));
+    out.elapsedNs = bench_clock::NowNs() - t0;
+    if (!ok) return;
+
+    socket_compat::TcpStats stats;
+    socket_compat::QueryTcpStats(s, stats);
+    out.bytes           = cfg.bytesPerStream;
+    out.rttUs           = stats.rttUs;
+    out.retransSegments = (cfg.direction == Direction::Upload) ? stats.retransSegments
+                                                                : serverRetrans;
+}
+
+Result Run(const Config& cfg)
+{
+    Result r;
+    if (!socket_compat::Startup()) { r.error = "socket startup failed"; return r; }
+
+    sockaddr_storage addr{};
+    socklen_t addrLen = 0;
+    if (!socket_compat::Resolve(cfg.host, cfg.port, SOCK_STREAM, addr, addrLen))
+    {
+        r.error = "cannot resolve " + cfg.host;
+        return r;
+    }
+
+    // Connect every stream first so all transfers start together.
+    std::vector<socket_t> sockets;
+    for (uint32_t i = 0; i < cfg.streams && r.error.empty(); ++i)
+    {
+        socket_t s = socket(addr.ss_family, SOCK_STREAM, IPPROTO_TCP);
+        if (s == kInvalidSocket) { r.error = SocketError("socket"); break; }
+        sockets.push_back(s);
+
+        // Buffer sizes must be fixed before connect() so the window scale
+        // negotiated in the SYN matches.
+        int buf = static_cast<int>(cfg.bufferSize);
+        socket_compat::SetBufferSizes(s, buf, buf);
+        socket_compat::SetRecvTimeout(s, cfg.timeoutMs);
+        if (!cfg.bindAddress.empty() && !socket_compat::BindLocal(s, cfg.bindAddress))
+            r.error = "cannot bind to " + cfg.bindAddress;
+        else if (connect(s, reinterpret_cast<sockaddr*>(&addr), addrLen) != 0)
+            r.error = SocketError("connect");
+    }
+
+    if (r.error.empty())
+    {
+        r.streams.resize(sockets.size());
+        std::vector<char> streamOk(sockets.size(), 0);
+        std::vector<std::thread> threads;
+
+        uint64_t start = bench_clock::NowNs();
+        for (std::size_t i = 0; i < sockets.size(); ++i)
+        {
+            threads.emplace_back([&, i] {
+                bool ok = false;
+                RunStream(sockets[i], cfg, r.streams[i], ok);
+                streamOk[i] = ok ? 1 : 0;
+            });
+        }
+        for (auto& t : threads) t.join();
+        r.completionNs = bench_clock::NowNs() - start;
+
+        for (std::size_t i = 0; i < sockets.size(); ++i)
+        {
+            if (!streamOk[i]) r.error = "stream " + std::to_string(i) + " transfer failed";
+            r.totalBytes      += r.streams[i].bytes;
+            r.retransSegments += r.streams[i].retransSegments;
+        }
+        if (r.completionNs)
+            r.goodputMbps = static_cast<double>(r.totalBytes) * 8.0 * 1000.0 /
+                            static_cast<double>(r.completionNs);
+    }
+
+    for (socket_t s : sockets) socket_compat::Close(s);
+    r.ok = r.error.empty();
+    return r;
+}
+
+// ─── BulkServer ──────────────────────────────────────────────────────────────
+
+BulkServer::BulkServer(uint16_t port, uint32_t bufferSize)
+    : m_port(port), m_bufferSize(bufferSize)
+{
+}
+
+BulkServer::~BulkServer()
+{
+    Stop();
+}
+
+bool BulkServer::Start()
+{
+    if (m_running) return true;
+    if (!socket_compat::Startup()) { m_error = "socket startup failed"; return false; }
+
+    m_listen = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (m_listen == kInvalidSocket) { m_error = SocketError("socket"); return false; }
+
+    // Accepted sockets inherit the listener's buffer sizes.
+    socket_compat::SetReuseAddr(m_listen);
+    int buf = static_cast<int>(m_bufferSize);
+    socket_compat::SetBufferSizes(m_listen, buf, buf);
+
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port        = htons(m_port);
+    if (bind(m_listen, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(m_listen, 64) != 0)
+    {
+        m_error = SocketError("bind/listen");
+        Stop();
+        return false;
+    }
+
+    sockaddr_in bound{};
+    socklen_t boundLen = sizeof(bound);
+    getsockname(m_listen, reinterpret_cast<sockaddr*>(&bound), &boundLen);
+    m_port = ntohs(bound.sin_port);
+
+    m_running      = true;
+    m_acceptThread = std::thread(&BulkServer::AcceptLoop, this);
+    return true;
+}
+
+void BulkServer::Stop()
+{
+    m_running = false;
+    if (m_acceptThread.joinable()) m_acceptThread.join();
+
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        threads.swap(m_threads);
+    }
+    for (auto& t : threads)
+        if (t.joinable()) t.join();
+
+    socket_compat::Close(m_listen);
+    m_listen = kInvalidSocket;
+}
+
+void BulkServer::AcceptLoop()
+{
+    while (m_running)
+    {
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(m_listen, &readSet);
+        timeval tv{};
+        tv.tv_usec = kPollMs * 1000;
+
+        if (select(static_cast<int>(m_listen) + 1, &readSet, nullptr, nullptr, &tv) <= 0)
+            continue;
+
+        socket_t client = accept(m_listen, nullptr, nullptr);
+        if (client == kInvalidSocket) continue;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.emplace_back(&BulkServer::ServeConnection, this, client);
+    }
+}
+
+void BulkServer::ServeConnection(socket_t client)
+{
+    socket_compat::SetRecvTimeout(client, kServerTimeoutMs);
+
+    RequestHeader hdr{};
+    if (socket_compat::RecvAll(client, reinterpret_cast<char*>(&hdr), sizeof(hdr)) &&
+        hdr.magic == kMagic)
+    {
+        const uint32_t chunk = 128 * 1024;
+        bool ok = (hdr.direction == static_cast<uint32_t>(Direction::Upload))
+            ? RecvBulk(client, hdr.bytes, chunk)
+            : SendBulk(client, hdr.bytes, chunk);
+
+        if (ok)
+        {
+            socket_compat::TcpStats stats;
+            socket_compat::QueryTcpStats(client, stats);
+            uint64_t retrans = stats.retransSegments;
+            socket_compat::SendAll(client, reinterpret_cast<const char*>(&retrans),
+                                   sizeof(retrans));
+        }
+    }
+    socket_compat::Close(client);
+}
+
+} // namespace throughput_bench
@@ -0,0 +1,88 @@
+#pragma once
+#include "socket_compat.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Multi-stream bulk TCP throughput benchmark.  Quantifies what the Network
+// category costs in bandwidth (e.g. DisableTCPAutoTuningTweak capping the
+// receive window on high bandwidth-delay links) so the latency/throughput
+// trade-off is measured rather than guessed.
+namespace throughput_bench {
+
+// Which side pushes the data.  Download makes this machine the receiver,
+// which is the side receive-window autotuning applies to.
+enum class Direction : uint32_t { Upload = 1, Download = 2 };
+
+struct Config {
+    std::string host           = "127.0.0.1";
+    uint16_t    port           = 7778;
+    std::string bindAddress;                  // local interface address ("" = any)
+    Direction   direction      = Direction::Download;
+    uint32_t    streams        = 4;
+    uint64_t    bytesPerStream = 256ull << 20;
+    uint32_t    bufferSize     = 0;           // SO_SNDBUF/SO_RCVBUF, 0 = OS autotuning
+    uint32_t    chunkSize      = 128 * 1024;  // bytes per send()/recv() call
+    uint32_t    timeoutMs      = 10000;       // per recv(); a stalled server fails the stream
+};
+
+struct StreamResult {
+    uint64_t bytes           = 0;
+    uint64_t elapsedNs       = 0;
+    uint64_t retransSegments = 0;   // reported by the sending side
+    uint32_t rttUs           = 0;
+};
+
+struct Result {
+    bool        ok = false;
+    std::string error;
+    uint64_t    totalBytes      = 0;
+    uint64_t    completionNs    = 0;   // first byte to last stream finished
+    double      goodputMbps     = 0.0;
+    uint64_t    retransSegments = 0;
+    std::vector<StreamResult> streams;
+};
+
+// Human-readable label, e.g. "download 4x256MiB buf=auto".
+std::string Describe(const Config& cfg);
+
+// Run one multi-stream transfer against a BulkServer.
+Result Run(const Config& cfg);
+
+// Bulk sink/source.  Each connection starts with a small request header
+// naming the direction and byte count; the server then either drains or
+// generates that many bytes and closes the exchange with an 8-byte trailer
+// carrying its own retransmit count.
+class BulkServer {
+public:
+    explicit BulkServer(uint16_t port, uint32_t bufferSize = 0);
+    ~BulkServer();
+
+    BulkServer(const BulkServer&)            = delete;
+    BulkServer& operator=(const BulkServer&) = delete;
+
+    bool Start();
+    void Stop();
+
+    uint16_t           Port()      const { return m_port; }
+    const std::string& LastError() const { return m_error; }
+
+private:
+    void AcceptLoop();
+    void ServeConnection(socket_t client);
+
+    uint16_t          m_port;
+    uint32_t          m_bufferSize;
+    std::string       m_error;
+    std::atomic<bool> m_running{false};
+    socket_t          m_listen = kInvalidSocket;
+    std::thread       m_acceptThread;
+    std::mutex        m_mutex;
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace throughput_bench
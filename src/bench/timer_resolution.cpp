@@ -0,0 +1,378 @@
+#include "timer_resolution.h"
+#include "bench_clock.h"
+#include "registry_access.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#ifndef PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION
+#define PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION 0x4
+#endif
+#else
+#include <cerrno>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace timer_resolution {
+
+// ─── Resolution ──────────────────────────────────────────────────────────────
+
+#ifdef _WIN32
+static const char* kKernelKey      = "SYSTEM\\CurrentControlSet\\Control\\Session Manager\\kernel";
+static const char* kGlobalRequests = "GlobalTimerResolutionRequests";
+
+static const uint32_t kWin11Build = 22000;
+
+typedef LONG (NTAPI* NtQueryTimerResolutionFn)(PULONG coarsest, PULONG finest, PULONG current);
+typedef LONG (NTAPI* NtSetTimerResolutionFn)(ULONG desired, BOOLEAN set, PULONG current);
+typedef LONG (NTAPI* RtlGetVersionFn)(PRTL_OSVERSIONINFOW info);
+
+static FARPROC Ntdll(const char* name)
+{
+    return GetProcAddress(GetModuleHandleW(L"ntdll.dll"), name);
+}
+#else
+static uint32_t ResolutionOf(clockid_t clock)
+{
+    timespec ts{};
+    if (clock_getres(clock, &ts) != 0) return 0;
+    uint64_t ns = static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    return static_cast<uint32_t>(std::max<uint64_t>((ns + 99) / 100, 1));
+}
+#endif
+
+bool Query(Resolution& out, std::string& error)
+{
+#ifdef _WIN32
+    static auto query = reinterpret_cast<NtQueryTimerResolutionFn>(Ntdll("NtQueryTimerResolution"));
+    ULONG coarsest = 0, finest = 0, current = 0;
+    if (!query || query(&coarsest, &finest, &current) < 0)
+    {
+        error = "NtQueryTimerResolution failed";
+        return false;
+    }
+    out.coarsest = coarsest;
+    out.finest   = finest;
+    out.current  = current;
+    return true;
+#else
+    // hrtimers serve CLOCK_MONOTONIC; the coarse clock ticks once a jiffy.
+    out.finest   = ResolutionOf(CLOCK_MONOTONIC);
+    out.current  = out.finest;
+    out.coarsest = std::max(ResolutionOf(CLOCK_MONOTONIC_COARSE), out.finest);
+    if (!out.finest)
+    {
+        error = "clock_getres failed";
+        return false;
+    }
+    return true;
+#endif
+}
+
+std::string FormatMs(uint32_t units100ns)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.4f ms", units100ns / 10000.0);
+    return buf;
+}
+
+uint32_t ClampRequest(const Resolution& r, double ms)
+{
+    double units = std::round(ms * 10000.0);
+    if (units < r.finest) return r.finest;
+    if (r.coarsest && units > r.coarsest) return r.coarsest;
+    return static_cast<uint32_t>(units);
+}
+
+BackgroundPolicy QueryPolicy()
+{
+    BackgroundPolicy p;
+#ifdef _WIN32
+    // GetVersionEx reports what the manifest claims; RtlGetVersion does not.
+    static auto version = reinterpret_cast<RtlGetVersionFn>(Ntdll("RtlGetVersion"));
+    RTL_OSVERSIONINFOW info{};
+    info.dwOSVersionInfoSize = sizeof(info);
+    if (version && version(&info) >= 0) p.build = info.dwBuildNumber;
+    p.perProcess = p.build >= kWin11Build;
+
+    std::string error;
+    if (auto reg = registry_access::SystemRegistry(error))
+        p.globalRequests = reg->ReadDword(kKernelKey, kGlobalRequests);
+
+    PROCESS_POWER_THROTTLING_STATE state{};
+    state.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+    if (GetProcessInformation(GetCurrentProcess(), ProcessPowerThrottling, &state, sizeof(state)))
+        p.optedOut = (state.ControlMask & PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION) &&
+                     !(state.StateMask & PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION);
+#endif
+    return p;
+}
+
+bool IgnoreBackgroundThrottling(std::string& error)
+{
+#ifdef _WIN32
+    if (!QueryPolicy().perProcess) return true;
+
+    // Keep whatever execution-speed setting the process already has.
+    PROCESS_POWER_THROTTLING_STATE state{};
+    state.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+    if (!GetProcessInformation(GetCurrentProcess(), ProcessPowerThrottling, &state, sizeof(state)))
+        state.ControlMask = state.StateMask = 0;
+    state.ControlMask |= PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION;
+    state.StateMask   &= ~static_cast<ULONG>(PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION);
+    if (!SetProcessInformation(GetCurrentProcess(), ProcessPowerThrottling, &state, sizeof(state)))
+    {
+        error = "SetProcessInformation(ProcessPowerThrottling) failed (" + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+#else
+    (void)error;
+#endif
+    return true;
+}
+
+std::string Describe(const Resolution& r, const BackgroundPolicy& p)
+{
+    std::ostringstream os;
+    os << "Timer resolution: current " << FormatMs(r.current) << ", finest " << FormatMs(r.finest)
+       << ", coarsest " << FormatMs(r.coarsest) << "\n";
+    if (!p.build) return os.str();
+
+    os << "Windows build " << p.build << ": ";
+    if (p.perProcess)
+        os << "requests from processes without a visible window are throttled\n"
+           << "  GlobalTimerResolutionRequests: "
+           << (p.globalRequests ? std::to_string(*p.globalRequests) : std::string("absent"))
+           << (p.globalRequests && *p.globalRequests ? " (every request counts)" : "") << "\n"
+           << "  this process: " << (p.optedOut ? "opted out" : "throttled when in the background") << "\n";
+    else
+        os << "every request counts system-wide\n";
+    return os.str();
+}
+
+// ─── Hold ────────────────────────────────────────────────────────────────────
+
+bool Hold::Request(double ms, std::string& error)
+{
+    Release();
+#ifdef _WIN32
+    static auto set = reinterpret_cast<NtSetTimerResolutionFn>(Ntdll("NtSetTimerResolution"));
+    if (!set)
+    {
+        error = "NtSetTimerResolution is not available";
+        return false;
+    }
+    Resolution r;
+    if (!Query(r, error)) return false;
+
+    // Without this the request lapses whenever the console is minimized or
+    // hidden on Windows 11.
+    if (!IgnoreBackgroundThrottling(error)) return false;
+
+    uint32_t desired = ClampRequest(r, ms);
+    ULONG    current = 0;
+    if (set(desired, TRUE, &current) < 0)
+    {
+        error = "NtSetTimerResolution failed";
+        return false;
+    }
+    m_active    = true;
+    m_requested = desired;
+    m_granted   = current;
+    return true;
+#else
+    (void)ms;
+    error = "the timer resolution is fixed by the kernel's hrtimers off Windows";
+    return false;
+#endif
+}
+
+void Hold::Release()
+{
+    if (!m_active) return;
+#ifdef _WIN32
+    static auto set = reinterpret_cast<NtSetTimerResolutionFn>(Ntdll("NtSetTimerResolution"));
+    ULONG current = 0;
+    if (set) set(m_requested, FALSE, &current);
+#endif
+    m_active = false;
+}
+
+// ─── Granularity ─────────────────────────────────────────────────────────────
+
+const char* WaiterName(Waiter w)
+{
+    switch (w) {
+#ifdef _WIN32
+    case Waiter::Sleep:         return "Sleep(1)";
+    case Waiter::WaitableTimer: return "waitable timer";
+    case Waiter::HighResTimer:  return "high-res timer";
+#else
+    case Waiter::Sleep:         return "nanosleep";
+    case Waiter::WaitableTimer: return "timerfd";
+    case Waiter::HighResTimer:  return "clock_nanosleep";
+#endif
+    }
+    return "?";
+}
+
+void Summarize(Granularity& g)
+{
+    g.mean = g.p50 = g.p99 = g.max = 0;
+    if (g.us.empty()) return;
+    std::vector<float> sorted = g.us;
+    std::sort(sorted.begin(), sorted.end());
+    g.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+    g.p50  = stats::PercentileSorted(sorted, 50);
+    g.p99  = stats::PercentileSorted(sorted, 99);
+    g.max  = sorted.back();
+}
+
+static const uint64_t kWaitNs = 1000000;   // every waiter asks for 1 ms
+
+static Granularity MeasureOne(Waiter w, uint32_t samples)
+{
+    Granularity g;
+    g.waiter = w;
+    g.us.reserve(samples);
+
+#ifdef _WIN32
+    HANDLE timer = nullptr;
+    if (w != Waiter::Sleep)
+    {
+        DWORD flags = w == Waiter::HighResTimer ? CREATE_WAITABLE_TIMER_HIGH_RESOLUTION : 0;
+        timer = CreateWaitableTimerExW(nullptr, nullptr, flags, TIMER_ALL_ACCESS);
+        if (!timer) return g;   // high-resolution timers need 1803+
+    }
+    for (uint32_t i = 0; i < samples; ++i)
+    {
+        uint64_t start = bench_clock::NowNs();
+        if (w == Waiter::Sleep)
+            Sleep(1);
+        else
+        {
+            LARGE_INTEGER due;
+            due.QuadPart = -static_cast<LONGLONG>(kWaitNs / 100);
+            if (!SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE)) break;
+            WaitForSingleObject(timer, INFINITE);
+        }
+        g.us.push_back(static_cast<float>((bench_clock::NowNs() - start) / 1000.0));
+    }
+    if (timer) CloseHandle(timer);
+#else
+    int fd = -1;
+    if (w == Waiter::WaitableTimer)
+    {
+        fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (fd < 0) return g;
+    }
+    for (uint32_t i = 0; i < samples; ++i)
+    {
+        uint64_t start = bench_clock::NowNs();
+        if (w == Waiter::Sleep)
+        {
+            timespec ts{0, static_cast<long>(kWaitNs)};
+            while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {}
+        }
+        else if (w == Waiter::WaitableTimer)
+        {
+            itimerspec spec{};
+            spec.it_value.tv_nsec = static_cast<long>(kWaitNs);
+            if (timerfd_settime(fd, 0, &spec, nullptr) != 0) break;
+            uint64_t expirations = 0;
+            while (read(fd, &expirations, sizeof(expirations)) == -1 && errno == EINTR) {}
+        }
+        else
+        {
+            // bench_clock is CLOCK_MONOTONIC, so the deadline is usable directly.
+            uint64_t deadline = start + kWaitNs;
+            timespec ts;
+            ts.tv_sec  = static_cast<time_t>(deadline / 1000000000ULL);
+            ts.tv_nsec = static_cast<long>(deadline % 1000000000ULL);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+        }
+        g.us.push_back(static_cast<float>((bench_clock::NowNs() - start) / 1000.0));
+    }
+    if (fd >= 0) close(fd);
+#endif
+
+    g.ok = !g.us.empty();
+    Summarize(g);
+    return g;
+}
+
+std::vector<Granularity> Measure(uint32_t samples)
+{
+    samples = std::max<uint32_t>(samples, 1);
+    return {MeasureOne(Waiter::Sleep, samples), MeasureOne(Waiter::WaitableTimer, samples),
+            MeasureOne(Waiter::HighResTimer, samples)};
+}
+
+std::string Describe(const std::vector<Granularity>& gs)
+{
+    std::ostringstream os;
+    char line[160];
+    std::snprintf(line, sizeof(line), "  %-16s %8s %9s %9s %9s %9s\n", "1 ms wait", "samples", "mean us",
+                  "p50 us", "p99 us", "max us");
+    os << line;
+    for (const auto& g : gs)
+    {
+        if (!g.ok)
+            std::snprintf(line, sizeof(line), "  %-16s not available\n", WaiterName(g.waiter));
+        else
+            std::snprintf(line, sizeof(line), "  %-16s %8zu %9.1f %9.1f %9.1f %9.1f\n", WaiterName(g.waiter),
+                          g.us.size(), g.mean, g.p50, g.p99, g.max);
+        os << line;
+    }
+    return os.str();
+}
+
+std::vector<Change> Compare(const std::vector<Granularity>& before, const std::vector<Granularity>& after)
+{
+    std::vector<Change> changes;
+    for (const auto& b : before)
+    {
+        auto a = std::find_if(after.begin(), after.end(),
+                              [&](const Granularity& g) { return g.waiter == b.waiter; });
+        if (!b.ok || a == after.end() || !a->ok) continue;
+
+        Change c;
+        c.waiter    = b.waiter;
+        c.p50Before = b.p50;
+        c.p50After  = a->p50;
+        c.p99Before = b.p99;
+        c.p99After  = a->p99;
+        c.shift     = stats::MannWhitney(b.us, a->us);
+        changes.push_back(c);
+    }
+    return changes;
+}
+
+std::string Describe(const std::vector<Change>& changes)
+{
+    std::ostringstream os;
+    char line[160];
+    std::snprintf(line, sizeof(line), "  %-16s %19s %19s %8s %8s\n", "1 ms wait", "p50 us before/after",
+                  "p99 us before/after", "effect", "p");
+    os << line;
+    for (const auto& c : changes)
+    {
+        std::snprintf(line, sizeof(line), "  %-16s %9.1f/%-9.1f %9.1f/%-9.1f %+8.2f %8.4f\n", WaiterName(c.waiter),
+                      c.p50Before, c.p50After, c.p99Before, c.p99After, c.shift.effect, c.shift.pValue);
+        os << line;
+    }
+    return os.str();
+}
+
+} // namespace timer_resolution
@@ -0,0 +1,132 @@
+#pragma once
+#include "stats.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// System timer resolution: what it is, holding a finer one for a session,
+// and what it does to real waits.  The High-Resolution System Timer tweak
+// only changes the BCD clock source; the tick that bounds Sleep() and
+// classic waitable timers is set at run time by whichever process asks for
+// the finest resolution (NtSetTimerResolution / timeBeginPeriod), and falls
+// back to 15.625 ms once nobody does.
+//
+// Windows 11 no longer lets a request raise the tick while the requesting
+// process has no visible window (minimized, background console): the
+// process is throttled unless it opts out of timer-resolution power
+// throttling or the machine sets
+//
+//   HKLM\SYSTEM\CurrentControlSet\Control\Session Manager\kernel
+//     GlobalTimerResolutionRequests = 1
+//
+// Hold opts its own process out, so the resolution it holds applies however
+// the probe's window is shown.
+//
+// Off Windows the kernel's hrtimers give the resolution; it is reported from
+// clock_getres and measured the same way, but cannot be changed.
+namespace timer_resolution {
+
+// ─── Resolution ──────────────────────────────────────────────────────────────
+
+// 100 ns units, as NtQueryTimerResolution reports them.
+struct Resolution {
+    uint32_t coarsest = 0;   // "minimum" resolution: the default tick, 156250 = 15.625 ms
+    uint32_t finest   = 0;   // "maximum" resolution, usually 5000 = 0.5 ms
+    uint32_t current  = 0;   // in force now: the finest any process holds
+};
+
+bool Query(Resolution& out, std::string& error);
+
+// "0.5000 ms"
+std::string FormatMs(uint32_t units100ns);
+
+// Nearest resolution the system can give for a request in milliseconds,
+// clamped to [finest, coarsest].
+uint32_t ClampRequest(const Resolution& r, double ms);
+
+// How this system treats requests from processes without a visible window.
+struct BackgroundPolicy {
+    uint32_t                build      = 0;       // Windows build number, 0 off Windows
+    bool                    perProcess = false;   // Windows 11 (build 22000+) throttles them
+    std::optional<uint32_t> globalRequests;       // GlobalTimerResolutionRequests, unset = absent
+    bool                    optedOut   = false;   // this process ignores the throttling
+};
+
+BackgroundPolicy QueryPolicy();
+
+// Opts the current process out of timer-resolution throttling
+// (SetProcessInformation ProcessPowerThrottling,
+// PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION).  Succeeds as a no-op
+// before Windows 11 and off Windows.
+bool IgnoreBackgroundThrottling(std::string& error);
+
+// Lines for the resolution and the background policy.
+std::string Describe(const Resolution& r, const BackgroundPolicy& p);
+
+// ─── Hold ────────────────────────────────────────────────────────────────────
+
+// Holds a resolution from Request() until Release() or destruction.  The
+// system runs at the finest resolution any process holds, so what is
+// granted can be finer than asked for, never coarser (unless the request is
+// below the hardware's finest).
+class Hold {
+public:
+    Hold() = default;
+    ~Hold() { Release(); }
+
+    Hold(const Hold&)            = delete;
+    Hold& operator=(const Hold&) = delete;
+
+    bool Request(double ms, std::string& error);
+    void Release();
+
+    bool     Active()    const { return m_active; }
+    uint32_t Requested() const { return m_requested; }   // 100 ns units
+    uint32_t Granted()   const { return m_granted; }     // current resolution right after the request
+
+private:
+    bool     m_active    = false;
+    uint32_t m_requested = 0;
+    uint32_t m_granted   = 0;
+};
+
+// ─── Granularity ─────────────────────────────────────────────────────────────
+
+// Ways of waiting 1 ms.  Sleep and the classic waitable timer expire on the
+// tick; the high-resolution timer (Windows 10 1803+) does not.  On Linux:
+// nanosleep, a timerfd and clock_nanosleep(TIMER_ABSTIME).
+enum class Waiter { Sleep, WaitableTimer, HighResTimer };
+
+const char* WaiterName(Waiter w);
+
+// Measured duration of `samples` 1 ms waits, in microseconds.
+struct Granularity {
+    Waiter             waiter = Waiter::Sleep;
+    bool               ok     = false;   // the waiter exists on this system
+    std::vector<float> us;
+    double             mean = 0, p50 = 0, p99 = 0, max = 0;
+};
+
+// Fills mean / percentiles from `us`.
+void Summarize(Granularity& g);
+
+// Every waiter, `samples` waits each.
+std::vector<Granularity> Measure(uint32_t samples);
+
+// Table of one measurement.
+std::string Describe(const std::vector<Granularity>& gs);
+
+// Per waiter: median and p99 before / after and the Mann-Whitney shift
+// (negative effect = waits got shorter).
+struct Change {
+    Waiter           waiter = Waiter::Sleep;
+    double           p50Before = 0, p50After = 0, p99Before = 0, p99After = 0;
+    stats::ShiftTest shift;
+};
+
+std::vector<Change> Compare(const std::vector<Granularity>& before, const std::vector<Granularity>& after);
+std::string         Describe(const std::vector<Change>& changes);
+
+} // namespace timer_resolution
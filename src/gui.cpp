@@ -1,4 +1,5 @@
 #include "gui.h"
+#include "bench/machine_profile.h"
 
 #include "../third_party/imgui/imgui.h"
 #include "../third_party/imgui/backends/imgui_impl_win32.h"
@@ -9,6 +10,7 @@
 #include <chrono>
 #include <ctime>
 #include <cctype>
+#include <cmath>
 
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(
     HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -19,6 +21,9 @@ Gui::Gui(BackupManager& backup) : m_backup(backup) {}
 
 Gui::~Gui()
 {
+    StopCoreLatency();
+    StopSentinel();
+    StopGameManager();
     Shutdown();
 }
 
@@ -112,6 +117,7 @@ bool Gui::Init(HWND hwnd, ID3D11Device* device, ID3D11DeviceContext* context)
     if (!ImGui_ImplDX11_Init(device, context)) return false;
 
     Log("Latency Optimizer started.");
+    StartSentinel();
     return true;
 }
 
@@ -126,6 +132,15 @@ void Gui::Render()
     if (m_showDetail)  DrawDetailPopup();
     if (m_showConfirm) DrawConfirmPopup();
     if (m_showAbout)   DrawAboutPopup();
+    if (m_showCoreLatency) DrawCoreLatencyPopup();
+    if (m_showTrends)      DrawTrendsPopup();
+    if (m_showInterrupts)  DrawInterruptsPopup();
+    if (m_showGames)       DrawGamesPopup();
+
+    CollectGameEvents();
+
+    CollectSentinel();
+    if (m_showSentinel)    DrawSentinelPopup();
 
     ImGui::Render();
     ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
@@ -175,6 +190,15 @@ int Gui::CountTotalInCategory(const std::string& cat) const
     return n;
 }
 
+// By Id(); profiles written before per-device ids stored Name().
+TweakBase* Gui::FindTweak(const std::string& id) const
+{
+    for (const auto& e : m_tweaks)
+        if (e.tweak->Id() == id || id == e.tweak->Name())
+            return e.tweak.get();
+    return nullptr;
+}
+
 bool Gui::MatchesSearch(const TweakBase* t) const
 {
     if (m_searchBuf[0] == '\0') return true;
@@ -307,11 +331,12 @@ void Gui::DrawHeader()
     float btnW   = 0.0f;
 
     // Calculate button widths for right alignment
-    const char* btns[] = { "Apply All Safe", "Revert All", "Restore Point", "Export Log", "About" };
+    const char* btns[] = { "Apply All Safe", "Revert All", "Restore Point", "Export Log",
+                           "Core Latency", "Trends", "Interrupts", "Games", "About" };
     float totalBtnW = 0;
     for (const char* b : btns)
         totalBtnW += ImGui::CalcTextSize(b).x + 20.0f;
-    totalBtnW += 4 * 6.0f; // spacing between buttons
+    totalBtnW += 8 * 6.0f; // spacing between buttons
 
     ImGui::SameLine(ImGui::GetWindowWidth() - totalBtnW - 20.0f);
     ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 2);
@@ -336,6 +361,14 @@ void Gui::DrawHeader()
     ImGui::SameLine();
     if (ImGui::Button("Export Log")) ExportLog();
     ImGui::SameLine();
+    if (ImGui::Button("Core Latency")) m_showCoreLatency = true;
+    ImGui::SameLine();
+    if (ImGui::Button("Trends")) m_showTrends = true;
+    ImGui::SameLine();
+    if (ImGui::Button("Interrupts")) m_showInterrupts = true;
+    ImGui::SameLine();
+    if (ImGui::Button("Games")) m_showGames = true;
+    ImGui::SameLine();
 
     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.18f, 0.18f, 0.22f, 1.0f));
     if (ImGui::Button("About")) m_showAbout = true;
@@ -764,6 +797,526 @@ void Gui::DrawAboutPopup()
     }
 }
 
+// ─── Core latency popup ───────────────────────────────────────────────────────
+
+// Log-scale cell colour: dark for no wake-ups, through teal to red as the
+// share of wake-ups in a bin grows by factors of ten.
+static ImU32 HeatColor(double fraction)
+{
+    if (fraction <= 0.0) return IM_COL32(22, 22, 28, 255);
+    float t = static_cast<float>((std::log10(fraction) + 5.0) / 5.0);
+    t = std::clamp(t, 0.05f, 1.0f);
+    ImVec4 lo(0.05f, 0.35f, 0.45f, 1.0f), hi(1.0f, 0.35f, 0.20f, 1.0f);
+    return ImGui::ColorConvertFloat4ToU32(ImVec4(lo.x + (hi.x - lo.x) * t,
+                                                 lo.y + (hi.y - lo.y) * t,
+                                                 lo.z + (hi.z - lo.z) * t, 1.0f));
+}
+
+void Gui::DrawCoreLatencyPopup()
+{
+    // Collect a finished run.
+    if (!m_coreRunning && m_coreThread.joinable())
+    {
+        m_coreThread.join();
+        m_coreResult = std::move(m_corePending);
+        std::vector<uint32_t> quiet = core_latency::RankByQuietness(m_coreResult);
+        std::ostringstream oss;
+        oss << "Core latency: " << m_coreResult.cores.size() << " CPU(s) measured";
+        if (!quiet.empty()) oss << ", quietest CPU " << quiet.front();
+        Log(oss.str());
+        if (m_coreResult.ok) StoreCoreLatencyRun(m_coreResult);
+    }
+
+    ImGui::OpenPopup("Core Latency##popup");
+    ImVec2 centre = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(centre, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(860, 520), ImGuiCond_Appearing);
+
+    if (ImGui::BeginPopupModal("Core Latency##popup", &m_showCoreLatency))
+    {
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 0.85f, 1.0f, 1.0f));
+        ImGui::Text("Per-core wake-up latency");
+        ImGui::PopStyleColor();
+        ImGui::TextWrapped("One pinned time-critical thread per logical CPU wakes every 1 ms on a "
+                           "high-resolution timer. Hot rows are cores busy with interrupts and "
+                           "DPCs; place interrupt affinity and game threads on the quiet ones.");
+        ImGui::Separator();
+
+        if (m_coreRunning)
+        {
+            ImGui::ProgressBar(m_coreProgress / 1000.0f, ImVec2(-90, 0));
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel", ImVec2(80, 0))) m_coreCancel = true;
+        }
+        else
+        {
+            ImGui::SetNextItemWidth(160);
+            ImGui::SliderInt("Duration (s)", &m_coreDurationS, 5, 60);
+            ImGui::SameLine();
+            if (ImGui::Button("Run", ImVec2(80, 0))) StartCoreLatency();
+        }
+
+        const core_latency::Result& r = m_coreResult;
+        if (!r.error.empty())
+            ImGui::TextColored(ImVec4(1.0f, 0.35f, 0.30f, 1.0f), "%s", r.error.c_str());
+        if (!r.note.empty())
+            ImGui::TextColored(ImVec4(1.0f, 0.78f, 0.15f, 1.0f), "%s", r.note.c_str());
+
+        if (r.ok)
+        {
+            ImGui::Spacing();
+            ImGui::BeginChild("Heatmap", ImVec2(0, -30), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+            const float labelW = 48.0f, cellW = 44.0f, cellH = 16.0f;
+            ImDrawList* dl = ImGui::GetWindowDrawList();
+
+            // Column header
+            ImVec2 origin = ImGui::GetCursorScreenPos();
+            for (int b = 0; b < core_latency::kHeatmapBins; ++b)
+                dl->AddText(ImVec2(origin.x + labelW + b * cellW, origin.y),
+                            IM_COL32(140, 145, 155, 255), core_latency::HeatmapBinLabel(b));
+            dl->AddText(ImVec2(origin.x + labelW + core_latency::kHeatmapBins * cellW + 8, origin.y),
+                        IM_COL32(140, 145, 155, 255), "p99.9 / max (us)");
+            ImGui::Dummy(ImVec2(0, cellH + 4));
+
+            for (const auto& core : r.cores)
+            {
+                ImVec2 p = ImGui::GetCursorScreenPos();
+                char label[32];
+                snprintf(label, sizeof(label), "CPU %u", core.cpu);
+                dl->AddText(ImVec2(p.x, p.y), IM_COL32(220, 222, 228, 255), label);
+
+                std::vector<double> row = core_latency::HeatmapRow(core.wakeup);
+                for (int b = 0; b < core_latency::kHeatmapBins; ++b)
+                {
+                    ImVec2 a(p.x + labelW + b * cellW, p.y);
+                    dl->AddRectFilled(a, ImVec2(a.x + cellW - 2, a.y + cellH), HeatColor(row[b]));
+                }
+
+                char stats[64];
+                snprintf(stats, sizeof(stats), "%.1f / %.1f",
+                         core.wakeup.ValueAtPercentile(99.9) / 1000.0, core.wakeup.Max() / 1000.0);
+                dl->AddText(ImVec2(p.x + labelW + core_latency::kHeatmapBins * cellW + 8, p.y),
+                            IM_COL32(220, 222, 228, 255), stats);
+                ImGui::Dummy(ImVec2(labelW + core_latency::kHeatmapBins * cellW + 140, cellH + 2));
+            }
+            ImGui::EndChild();
+
+            std::string quiet;
+            for (uint32_t cpu : core_latency::RankByQuietness(r))
+                quiet += (quiet.empty() ? "" : ", ") + std::to_string(cpu);
+            ImGui::Text("Quietest first: %s", quiet.c_str());
+        }
+        ImGui::EndPopup();
+    }
+}
+
+// ─── Trends popup ─────────────────────────────────────────────────────────────
+
+void Gui::DrawTrendsPopup()
+{
+    ImGui::OpenPopup("Trends##popup");
+    ImVec2 centre = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(centre, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(820, 520), ImGuiCond_Appearing);
+
+    if (ImGui::BeginPopupModal("Trends##popup", &m_showTrends))
+    {
+        if (ImGui::IsWindowAppearing() && OpenResultsStore())
+        {
+            std::string error;
+            if (!m_store.Refresh(error)) m_storeError = error;
+        }
+
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 0.85f, 1.0f, 1.0f));
+        ImGui::Text("p99.9 over time");
+        ImGui::PopStyleColor();
+        ImGui::TextWrapped("Every stored probe run (Core Latency here, or LatencyProbe with --store on) "
+                           "is one point. Compare before and after tweaks, driver and OS updates.");
+        ImGui::Separator();
+
+        if (!m_storeError.empty())
+            ImGui::TextColored(ImVec4(1.0f, 0.35f, 0.30f, 1.0f), "%s", m_storeError.c_str());
+        if (!m_store.Note().empty())
+            ImGui::TextColored(ImVec4(1.0f, 0.78f, 0.15f, 1.0f), "%s", m_store.Note().c_str());
+
+        std::vector<std::pair<std::string, std::string>> series;
+        if (m_storeOpen) series = m_store.Series();
+        if (series.empty())
+        {
+            ImGui::TextDisabled("No stored runs yet.");
+        }
+        else
+        {
+            m_trendSeries = std::clamp(m_trendSeries, 0, (int)series.size() - 1);
+            auto name = [&](int i) { return series[i].first + " / " + series[i].second; };
+
+            ImGui::SetNextItemWidth(360);
+            if (ImGui::BeginCombo("Series", name(m_trendSeries).c_str()))
+            {
+                for (int i = 0; i < (int)series.size(); ++i)
+                    if (ImGui::Selectable(name(i).c_str(), i == m_trendSeries)) m_trendSeries = i;
+                ImGui::EndCombo();
+            }
+            ImGui::SameLine();
+            ImGui::Checkbox("This machine only", &m_trendThisMachine);
+
+            results_store::Query q;
+            q.probe = series[m_trendSeries].first;
+            q.label = series[m_trendSeries].second;
+            if (m_trendThisMachine) q.fingerprint = machine_profile::Current().fingerprint;
+            std::vector<results_store::Point> points = m_store.Find(q);
+
+            std::vector<float> p999;
+            for (const auto& p : points) p999.push_back(static_cast<float>(p.p999Us));
+            float top = p999.empty() ? 1.0f : *std::max_element(p999.begin(), p999.end()) * 1.1f;
+
+            char overlay[64];
+            snprintf(overlay, sizeof(overlay), "%d run(s), peak %.1f us", (int)points.size(), top / 1.1f);
+            ImGui::PlotLines("##p999", p999.data(), (int)p999.size(), 0, overlay, 0.0f, top,
+                             ImVec2(-1, 160));
+
+            ImGui::BeginChild("TrendRows", ImVec2(0, -4), false);
+            ImGui::Columns(5, "trendcols", false);
+            ImGui::TextDisabled("Time (UTC)"); ImGui::NextColumn();
+            ImGui::TextDisabled("Samples");    ImGui::NextColumn();
+            ImGui::TextDisabled("p50 us");     ImGui::NextColumn();
+            ImGui::TextDisabled("p99 us");     ImGui::NextColumn();
+            ImGui::TextDisabled("p99.9 us");   ImGui::NextColumn();
+            for (auto it = points.rbegin(); it != points.rend(); ++it)
+            {
+                ImGui::Text("%s", results_store::FormatTime(it->timestamp).c_str()); ImGui::NextColumn();
+                ImGui::Text("%llu", (unsigned long long)it->count);                  ImGui::NextColumn();
+                ImGui::Text("%.1f", it->p50Us);                                       ImGui::NextColumn();
+                ImGui::Text("%.1f", it->p99Us);                                       ImGui::NextColumn();
+                ImGui::Text("%.1f", it->p999Us);                                      ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+            ImGui::EndChild();
+        }
+        ImGui::EndPopup();
+    }
+}
+
+// ─── Sentinel popup ───────────────────────────────────────────────────────────
+
+void Gui::DrawSentinelPopup()
+{
+    ImGui::OpenPopup("Driver / OS change##popup");
+    ImVec2 centre = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(centre, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(620, 420), ImGuiCond_Appearing);
+
+    if (ImGui::BeginPopupModal("Driver / OS change##popup", &m_showSentinel))
+    {
+        const regression_sentinel::Outcome& o = m_sentinel;
+        ImGui::PushStyleColor(ImGuiCol_Text, o.verdict.Regressed() ? ImVec4(1.0f, 0.45f, 0.35f, 1.0f)
+                                                                    : ImVec4(0.0f, 0.85f, 1.0f, 1.0f));
+        ImGui::Text("%s", o.verdict.Regressed() ? "Latency regressed after an update" : "Drivers or OS updated");
+        ImGui::PopStyleColor();
+        ImGui::Separator();
+
+        for (const auto& c : o.changes)
+            ImGui::BulletText("%s", regression_sentinel::Describe(c).c_str());
+
+        ImGui::Spacing();
+        if (o.verdict.compared.empty())
+            ImGui::TextWrapped("No earlier baseline on this machine; this run is the new reference.");
+        else if (!o.verdict.Regressed())
+            ImGui::TextWrapped("Wake-up latency matches the last baseline (%d series).",
+                               (int)o.verdict.compared.size());
+        if (o.verdict.Regressed() &&
+            ImGui::BeginTable("##regressions", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH))
+        {
+            ImGui::TableSetupColumn("Series");
+            ImGui::TableSetupColumn("p99.9 before (us)");
+            ImGui::TableSetupColumn("p99.9 now (us)");
+            ImGui::TableSetupColumn("Shift p");
+            ImGui::TableHeadersRow();
+            for (const auto& r : o.verdict.regressions)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%s", r.label.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", r.baseP999Us);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", r.nowP999Us);
+                ImGui::TableNextColumn(); ImGui::Text("%.3g", r.shift.pValue);
+            }
+            ImGui::EndTable();
+        }
+
+        if (!o.droppedTweaks.empty())
+        {
+            ImGui::Spacing();
+            ImGui::Text("No longer applied (reset by the update):");
+            for (const auto& id : o.droppedTweaks)
+            {
+                const TweakBase* t = FindTweak(id);
+                ImGui::BulletText("%s", t ? t->Name() : id.c_str());
+            }
+            if (ImGui::Button("Re-apply now")) ReapplyDroppedTweaks();
+            ImGui::SameLine();
+        }
+        if (ImGui::Checkbox("Re-apply automatically after updates", &m_sentinelReapply))
+            SaveSentinelProfile(m_sentinelReapply);
+
+        ImGui::Spacing();
+        ImGui::Separator();
+        float btnW = 100.0f;
+        ImGui::SetCursorPosX((ImGui::GetWindowWidth() - btnW) * 0.5f);
+        if (ImGui::Button("Close", ImVec2(btnW, 0)))
+            m_showSentinel = false;
+        ImGui::EndPopup();
+    }
+}
+
+// ─── Interrupts popup ─────────────────────────────────────────────────────────
+
+void Gui::DrawInterruptsPopup()
+{
+    ImGui::OpenPopup("Interrupts##popup");
+    ImVec2 centre = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(centre, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(900, 560), ImGuiCond_Appearing);
+
+    if (ImGui::BeginPopupModal("Interrupts##popup", &m_showInterrupts))
+    {
+        if (ImGui::IsWindowAppearing()) RefreshInterruptDevices();
+
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 0.85f, 1.0f, 1.0f));
+        ImGui::Text("MSI mode and interrupt priority per PCI device");
+        ImGui::PopStyleColor();
+        ImGui::TextWrapped("Written to each device's hardware key; takes effect after a reboot. The first "
+                           "change of a device backs up its values so Restore can put them back.");
+        ImGui::Separator();
+
+        if (!m_irqError.empty())
+            ImGui::TextColored(ImVec4(1.0f, 0.35f, 0.30f, 1.0f), "%s", m_irqError.c_str());
+
+        const char* modes[]      = { "MSI / MSI-X", "Line-based" };
+        const char* priorities[] = { "Leave", "Undefined", "Low", "Normal", "High" };
+        ImGui::SetNextItemWidth(130);
+        ImGui::Combo("Mode", &m_irqMode, modes, IM_ARRAYSIZE(modes));
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(110);
+        ImGui::Combo("Priority", &m_irqPriority, priorities, IM_ARRAYSIZE(priorities));
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(90);
+        ImGui::InputInt("Message limit", &m_irqLimit);
+        m_irqLimit = std::max(m_irqLimit, -1);
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("-1 leaves the limit, 0 removes it");
+        ImGui::SameLine();
+        if (ImGui::Checkbox("Show absent", &m_irqShowAbsent)) RefreshInterruptDevices();
+
+        if (ImGui::Button("Apply to selected")) ApplyInterruptSetting(false);
+        ImGui::SameLine();
+        if (ImGui::Button("Restore selected")) ApplyInterruptSetting(true);
+        ImGui::SameLine();
+        if (ImGui::Button("Select MSI-capable"))
+            for (std::size_t i = 0; i < m_irqDevices.size(); ++i)
+                m_irqSelected[i] = m_irqDevices[i].msiCapable && m_irqDevices[i].present;
+        ImGui::SameLine();
+        if (ImGui::Button("Refresh")) RefreshInterruptDevices();
+
+        ImGui::BeginChild("IrqRows", ImVec2(0, -4), false);
+        if (ImGui::BeginTable("##irq", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH |
+                                              ImGuiTableFlags_Resizable))
+        {
+            ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed, 24);
+            ImGui::TableSetupColumn("Device");
+            ImGui::TableSetupColumn("Class", ImGuiTableColumnFlags_WidthFixed, 80);
+            ImGui::TableSetupColumn("Mode", ImGuiTableColumnFlags_WidthFixed, 110);
+            ImGui::TableSetupColumn("Priority", ImGuiTableColumnFlags_WidthFixed, 70);
+            ImGui::TableSetupColumn("Backup", ImGuiTableColumnFlags_WidthFixed, 50);
+            ImGui::TableHeadersRow();
+            for (std::size_t i = 0; i < m_irqDevices.size(); ++i)
+            {
+                const auto& d = m_irqDevices[i];
+                ImGui::TableNextRow();
+                ImGui::PushID((int)i);
+                ImGui::TableNextColumn();
+                bool sel = m_irqSelected[i] != 0;
+                if (ImGui::Checkbox("##sel", &sel)) m_irqSelected[i] = sel;
+                ImGui::TableNextColumn();
+                if (d.present) ImGui::Text("%s", d.description.c_str());
+                else           ImGui::TextDisabled("%s (absent)", d.description.c_str());
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("%s", d.instanceId.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%s", d.className.c_str());
+                ImGui::TableNextColumn();
+                if (d.msiCapable) ImGui::Text("%s", interrupt_manager::ModeName(d).c_str());
+                else              ImGui::TextDisabled("%s (no MSI)", interrupt_manager::ModeName(d).c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%s", interrupt_manager::PriorityName(d.priority));
+                ImGui::TableNextColumn();
+                std::string id = d.instanceId;
+                std::transform(id.begin(), id.end(), id.begin(), ::toupper);
+                ImGui::Text("%s", m_irqBackups.count(id) ? "yes" : "");
+                ImGui::PopID();
+            }
+            ImGui::EndTable();
+        }
+        ImGui::EndChild();
+        ImGui::EndPopup();
+    }
+}
+
+// ─── Games popup ──────────────────────────────────────────────────────────────
+
+void Gui::DrawGamesPopup()
+{
+    ImGui::OpenPopup("Games##popup");
+    ImVec2 centre = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(centre, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(900, 560), ImGuiCond_Appearing);
+
+    if (ImGui::BeginPopupModal("Games##popup", &m_showGames))
+    {
+        if (ImGui::IsWindowAppearing() && !m_gameManager) LoadGameRules();
+
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 0.85f, 1.0f, 1.0f));
+        ImGui::Text("Priority, CPU Sets, I/O / memory priority and power throttling per game");
+        ImGui::PopStyleColor();
+        ImGui::TextWrapped("While the manager runs, each listed executable gets its settings the moment it "
+                           "starts (kernel process events, no polling). Stopping the manager restores games "
+                           "that are still running; a game that exits takes its settings with it. While any "
+                           "game runs, the background list is throttled and moved off the game cores.");
+        ImGui::Separator();
+
+        if (!m_gameError.empty())
+            ImGui::TextColored(ImVec4(1.0f, 0.35f, 0.30f, 1.0f), "%s", m_gameError.c_str());
+
+        bool running = m_gameManager && m_gameManager->Running();
+        if (ImGui::Button(running ? "Stop manager" : "Start manager"))
+        {
+            if (running) StopGameManager();
+            else         StartGameManager();
+        }
+        ImGui::SameLine();
+        if (running) ImGui::TextColored(ImVec4(0.3f, 0.9f, 0.4f, 1.0f), "Watching %zu rule(s)", m_gameRules.size());
+        else         ImGui::TextDisabled("Stopped");
+        if (m_gameManager)
+        {
+            game_runtime::Savings saved = m_gameManager->BackgroundSavings();
+            ImGui::SameLine();
+            ImGui::TextDisabled("| kept off the game cores: %s", game_runtime::Describe(saved).c_str());
+        }
+
+        // The two lists share the editor; switching loads the list's defaults.
+        const char* lists[] = { "Games", "Background (throttled while a game runs)" };
+        int list = m_gameEditBackground ? 1 : 0;
+        ImGui::SetNextItemWidth(300);
+        if (ImGui::Combo("List", &list, lists, IM_ARRAYSIZE(lists)))
+        {
+            m_gameEditBackground = list == 1;
+            game_runtime::Rule d = m_gameEditBackground ? game_runtime::BackgroundDefaults() : game_runtime::Rule();
+            m_gamePriority    = static_cast<int>(d.priority);
+            m_gameIo          = static_cast<int>(d.io);
+            m_gameMemory      = static_cast<int>(d.memory);
+            m_gameThrottling  = static_cast<int>(d.throttling);
+            m_gameCpuChoice   = m_gameEditBackground ? 3 : 1;
+        }
+        std::vector<game_runtime::Rule>& rules = m_gameEditBackground ? m_gameBackground : m_gameRules;
+
+        const char* priorities[]  = { "Keep", "Idle", "Below normal", "Normal", "Above normal", "High" };
+        const char* ioLevels[]    = { "Keep", "Very low", "Low", "Normal", "High" };
+        const char* memLevels[]   = { "Keep", "Very low", "Low", "Medium", "Below normal", "Normal" };
+        const char* throttling[]  = { "Keep", "Off", "On (EcoQoS)" };
+        ImGui::SetNextItemWidth(200);
+        ImGui::InputTextWithHint("##exe", "game.exe", m_gameExe, sizeof(m_gameExe));
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(110);
+        ImGui::Combo("Priority", &m_gamePriority, priorities, IM_ARRAYSIZE(priorities));
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(80);
+        ImGui::Combo("I/O", &m_gameIo, ioLevels, IM_ARRAYSIZE(ioLevels));
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(110);
+        ImGui::Combo("Memory", &m_gameMemory, memLevels, IM_ARRAYSIZE(memLevels));
+        ImGui::SetNextItemWidth(110);
+        ImGui::Combo("Throttling", &m_gameThrottling, throttling, IM_ARRAYSIZE(throttling));
+        ImGui::SameLine();
+        const char* cpuLabels[] = { "Keep", "Game CPUs", "Non-game CPUs", "E-cores" };
+        ImGui::SetNextItemWidth(130);
+        ImGui::Combo("CPUs", &m_gameCpuChoice, cpuLabels, IM_ARRAYSIZE(cpuLabels));
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("CPU Sets: the machine profile's game CPUs, every other CPU, or the efficiency "
+                              "cores outside them");
+        ImGui::SameLine();
+        if (ImGui::Button("Add / update") && m_gameExe[0])
+        {
+            game_runtime::Rule r;
+            std::string error;
+            if (game_runtime::ParseRule(m_gameExe, r, error))
+            {
+                r.priority   = static_cast<game_runtime::Priority>(m_gamePriority);
+                r.io         = static_cast<game_runtime::IoPriority>(m_gameIo);
+                r.memory     = static_cast<game_runtime::MemoryPriority>(m_gameMemory);
+                r.throttling = static_cast<game_runtime::Throttling>(m_gameThrottling);
+                const game_runtime::CpuChoice choices[] = { game_runtime::CpuChoice::Keep, game_runtime::CpuChoice::Game,
+                                                            game_runtime::CpuChoice::NonGame,
+                                                            game_runtime::CpuChoice::Efficiency };
+                r.cpuChoice  = choices[m_gameCpuChoice];
+                game_runtime::PutRule(rules, r);
+                SaveGameRules();
+                m_gameExe[0] = 0;
+            }
+            else m_gameError = error;
+        }
+        if (running) ImGui::TextDisabled("Rule changes apply the next time the manager starts.");
+
+        const cpu_topology::Topology& topo = cpu_topology::Current();
+        std::vector<game_runtime::Process> tracked;
+        if (m_gameManager) tracked = m_gameManager->Processes();
+
+        ImGui::BeginChild("GameRows", ImVec2(0, -4), false);
+        std::string removeExe;
+        if (ImGui::BeginTable("##games", 7, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH |
+                                                ImGuiTableFlags_Resizable))
+        {
+            ImGui::TableSetupColumn("Executable");
+            ImGui::TableSetupColumn("Priority", ImGuiTableColumnFlags_WidthFixed, 90);
+            ImGui::TableSetupColumn("I/O", ImGuiTableColumnFlags_WidthFixed, 60);
+            ImGui::TableSetupColumn("Memory", ImGuiTableColumnFlags_WidthFixed, 90);
+            ImGui::TableSetupColumn("CPUs", ImGuiTableColumnFlags_WidthFixed, 90);
+            ImGui::TableSetupColumn("Throttling", ImGuiTableColumnFlags_WidthFixed, 80);
+            ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed, 60);
+            ImGui::TableHeadersRow();
+            for (std::size_t i = 0; i < rules.size(); ++i)
+            {
+                const auto& r = rules[i];
+                ImGui::TableNextRow();
+                ImGui::PushID((int)i);
+                ImGui::TableNextColumn();
+                ImGui::Text("%s", r.exe.c_str());
+                for (const auto& p : tracked)
+                    if (p.exe == r.exe && ImGui::IsItemHovered())
+                        ImGui::SetTooltip("pid %u: %s", p.pid, p.applied.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%s", game_runtime::PriorityName(r.priority));
+                ImGui::TableNextColumn(); ImGui::Text("%s", game_runtime::IoPriorityName(r.io));
+                ImGui::TableNextColumn(); ImGui::Text("%s", game_runtime::MemoryPriorityName(r.memory));
+                ImGui::TableNextColumn();
+                std::vector<uint32_t> cpus = game_runtime::ResolveCpus(r, topo, m_gameCpus);
+                ImGui::Text("%s", cpus.empty() ? "keep" : cpu_topology::FormatCpuList(cpus).c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%s", game_runtime::ThrottlingName(r.throttling));
+                ImGui::TableNextColumn();
+                if (!running && ImGui::SmallButton("Remove")) removeExe = r.exe;
+                ImGui::PopID();
+            }
+            ImGui::EndTable();
+        }
+        if (!removeExe.empty() && game_runtime::RemoveRule(rules, removeExe)) SaveGameRules();
+
+        if (!tracked.empty())
+        {
+            ImGui::Spacing();
+            ImGui::Text("Running now");
+            for (const auto& p : tracked)
+                ImGui::BulletText("%s (pid %u)%s: %s", p.exe.c_str(), p.pid, p.background ? ", throttled" : "",
+                                  p.applied.c_str());
+        }
+        ImGui::EndChild();
+        ImGui::EndPopup();
+    }
+}
+
 // ─── Tweak actions ────────────────────────────────────────────────────────────
 
 void Gui::ApplyTweak(TweakBase* tweak)
@@ -839,3 +1392,292 @@ void Gui::ExportLog()
         Log(ok ? "Log exported." : "Log export failed.");
     }
 }
+
+void Gui::StartCoreLatency()
+{
+    if (m_coreRunning || m_coreThread.joinable()) return;
+
+    core_latency::Config cfg;
+    cfg.durationMs = static_cast<uint32_t>(m_coreDurationS) * 1000;
+
+    m_coreCancel   = false;
+    m_coreProgress = 0;
+    m_coreRunning  = true;
+    m_coreResult   = core_latency::Result{};
+    m_coreThread   = std::thread([this, cfg]() {
+        m_corePending = core_latency::Run(cfg, &m_coreCancel, &m_coreProgress);
+        m_coreRunning = false;
+    });
+    Log("Core latency: measuring all logical CPUs...");
+}
+
+void Gui::StopCoreLatency()
+{
+    m_coreCancel = true;
+    if (m_coreThread.joinable())
+        m_coreThread.join();
+}
+
+// ─── Results store ────────────────────────────────────────────────────────────
+
+bool Gui::OpenResultsStore()
+{
+    if (m_storeOpen) return true;
+    m_storeOpen = m_store.Open(results_store::DefaultDirectory(), m_storeError);
+    return m_storeOpen;
+}
+
+void Gui::StoreCoreLatencyRun(const core_latency::Result& r)
+{
+    if (!OpenResultsStore())
+    {
+        Log("Results store: " + m_storeError);
+        return;
+    }
+
+    results_store::Record rec;
+    rec.fingerprint = machine_profile::Current().fingerprint;
+    rec.probe       = "core-latency";
+    rec.tags.push_back("gui");
+    for (const auto& entry : m_tweaks)
+        if (entry.tweak->IsApplied()) rec.tweaks.push_back(entry.tweak->Id());
+    for (const auto& core : r.cores)
+        rec.histograms.emplace_back("cpu " + std::to_string(core.cpu), core.wakeup);
+
+    std::string error;
+    if (!m_store.Append(rec, error)) Log("Results store: " + error);
+}
+
+// ─── Regression sentinel ──────────────────────────────────────────────────────
+
+void Gui::StartSentinel()
+{
+    if (m_sentinelRunning || m_sentinelThread.joinable()) return;
+
+    regression_sentinel::Options opt;
+    opt.trackTweaks = true;
+    for (const auto& entry : m_tweaks)
+        if (entry.tweak->IsApplied()) opt.appliedTweaks.push_back(entry.tweak->Id());
+
+    m_sentinelCancel  = false;
+    m_sentinelRunning = true;
+    m_sentinelThread  = std::thread([this, opt]() {
+        m_sentinel = regression_sentinel::Check(opt, &m_sentinelCancel);
+        m_sentinelRunning = false;
+    });
+}
+
+void Gui::StopSentinel()
+{
+    m_sentinelCancel = true;
+    if (m_sentinelThread.joinable())
+        m_sentinelThread.join();
+}
+
+void Gui::CollectSentinel()
+{
+    if (m_sentinelRunning || !m_sentinelThread.joinable()) return;
+    m_sentinelThread.join();
+
+    // An entry from an older profile (stored by name) whose tweak is still
+    // applied was not dropped.
+    auto& dropped = m_sentinel.droppedTweaks;
+    dropped.erase(std::remove_if(dropped.begin(), dropped.end(), [this](const std::string& id) {
+                      const TweakBase* t = FindTweak(id);
+                      return t && t->IsApplied();
+                  }), dropped.end());
+
+    const regression_sentinel::Outcome& o = m_sentinel;
+    if (!o.ok)
+    {
+        Log("Sentinel: " + o.error);
+        return;
+    }
+    for (const auto& c : o.changes)
+        Log("Sentinel: " + regression_sentinel::Describe(c));
+    for (const auto& r : o.verdict.regressions)
+    {
+        char line[160];
+        snprintf(line, sizeof(line), "Sentinel: %s p99.9 %.1f -> %.1f us", r.label.c_str(), r.baseP999Us,
+                 r.nowP999Us);
+        Log(line);
+    }
+    if (o.changes.empty() && !o.verdict.Regressed()) return;
+
+    m_sentinelReapply = o.reapplyAllowed;
+    if (m_sentinelReapply && !o.droppedTweaks.empty())
+        ReapplyDroppedTweaks();
+    m_showSentinel = true;
+}
+
+void Gui::ReapplyDroppedTweaks()
+{
+    int count = 0;
+    for (const auto& id : m_sentinel.droppedTweaks)
+    {
+        // Re-resolved against this run's device objects; an adapter that is
+        // gone has no tweak to apply.
+        TweakBase* t = FindTweak(id);
+        if (t && !t->IsApplied())
+        {
+            ApplyTweak(t);
+            ++count;
+        }
+    }
+    m_sentinel.droppedTweaks.clear();
+    Log("Sentinel: re-applied " + std::to_string(count) + " tweak(s).");
+    SaveSentinelProfile(m_sentinelReapply);
+}
+
+// Policy plus the current tweak list, so the next update is compared
+// against what is applied now.
+void Gui::SaveSentinelProfile(bool reapplyAllowed)
+{
+    std::string path = machine_profile::DefaultPath();
+    machine_profile::Profile p;
+    std::string error;
+    if (!machine_profile::Load(path, p, error)) p = machine_profile::Current();
+
+    regression_sentinel::SetReapplyAllowed(p, reapplyAllowed);
+    if (m_sentinel.droppedTweaks.empty())
+    {
+        std::vector<std::string> applied;
+        for (const auto& entry : m_tweaks)
+            if (entry.tweak->IsApplied()) applied.push_back(entry.tweak->Id());
+        regression_sentinel::StoreAppliedTweaks(p, applied);
+    }
+    if (!machine_profile::Save(path, p)) Log("Sentinel: cannot write " + path);
+}
+
+// ─── Interrupt management ─────────────────────────────────────────────────────
+
+void Gui::RefreshInterruptDevices()
+{
+    // Keep the selection across refreshes
+    std::vector<std::string> selected;
+    for (std::size_t i = 0; i < m_irqDevices.size(); ++i)
+        if (m_irqSelected[i]) selected.push_back(m_irqDevices[i].instanceId);
+
+    m_irqDevices.clear();
+    m_irqError.clear();
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg || !interrupt_manager::LoadBackups(interrupt_manager::DefaultBackupPath(), m_irqBackups, error))
+    {
+        m_irqError = error;
+        return;
+    }
+    for (auto& d : interrupt_manager::ListDevices(*reg))
+        if (d.present || m_irqShowAbsent) m_irqDevices.push_back(std::move(d));
+    m_irqSelected.assign(m_irqDevices.size(), 0);
+    for (std::size_t i = 0; i < m_irqDevices.size(); ++i)
+        m_irqSelected[i] = std::find(selected.begin(), selected.end(), m_irqDevices[i].instanceId) != selected.end();
+}
+
+void Gui::ApplyInterruptSetting(bool restore)
+{
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    std::string path = interrupt_manager::DefaultBackupPath();
+    if (!reg || !interrupt_manager::LoadBackups(path, m_irqBackups, error))
+    {
+        m_irqError = error;
+        return;
+    }
+
+    interrupt_manager::Setting s;
+    s.msi = m_irqMode == 0;
+    if (m_irqPriority > 0) s.priority = static_cast<interrupt_manager::Priority>(m_irqPriority - 1);
+    if (m_irqLimit >= 0)   s.messageLimit = static_cast<uint32_t>(m_irqLimit);
+
+    std::vector<interrupt_manager::DeviceInfo> targets;
+    for (std::size_t i = 0; i < m_irqDevices.size(); ++i)
+        if (m_irqSelected[i]) targets.push_back(m_irqDevices[i]);
+
+    std::vector<interrupt_manager::Result> results;
+    if (restore)
+        for (const auto& d : targets)
+        {
+            interrupt_manager::Result r;
+            r.instanceId = d.instanceId;
+            r.ok = interrupt_manager::Restore(*reg, d.instanceId, m_irqBackups, r.error);
+            results.push_back(r);
+        }
+    else
+        results = interrupt_manager::ApplyAll(*reg, targets, s, m_irqBackups);
+
+    int ok = 0;
+    for (const auto& r : results)
+    {
+        if (r.ok) ++ok;
+        else      Log("Interrupts: " + r.error);
+    }
+    if (!interrupt_manager::SaveBackups(path, m_irqBackups, error)) Log("Interrupts: " + error);
+    Log("Interrupts: " + std::string(restore ? "restored " : "updated ") + std::to_string(ok) + " of " +
+        std::to_string(results.size()) + " device(s); reboot to apply.");
+    RefreshInterruptDevices();
+}
+
+// ─── Game runtime manager ─────────────────────────────────────────────────────
+
+void Gui::LoadGameRules()
+{
+    m_gameError.clear();
+    m_gameCpus = game_runtime::ConfiguredGameCpus(cpu_topology::Current());
+    std::string error;
+    if (!game_runtime::LoadRules(game_runtime::DefaultPath(), m_gameRules, error) ||
+        !game_runtime::LoadRules(game_runtime::DefaultBackgroundPath(), m_gameBackground, error,
+                                 game_runtime::BackgroundDefaults()))
+        m_gameError = error;
+}
+
+void Gui::SaveGameRules()
+{
+    std::string error;
+    if (game_runtime::SaveRules(game_runtime::DefaultPath(), m_gameRules, error) &&
+        game_runtime::SaveRules(game_runtime::DefaultBackgroundPath(), m_gameBackground, error))
+        m_gameError.clear();
+    else
+        m_gameError = error;
+}
+
+void Gui::StartGameManager()
+{
+    m_gameError.clear();
+    auto onEvent = [this](const game_runtime::Event& e) {
+        std::lock_guard<std::mutex> lock(m_gameMutex);
+        m_gameEvents.push_back("Games: " + e.exe + " (pid " + std::to_string(e.pid) + ") " +
+                               game_runtime::EventName(e.kind) + ": " + e.detail);
+    };
+    m_gameManager = std::make_unique<game_runtime::Manager>(m_gameRules, m_gameCpus, onEvent);
+    m_gameManager->SetBackgroundRules(m_gameBackground);
+    std::string error;
+    if (!m_gameManager->Start(error))
+    {
+        m_gameManager.reset();
+        m_gameError = error;
+        return;
+    }
+    Log("Games: manager started for " + std::to_string(m_gameRules.size()) + " rule(s).");
+}
+
+void Gui::StopGameManager()
+{
+    if (!m_gameManager) return;
+    m_gameManager->Stop();
+    game_runtime::Savings saved = m_gameManager->BackgroundSavings();
+    m_gameManager.reset();
+    CollectGameEvents();
+    Log("Games: manager stopped." +
+        (saved.sessions ? " Kept off the game cores: " + game_runtime::Describe(saved) + "." : std::string()));
+}
+
+void Gui::CollectGameEvents()
+{
+    std::vector<std::string> events;
+    {
+        std::lock_guard<std::mutex> lock(m_gameMutex);
+        events.swap(m_gameEvents);
+    }
+    for (const auto& e : events) Log(e);
+}
@@ -2,12 +2,20 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <d3d11.h>
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include "tweaks/tweak_base.h"
 #include "backup_manager.h"
+#include "bench/core_latency.h"
+#include "bench/results_store.h"
+#include "bench/regression_sentinel.h"
+#include "bench/interrupt_manager.h"
+#include "bench/game_runtime.h"
 
 struct ImVec4;
 
@@ -32,6 +40,11 @@ private:
     void DrawDetailPopup();
     void DrawConfirmPopup();
     void DrawAboutPopup();
+    void DrawCoreLatencyPopup();
+    void DrawTrendsPopup();
+    void DrawSentinelPopup();
+    void DrawInterruptsPopup();
+    void DrawGamesPopup();
 
     void ApplyTweak(TweakBase* tweak);
     void RevertTweak(TweakBase* tweak);
@@ -39,6 +52,22 @@ private:
     void RevertAll();
     void CreateRestorePoint();
     void ExportLog();
+    void StartCoreLatency();
+    void StopCoreLatency();
+    bool OpenResultsStore();
+    void StoreCoreLatencyRun(const core_latency::Result& r);
+    void StartSentinel();
+    void StopSentinel();
+    void CollectSentinel();
+    void ReapplyDroppedTweaks();
+    void SaveSentinelProfile(bool reapplyAllowed);
+    void RefreshInterruptDevices();
+    void ApplyInterruptSetting(bool restore);
+    void LoadGameRules();
+    void SaveGameRules();
+    void StartGameManager();
+    void StopGameManager();
+    void CollectGameEvents();
 
     void Log(const std::string& msg);
 
@@ -56,11 +85,65 @@ private:
     bool        m_showDetail       = false;
     bool        m_showConfirm      = false;
     bool        m_showAbout        = false;
+    bool        m_showCoreLatency  = false;
+    bool        m_showTrends       = false;
+    bool        m_showSentinel     = false;
+    bool        m_showInterrupts   = false;
+    bool        m_showGames        = false;
     bool        m_confirmRevert    = false;
     std::string m_statusMsg;
     std::vector<std::string> m_log;
     char        m_searchBuf[128]   = {};
 
+    // Per-core wake-up latency run (background thread)
+    std::thread             m_coreThread;
+    std::atomic<bool>       m_coreRunning{false};
+    std::atomic<bool>       m_coreCancel{false};
+    std::atomic<uint32_t>   m_coreProgress{0};
+    core_latency::Result    m_corePending;     // written by the worker
+    core_latency::Result    m_coreResult;      // shown by the UI
+    int                     m_coreDurationS    = 10;
+
+    // Results store and p99.9 trend view
+    results_store::Store    m_store;
+    bool                    m_storeOpen        = false;
+    std::string             m_storeError;
+    int                     m_trendSeries      = 0;
+    bool                    m_trendThisMachine = true;
+
+    // Driver / OS update sentinel, checked once at startup (background thread)
+    std::thread                   m_sentinelThread;
+    std::atomic<bool>             m_sentinelRunning{false};
+    std::atomic<bool>             m_sentinelCancel{false};
+    regression_sentinel::Outcome  m_sentinel;          // written by the worker
+    bool                          m_sentinelReapply  = false;
+
+    // Per-device MSI mode and interrupt priority
+    std::vector<interrupt_manager::DeviceInfo> m_irqDevices;
+    std::vector<char>                          m_irqSelected;
+    interrupt_manager::BackupSet               m_irqBackups;
+    std::string                                m_irqError;
+    int                                        m_irqMode      = 0;    // 0 = MSI, 1 = line-based
+    int                                        m_irqPriority  = 0;    // 0 = leave, else Priority + 1
+    int                                        m_irqLimit     = -1;   // -1 = leave, 0 = remove the cap
+    bool                                       m_irqShowAbsent = false;
+
+    // Game process runtime manager; events arrive on its trace thread
+    std::vector<game_runtime::Rule>        m_gameRules;
+    std::vector<game_runtime::Rule>        m_gameBackground;  // throttled while a game runs
+    std::vector<uint32_t>                  m_gameCpus;        // machine profile, read with the rules
+    std::unique_ptr<game_runtime::Manager> m_gameManager;
+    std::mutex                             m_gameMutex;
+    std::vector<std::string>               m_gameEvents;      // written by the trace thread
+    std::string                            m_gameError;
+    char                                   m_gameExe[128]   = {};
+    int                                    m_gamePriority   = static_cast<int>(game_runtime::Priority::High);
+    int                                    m_gameIo         = static_cast<int>(game_runtime::IoPriority::High);
+    int                                    m_gameMemory     = static_cast<int>(game_runtime::MemoryPriority::Normal);
+    int                                    m_gameThrottling = static_cast<int>(game_runtime::Throttling::Off);
+    int                                    m_gameCpuChoice  = 1;      // keep, game, non-game, E-cores
+    bool                                   m_gameEditBackground = false;
+
     // Category info
     std::vector<std::string> m_categories;
     void RebuildCategories();
@@ -69,4 +152,5 @@ private:
     int CountAppliedInCategory(const std::string& cat) const;
     int CountTotalInCategory(const std::string& cat) const;
     bool MatchesSearch(const TweakBase* t) const;
+    TweakBase* FindTweak(const std::string& id) const;
 };
@@ -6,6 +6,7 @@
 #include "gui.h"
 #include "backup_manager.h"
 #include "utils/privilege_utils.h"
+#include "utils/device_utils.h"
 
 // Tweaks
 #include "tweaks/services_tweaks.h"
@@ -101,8 +102,21 @@ static LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 }
 
 // ─── Register all tweaks ──────────────────────────────────────────────────────
+// Device tweaks get one object per matching active adapter, so a machine
+// with an iGPU and a dGPU, or several NICs, targets each one explicitly.
+template <typename T>
+static void RegisterPerDevice(Gui& gui, const std::vector<device_utils::ClassDevice>& devices)
+{
+    for (const auto& dev : devices)
+        gui.RegisterTweak(std::make_shared<T>(dev));
+}
+
 static void RegisterTweaks(Gui& gui)
 {
+    const auto nvidia = device_utils::FindDevices(device_utils::kDisplayClass, device_utils::NvidiaGpu());
+    const auto gpus   = device_utils::FindDevices(device_utils::kDisplayClass, device_utils::PciDevice());
+    const auto nics   = device_utils::FindDevices(device_utils::kNetClass, device_utils::PciDevice());
+
     // Services (5)
     gui.RegisterTweak(std::make_shared<DisableSysMainTweak>());
     gui.RegisterTweak(std::make_shared<DisableWSearchTweak>());
@@ -117,21 +131,24 @@ static void RegisterTweaks(Gui& gui)
     gui.RegisterTweak(std::make_shared<DisableCortanaTweak>());
     gui.RegisterTweak(std::make_shared<DisableFastStartupTweak>());
 
-    // Power (4)
+    // Power (5)
     gui.RegisterTweak(std::make_shared<UltimatePerformancePlanTweak>());
     gui.RegisterTweak(std::make_shared<DisableUSBSuspendTweak>());
+    gui.RegisterTweak(std::make_shared<PathPowerManagementTweak>());
     gui.RegisterTweak(std::make_shared<DisableCoreParkingTweak>());
     gui.RegisterTweak(std::make_shared<DisablePowerThrottlingTweak>());
 
-    // Network (5)
+    // Network (5 + 2 per NIC)
     gui.RegisterTweak(std::make_shared<DisableNagleTweak>());
     gui.RegisterTweak(std::make_shared<DisableNetworkThrottlingTweak>());
     gui.RegisterTweak(std::make_shared<DisableTCPAutoTuningTweak>());
     gui.RegisterTweak(std::make_shared<DisableECNTweak>());
     gui.RegisterTweak(std::make_shared<DisableTCPTimestampsTweak>());
+    RegisterPerDevice<RssPlanTweak>(gui, nics);
+    RegisterPerDevice<NicLatencyPresetTweak>(gui, nics);
 
-    // GPU (4)
-    gui.RegisterTweak(std::make_shared<NvidiaOptimizeTweak>());
+    // GPU (3 + 1 per NVIDIA adapter)
+    RegisterPerDevice<NvidiaOptimizeTweak>(gui, nvidia);
     gui.RegisterTweak(std::make_shared<DisableHAGSTweak>());
     gui.RegisterTweak(std::make_shared<EnableHAGSTweak>());
     gui.RegisterTweak(std::make_shared<DisableFullscreenOptTweak>());
@@ -141,13 +158,14 @@ static void RegisterTweaks(Gui& gui)
     gui.RegisterTweak(std::make_shared<LargeSystemCacheTweak>());
     gui.RegisterTweak(std::make_shared<DisableMemoryCompressionTweak>());
 
-    // Timers (2)
+    // Timers (3)
     gui.RegisterTweak(std::make_shared<HighResTimerTweak>());
     gui.RegisterTweak(std::make_shared<DisableDynamicTickTweak>());
+    gui.RegisterTweak(std::make_shared<GlobalTimerRequestsTweak>());
 
-    // Interrupts (2)
-    gui.RegisterTweak(std::make_shared<NetworkInterruptAffinityTweak>());
-    gui.RegisterTweak(std::make_shared<DisableNetworkMSITweak>());
+    // Interrupts (1 + 1 per NIC)
+    gui.RegisterTweak(std::make_shared<InterruptAffinityPlanTweak>());
+    RegisterPerDevice<DisableNetworkMSITweak>(gui, nics);
 
     // Input (5)
     gui.RegisterTweak(std::make_shared<DisableMouseAccelerationTweak>());
@@ -161,14 +179,13 @@ static void RegisterTweaks(Gui& gui)
     gui.RegisterTweak(std::make_shared<GameCPUPriorityTweak>());
     gui.RegisterTweak(std::make_shared<SFIOPriorityTweak>());
 
-    // DPC Latency (7)
-    gui.RegisterTweak(std::make_shared<DisableNvidiaHDCPTweak>());
-    gui.RegisterTweak(std::make_shared<NvidiaPerCpuDpcTweak>());
-    gui.RegisterTweak(std::make_shared<DisableNvidiaASPMTweak>());
-    gui.RegisterTweak(std::make_shared<EnableGPUMSITweak>());
+    // DPC Latency (1 + 4 per NVIDIA adapter + 1 per GPU)
+    RegisterPerDevice<DisableNvidiaHDCPTweak>(gui, nvidia);
+    RegisterPerDevice<NvidiaPerCpuDpcTweak>(gui, nvidia);
+    RegisterPerDevice<DisableNvidiaASPMTweak>(gui, nvidia);
+    RegisterPerDevice<EnableGPUMSITweak>(gui, gpus);
     gui.RegisterTweak(std::make_shared<DisableNvTelemetryTweak>());
-    gui.RegisterTweak(std::make_shared<GPUInterruptAffinityTweak>());
-    gui.RegisterTweak(std::make_shared<DisableNvidiaEnergyDriverTweak>());
+    RegisterPerDevice<DisableNvidiaEnergyDriverTweak>(gui, nvidia);
 
     // Misc (7)
     gui.RegisterTweak(std::make_shared<DisableDeliveryOptimizationTweak>());
@@ -0,0 +1,2067 @@
+// LatencyProbe – console front-end for the measurement probes in src/bench.
+//
+// Portable: builds on Windows (alongside the GUI) and on Linux, so the same
+// probes can run on both ends of a LAN link or on Linux test machines.
+
+#include "bench/bench_clock.h"
+#include "bench/histogram.h"
+#include "bench/net_probe.h"
+#include "bench/throughput_bench.h"
+#include "bench/frame_analyzer.h"
+#include "bench/input_analyzer.h"
+#include "bench/input_capture.h"
+#include "bench/audio_deadline.h"
+#include "bench/load_gen.h"
+#include "bench/core_latency.h"
+#include "bench/c2c_latency.h"
+#include "bench/clock_source.h"
+#include "bench/machine_profile.h"
+#include "bench/page_fault_bench.h"
+#include "bench/storage_bench.h"
+#include "bench/standby_list.h"
+#include "bench/power_scheme.h"
+#include "bench/results_store.h"
+#include "bench/regression_sentinel.h"
+#include "bench/cpu_topology.h"
+#include "bench/affinity_planner.h"
+#include "bench/interrupt_manager.h"
+#include "bench/device_power.h"
+#include "bench/game_runtime.h"
+#include "bench/nic_params.h"
+#include "bench/nic_tuning.h"
+#include "bench/rss_planner.h"
+#include "bench/timer_resolution.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ─── Argument parsing ────────────────────────────────────────────────────────
+
+class Args {
+public:
+    Args(int argc, char** argv, int first)
+    {
+        for (int i = first; i < argc; ++i)
+            m_args.emplace_back(argv[i]);
+    }
+
+    bool Has(const std::string& flag) const
+    {
+        for (const auto& a : m_args)
+            if (a == flag) return true;
+        return false;
+    }
+
+    std::string Get(const std::string& name, const std::string& def) const
+    {
+        for (std::size_t i = 0; i + 1 < m_args.size(); ++i)
+            if (m_args[i] == name) return m_args[i + 1];
+        return def;
+    }
+
+    uint32_t GetU32(const std::string& name, uint32_t def) const
+    {
+        std::string v = Get(name, "");
+        return v.empty() ? def : static_cast<uint32_t>(std::strtoul(v.c_str(), nullptr, 0));
+    }
+
+    // Comma-separated list of unsigned values, e.g. "--size 64,512,1400".
+    std::vector<uint32_t> GetU32List(const std::string& name, uint32_t def) const
+    {
+        std::vector<uint32_t> out;
+        std::string v = Get(name, "");
+        std::size_t pos = 0;
+        while (pos < v.size())
+        {
+            std::size_t comma = v.find(',', pos);
+            if (comma == std::string::npos) comma = v.size();
+            out.push_back(static_cast<uint32_t>(
+                std::strtoul(v.substr(pos, comma - pos).c_str(), nullptr, 0)));
+            pos = comma + 1;
+        }
+        if (out.empty()) out.push_back(def);
+        return out;
+    }
+
+    // Tokens that are neither options nor option values.  Every "--name"
+    // consumes the following token, so boolean flags must come last.
+    std::vector<std::string> Positional() const
+    {
+        std::vector<std::string> out;
+        for (std::size_t i = 0; i < m_args.size(); ++i)
+        {
+            if (m_args[i].rfind("--", 0) == 0) { ++i; continue; }
+            out.push_back(m_args[i]);
+        }
+        return out;
+    }
+
+    double GetDouble(const std::string& name, double def) const
+    {
+        std::string v = Get(name, "");
+        return v.empty() ? def : std::strtod(v.c_str(), nullptr);
+    }
+
+    // Byte size with optional K/M/G suffix; "auto" or "0" means 0.
+    static uint64_t ParseSize(const std::string& v)
+    {
+        if (v.empty() || v == "auto") return 0;
+        char* end = nullptr;
+        uint64_t n = std::strtoull(v.c_str(), &end, 0);
+        switch (end ? *end : '\0') {
+            case 'k': case 'K': return n << 10;
+            case 'm': case 'M': return n << 20;
+            case 'g': case 'G': return n << 30;
+        }
+        return n;
+    }
+
+    uint64_t GetSize(const std::string& name, uint64_t def) const
+    {
+        std::string v = Get(name, "");
+        return v.empty() ? def : ParseSize(v);
+    }
+
+    // Comma-separated list of sizes, e.g. "--buffers auto,64K,4M".
+    std::vector<uint64_t> GetSizeList(const std::string& name, uint64_t def) const
+    {
+        std::vector<uint64_t> out;
+        std::string v = Get(name, "");
+        std::size_t pos = 0;
+        while (pos < v.size())
+        {
+            std::size_t comma = v.find(',', pos);
+            if (comma == std::string::npos) comma = v.size();
+            out.push_back(ParseSize(v.substr(pos, comma - pos)));
+            pos = comma + 1;
+        }
+        if (out.empty()) out.push_back(def);
+        return out;
+    }
+
+private:
+    std::vector<std::string> m_args;
+};
+
+static std::atomic<bool> g_interrupted{false};
+
+static void OnInterrupt(int)
+{
+    g_interrupted = true;
+}
+
+// Write labelled histogram blocks to a CSV file (one "# label" line per block).
+static bool WriteHistogramCsv(const std::string& path,
+                              const std::vector<std::pair<std::string, LatencyHistogram>>& runs)
+{
+    std::ofstream f(path);
+    if (!f.is_open()) return false;
+    for (const auto& run : runs)
+    {
+        f << "# " << run.first << "\n";
+        run.second.WriteCsv(f);
+    }
+    return true;
+}
+
+// Comma-separated strings, empty items dropped.
+static std::vector<std::string> SplitList(const std::string& v)
+{
+    std::vector<std::string> out;
+    std::size_t pos = 0;
+    while (pos < v.size())
+    {
+        std::size_t comma = v.find(',', pos);
+        if (comma == std::string::npos) comma = v.size();
+        if (comma > pos) out.push_back(v.substr(pos, comma - pos));
+        pos = comma + 1;
+    }
+    return out;
+}
+
+// Append the run to the results store when "--store on|DIR" is given;
+// --tags and --tweaks label it for later queries.
+static void StoreRuns(const Args& args, const char* probe,
+                      const std::vector<std::pair<std::string, LatencyHistogram>>& runs)
+{
+    std::string where = args.Get("--store", "off");
+    if (where == "off") return;
+
+    results_store::Store store;
+    std::string error;
+    if (!store.Open(where == "on" ? results_store::DefaultDirectory() : where, error))
+    {
+        std::fprintf(stderr, "store: %s\n", error.c_str());
+        return;
+    }
+    results_store::Record rec;
+    rec.fingerprint = machine_profile::Current().fingerprint;
+    rec.probe       = probe;
+    rec.tags        = SplitList(args.Get("--tags", ""));
+    rec.tweaks      = SplitList(args.Get("--tweaks", ""));
+    rec.histograms  = runs;
+    if (!store.Append(rec, error))
+        std::fprintf(stderr, "store: %s\n", error.c_str());
+    else
+        std::printf("Stored as run %zu in the results store\n", store.Runs());
+}
+
+// ─── net-echo ────────────────────────────────────────────────────────────────
+
+static int CmdNetEcho(const Args& args)
+{
+    uint16_t port    = static_cast<uint16_t>(args.GetU32("--port", 7777));
+    bool     noDelay = args.Get("--nodelay", "on") != "off";
+
+    net_probe::EchoResponder responder(port, noDelay);
+    if (!responder.Start())
+    {
+        std::fprintf(stderr, "net-echo: %s\n", responder.LastError().c_str());
+        return 1;
+    }
+
+    std::printf("Echo responder listening on udp/tcp port %u (Ctrl+C to stop)\n",
+                static_cast<unsigned>(responder.Port()));
+    std::signal(SIGINT, OnInterrupt);
+    while (!g_interrupted)
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    responder.Stop();
+    std::printf("Echoed %llu messages.\n",
+                static_cast<unsigned long long>(responder.Echoed()));
+    return 0;
+}
+
+// ─── net-ping ────────────────────────────────────────────────────────────────
+
+static int CmdNetPing(const Args& args)
+{
+    net_probe::Config base;
+    base.host      = args.Get("--host", base.host);
+    base.port      = static_cast<uint16_t>(args.GetU32("--port", base.port));
+    base.rateHz    = args.GetU32("--rate", base.rateHz);
+    base.count     = args.GetU32("--count", base.count);
+    base.warmup    = args.GetU32("--warmup", base.warmup);
+    base.timeoutMs = args.GetU32("--timeout", base.timeoutMs);
+
+    std::vector<net_probe::Proto> protos;
+    std::string proto = args.Get("--proto", "both");
+    if (proto != "tcp") protos.push_back(net_probe::Proto::Udp);
+    if (proto != "udp") protos.push_back(net_probe::Proto::Tcp);
+
+    std::vector<bool> noDelays;
+    std::string nodelay = args.Get("--nodelay", "both");
+    if (nodelay != "off") noDelays.push_back(true);
+    if (nodelay != "on")  noDelays.push_back(false);
+
+    // --loopback: run the responder in-process so one command is self-contained.
+    std::unique_ptr<net_probe::EchoResponder> local;
+    if (args.Has("--loopback"))
+    {
+        local = std::make_unique<net_probe::EchoResponder>(base.port);
+        if (!local->Start())
+        {
+            std::fprintf(stderr, "net-ping: local responder: %s\n", local->LastError().c_str());
+            return 1;
+        }
+        base.host = "127.0.0.1";
+        base.port = local->Port();
+    }
+
+    std::vector<std::pair<std::string, LatencyHistogram>> runs;
+    int failures = 0;
+
+    for (uint32_t size : args.GetU32List("--size", base.messageSize))
+    {
+        for (auto p : protos)
+        {
+            // TCP_NODELAY only means something for TCP.
+            std::size_t variants = (p == net_probe::Proto::Tcp) ? noDelays.size() : 1;
+            for (std::size_t v = 0; v < variants; ++v)
+            {
+                net_probe::Config cfg = base;
+                cfg.proto       = p;
+                cfg.messageSize = size;
+                cfg.noDelay     = noDelays[v];
+
+                std::string label = net_probe::Describe(cfg);
+                net_probe::Result r = net_probe::RunPingPong(cfg);
+
+                std::printf("[%s] -> %s:%u\n", label.c_str(), cfg.host.c_str(),
+                            static_cast<unsigned>(cfg.port));
+                if (!r.ok)
+                {
+                    std::printf("  FAILED: %s\n", r.error.c_str());
+                    ++failures;
+                }
+                std::printf("  sent=%u received=%u lost=%u  elapsed=%.2f s\n",
+                            r.sent, r.received, r.lost, r.elapsedNs / 1e9);
+                std::printf("  rtt %s\n", r.rtt.Summary().c_str());
+                runs.emplace_back(label, r.rtt);
+            }
+        }
+    }
+
+    std::string csv = args.Get("--csv", "");
+    if (!csv.empty() && !WriteHistogramCsv(csv, runs))
+        std::fprintf(stderr, "net-ping: cannot write %s\n", csv.c_str());
+    StoreRuns(args, "net-ping", runs);
+
+    return failures ? 1 : 0;
+}
+
+// ─── tcp-sink ────────────────────────────────────────────────────────────────
+
+static int CmdTcpSink(const Args& args)
+{
+    uint16_t port   = static_cast<uint16_t>(args.GetU32("--port", 7778));
+    uint32_t buffer = static_cast<uint32_t>(args.GetSize("--buffer", 0));
+
+    throughput_bench::BulkServer server(port, buffer);
+    if (!server.Start())
+    {
+        std::fprintf(stderr, "tcp-sink: %s\n", server.LastError().c_str());
+        return 1;
+    }
+
+    std::printf("Bulk TCP server listening on port %u (Ctrl+C to stop)\n",
+                static_cast<unsigned>(server.Port()));
+    std::signal(SIGINT, OnInterrupt);
+    while (!g_interrupted)
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    server.Stop();
+    return 0;
+}
+
+// ─── tcp-bulk ────────────────────────────────────────────────────────────────
+
+static int CmdTcpBulk(const Args& args)
+{
+    throughput_bench::Config base;
+    base.host           = args.Get("--host", base.host);
+    base.port           = static_cast<uint16_t>(args.GetU32("--port", base.port));
+    base.bindAddress    = args.Get("--bind", "");
+    base.streams        = args.GetU32("--streams", base.streams);
+    base.bytesPerStream = args.GetSize("--bytes", base.bytesPerStream);
+    base.chunkSize      = static_cast<uint32_t>(args.GetSize("--chunk", base.chunkSize));
+    base.timeoutMs      = args.GetU32("--timeout", base.timeoutMs);
+    base.direction      = args.Get("--direction", "down") == "up"
+                        ? throughput_bench::Direction::Upload
+                        : throughput_bench::Direction::Download;
+
+    const bool loopback = args.Has("--loopback");
+    if (loopback) base.host = "127.0.0.1";
+
+    int failures = 0;
+    std::printf("%-32s %12s %12s %10s %10s\n",
+                "run", "goodput", "completion", "retrans", "rtt");
+    for (uint64_t buffer : args.GetSizeList("--buffers", 0))
+    {
+        throughput_bench::Config cfg = base;
+        cfg.bufferSize = static_cast<uint32_t>(buffer);
+
+        // --loopback: in-process server so sender and receiver share one
+        // command, restarted per run so both ends use the same buffer size.
+        std::unique_ptr<throughput_bench::BulkServer> local;
+        if (loopback)
+        {
+            local = std::make_unique<throughput_bench::BulkServer>(base.port, cfg.bufferSize);
+            if (!local->Start())
+            {
+                std::fprintf(stderr, "tcp-bulk: local server: %s\n", local->LastError().c_str());
+                return 1;
+            }
+            cfg.port = local->Port();
+        }
+
+        throughput_bench::Result r = throughput_bench::Run(cfg);
+        uint32_t rtt = r.streams.empty() ? 0 : r.streams.front().rttUs;
+        std::printf("%-32s %7.1f Mb/s %10.3f s %10llu %7u us\n",
+                    throughput_bench::Describe(cfg).c_str(), r.goodputMbps,
+                    r.completionNs / 1e9,
+                    static_cast<unsigned long long>(r.retransSegments), rtt);
+        if (!r.ok)
+        {
+            std::printf("  FAILED: %s\n", r.error.c_str());
+            ++failures;
+        }
+    }
+    return failures ? 1 : 0;
+}
+
+// ─── frames ──────────────────────────────────────────────────────────────────
+
+static int CmdFrames(const Args& args)
+{
+    std::vector<std::string> files = args.Positional();
+    if (files.empty())
+    {
+        std::fprintf(stderr, "frames: no PresentMon CSV files given\n");
+        return 1;
+    }
+
+    std::string app     = args.Get("--app", "");
+    double      stutter = args.GetDouble("--stutter", 2.0);
+    double      alpha   = args.GetDouble("--alpha", 0.01);
+
+    std::vector<frame_analyzer::Capture> captures;
+    std::vector<frame_analyzer::Stats>   results;
+    for (const auto& path : files)
+    {
+        frame_analyzer::Capture cap;
+        std::string error;
+        if (!frame_analyzer::LoadCsv(path, app, cap, error))
+        {
+            std::fprintf(stderr, "frames: %s: %s\n", path.c_str(), error.c_str());
+            return 1;
+        }
+        results.push_back(frame_analyzer::Analyze(cap, stutter));
+        captures.push_back(std::move(cap));
+    }
+
+    // Side-by-side table, one column per run.
+    std::printf("%-22s", "");
+    for (std::size_t i = 0; i < captures.size(); ++i)
+        std::printf(" %14s", ("run " + std::to_string(i + 1)).c_str());
+    std::printf("\n");
+
+    auto row = [&](const char* label, auto getter, const char* fmt) {
+        std::printf("%-22s", label);
+        for (const auto& s : results) std::printf(fmt, getter(s));
+        std::printf("\n");
+    };
+    using S = frame_analyzer::Stats;
+    row("frames",            [](const S& s) { return (unsigned long long)s.frames; }, " %14llu");
+    row("duration (s)",      [](const S& s) { return s.durationS; },    " %14.1f");
+    row("avg fps",           [](const S& s) { return s.avgFps; },       " %14.1f");
+    row("1% low fps",        [](const S& s) { return s.low1Fps; },      " %14.1f");
+    row("0.1% low fps",      [](const S& s) { return s.low01Fps; },     " %14.1f");
+    row("frame p50 (ms)",    [](const S& s) { return s.p50Ms; },        " %14.2f");
+    row("frame p90 (ms)",    [](const S& s) { return s.p90Ms; },        " %14.2f");
+    row("frame p99 (ms)",    [](const S& s) { return s.p99Ms; },        " %14.2f");
+    row("frame p99.9 (ms)",  [](const S& s) { return s.p999Ms; },       " %14.2f");
+    row("frame max (ms)",    [](const S& s) { return s.maxMs; },        " %14.2f");
+    row("stutters",          [](const S& s) { return (unsigned long long)s.stutters; }, " %14llu");
+    row("dropped",           [](const S& s) { return (unsigned long long)s.dropped; },  " %14llu");
+    row("display p50 (ms)",  [](const S& s) { return s.displayP50Ms; }, " %14.2f");
+    row("display p99 (ms)",  [](const S& s) { return s.displayP99Ms; }, " %14.2f");
+
+    std::printf("\nSources:\n");
+    for (std::size_t i = 0; i < captures.size(); ++i)
+        std::printf("  run %zu: %s [%s]\n", i + 1, captures[i].source.c_str(),
+                    captures[i].application.c_str());
+
+    // Every later run is tested against run 1 (the baseline).
+    if (captures.size() > 1)
+    {
+        std::printf("\nShift vs. run 1 (Mann-Whitney, alpha=%.3g; effect > 0 = slower):\n", alpha);
+        for (std::size_t i = 1; i < captures.size(); ++i)
+        {
+            auto c = frame_analyzer::Compare(captures[0], captures[i], alpha);
+            std::printf("  run %zu frame time:      effect=%+.3f p=%.2e  %s\n", i + 1,
+                        c.frameTime.effect, c.frameTime.pValue,
+                        c.frameTimeShift ? "SIGNIFICANT" : "no significant shift");
+            if (results[0].hasDisplay && results[i].hasDisplay)
+                std::printf("  run %zu display latency: effect=%+.3f p=%.2e  %s\n", i + 1,
+                            c.displayLatency.effect, c.displayLatency.pValue,
+                            c.displayLatencyShift ? "SIGNIFICANT" : "no significant shift");
+        }
+    }
+    return 0;
+}
+
+// ─── input-capture / input-analyze ───────────────────────────────────────────
+
+static void PrintInputAnalysis(const input_analyzer::Analysis& a)
+{
+    std::printf("device %llu: %llu reports in %llu bursts\n",
+                static_cast<unsigned long long>(a.device),
+                static_cast<unsigned long long>(a.reports),
+                static_cast<unsigned long long>(a.bursts));
+    if (a.nominalNs == 0)
+    {
+        std::printf("  not enough in-burst reports (move the mouse continuously)\n");
+        return;
+    }
+    std::printf("  effective rate   %.0f Hz (nominal interval %.1f us)\n",
+                a.effectiveHz, a.nominalNs / 1000.0);
+    std::printf("  jitter           sd=%.1f us  p99 |dev|=%.1f us\n",
+                a.jitterNs / 1000.0, a.jitterP99Ns / 1000.0);
+    std::printf("  dropped reports  %llu (est.)\n", static_cast<unsigned long long>(a.droppedReports));
+    std::printf("  coalesced        %llu\n", static_cast<unsigned long long>(a.coalesced));
+    std::printf("  interval %s\n", a.intervals.Summary().c_str());
+    if (a.deliveryDelay.Count())
+        std::printf("  delivery (rel.) %s  [source resolution %.1f us]\n",
+                    a.deliveryDelay.Summary().c_str(), a.sourceResolutionNs / 1000.0);
+    else if (a.sourceResolutionNs > input_analyzer::kMaxSourceResolutionNs)
+        std::printf("  delivery         n/a (source stamps %.1f ms apart are too coarse)\n",
+                    a.sourceResolutionNs / 1e6);
+    else
+        std::printf("  delivery         n/a (no per-report OS stamp; Windows raw input has none)\n");
+}
+
+static input_analyzer::Config InputConfig(const Args& args)
+{
+    input_analyzer::Config cfg;
+    cfg.idleGapNs  = static_cast<uint64_t>(args.GetDouble("--idle-ms", cfg.idleGapNs / 1e6) * 1e6);
+    cfg.dropFactor = args.GetDouble("--drop-factor", cfg.dropFactor);
+    cfg.device     = std::strtoull(args.Get("--device-id", "0").c_str(), nullptr, 0);
+    return cfg;
+}
+
+static int CmdInputCapture(const Args& args)
+{
+    input_capture::Config cfg;
+    cfg.durationMs = static_cast<uint32_t>(args.GetDouble("--duration", cfg.durationMs / 1000.0) * 1000.0);
+    cfg.device     = args.Get("--device", "");
+
+    std::printf("Capturing pointer input for %.1f s - move the mouse in steady circles...\n",
+                cfg.durationMs / 1000.0);
+    std::signal(SIGINT, OnInterrupt);
+
+    input_analyzer::Recording rec;
+    std::string error;
+    if (!input_capture::Record(cfg, rec, error, &g_interrupted))
+    {
+        std::fprintf(stderr, "input-capture: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::string out = args.Get("--out", "");
+    if (!out.empty() && !input_analyzer::SaveCsv(out, rec))
+        std::fprintf(stderr, "input-capture: cannot write %s\n", out.c_str());
+
+    PrintInputAnalysis(input_analyzer::Analyze(rec, InputConfig(args)));
+    return 0;
+}
+
+static int CmdInputAnalyze(const Args& args)
+{
+    std::vector<std::string> files = args.Positional();
+    if (files.empty())
+    {
+        std::fprintf(stderr, "input-analyze: no recording given\n");
+        return 1;
+    }
+
+    for (const auto& path : files)
+    {
+        input_analyzer::Recording rec;
+        std::string error;
+        if (!input_analyzer::LoadCsv(path, rec, error))
+        {
+            std::fprintf(stderr, "input-analyze: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("%s\n", path.c_str());
+        PrintInputAnalysis(input_analyzer::Analyze(rec, InputConfig(args)));
+    }
+    return 0;
+}
+
+// ─── audio-deadline ──────────────────────────────────────────────────────────
+
+static int CmdAudioDeadline(const Args& args)
+{
+    audio_deadline::Config base;
+    base.durationMs = static_cast<uint32_t>(args.GetDouble("--duration", base.durationMs / 1000.0) * 1000.0);
+    base.dspLoad    = args.GetDouble("--load", base.dspLoad);
+
+    std::vector<audio_deadline::Scheduling> modes;
+    std::string mode = args.Get("--mode", "both");
+    if (mode != "rt")     modes.push_back(audio_deadline::Scheduling::Normal);
+    if (mode != "normal") modes.push_back(audio_deadline::Scheduling::RealTime);
+
+    std::vector<uint32_t> rates   = args.GetU32List("--rate", base.sampleRate);
+    std::vector<uint32_t> buffers = args.GetU32List("--buffers", 0);
+    if (buffers.size() == 1 && buffers[0] == 0) buffers = { 32, 64, 128, 256, 512 };
+
+    std::signal(SIGINT, OnInterrupt);
+    std::printf("%-38s %10s %10s %10s %8s  %s\n",
+                "run", "late p99", "late p99.9", "late max", "misses", "verdict");
+
+    std::vector<std::string> recommendations;
+    for (uint32_t rate : rates)
+    {
+        for (auto m : modes)
+        {
+            std::vector<std::pair<audio_deadline::Config, audio_deadline::Result>> sweep;
+            for (uint32_t frames : buffers)
+            {
+                if (g_interrupted) break;
+                audio_deadline::Config cfg = base;
+                cfg.sampleRate   = rate;
+                cfg.bufferFrames = frames;
+                cfg.scheduling   = m;
+
+                audio_deadline::Result r = audio_deadline::Run(cfg, &g_interrupted);
+                std::printf("%-38s %7.1f us %7.1f us %7.1f us %8llu  %s\n",
+                            audio_deadline::Describe(cfg).c_str(),
+                            r.lateness.ValueAtPercentile(99.0) / 1000.0,
+                            r.lateness.ValueAtPercentile(99.9) / 1000.0,
+                            r.lateness.Max() / 1000.0,
+                            static_cast<unsigned long long>(r.misses),
+                            audio_deadline::Passed(r) ? "PASS" : "FAIL");
+                if (!r.ok)           std::printf("  FAILED: %s\n", r.error.c_str());
+                if (!r.note.empty()) std::printf("  note: %s\n", r.note.c_str());
+                sweep.emplace_back(cfg, std::move(r));
+            }
+
+            uint32_t best = audio_deadline::Recommend(sweep);
+            char line[160];
+            if (best)
+                std::snprintf(line, sizeof(line), "%u Hz, %s: %u samples (%.2f ms)", rate,
+                              audio_deadline::SchedulingName(m), best, best * 1000.0 / rate);
+            else
+                std::snprintf(line, sizeof(line), "%u Hz, %s: no tested buffer size is safe",
+                              rate, audio_deadline::SchedulingName(m));
+            recommendations.push_back(line);
+        }
+    }
+
+    std::printf("\nRecommended buffer size (smallest with no misses at it or above):\n");
+    for (const auto& line : recommendations)
+        std::printf("  %s\n", line.c_str());
+    return 0;
+}
+
+// ─── load ────────────────────────────────────────────────────────────────────
+
+// Scenario from --script file or an inline ';'-separated --spec.
+static bool ScenarioFromArgs(const Args& args, const char* script, const char* spec,
+                             load_gen::Scenario& out, std::string& error)
+{
+    std::string path = args.Get(script, "");
+    if (!path.empty()) return load_gen::LoadScenario(path, out, error);
+    return load_gen::ParseScenario(args.Get(spec, ""), out, error);
+}
+
+static void PrintScenario(const load_gen::Scenario& sc)
+{
+    std::printf("Background load (seed %llu):\n", static_cast<unsigned long long>(sc.seed));
+    for (const auto& w : sc.workloads)
+        std::printf("  %s\n", load_gen::Describe(w).c_str());
+}
+
+static int CmdLoad(const Args& args)
+{
+    load_gen::Scenario sc;
+    std::string error;
+    if (!ScenarioFromArgs(args, "--script", "--spec", sc, error))
+    {
+        std::fprintf(stderr, "load: %s\n", error.c_str());
+        return 1;
+    }
+
+    load_gen::LoadGenerator gen(sc);
+    if (!gen.Start())
+    {
+        std::fprintf(stderr, "load: %s\n", gen.LastError().c_str());
+        return 1;
+    }
+    PrintScenario(sc);
+
+    double duration = args.GetDouble("--duration", 0.0);
+    std::printf("Running %s (Ctrl+C to stop)\n", duration > 0 ? "for the given duration" : "until stopped");
+    std::signal(SIGINT, OnInterrupt);
+    uint64_t endNs = duration > 0 ? bench_clock::NowNs() + static_cast<uint64_t>(duration * 1e9) : 0;
+    while (!g_interrupted && (endNs == 0 || bench_clock::NowNs() < endNs))
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    gen.Stop();
+    for (std::size_t i = 0; i < sc.workloads.size(); ++i)
+        std::printf("  %-40s %14llu ops\n", load_gen::Describe(sc.workloads[i]).c_str(),
+                    static_cast<unsigned long long>(gen.Operations(i)));
+    return 0;
+}
+
+// ─── core-latency ────────────────────────────────────────────────────────────
+
+static int CmdCoreLatency(const Args& args)
+{
+    core_latency::Config cfg;
+    cfg.intervalUs = args.GetU32("--interval", cfg.intervalUs);
+    cfg.durationMs = static_cast<uint32_t>(args.GetDouble("--duration", cfg.durationMs / 1000.0) * 1000.0);
+    cfg.realTime   = args.Get("--priority", "rt") != "normal";
+    if (args.Has("--cpus")) cfg.cpus = args.GetU32List("--cpus", 0);
+
+    std::printf("Measuring wake-up latency on %s for %.1f s (interval %u us)...\n",
+                cfg.cpus.empty() ? "every logical CPU" : "the selected CPUs",
+                cfg.durationMs / 1000.0, cfg.intervalUs);
+    std::signal(SIGINT, OnInterrupt);
+
+    core_latency::Result r = core_latency::Run(cfg, &g_interrupted);
+    if (!r.ok)
+    {
+        std::fprintf(stderr, "core-latency: %s\n", r.error.c_str());
+        return 1;
+    }
+    if (!r.note.empty()) std::printf("note: %s\n", r.note.c_str());
+
+    std::printf("\n%s", core_latency::RenderHeatmap(r).c_str());
+
+    std::printf("\nQuietest cores first (p99.9):");
+    for (uint32_t cpu : core_latency::RankByQuietness(r)) std::printf(" %u", cpu);
+    std::printf("\n");
+
+    std::vector<std::pair<std::string, LatencyHistogram>> runs;
+    for (const auto& c : r.cores)
+        runs.emplace_back("cpu " + std::to_string(c.cpu), c.wakeup);
+
+    std::string csv = args.Get("--csv", "");
+    if (!csv.empty() && !WriteHistogramCsv(csv, runs))
+        std::fprintf(stderr, "core-latency: cannot write %s\n", csv.c_str());
+    StoreRuns(args, "core-latency", runs);
+    return 0;
+}
+
+// ─── c2c ─────────────────────────────────────────────────────────────────────
+
+static int CmdC2c(const Args& args)
+{
+    c2c_latency::Config cfg;
+    cfg.roundTrips = args.GetU32("--round-trips", cfg.roundTrips);
+    if (args.Has("--cpus")) cfg.cpus = args.GetU32List("--cpus", 0);
+
+    std::signal(SIGINT, OnInterrupt);
+    std::printf("Measuring core-to-core round trips (%u per pair)...\n", cfg.roundTrips);
+    c2c_latency::Matrix m = c2c_latency::Measure(cfg, &g_interrupted);
+    if (m.cpus.size() < 2)
+    {
+        std::fprintf(stderr, "c2c: need at least two CPUs\n");
+        return 1;
+    }
+
+    std::vector<int> domains = c2c_latency::ClusterDomains(m);
+    std::printf("\n%s", c2c_latency::Render(m, domains).c_str());
+
+    int domainCount = domains.empty() ? 0 : *std::max_element(domains.begin(), domains.end()) + 1;
+    std::printf("\n%d cache domain(s):\n", domainCount);
+    for (int d = 0; d < domainCount; ++d)
+    {
+        std::printf("  domain %d: cpus", d);
+        for (std::size_t i = 0; i < domains.size(); ++i)
+            if (domains[i] == d) std::printf(" %u", m.cpus[i]);
+        std::printf("\n");
+    }
+
+    if (args.Get("--save", "on") == "off" || g_interrupted) return 0;
+
+    if (std::size_t failed = c2c_latency::FailedPairs(m))
+    {
+        std::fprintf(stderr, "c2c: %zu pair(s) could not be pinned or measured; "
+                             "not saving to the machine profile\n", failed);
+        return 1;
+    }
+
+    // Merge into the machine profile so planners can read it back.
+    std::string path = args.Get("--profile", machine_profile::DefaultPath());
+    machine_profile::Profile profile;
+    std::string error;
+    if (!machine_profile::Load(path, profile, error))
+        profile = machine_profile::Current();
+    machine_profile::Profile now = machine_profile::Current();
+    profile.fingerprint   = now.fingerprint;
+    profile.hostName      = now.hostName;
+    profile.cpuName       = now.cpuName;
+    profile.logicalCpus   = now.logicalCpus;
+    profile.c2cMeasuredAt = machine_profile::NowIso8601();
+    profile.c2cCpus       = m.cpus;
+    profile.c2cRttNs      = m.rttNs;
+    profile.c2cDomains    = domains;
+    if (!machine_profile::Save(path, profile))
+    {
+        std::fprintf(stderr, "c2c: cannot write %s\n", path.c_str());
+        return 1;
+    }
+    std::printf("Saved to machine profile %s\n", path.c_str());
+    return 0;
+}
+
+// ─── page-faults ─────────────────────────────────────────────────────────────
+
+static int CmdPageFaults(const Args& args)
+{
+    page_fault_bench::Config cfg;
+    cfg.workingSetBytes = args.GetSize("--size", cfg.workingSetBytes);
+    cfg.pressureBytes   = args.GetSize("--pressure", cfg.pressureBytes);
+    cfg.cgroupLimit     = args.GetSize("--cgroup-limit", cfg.cgroupLimit);
+    cfg.settleMs        = args.GetU32("--settle", cfg.settleMs);
+    cfg.samples         = args.GetU32("--samples", cfg.samples);
+    cfg.rounds          = args.GetU32("--rounds", cfg.rounds);
+    cfg.seed            = args.GetU32("--seed", static_cast<uint32_t>(cfg.seed));
+
+    std::printf("Working set %llu MiB, %u round(s) of %u touches...\n",
+                static_cast<unsigned long long>(cfg.workingSetBytes >> 20), cfg.rounds, cfg.samples);
+    std::signal(SIGINT, OnInterrupt);
+
+    page_fault_bench::Result r = page_fault_bench::Run(cfg, &g_interrupted);
+    if (!r.ok)
+    {
+        std::fprintf(stderr, "page-faults: %s\n", r.error.c_str());
+        return 1;
+    }
+    if (!r.note.empty()) std::printf("note: %s\n", r.note.c_str());
+
+    std::printf("  resident (no fault): %llu\n", static_cast<unsigned long long>(r.resident));
+    std::printf("  soft        %s\n", r.soft.Summary().c_str());
+    std::printf("  compressed  %s\n", r.compressed.Summary().c_str());
+    std::printf("  disk        %s\n", r.disk.Summary().c_str());
+
+    std::vector<std::pair<std::string, LatencyHistogram>> runs = {
+        { "soft", r.soft }, { "compressed", r.compressed }, { "disk", r.disk } };
+
+    std::string csv = args.Get("--csv", "");
+    if (!csv.empty() && !WriteHistogramCsv(csv, runs))
+        std::fprintf(stderr, "page-faults: cannot write %s\n", csv.c_str());
+    StoreRuns(args, "page-faults", runs);
+    return 0;
+}
+
+// ─── storage ─────────────────────────────────────────────────────────────────
+
+static int CmdStorage(const Args& args)
+{
+    storage_bench::Config cfg;
+    cfg.directory    = args.Get("--dir", cfg.directory);
+    cfg.fileBytes    = args.GetSize("--size", cfg.fileBytes);
+    cfg.blockBytes   = static_cast<uint32_t>(args.GetSize("--block", cfg.blockBytes));
+    cfg.queueDepth   = args.GetU32("--qd", cfg.queueDepth);
+    cfg.readPercent  = args.GetU32("--read", cfg.readPercent);
+    cfg.warmupMs     = static_cast<uint32_t>(args.GetDouble("--warmup", cfg.warmupMs / 1000.0) * 1000.0);
+    cfg.durationMs   = static_cast<uint32_t>(args.GetDouble("--duration", cfg.durationMs / 1000.0) * 1000.0);
+    cfg.seed         = args.GetU32("--seed", static_cast<uint32_t>(cfg.seed));
+    cfg.forceThreads = args.Get("--engine", "auto") == "threads";
+    cfg.scanBytes    = args.GetSize("--scan-size", cfg.scanBytes);
+    cfg.scanChunk    = static_cast<uint32_t>(args.GetSize("--scan-chunk", cfg.scanChunk));
+    cfg.scanMBps     = args.GetU32("--scan-rate", cfg.scanMBps);
+
+    std::string scanner = args.Get("--scanner", "off");
+    std::vector<bool> passes;
+    if (scanner == "off" || scanner == "both") passes.push_back(false);
+    if (scanner == "on" || scanner == "both")  passes.push_back(true);
+    if (passes.empty())
+    {
+        std::fprintf(stderr, "storage: --scanner must be on, off or both\n");
+        return 1;
+    }
+
+    std::signal(SIGINT, OnInterrupt);
+    std::vector<std::pair<std::string, LatencyHistogram>> runs;
+    std::vector<storage_bench::Result> results;
+    for (bool withScanner : passes)
+    {
+        if (g_interrupted) break;
+        cfg.scanner = withScanner;
+        std::printf("Preparing %llu MiB scratch file%s in %s...\n",
+                    static_cast<unsigned long long>(cfg.fileBytes >> 20),
+                    withScanner ? " (+ scanner file)" : "", cfg.directory.c_str());
+
+        storage_bench::Result r = storage_bench::Run(cfg, &g_interrupted);
+        if (!r.ok)
+        {
+            std::fprintf(stderr, "storage: %s\n", r.error.c_str());
+            return 1;
+        }
+        if (!r.note.empty()) std::printf("note: %s\n", r.note.c_str());
+
+        std::printf("%s\n", storage_bench::Describe(cfg, r).c_str());
+        std::printf("  read   %.0f IOPS  %s\n", r.reads.Count() / r.seconds, r.reads.Summary().c_str());
+        std::printf("  write  %.0f IOPS  %s\n", r.writes.Count() / r.seconds, r.writes.Summary().c_str());
+        if (withScanner)
+            std::printf("  scanner %.1f MB/s\n", r.scanBytes / r.seconds / 1e6);
+
+        const char* tag = withScanner ? " +scanner" : "";
+        runs.emplace_back(std::string("read") + tag, r.reads);
+        runs.emplace_back(std::string("write") + tag, r.writes);
+        results.push_back(std::move(r));
+    }
+
+    // Contention cost: how much the scanner moved the tail.
+    if (results.size() == 2)
+    {
+        auto tail = [](const LatencyHistogram& h) { return h.ValueAtPercentile(99.9) / 1000.0; };
+        std::printf("\nScanner effect on p99.9: read %.0f -> %.0f us, write %.0f -> %.0f us\n",
+                    tail(results[0].reads), tail(results[1].reads),
+                    tail(results[0].writes), tail(results[1].writes));
+    }
+
+    std::string csv = args.Get("--csv", "");
+    if (!csv.empty() && !WriteHistogramCsv(csv, runs))
+        std::fprintf(stderr, "storage: cannot write %s\n", csv.c_str());
+    StoreRuns(args, "storage", runs);
+    return 0;
+}
+
+// ─── results ─────────────────────────────────────────────────────────────────
+
+static int CmdResults(const Args& args)
+{
+    results_store::Store store;
+    std::string error;
+    if (!store.Open(args.Get("--dir", results_store::DefaultDirectory()), error))
+    {
+        std::fprintf(stderr, "results: %s\n", error.c_str());
+        return 1;
+    }
+    if (!store.Note().empty()) std::printf("note: %s\n", store.Note().c_str());
+
+    if (args.Has("--series"))
+    {
+        std::printf("%zu run(s)\n", store.Runs());
+        for (const auto& s : store.Series())
+        {
+            results_store::Query q;
+            q.probe = s.first;
+            q.label = s.second;
+            std::printf("  %-14s %-32s %zu point(s)\n", s.first.c_str(), s.second.c_str(),
+                        store.Find(q).size());
+        }
+        return 0;
+    }
+
+    results_store::Query q;
+    q.probe  = args.Get("--probe", "");
+    q.label  = args.Get("--label", "");
+    q.tags   = SplitList(args.Get("--tags", ""));
+    q.tweaks = SplitList(args.Get("--tweaks", ""));
+    if (args.Get("--machine", "this") == "this")
+        q.fingerprint = machine_profile::Current().fingerprint;
+    for (auto bound : { std::make_pair("--since", &q.from), std::make_pair("--until", &q.to) })
+    {
+        std::string v = args.Get(bound.first, "");
+        if (!v.empty() && !results_store::ParseTime(v, *bound.second))
+        {
+            std::fprintf(stderr, "results: %s expects YYYY-MM-DD[THH:MM:SS]\n", bound.first);
+            return 1;
+        }
+    }
+
+    std::vector<results_store::Point> points = store.Find(q);
+    std::printf("%-20s %-14s %-28s %8s %9s %9s %9s %9s\n",
+                "time (UTC)", "probe", "label", "n", "p50 us", "p99 us", "p99.9 us", "max us");
+    for (const auto& p : points)
+        std::printf("%-20s %-14s %-28s %8llu %9.1f %9.1f %9.1f %9.1f\n",
+                    results_store::FormatTime(p.timestamp).c_str(), p.probe.c_str(), p.label.c_str(),
+                    static_cast<unsigned long long>(p.count), p.p50Us, p.p99Us, p.p999Us, p.maxUs);
+
+    if (points.size() >= 2 && !q.probe.empty() && !q.label.empty() && points.front().p999Us > 0.0)
+        std::printf("\np99.9 trend: %.1f -> %.1f us (%+.0f%%) over %zu runs\n",
+                    points.front().p999Us, points.back().p999Us,
+                    (points.back().p999Us / points.front().p999Us - 1.0) * 100.0, points.size());
+    return 0;
+}
+
+// ─── sentinel ────────────────────────────────────────────────────────────────
+
+static int CmdSentinel(const Args& args)
+{
+    regression_sentinel::Options opt;
+    opt.suite.coreLatencyMs =
+        static_cast<uint32_t>(args.GetDouble("--duration", opt.suite.coreLatencyMs / 1000.0) * 1000.0);
+    opt.storeDir    = args.Get("--dir", "");
+    opt.profilePath = args.Get("--profile", "");
+    opt.force       = args.Has("--force");
+    if (args.Has("--tweaks"))
+    {
+        opt.trackTweaks   = true;
+        opt.appliedTweaks = SplitList(args.Get("--tweaks", ""));
+    }
+
+    if (args.Has("--reapply"))
+    {
+        std::string path = opt.profilePath.empty() ? machine_profile::DefaultPath() : opt.profilePath;
+        machine_profile::Profile p;
+        std::string error;
+        if (!machine_profile::Load(path, p, error)) p = machine_profile::Current();
+        regression_sentinel::SetReapplyAllowed(p, args.Get("--reapply", "off") == "on");
+        if (!machine_profile::Save(path, p))
+        {
+            std::fprintf(stderr, "sentinel: cannot write %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("Automatic re-apply after a driver update: %s\n",
+                    regression_sentinel::ReapplyAllowed(p) ? "on" : "off");
+    }
+
+    std::printf("Inventory:\n");
+    for (const auto& c : regression_sentinel::Collect())
+        std::printf("  %-4s %-40s %s\n", c.kind.c_str(), c.name.c_str(), c.version.c_str());
+
+    std::signal(SIGINT, OnInterrupt);
+    regression_sentinel::Outcome o = regression_sentinel::Check(opt, &g_interrupted);
+    if (!o.ok)
+    {
+        std::fprintf(stderr, "sentinel: %s\n", o.error.c_str());
+        return 1;
+    }
+
+    if (!o.alert.empty())
+        std::printf("\n%s", o.alert.c_str());
+    else if (o.firstCheck)
+        std::printf("\nFirst check: inventory recorded.\n");
+    else if (o.ranSuite)
+        std::printf("\nNo inventory change; probe suite %s (%zu series compared).\n",
+                    o.verdict.Regressed() ? "REGRESSED" : "recorded", o.verdict.compared.size());
+    else
+        std::printf("\nNo inventory change since the last check.\n");
+    if (o.ranSuite && o.baselineCreated) std::printf("Run stored as the new baseline.\n");
+    if (!o.droppedTweaks.empty())
+        std::printf("Re-apply the tweaks above %s.\n",
+                    o.reapplyAllowed ? "(the GUI does this automatically)" : "from the GUI");
+    return o.verdict.Regressed() ? 2 : 0;
+}
+
+// ─── topology ────────────────────────────────────────────────────────────────
+
+// --raw FILE (captured processor information), --sysfs ROOT, or this machine.
+static bool TopologyFromArgs(const Args& args, cpu_topology::Topology& t, std::string& error)
+{
+    if (args.Has("--raw"))
+    {
+        std::ifstream f(args.Get("--raw", ""), std::ios::binary);
+        if (!f.is_open())
+        {
+            error = "cannot read " + args.Get("--raw", "");
+            return false;
+        }
+        std::string raw((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        return cpu_topology::DecodeProcessorInformation(raw.data(), raw.size(), t, error);
+    }
+    if (args.Has("--sysfs")) return cpu_topology::ParseSysfs(args.Get("--sysfs", ""), t, error);
+    t = cpu_topology::Current();
+    return true;
+}
+
+static int CmdTopology(const Args& args)
+{
+    cpu_topology::Topology t;
+    std::string error;
+
+    // Capture for later decoding on any host: the raw processor information
+    // buffer on Windows, the relevant sysfs files on Linux.
+    std::string capture = args.Get("--capture", "");
+    if (!capture.empty())
+    {
+#ifdef _WIN32
+        std::vector<uint8_t> raw;
+        bool ok = cpu_topology::ReadProcessorInformation(raw, error);
+        if (ok)
+        {
+            std::ofstream f(capture, std::ios::binary);
+            ok = static_cast<bool>(f.write(reinterpret_cast<const char*>(raw.data()),
+                                           static_cast<std::streamsize>(raw.size())));
+            if (!ok) error = "cannot write " + capture;
+        }
+#else
+        bool ok = cpu_topology::CaptureSysfs("", capture, error);
+#endif
+        if (!ok)
+        {
+            std::fprintf(stderr, "topology: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("Captured to %s\n", capture.c_str());
+    }
+
+    if (!TopologyFromArgs(args, t, error))
+    {
+        std::fprintf(stderr, "topology: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::printf("%s", cpu_topology::Describe(t).c_str());
+    std::printf("Primary threads (performance cores): %s\n",
+                cpu_topology::FormatCpuList(cpu_topology::PrimaryThreads(t, true)).c_str());
+    return 0;
+}
+
+// ─── irq-plan ────────────────────────────────────────────────────────────────
+
+static int CmdIrqPlan(const Args& args)
+{
+    cpu_topology::Topology t;
+    std::string error;
+    if (!TopologyFromArgs(args, t, error))
+    {
+        std::fprintf(stderr, "irq-plan: %s\n", error.c_str());
+        return 1;
+    }
+
+    affinity_planner::Request req;
+    std::map<std::string, int> seen;
+    for (const auto& name : SplitList(args.Get("--devices", "display,network,usb")))
+    {
+        affinity_planner::Device d;
+        if (!affinity_planner::ParseKind(name, d.kind))
+        {
+            std::fprintf(stderr, "irq-plan: unknown device kind '%s' (display|network|usb)\n", name.c_str());
+            return 1;
+        }
+        d.id = name + "#" + std::to_string(seen[name]++);
+        req.devices.push_back(d);
+    }
+    if (args.Has("--quiet")) req.quietOrder = args.GetU32List("--quiet", 0);
+
+    // --game wins over the profile; without either, the planner's default.
+    std::string profilePath = args.Get("--profile", machine_profile::DefaultPath());
+    machine_profile::Profile profile;
+    if (!machine_profile::Load(profilePath, profile, error)) profile = machine_profile::Current();
+    if (args.Has("--game") && !cpu_topology::ParseCpuList(args.Get("--game", ""), req.gameCpus))
+    {
+        std::fprintf(stderr, "irq-plan: --game expects a CPU list such as 2-5,8\n");
+        return 1;
+    }
+    if (req.gameCpus.empty()) req.gameCpus = affinity_planner::GameCpus(t, profile);
+
+    if (args.Get("--save", "off") == "on")
+    {
+        affinity_planner::StoreGameCpus(profile, req.gameCpus);
+        if (!machine_profile::Save(profilePath, profile))
+        {
+            std::fprintf(stderr, "irq-plan: cannot write %s\n", profilePath.c_str());
+            return 1;
+        }
+        std::printf("Game CPUs saved to %s\n", profilePath.c_str());
+    }
+
+    std::printf("Game CPUs: %s\n", cpu_topology::FormatCpuList(req.gameCpus).c_str());
+    affinity_planner::Plan plan = affinity_planner::Build(t, req);
+    std::printf("%s", affinity_planner::Describe(plan).c_str());
+    return 0;
+}
+
+// ─── msi ─────────────────────────────────────────────────────────────────────
+
+static std::string LowerCase(std::string s)
+{
+    for (char& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+static void PrintResults(const std::vector<interrupt_manager::Result>& results, const char* verb, int& failures)
+{
+    for (const auto& r : results)
+    {
+        if (r.ok) std::printf("%s %s\n", verb, r.instanceId.c_str());
+        else      std::fprintf(stderr, "msi: %s\n", r.error.c_str());
+        if (!r.ok) ++failures;
+    }
+}
+
+// --reg FILE works on a `reg export` instead of the live registry; commands
+// that change settings write the result back to that file.
+static registry_access::Registry* OpenRegistry(const Args& args, registry_access::MemoryRegistry& memory,
+                                               std::unique_ptr<registry_access::Registry>& system,
+                                               std::string& error)
+{
+    std::string regFile = args.Get("--reg", "");
+    if (!regFile.empty()) return memory.Load(regFile, error) ? &memory : nullptr;
+    system = registry_access::SystemRegistry(error);
+    return system.get();
+}
+
+static int CmdMsi(const Args& args)
+{
+    std::string regFile = args.Get("--reg", "");
+    std::string error;
+    registry_access::MemoryRegistry memory;
+    std::unique_ptr<registry_access::Registry> system;
+    registry_access::Registry* reg = OpenRegistry(args, memory, system, error);
+    if (!reg)
+    {
+        std::fprintf(stderr, "msi: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::string backupPath = args.Get("--backup", regFile.empty() ? interrupt_manager::DefaultBackupPath()
+                                                                   : regFile + ".backup.txt");
+    interrupt_manager::BackupSet backups;
+    if (!interrupt_manager::LoadBackups(backupPath, backups, error))
+    {
+        std::fprintf(stderr, "msi: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::vector<std::string> classes = SplitList(args.Get("--class", ""));
+    auto selected = [&](const interrupt_manager::DeviceInfo& d) {
+        if (classes.empty()) return true;
+        for (const auto& c : classes)
+            if (LowerCase(d.className) == LowerCase(c)) return true;
+        return false;
+    };
+
+    bool changed = false;
+    int  failures = 0;
+
+    std::string restore = args.Get("--restore", "");
+    if (!restore.empty())
+    {
+        std::vector<interrupt_manager::Result> results;
+        if (restore == "all")
+            results = interrupt_manager::RestoreAll(*reg, backups);
+        else
+            for (const auto& id : SplitList(restore))
+            {
+                interrupt_manager::Result r;
+                r.instanceId = id;
+                r.ok = interrupt_manager::Restore(*reg, id, backups, r.error);
+                results.push_back(r);
+            }
+        PrintResults(results, "restored", failures);
+        changed = true;
+    }
+
+    std::string set = args.Get("--set", "");
+    if (!set.empty())
+    {
+        interrupt_manager::Setting s;
+        std::string mode = args.Get("--mode", "msi");
+        if (mode != "msi" && mode != "line")
+        {
+            std::fprintf(stderr, "msi: --mode expects msi or line\n");
+            return 1;
+        }
+        s.msi   = mode == "msi";
+        s.force = args.Has("--force");
+        if (args.Has("--limit")) s.messageLimit = args.GetU32("--limit", 0);
+        if (args.Has("--priority"))
+        {
+            interrupt_manager::Priority p;
+            if (!interrupt_manager::ParsePriority(args.Get("--priority", ""), p))
+            {
+                std::fprintf(stderr, "msi: --priority expects undefined|low|normal|high\n");
+                return 1;
+            }
+            s.priority = p;
+        }
+
+        // "all" takes every present device the driver allows; otherwise each
+        // comma-separated part selects devices whose instance id contains it.
+        std::vector<interrupt_manager::DeviceInfo> targets;
+        std::size_t skipped = 0;
+        for (const auto& d : interrupt_manager::ListDevices(*reg))
+        {
+            if (!selected(d)) continue;
+            if (set == "all")
+            {
+                if (!d.present) continue;
+                if (s.msi && !d.msiCapable && !s.force) { ++skipped; continue; }
+                targets.push_back(d);
+                continue;
+            }
+            for (const auto& part : SplitList(set))
+                if (LowerCase(d.instanceId).find(LowerCase(part)) != std::string::npos)
+                {
+                    targets.push_back(d);
+                    break;
+                }
+        }
+        if (targets.empty())
+        {
+            std::fprintf(stderr, "msi: no device matches '%s'\n", set.c_str());
+            return 1;
+        }
+        PrintResults(interrupt_manager::ApplyAll(*reg, targets, s, backups), "set", failures);
+        if (skipped)
+            std::printf("Skipped %zu device(s) whose driver does not declare MSI support (--force overrides)\n",
+                        skipped);
+        changed = true;
+    }
+
+    if (changed)
+    {
+        if (!interrupt_manager::SaveBackups(backupPath, backups, error) ||
+            (!regFile.empty() && !memory.Save(regFile, error)))
+        {
+            std::fprintf(stderr, "msi: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("Backups in %s. Changes take effect when the device restarts (reboot).\n\n",
+                    backupPath.c_str());
+    }
+
+    std::vector<interrupt_manager::DeviceInfo> shown;
+    for (const auto& d : interrupt_manager::ListDevices(*reg))
+        if ((d.present || args.Has("--all")) && selected(d)) shown.push_back(d);
+    std::printf("%s", interrupt_manager::Describe(shown, backups).c_str());
+    return failures ? 2 : 0;
+}
+
+// ─── devpm ───────────────────────────────────────────────────────────────────
+
+static int CmdDevpm(const Args& args)
+{
+    std::string regFile = args.Get("--reg", "");
+    std::string error;
+    registry_access::MemoryRegistry memory;
+    std::unique_ptr<registry_access::Registry> system;
+    registry_access::Registry* reg = OpenRegistry(args, memory, system, error);
+    if (!reg)
+    {
+        std::fprintf(stderr, "devpm: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::vector<device_power::DeviceInfo> devices =
+        regFile.empty() ? device_power::LiveDevices(*reg) : device_power::ListDevices(*reg);
+
+    std::string backupPath = args.Get("--backup", regFile.empty() ? device_power::DefaultBackupPath()
+                                                                   : regFile + ".power-backup.txt");
+    device_power::BackupSet backups;
+    if (!device_power::LoadBackups(backupPath, backups, error))
+    {
+        std::fprintf(stderr, "devpm: %s\n", error.c_str());
+        return 1;
+    }
+
+    // --apply path | ID,ID (fragments of instance ids); --restore all | ID,ID
+    auto chosen = [](const std::string& which, const std::string& id) {
+        for (const auto& part : SplitList(which))
+            if (LowerCase(id).find(LowerCase(part)) != std::string::npos) return true;
+        return false;
+    };
+    std::string apply   = args.Get("--apply", "");
+    std::string restore = args.Get("--restore", "");
+    bool changed  = false;
+    int  failures = 0;
+    if (!restore.empty())
+    {
+        std::vector<std::string> ids;
+        for (const auto& [key, b] : backups)
+            if (restore == "all" || chosen(restore, b.instanceId)) ids.push_back(b.instanceId);
+        for (const auto& id : ids)
+        {
+            changed = true;
+            if (device_power::Restore(*reg, id, backups, error)) std::printf("restored %s\n", id.c_str());
+            else { std::fprintf(stderr, "devpm: %s\n", error.c_str()); ++failures; }
+        }
+    }
+    else if (!apply.empty())
+    {
+        for (const auto& d : devices)
+        {
+            if (apply == "path" ? !(d.onPath && d.present) : !chosen(apply, d.instanceId)) continue;
+            if (!d.onPath && !args.Has("--force"))
+            {
+                std::fprintf(stderr, "devpm: %s is not on the input / network path (--force to change it)\n",
+                             d.instanceId.c_str());
+                ++failures;
+                continue;
+            }
+            changed = true;
+            if (device_power::Apply(*reg, d, backups, error)) std::printf("idle power management off: %s\n",
+                                                                          d.instanceId.c_str());
+            else { std::fprintf(stderr, "devpm: %s\n", error.c_str()); ++failures; }
+        }
+    }
+
+    if (changed)
+    {
+        if (!device_power::SaveBackups(backupPath, backups, error) || (!regFile.empty() && !memory.Save(regFile, error)))
+        {
+            std::fprintf(stderr, "devpm: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("Backups in %s. Replug the devices or reboot to apply.\n\n", backupPath.c_str());
+    }
+
+    // Devices on the path and the USB infrastructure; --all shows everything
+    std::vector<device_power::DeviceInfo> shown;
+    for (const auto& d : devices)
+        if (args.Has("--all") || (d.present && (d.onPath || d.role != device_power::Role::Other)))
+            shown.push_back(d);
+    std::printf("%s", device_power::Describe(*reg, shown, backups).c_str());
+    return failures ? 2 : 0;
+}
+
+// ─── rss ─────────────────────────────────────────────────────────────────────
+
+// --apply / --restore take "all" or parts of an adapter label
+static bool AdapterChosen(const std::string& which, const nic_params::Adapter& a)
+{
+    if (which == "all") return true;
+    for (const auto& part : SplitList(which))
+        if (LowerCase(nic_params::Label(a)).find(LowerCase(part)) != std::string::npos) return true;
+    return false;
+}
+
+static int CmdRss(const Args& args)
+{
+    cpu_topology::Topology t;
+    std::string error;
+    if (!TopologyFromArgs(args, t, error))
+    {
+        std::fprintf(stderr, "rss: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::string regFile = args.Get("--reg", "");
+    registry_access::MemoryRegistry memory;
+    std::unique_ptr<registry_access::Registry> system;
+    registry_access::Registry* reg = OpenRegistry(args, memory, system, error);
+    if (!reg)
+    {
+        std::fprintf(stderr, "rss: %s\n", error.c_str());
+        return 1;
+    }
+
+    // Game CPUs as for irq-plan; the default leaves the top cores to RSS.
+    rss_planner::Request req;
+    req.maxQueues = args.GetU32("--queues", 4);
+    machine_profile::Profile profile;
+    if (!machine_profile::Load(args.Get("--profile", machine_profile::DefaultPath()), profile, error))
+        profile = machine_profile::Current();
+    if (args.Has("--game") && !cpu_topology::ParseCpuList(args.Get("--game", ""), req.gameCpus))
+    {
+        std::fprintf(stderr, "rss: --game expects a CPU list such as 2-5,8\n");
+        return 1;
+    }
+    if (req.gameCpus.empty()) req.gameCpus = affinity_planner::GameCpus(t, profile);
+
+    std::string backupPath = args.Get("--backup", regFile.empty() ? nic_params::DefaultBackupPath()
+                                                                   : regFile + ".nic-backup.txt");
+    nic_params::BackupSet backups;
+    if (!nic_params::LoadBackups(backupPath, backups, error))
+    {
+        std::fprintf(stderr, "rss: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::string apply   = args.Get("--apply", "");
+    std::string restore = args.Get("--restore", "");
+
+    std::printf("Game CPUs: %s\n", cpu_topology::FormatCpuList(req.gameCpus).c_str());
+    bool changed  = false;
+    int  failures = 0;
+    for (const auto& a : nic_params::ListAdapters(*reg, !args.Has("--all")))
+    {
+        rss_planner::Capabilities caps = rss_planner::ReadCapabilities(a);
+        rss_planner::Plan plan = rss_planner::Build(t, caps, req);
+        std::printf("\n%s%s\n%s%s", nic_params::Label(a).c_str(), a.present ? "" : " (absent)",
+                    rss_planner::Describe(caps).c_str(), rss_planner::Describe(plan).c_str());
+        if (plan.ok && nic_params::Matches(a, plan.values)) std::printf("  (in effect)\n");
+
+        if (!restore.empty() && AdapterChosen(restore, a) && backups.count(LowerCase(a.classKey)))
+        {
+            changed = true;
+            if (nic_params::Restore(*reg, a.classKey, backups, error, rss_planner::Keywords()))
+                std::printf("  restored\n");
+            else { std::fprintf(stderr, "rss: %s\n", error.c_str()); ++failures; }
+        }
+        else if (!apply.empty() && AdapterChosen(apply, a) && plan.ok)
+        {
+            changed = true;
+            if (nic_params::SetValues(*reg, a, plan.values, backups, error)) std::printf("  applied\n");
+            else { std::fprintf(stderr, "rss: %s\n", error.c_str()); ++failures; }
+        }
+    }
+
+    if (changed)
+    {
+        if (!nic_params::SaveBackups(backupPath, backups, error) || (!regFile.empty() && !memory.Save(regFile, error)))
+        {
+            std::fprintf(stderr, "rss: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("\nBackups in %s. Restart the adapter (disable / enable) or reboot to apply.\n",
+                    backupPath.c_str());
+    }
+    return failures ? 2 : 0;
+}
+
+// ─── nic ─────────────────────────────────────────────────────────────────────
+
+static int CmdNic(const Args& args)
+{
+    nic_tuning::Preset preset = nic_tuning::Preset::Latency;
+    if (!nic_tuning::ParsePreset(args.Get("--preset", "latency"), preset))
+    {
+        std::fprintf(stderr, "nic: --preset expects latency or throughput\n");
+        return 1;
+    }
+
+    std::string regFile = args.Get("--reg", "");
+    std::string error;
+    registry_access::MemoryRegistry memory;
+    std::unique_ptr<registry_access::Registry> system;
+    registry_access::Registry* reg = OpenRegistry(args, memory, system, error);
+    if (!reg)
+    {
+        std::fprintf(stderr, "nic: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::string backupPath = args.Get("--backup", regFile.empty() ? nic_params::DefaultBackupPath()
+                                                                   : regFile + ".nic-backup.txt");
+    nic_params::BackupSet backups;
+    if (!nic_params::LoadBackups(backupPath, backups, error))
+    {
+        std::fprintf(stderr, "nic: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::string apply   = args.Get("--apply", "");
+    std::string restore = args.Get("--restore", "");
+    bool changed  = false;
+    int  failures = 0;
+    for (const auto& a : nic_params::ListAdapters(*reg, !args.Has("--all")))
+    {
+        nic_tuning::Plan plan = nic_tuning::Build(a, preset);
+        std::printf("\n%s%s\n", nic_params::Label(a).c_str(), a.present ? "" : " (absent)");
+        if (args.Has("--keywords")) std::printf("%s", nic_tuning::DescribeKeywords(a).c_str());
+        std::printf("%s", nic_tuning::Describe(plan).c_str());
+
+        if (!restore.empty() && AdapterChosen(restore, a) && backups.count(LowerCase(a.classKey)))
+        {
+            changed = true;
+            if (nic_params::Restore(*reg, a.classKey, backups, error, nic_tuning::Keywords(a)))
+                std::printf("  restored\n");
+            else { std::fprintf(stderr, "nic: %s\n", error.c_str()); ++failures; }
+        }
+        else if (!apply.empty() && AdapterChosen(apply, a) && !plan.changes.empty())
+        {
+            nic_params::Values values;
+            for (const auto& c : plan.changes) values.emplace_back(c.keyword, c.to);
+            changed = true;
+            if (nic_params::SetValues(*reg, a, values, backups, error)) std::printf("  applied\n");
+            else { std::fprintf(stderr, "nic: %s\n", error.c_str()); ++failures; }
+        }
+    }
+
+    if (changed)
+    {
+        if (!nic_params::SaveBackups(backupPath, backups, error) || (!regFile.empty() && !memory.Save(regFile, error)))
+        {
+            std::fprintf(stderr, "nic: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("\nBackups in %s. Restart the adapter (disable / enable) or reboot to apply.\n",
+                    backupPath.c_str());
+    }
+    return failures ? 2 : 0;
+}
+
+// ─── game ────────────────────────────────────────────────────────────────────
+
+static int CmdGame(const Args& args)
+{
+    cpu_topology::Topology t;
+    std::string error;
+    if (!TopologyFromArgs(args, t, error))
+    {
+        std::fprintf(stderr, "game: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::string path   = args.Get("--rules", game_runtime::DefaultPath());
+    std::string bgPath = args.Get("--bg-rules", game_runtime::DefaultBackgroundPath());
+    std::vector<game_runtime::Rule> rules, background;
+    if (!game_runtime::LoadRules(path, rules, error) ||
+        !game_runtime::LoadRules(bgPath, background, error, game_runtime::BackgroundDefaults()))
+    {
+        std::fprintf(stderr, "game: %s\n", error.c_str());
+        return 1;
+    }
+
+    // --add takes the rule keys as flags: --priority high --cpus game ...
+    // With --bg, --add and --remove edit the background list.
+    bool bg = args.Has("--bg");
+    std::vector<game_runtime::Rule>& edited = bg ? background : rules;
+    bool changed = false;
+    if (args.Has("--add"))
+    {
+        std::string line = args.Get("--add", "");
+        for (std::string key : { "priority", "io", "memory", "cpus", "throttling" })
+            if (args.Has("--" + key)) line += " " + key + "=" + args.Get("--" + key, "");
+        game_runtime::Rule r;
+        if (!game_runtime::ParseRule(line, r, error, bg ? game_runtime::BackgroundDefaults() : game_runtime::Rule()))
+        {
+            std::fprintf(stderr, "game: %s\n", error.c_str());
+            return 1;
+        }
+        game_runtime::PutRule(edited, r);
+        changed = true;
+    }
+    if (args.Has("--remove"))
+    {
+        if (!game_runtime::RemoveRule(edited, args.Get("--remove", "")))
+        {
+            std::fprintf(stderr, "game: no rule for %s\n", args.Get("--remove", "").c_str());
+            return 1;
+        }
+        changed = true;
+    }
+    if (changed && !game_runtime::SaveRules(bg ? bgPath : path, edited, error))
+    {
+        std::fprintf(stderr, "game: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::vector<uint32_t> gameCpus;
+    if (args.Has("--game") && !cpu_topology::ParseCpuList(args.Get("--game", ""), gameCpus))
+    {
+        std::fprintf(stderr, "game: --game expects a CPU list such as 2-5,8\n");
+        return 1;
+    }
+    if (gameCpus.empty()) gameCpus = game_runtime::ConfiguredGameCpus(t);
+
+    std::printf("Game CPUs %s\n\nGames (%s)\n", cpu_topology::FormatCpuList(gameCpus).c_str(), path.c_str());
+    if (rules.empty()) std::printf("  (none; add one with --add EXE)\n");
+    else               std::printf("%s", game_runtime::Describe(rules, t, gameCpus).c_str());
+    std::printf("\nThrottled while a game runs (%s)\n", bgPath.c_str());
+    if (background.empty()) std::printf("  (none; add one with --bg --add EXE)\n");
+    else                    std::printf("%s", game_runtime::Describe(background, t, gameCpus).c_str());
+    if (!args.Has("--watch")) return 0;
+
+    game_runtime::Manager manager(rules, gameCpus, [](const game_runtime::Event& e) {
+        std::printf("%-9s %6u %-28s %s\n", game_runtime::EventName(e.kind), e.pid, e.exe.c_str(), e.detail.c_str());
+        std::fflush(stdout);
+    });
+    manager.SetBackgroundRules(background);
+    if (!manager.Start(error))
+    {
+        std::fprintf(stderr, "game: %s\n", error.c_str());
+        return 1;
+    }
+
+    double duration = args.GetDouble("--duration", 0.0);
+    std::printf("\nWatching for launches %s (Ctrl+C to stop)\n",
+                duration > 0 ? "for the given duration" : "until stopped");
+    std::signal(SIGINT, OnInterrupt);
+    uint64_t endNs = duration > 0 ? bench_clock::NowNs() + static_cast<uint64_t>(duration * 1e9) : 0;
+    while (!g_interrupted && (endNs == 0 || bench_clock::NowNs() < endNs))
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    manager.Stop();
+
+    game_runtime::Savings saved = manager.BackgroundSavings();
+    if (saved.sessions)
+        std::printf("\nKept off the game cores in %u game session(s): %s\n", saved.sessions,
+                    game_runtime::Describe(saved).c_str());
+    return 0;
+}
+
+// ─── timer ───────────────────────────────────────────────────────────────────
+
+static int CmdTimer(const Args& args)
+{
+    uint32_t samples = args.GetU32("--samples", 200);
+    std::string error;
+    timer_resolution::Resolution r;
+    if (!timer_resolution::Query(r, error))
+    {
+        std::fprintf(stderr, "timer: %s\n", error.c_str());
+        return 1;
+    }
+    std::printf("%s", timer_resolution::Describe(r, timer_resolution::QueryPolicy()).c_str());
+
+    std::printf("\nMeasuring %u waits of each kind\n", samples);
+    std::fflush(stdout);
+    std::vector<timer_resolution::Granularity> before = timer_resolution::Measure(samples);
+    std::printf("%s", timer_resolution::Describe(before).c_str());
+    if (!args.Has("--resolution")) return 0;
+
+    timer_resolution::Hold hold;
+    if (!hold.Request(args.GetDouble("--resolution", 0.5), error))
+    {
+        std::fprintf(stderr, "timer: %s\n", error.c_str());
+        return 1;
+    }
+    std::printf("\nHolding %s (current resolution %s)\n", timer_resolution::FormatMs(hold.Requested()).c_str(),
+                timer_resolution::FormatMs(hold.Granted()).c_str());
+    if (timer_resolution::Query(r, error))
+        std::printf("%s", timer_resolution::Describe(r, timer_resolution::QueryPolicy()).c_str());
+    std::fflush(stdout);
+    std::vector<timer_resolution::Granularity> after = timer_resolution::Measure(samples);
+    std::printf("%s\nBefore / after the hold (negative effect = shorter waits)\n%s",
+                timer_resolution::Describe(after).c_str(),
+                timer_resolution::Describe(timer_resolution::Compare(before, after)).c_str());
+
+    if (args.Has("--hold"))
+    {
+        double duration = args.GetDouble("--hold", 0.0);
+        std::printf("\nHolding %s (Ctrl+C to release)\n", duration > 0 ? "for the given duration" : "until stopped");
+        std::fflush(stdout);
+        std::signal(SIGINT, OnInterrupt);
+        uint64_t endNs = duration > 0 ? bench_clock::NowNs() + static_cast<uint64_t>(duration * 1e9) : 0;
+        while (!g_interrupted && (endNs == 0 || bench_clock::NowNs() < endNs))
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    hold.Release();
+    if (timer_resolution::Query(r, error))
+        std::printf("\nReleased; current resolution %s\n", timer_resolution::FormatMs(r.current).c_str());
+    return 0;
+}
+
+// ─── clock ───────────────────────────────────────────────────────────────────
+
+static int CmdClock(const Args& args)
+{
+    clock_source::Options o;
+    o.calls  = args.GetU32("--calls", o.calls);
+    o.rounds = args.GetU32("--rounds", o.rounds);
+    o.root   = args.Get("--sysfs", "");
+    if (args.Has("--cpus")) o.cpus = args.GetU32List("--cpus", 0);
+
+    std::printf("Measuring clock reads and cross-core handoffs\n");
+    std::fflush(stdout);
+    clock_source::Report r = clock_source::Run(o);
+    r.source.bcd = clock_source::ReadBcd();
+    std::printf("%s\n%s", clock_source::Describe(r).c_str(),
+                clock_source::Describe(clock_source::Recommend(r)).c_str());
+    return 0;
+}
+
+// ─── standby ─────────────────────────────────────────────────────────────────
+
+static void PrintPurge(const standby_list::PurgeRecord& r)
+{
+    if (r.ok)
+        std::printf("%s  purged %s list in %.1f ms: free %s -> %s, standby %s -> %s (%+lld MiB)\n",
+                    results_store::FormatTime(r.timestamp).c_str(), standby_list::CommandName(r.command),
+                    r.durationMs, standby_list::FormatMiB(r.before.free).c_str(),
+                    standby_list::FormatMiB(r.after.free).c_str(), standby_list::FormatMiB(r.before.standby).c_str(),
+                    standby_list::FormatMiB(r.after.standby).c_str(),
+                    static_cast<long long>(r.Reclaimed() / (1 << 20)));
+    else
+        std::printf("%s  purge failed: %s\n", results_store::FormatTime(r.timestamp).c_str(), r.error.c_str());
+    std::fflush(stdout);
+}
+
+static int CmdStandby(const Args& args)
+{
+    standby_list::Policy policy;
+    policy.freeBelow    = static_cast<uint64_t>(args.GetU32("--free-below", 1024)) << 20;
+    policy.standbyAbove = static_cast<uint64_t>(args.GetU32("--standby-above", 1024)) << 20;
+    policy.minGapS      = args.GetU32("--min-gap", policy.minGapS);
+    if (args.Has("--low-priority")) policy.command = standby_list::Command::LowPriorityStandby;
+    std::string tracePath = args.Get("--trace", standby_list::DefaultTracePath());
+    std::string error;
+
+    if (args.Has("--correlate"))
+    {
+        std::vector<standby_list::PurgeRecord> purges;
+        results_store::Store store;
+        if (!standby_list::LoadTrace(tracePath, purges, error) ||
+            !store.Open(args.Get("--dir", results_store::DefaultDirectory()), error))
+        {
+            std::fprintf(stderr, "standby: %s\n", error.c_str());
+            return 1;
+        }
+        results_store::Query q;
+        q.probe       = args.Get("--probe", "");
+        q.fingerprint = machine_profile::Current().fingerprint;
+        uint32_t window = args.GetU32("--window", 60);
+        std::printf("%zu purge(s) in %s; runs with a purge in the %u s before they ended against the rest\n"
+                    "(positive effect = p99 higher with purges)\n%s",
+                    purges.size(), tracePath.c_str(), window,
+                    standby_list::Describe(standby_list::Correlate(store.Find(q), purges, window)).c_str());
+        return 0;
+    }
+
+    standby_list::MemoryState m;
+    if (args.Has("--meminfo"))
+    {
+        std::ifstream f(args.Get("--meminfo", ""));
+        std::string text((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        if (!standby_list::ParseMeminfo(text, m))
+        {
+            std::fprintf(stderr, "standby: %s is not a meminfo file\n", args.Get("--meminfo", "").c_str());
+            return 1;
+        }
+    }
+    else if (!standby_list::Query(m, error))
+    {
+        std::fprintf(stderr, "standby: %s\n", error.c_str());
+        return 1;
+    }
+    std::printf("Memory: %s\nPolicy: purge the %s list when free < %s and standby >= %s, at most every %u s -> %s\n",
+                standby_list::Describe(m).c_str(), standby_list::CommandName(policy.command),
+                standby_list::FormatMiB(policy.freeBelow).c_str(), standby_list::FormatMiB(policy.standbyAbove).c_str(),
+                policy.minGapS, standby_list::DecisionName(standby_list::Decide(policy, m, -1.0)));
+    if (args.Has("--meminfo")) return 0;
+
+    standby_list::Monitor monitor(policy);
+    auto record = [&](const standby_list::PurgeRecord& r) {
+        PrintPurge(r);
+        std::string traceError;
+        if (!standby_list::AppendTrace(tracePath, r, traceError))
+            std::fprintf(stderr, "standby: %s\n", traceError.c_str());
+    };
+
+    if (args.Has("--purge"))
+    {
+        standby_list::PurgeRecord r = monitor.PurgeNow(m);
+        record(r);
+        return r.ok ? 0 : 1;
+    }
+    if (!args.Has("--watch")) return 0;
+
+    double   duration   = args.GetDouble("--duration", 0.0);
+    uint32_t intervalMs = static_cast<uint32_t>(args.GetDouble("--interval", 1.0) * 1000);
+    std::printf("\nWatching %s (Ctrl+C to stop); purges go to %s\n",
+                duration > 0 ? "for the given duration" : "until stopped", tracePath.c_str());
+    std::fflush(stdout);
+    std::signal(SIGINT, OnInterrupt);
+    uint64_t endNs = duration > 0 ? bench_clock::NowNs() + static_cast<uint64_t>(duration * 1e9) : 0;
+    uint64_t nextNs = bench_clock::NowNs();
+    while (!g_interrupted && (endNs == 0 || bench_clock::NowNs() < endNs))
+    {
+        if (bench_clock::NowNs() >= nextNs)
+        {
+            standby_list::PurgeRecord r;
+            if (monitor.Poll(m, r, error) == standby_list::Decision::Purge) record(r);
+            nextNs = bench_clock::NowNs() + static_cast<uint64_t>(std::max<uint32_t>(intervalMs, 100)) * 1000000;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::printf("\n%u purge(s); memory now %s\n", monitor.Purges(), standby_list::Describe(m).c_str());
+    return 0;
+}
+
+// ─── power ───────────────────────────────────────────────────────────────────
+
+static int CmdPower(const Args& args)
+{
+    power_scheme::Options o;
+    o.idleDisable = args.Has("--idle-disable");
+    o.dc          = !args.Has("--ac-only");
+    std::string base = args.Get("--base", "ultimate");
+    o.base = base == "ultimate" ? power_scheme::kUltimatePerformance
+           : base == "active"   ? std::string()
+                                : power_scheme::NormalizeGuid(base);
+    std::string error;
+    if (base != "ultimate" && base != "active" && o.base.empty())
+    {
+        std::fprintf(stderr, "power: --base takes ultimate, active or a scheme GUID\n");
+        return 2;
+    }
+    if (!power_scheme::ParseOverrides(args.Get("--set", ""), o.overrides, error))
+    {
+        std::fprintf(stderr, "power: %s\n", error.c_str());
+        return 2;
+    }
+    std::vector<power_scheme::Planned> plan;
+    if (!power_scheme::Plan(o, plan, error))
+    {
+        std::fprintf(stderr, "power: %s\n", error.c_str());
+        return 2;
+    }
+
+    if (args.Has("--revert"))
+    {
+        bool ok = power_scheme::RestoreOriginalScheme(error) && power_scheme::RestoreValues({}, error);
+        if (!ok) std::fprintf(stderr, "power: %s\n", error.c_str());
+        else std::printf("Original power scheme and values restored.\n");
+        return ok ? 0 : 1;
+    }
+    if (args.Has("--restore"))
+    {
+        std::vector<std::string> keys;
+        std::string list = args.Get("--restore", "all");
+        for (size_t pos = 0; list != "all" && pos <= list.size();)
+        {
+            size_t comma = std::min(list.find(',', pos), list.size());
+            if (comma > pos) keys.push_back(list.substr(pos, comma - pos));
+            pos = comma + 1;
+        }
+        if (!power_scheme::RestoreValues(keys, error))
+        {
+            std::fprintf(stderr, "power: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("Restored.\n");
+        return 0;
+    }
+    if (args.Has("--build"))
+    {
+        power_scheme::BuildResult r;
+        if (!power_scheme::BuildLatencyScheme(o, r, error))
+        {
+            std::fprintf(stderr, "power: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("%s", power_scheme::Describe(r).c_str());
+    }
+    else if (args.Has("--apply"))
+    {
+        // Only the named settings, written into the active scheme
+        std::map<std::string, uint32_t> values;
+        if (!power_scheme::ParseOverrides(args.Get("--apply", ""), values, error) || values.empty())
+        {
+            std::fprintf(stderr, "power: %s\n", values.empty() && error.empty() ? "--apply needs key=value" : error.c_str());
+            return 2;
+        }
+        std::vector<power_scheme::Planned> writes;
+        for (const auto& [key, value] : values) writes.push_back({ power_scheme::Find(key), value });
+        if (!power_scheme::ApplyValues(writes, o.dc, error))
+        {
+            std::fprintf(stderr, "power: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("Written into the active scheme; originals kept in %s\n", power_scheme::DefaultStatePath().c_str());
+    }
+
+    std::string active;
+    std::vector<power_scheme::Value> values;
+    if (!power_scheme::ActiveScheme(active, error) || !power_scheme::ReadScheme(active, values, error))
+    {
+        // Off Windows: the plan alone
+        std::printf("%s; latency scheme plan:\n", error.c_str());
+        for (const auto& p : plan)
+            std::printf("  %-15s %-9u %s\n", p.setting->key, p.value, p.setting->name);
+        return 0;
+    }
+    std::printf("\nActive scheme: %s (%s)%s\n", active.c_str(), power_scheme::SchemeName(active).c_str(),
+                power_scheme::LatencySchemeActive() ? " [latency scheme]" : "");
+    std::printf("%s", power_scheme::Describe(values, plan).c_str());
+    return 0;
+}
+
+// ─── Dispatch ────────────────────────────────────────────────────────────────
+
+struct Command {
+    const char* name;
+    const char* usage;
+    int (*run)(const Args&);
+};
+
+static const Command kCommands[] = {
+    { "net-echo", "[--port 7777] [--nodelay on|off]", CmdNetEcho },
+    { "net-ping", "[--host H] [--port 7777] [--proto udp|tcp|both] [--size 64,512]\n"
+                  "               [--rate 1000] [--count 10000] [--warmup 100]\n"
+                  "               [--nodelay on|off|both] [--timeout ms] [--loopback] [--csv file]",
+      CmdNetPing },
+    { "tcp-sink", "[--port 7778] [--buffer auto|64K]", CmdTcpSink },
+    { "tcp-bulk", "[--host H] [--port 7778] [--bind ADDR] [--direction up|down]\n"
+                  "               [--streams 4] [--bytes 256M] [--buffers auto,64K,256K,4M]\n"
+                  "               [--chunk 128K] [--timeout ms] [--loopback]",
+      CmdTcpBulk },
+    { "frames",   "<baseline.csv> [run2.csv ...] [--app Game.exe] [--stutter 2.0] [--alpha 0.01]",
+      CmdFrames },
+    { "input-capture", "[--duration 10] [--out rec.csv] [--device /dev/input/eventN]\n"
+                       "               [--idle-ms 50] [--drop-factor 1.5]",
+      CmdInputCapture },
+    { "input-analyze", "<rec.csv> [...] [--device-id N] [--idle-ms 50] [--drop-factor 1.5]",
+      CmdInputAnalyze },
+    { "audio-deadline", "[--rate 44100,48000,96000] [--buffers 32,64,128,256,512]\n"
+                        "               [--load 0.5] [--duration 10] [--mode normal|rt|both]",
+      CmdAudioDeadline },
+    { "load",     "(--script scenario.txt | --spec \"cpu threads=2 intensity=0.5; memory\")\n"
+                  "               [--duration s]",
+      CmdLoad },
+    { "core-latency", "[--interval 1000] [--duration 10] [--cpus 0,2,4] [--priority rt|normal]\n"
+                      "               [--csv file]",
+      CmdCoreLatency },
+    { "c2c",      "[--cpus 0,1,2,3] [--round-trips 2000] [--profile file] [--save on|off]",
+      CmdC2c },
+    { "page-faults", "[--size 512M] [--pressure 2G] [--cgroup-limit 256M] [--settle 2000]\n"
+                     "               [--samples 20000] [--rounds 3] [--seed 1] [--csv file]",
+      CmdPageFaults },
+    { "storage",  "[--dir D] [--size 1G] [--block 4K] [--qd 32] [--read 70] [--duration 10]\n"
+                  "               [--warmup 1] [--engine auto|threads] [--scanner off|on|both]\n"
+                  "               [--scan-size 1G] [--scan-chunk 1M] [--scan-rate MB/s] [--csv file]",
+      CmdStorage },
+    { "results",  "[--dir D] [--series] [--probe P] [--label L] [--tags a,b] [--tweaks x,y]\n"
+                  "               [--since 2024-05-01] [--until T] [--machine this|any]",
+      CmdResults },
+    { "sentinel", "[--duration 5] [--force] [--tweaks x,y] [--reapply on|off] [--dir D]\n"
+                  "               [--profile file]",
+      CmdSentinel },
+    { "topology", "[--raw slpi.bin | --sysfs ROOT] [--capture FILE|DIR]", CmdTopology },
+    { "irq-plan", "[--devices display,network,usb] [--game 2-5] [--quiet 7,5,3]\n"
+                  "               [--raw slpi.bin | --sysfs ROOT] [--profile file] [--save on|off]",
+      CmdIrqPlan },
+    { "msi",      "[--reg pci.reg] [--class Display,Net] [--set all|ID,ID [--mode msi|line]\n"
+                  "               [--limit N] [--priority undefined|low|normal|high]] [--restore all|ID]\n"
+                  "               [--backup file] [--all] [--force]",
+      CmdMsi },
+    { "devpm",    "[--reg enum.reg] [--apply path|ID,ID] [--restore all|ID,ID] [--backup file]\n"
+                  "               [--all] [--force]",
+      CmdDevpm },
+    { "rss",      "[--reg net.reg] [--raw slpi.bin | --sysfs ROOT] [--game 2-5] [--queues 4]\n"
+                  "               [--profile file] [--apply all|NAME] [--restore all|NAME] [--backup file]\n"
+                  "               [--all]",
+      CmdRss },
+    { "nic",      "[--reg net.reg] [--preset latency|throughput] [--keywords] [--apply all|NAME]\n"
+                  "               [--restore all|NAME] [--backup file] [--all]",
+      CmdNic },
+    { "game",     "[--rules file] [--bg-rules file] [--bg] [--add EXE [--priority high] [--io high]\n"
+                  "               [--memory normal] [--cpus game|nongame|ecores|keep|LIST]\n"
+                  "               [--throttling off|on|keep]] [--remove EXE] [--game 2-5]\n"
+                  "               [--raw slpi.bin | --sysfs ROOT] [--watch [--duration S]]",
+      CmdGame },
+    { "timer",    "[--samples 200] [--resolution 0.5 [--hold S]]", CmdTimer },
+    { "clock",    "[--calls 1000000] [--rounds 2000] [--cpus 0,2,4] [--sysfs ROOT]", CmdClock },
+    { "standby",  "[--free-below 1024] [--standby-above 1024] [--min-gap 60] [--low-priority]\n"
+                  "               [--purge | --watch [--interval 1] [--duration S]] [--trace file]\n"
+                  "               [--correlate [--dir D] [--probe P] [--window 60]] [--meminfo FILE]",
+      CmdStandby },
+    { "power",    "[--build [--base ultimate|active|GUID] [--idle-disable] [--set key=value,...]]\n"
+                  "               [--apply key=value,...] [--ac-only] [--restore all|key,key] [--revert]",
+      CmdPower },
+};
+
+static void PrintUsage()
+{
+    std::printf("LatencyProbe - latency measurement probes\n\nUsage:\n");
+    for (const auto& c : kCommands)
+        std::printf("  LatencyProbe %s %s\n", c.name, c.usage);
+    std::printf("\nAny command also accepts --background \"<spec>\" or --background-script file\n"
+                "to run a load_gen scenario for the duration of the measurement.\n"
+                "net-ping, core-latency, page-faults and storage accept --store on|DIR with\n"
+                "optional --tags a,b and --tweaks x,y to keep the run in the results store.\n");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string name = argv[1];
+    for (const auto& c : kCommands)
+    {
+        if (name != c.name) continue;
+        Args args(argc, argv, 2);
+
+        // Optional background load, held for the whole command.
+        std::unique_ptr<load_gen::LoadGenerator> background;
+        if (args.Has("--background") || args.Has("--background-script"))
+        {
+            load_gen::Scenario sc;
+            std::string error;
+            if (!ScenarioFromArgs(args, "--background-script", "--background", sc, error))
+            {
+                std::fprintf(stderr, "background: %s\n", error.c_str());
+                return 1;
+            }
+            background = std::make_unique<load_gen::LoadGenerator>(sc);
+            if (!background->Start())
+            {
+                std::fprintf(stderr, "background: %s\n", background->LastError().c_str());
+                return 1;
+            }
+            PrintScenario(sc);
+        }
+        return c.run(args);
+    }
+
+    PrintUsage();
+    return 1;
+}
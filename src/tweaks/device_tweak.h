@@ -0,0 +1,39 @@
+#pragma once
+#include "tweak_base.h"
+#include "../utils/device_utils.h"
+
+#include <string>
+
+// Base for tweaks that act on one device instance – a display or network
+// class subkey such as {4d36e968-...}\0001.  main.cpp registers one object
+// per matching active adapter, so each instance keeps its own status and
+// the list shows which adapter it targets.
+class DeviceTweak : public TweakBase {
+public:
+    explicit DeviceTweak(device_utils::ClassDevice device) : m_device(std::move(device)) {}
+
+    // "<BaseName()> [<DriverDesc> #<instance>]"
+    const char* Name() const override
+    {
+        if (m_name.empty()) m_name = std::string(BaseName()) + " [" + device_utils::Label(m_device) + "]";
+        return m_name.c_str();
+    }
+
+    // "<BaseName()>@<PnP instance id>"
+    std::string Id() const override { return std::string(BaseName()) + "@" + InstanceId(); }
+
+    const device_utils::ClassDevice& Device() const { return m_device; }
+
+protected:
+    virtual const char* BaseName() const = 0;
+
+    // Driver class key of the instance
+    const std::wstring& Key() const { return m_device.classKey; }
+
+    // Device instance id (PCI\VEN_...\...), the hardware key under Enum
+    std::string InstanceId() const { return device_utils::ToUtf8(m_device.instanceId); }
+
+private:
+    device_utils::ClassDevice m_device;
+    mutable std::string       m_name;
+};
@@ -1,17 +1,16 @@
 #include "dpc_tweaks.h"
 #include "../utils/registry_utils.h"
 #include "../utils/service_utils.h"
+#include "../bench/interrupt_manager.h"
 
-// NVIDIA display adapter class key (device 0000)
-static const wchar_t* kNvDisplayKey =
-    L"SYSTEM\\CurrentControlSet\\Control\\Class\\"
-    L"{4d36e968-e325-11ce-bfc1-08002be10318}\\0000";
+// Per-adapter tweaks below write to Key(), the display class instance of the
+// adapter they were registered for.
 
 // ─── DisableNvidiaHDCPTweak ─────────────────────────────────────────────────
 
 bool DisableNvidiaHDCPTweak::Apply()
 {
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"RmHdcpEnable", 0);
     m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
     return ok;
@@ -19,7 +18,7 @@ bool DisableNvidiaHDCPTweak::Apply()
 
 bool DisableNvidiaHDCPTweak::Revert()
 {
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"RmHdcpEnable", 1);
     m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
     return ok;
@@ -27,7 +26,7 @@ bool DisableNvidiaHDCPTweak::Revert()
 
 bool DisableNvidiaHDCPTweak::IsApplied() const
 {
-    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"RmHdcpEnable");
     return val.has_value() && *val == 0;
 }
@@ -36,7 +35,7 @@ bool DisableNvidiaHDCPTweak::IsApplied() const
 
 bool NvidiaPerCpuDpcTweak::Apply()
 {
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"RmGpsPsEnablePerCpuCoreDpc", 1);
     m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
     return ok;
@@ -44,7 +43,7 @@ bool NvidiaPerCpuDpcTweak::Apply()
 
 bool NvidiaPerCpuDpcTweak::Revert()
 {
-    bool ok = registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    bool ok = registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, Key(),
                                            L"RmGpsPsEnablePerCpuCoreDpc");
     m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
     return ok;
@@ -52,7 +51,7 @@ bool NvidiaPerCpuDpcTweak::Revert()
 
 bool NvidiaPerCpuDpcTweak::IsApplied() const
 {
-    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"RmGpsPsEnablePerCpuCoreDpc");
     return val.has_value() && *val == 1;
 }
@@ -62,7 +61,7 @@ bool NvidiaPerCpuDpcTweak::IsApplied() const
 bool DisableNvidiaASPMTweak::Apply()
 {
     // Bit 0 = disable L0s, Bit 1 = disable L1 → 0x3 = disable both
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"RmDisableGpuASPMFlags", 0x3);
     m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
     return ok;
@@ -70,7 +69,7 @@ bool DisableNvidiaASPMTweak::Apply()
 
 bool DisableNvidiaASPMTweak::Revert()
 {
-    bool ok = registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    bool ok = registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, Key(),
                                            L"RmDisableGpuASPMFlags");
     m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
     return ok;
@@ -78,33 +77,39 @@ bool DisableNvidiaASPMTweak::Revert()
 
 bool DisableNvidiaASPMTweak::IsApplied() const
 {
-    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"RmDisableGpuASPMFlags");
     return val.has_value() && *val == 0x3;
 }
 
 // ─── EnableGPUMSITweak ─────────────────────────────────────────────────────
+// Windows reads MSISupported from the hardware key (Enum\PCI\<id>\Device
+// Parameters\Interrupt Management), not the class key.  interrupt_manager
+// keeps the original values so Revert puts back whatever the driver had.
 
 bool EnableGPUMSITweak::Apply()
 {
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
-                                          L"MSISupported", 1);
+    interrupt_manager::Setting s;
+    s.msi = true;
+    std::string error;
+    bool ok = interrupt_manager::ApplyToDevice(InstanceId(), s, error);
     m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
     return ok;
 }
 
 bool EnableGPUMSITweak::Revert()
 {
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
-                                          L"MSISupported", 0);
+    std::string error;
+    bool ok = interrupt_manager::RestoreDevice(InstanceId(), error);
     m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
     return ok;
 }
 
 bool EnableGPUMSITweak::IsApplied() const
 {
-    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
-                                          L"MSISupported");
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    auto val = reg ? reg->ReadDword(interrupt_manager::MsiKey(InstanceId()), "MSISupported") : std::nullopt;
     return val.has_value() && *val == 1;
 }
 
@@ -131,49 +136,18 @@ bool DisableNvTelemetryTweak::IsApplied() const
     return service_utils::GetStartType(L"NvTelemetryContainer") == SERVICE_DISABLED;
 }
 
-// ─── GPUInterruptAffinityTweak ──────────────────────────────────────────────
-// Uses GPU class key {4d36e968-...}
-
-bool GPUInterruptAffinityTweak::Apply()
-{
-    // IrqPolicySpecifiedProcessors = 5, AffinityMask = 0x02 = CPU 1
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
-                                          L"*InterruptAffinityPolicy", 5);
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
-                                      L"*InterruptAffinity", 0x02);
-    m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
-    return ok;
-}
-
-bool GPUInterruptAffinityTweak::Revert()
-{
-    bool ok = registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, kNvDisplayKey,
-                                           L"*InterruptAffinityPolicy");
-    ok &= registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, kNvDisplayKey,
-                                       L"*InterruptAffinity");
-    m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
-    return ok;
-}
-
-bool GPUInterruptAffinityTweak::IsApplied() const
-{
-    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
-                                          L"*InterruptAffinityPolicy");
-    return val.has_value() && *val == 5;
-}
-
 // ─── DisableNvidiaEnergyDriverTweak ─────────────────────────────────────────
 
 bool DisableNvidiaEnergyDriverTweak::Apply()
 {
     // Disable deep-idle P-state transitions
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"EnableRID73519", 0);
     // PerfLevelSrc 0x2222 = prefer performance on all sub-systems
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                       L"PerfLevelSrc", 0x2222);
     // Disable dynamic PState switching (keeps GPU clocks stable)
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                       L"DisableDynamicPstate", 1);
     m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
     return ok;
@@ -181,11 +155,11 @@ bool DisableNvidiaEnergyDriverTweak::Apply()
 
 bool DisableNvidiaEnergyDriverTweak::Revert()
 {
-    bool ok = registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    bool ok = registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, Key(),
                                            L"EnableRID73519");
-    ok &= registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    ok &= registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, Key(),
                                        L"PerfLevelSrc");
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                       L"DisableDynamicPstate", 0);
     m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
     return ok;
@@ -193,7 +167,7 @@ bool DisableNvidiaEnergyDriverTweak::Revert()
 
 bool DisableNvidiaEnergyDriverTweak::IsApplied() const
 {
-    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNvDisplayKey,
+    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"DisableDynamicPstate");
     return val.has_value() && *val == 1;
 }
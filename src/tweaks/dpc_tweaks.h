@@ -1,5 +1,6 @@
 #pragma once
 #include "tweak_base.h"
+#include "device_tweak.h"
 
 // ─── DPC Latency Category ────────────────────────────────────────────────────
 // Advanced tweaks targeting Deferred Procedure Call (DPC) routine execution time,
@@ -8,9 +9,11 @@
 // Tweak: Disable NVIDIA HDCP (High-bandwidth Digital Content Protection)
 // HDCP handshake logic runs inside the NVIDIA display driver's DPC routine.
 // Disabling it removes that overhead entirely.
-class DisableNvidiaHDCPTweak : public TweakBase {
+class DisableNvidiaHDCPTweak : public DeviceTweak {
 public:
-    const char* Name()        const override { return "NVIDIA: Disable HDCP"; }
+    using DeviceTweak::DeviceTweak;
+
+    const char* BaseName()    const override { return "NVIDIA: Disable HDCP"; }
     const char* Description() const override { return "Disables HDCP in the NVIDIA driver to eliminate HDCP handshake DPC overhead."; }
     const char* Detail()      const override {
         return "HDCP (High-bandwidth Digital Content Protection) validation runs\n"
@@ -34,9 +37,11 @@ public:
 // By default the NVIDIA driver funnels all DPC work to a single core.
 // Enabling RmGpsPsEnablePerCpuCoreDpc distributes DPC processing across
 // multiple cores, reducing per-core DPC execution time.
-class NvidiaPerCpuDpcTweak : public TweakBase {
+class NvidiaPerCpuDpcTweak : public DeviceTweak {
 public:
-    const char* Name()        const override { return "NVIDIA: Per-CPU DPC Distribution"; }
+    using DeviceTweak::DeviceTweak;
+
+    const char* BaseName()    const override { return "NVIDIA: Per-CPU DPC Distribution"; }
     const char* Description() const override { return "Distributes NVIDIA driver DPC work across multiple CPU cores."; }
     const char* Detail()      const override {
         return "The NVIDIA kernel driver (nvlddmkm.sys) schedules all DPC callbacks\n"
@@ -59,9 +64,11 @@ public:
 // PCIe ASPM transitions (L0s/L1) on the GPU link cause latency spikes in the
 // driver's DPC routine while the link re-trains. Disabling ASPM keeps the PCIe
 // link at full speed, eliminating these spikes.
-class DisableNvidiaASPMTweak : public TweakBase {
+class DisableNvidiaASPMTweak : public DeviceTweak {
 public:
-    const char* Name()        const override { return "NVIDIA: Disable GPU PCIe ASPM"; }
+    using DeviceTweak::DeviceTweak;
+
+    const char* BaseName()    const override { return "NVIDIA: Disable GPU PCIe ASPM"; }
     const char* Description() const override { return "Disables PCIe Active State Power Management on the GPU link to prevent DPC spikes."; }
     const char* Detail()      const override {
         return "PCIe L0s/L1 power states save power by partly shutting down the\n"
@@ -85,9 +92,11 @@ public:
 // Unlike NICs where MSI can sometimes hurt, GPUs almost universally benefit
 // from MSI mode. MSI avoids the shared IRQ line and its associated DPC
 // serialization, giving the GPU its own dedicated interrupt vector.
-class EnableGPUMSITweak : public TweakBase {
+class EnableGPUMSITweak : public DeviceTweak {
 public:
-    const char* Name()        const override { return "GPU: Enable MSI (Message-Signaled Interrupts)"; }
+    using DeviceTweak::DeviceTweak;
+
+    const char* BaseName()    const override { return "GPU: Enable MSI (Message-Signaled Interrupts)"; }
     const char* Description() const override { return "Enables MSI for the GPU, giving it a dedicated interrupt vector to reduce DPC queueing."; }
     const char* Detail()      const override {
         return "Legacy line-based interrupts are shared among devices, forcing DPC\n"
@@ -132,38 +141,14 @@ public:
     bool IsApplied() const override;
 };
 
-// Tweak: GPU Interrupt Affinity to Dedicated Core
-// Pins GPU interrupts (and their resulting DPCs) to a specific CPU core,
-// separate from NIC and other device interrupts. Prevents cross-device DPC
-// contention on the same core.
-class GPUInterruptAffinityTweak : public TweakBase {
-public:
-    const char* Name()        const override { return "GPU: Pin Interrupts to CPU 1"; }
-    const char* Description() const override { return "Pins GPU interrupts to CPU core 1 to isolate GPU DPCs from NIC/other DPCs."; }
-    const char* Detail()      const override {
-        return "By default, GPU interrupts may land on the same core as network\n"
-               "or USB interrupts, causing DPC routines from different drivers to\n"
-               "queue behind each other. Pinning GPU interrupts to CPU 1 (while\n"
-               "NIC is on CPU 0) ensures GPU DPC execution is never blocked by\n"
-               "unrelated device DPCs. Pairs well with the NIC Interrupt Affinity\n"
-               "tweak. Requires reboot.";
-    }
-    const char* Category()    const override { return "DPC Latency"; }
-    TweakRisk   Risk()        const override { return TweakRisk::Medium; }
-    TweakCompat Compat()      const override { return TweakCompat::All; }
-    bool RequiresBackup()     const override { return true; }
-
-    bool Apply()    override;
-    bool Revert()   override;
-    bool IsApplied() const override;
-};
-
 // Tweak: Disable NVIDIA Ultra Low Power State (ULPS equivalent for NVIDIA)
 // Disables deep idle power states on the GPU. Waking from deep idle causes
 // a burst of DPC activity and high latency while the GPU re-initializes.
-class DisableNvidiaEnergyDriverTweak : public TweakBase {
+class DisableNvidiaEnergyDriverTweak : public DeviceTweak {
 public:
-    const char* Name()        const override { return "NVIDIA: Disable PState Deep Idle (P8)"; }
+    using DeviceTweak::DeviceTweak;
+
+    const char* BaseName()    const override { return "NVIDIA: Disable PState Deep Idle (P8)"; }
     const char* Description() const override { return "Prevents the GPU from entering deep idle (P8), avoiding wake-up DPC storms."; }
     const char* Detail()      const override {
         return "When the GPU enters its deepest idle state (P8/D3), waking it back\n"
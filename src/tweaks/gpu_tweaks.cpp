@@ -2,28 +2,37 @@
 #include "../utils/registry_utils.h"
 
 // ─── NvidiaOptimizeTweak ─────────────────────────────────────────────────────
-static const wchar_t* kNvGlobalKey =
-    L"SYSTEM\\CurrentControlSet\\Control\\Class\\"
-    L"{4d36e968-e325-11ce-bfc1-08002be10318}\\0000";
+// Key() is this adapter's display class instance.  Prerender lives in the
+// machine-wide NVTweak key, shared by every NVIDIA instance: it is set by
+// the first one applied and reset only when the last one is reverted.
+static const wchar_t* kNvTweakKey =
+    L"SOFTWARE\\NVIDIA Corporation\\Global\\NVTweak";
+
+static bool MaxPerformance(const std::wstring& classKey)
+{
+    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, classKey, L"PowerMizerEnable");
+    return val.has_value() && *val == 0;
+}
+
+// Another active NVIDIA adapter still has the tweak applied
+static bool OtherInstanceApplied(const std::wstring& classKey)
+{
+    for (const auto& dev : device_utils::FindDevices(device_utils::kDisplayClass, device_utils::NvidiaGpu()))
+        if (dev.classKey != classKey && MaxPerformance(dev.classKey)) return true;
+    return false;
+}
 
 bool NvidiaOptimizeTweak::Apply()
 {
     // PowerMizerEnable 0 = always max perf, PrerenderedFrames = 1
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvGlobalKey,
+    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"PowerMizerEnable", 0);
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvGlobalKey,
+    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                       L"PowerMizerLevel", 1);
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvGlobalKey,
+    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                       L"PowerMizerLevelAC", 1);
-
-    // D3D prerendered frames limit (applies to all DXGI apps)
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE,
-        L"SYSTEM\\CurrentControlSet\\Control\\GraphicsDrivers",
-        L"PendingDriverOperations", 1);
-
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE,
-        L"SOFTWARE\\NVIDIA Corporation\\Global\\NVTweak",
-        L"Prerender", 1);
+    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvTweakKey,
+                                      L"Prerender", 1);
 
     m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
     return ok;
@@ -31,24 +40,23 @@ bool NvidiaOptimizeTweak::Apply()
 
 bool NvidiaOptimizeTweak::Revert()
 {
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvGlobalKey,
+    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                           L"PowerMizerEnable", 1);
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvGlobalKey,
+    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                       L"PowerMizerLevel", 3);
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvGlobalKey,
+    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, Key(),
                                       L"PowerMizerLevelAC", 3);
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE,
-        L"SOFTWARE\\NVIDIA Corporation\\Global\\NVTweak",
-        L"Prerender", 3);
+    if (!OtherInstanceApplied(Key()))
+        ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNvTweakKey,
+                                          L"Prerender", 3);
     m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
     return ok;
 }
 
 bool NvidiaOptimizeTweak::IsApplied() const
 {
-    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNvGlobalKey,
-                                          L"PowerMizerEnable");
-    return val.has_value() && *val == 0;
+    auto prerender = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNvTweakKey, L"Prerender");
+    return MaxPerformance(Key()) && prerender.has_value() && *prerender == 1;
 }
 
 // ─── DisableHAGSTweak ─────────────────────────────────────────────────────────
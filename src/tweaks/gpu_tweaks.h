@@ -1,16 +1,20 @@
 #pragma once
 #include "tweak_base.h"
+#include "device_tweak.h"
 
 // ─── GPU Category ─────────────────────────────────────────────────────────────
 
 // Tweak 12: NVIDIA – Maximum Performance + Pre-rendered frames = 1
-class NvidiaOptimizeTweak : public TweakBase {
+class NvidiaOptimizeTweak : public DeviceTweak {
 public:
-    const char* Name()        const override { return "NVIDIA: Max Performance + Prerendered Frames=1"; }
+    using DeviceTweak::DeviceTweak;
+
+    const char* BaseName()    const override { return "NVIDIA: Max Performance + Prerendered Frames=1"; }
     const char* Description() const override { return "Sets NVIDIA driver to Max Performance mode and reduces pre-rendered frames."; }
     const char* Detail()      const override {
-        return "Sets PowerMizerEnable=0 (always max clocks) and\n"
-               "PrerenderedFrames=1 via registry for all NVIDIA adapters.\n"
+        return "Sets PowerMizerEnable=0 (always max clocks) for this NVIDIA\n"
+               "adapter and the driver-wide Prerender=1, which stays set\n"
+               "until the last NVIDIA adapter is reverted.\n"
                "Reduces render-queue latency at the cost of higher GPU power draw.\n"
                "Requires NVIDIA GPU.";
     }
@@ -1,63 +1,123 @@
 #include "interrupts_tweaks.h"
 #include "../utils/registry_utils.h"
+#include "../utils/device_utils.h"
+#include "../bench/affinity_planner.h"
+#include "../bench/cpu_topology.h"
+#include "../bench/interrupt_manager.h"
+#include "../bench/machine_profile.h"
 
-// Network device class GUID
-static const wchar_t* kNetClassKey =
-    L"SYSTEM\\CurrentControlSet\\Control\\Class\\{4d36e972-e325-11ce-bfc1-08002be10318}\\0000";
+// ─── InterruptAffinityPlanTweak ───────────────────────────────────────────────
 
-// ─── NetworkInterruptAffinityTweak ────────────────────────────────────────────
+// Physical display and network adapters plus xHCI controllers, planned
+// against the reserved game CPUs (machine profile, else the default split).
+const std::vector<InterruptAffinityPlanTweak::Target>& InterruptAffinityPlanTweak::Targets() const
+{
+    if (m_planned) return m_targets;
+    m_planned = true;
+
+    using affinity_planner::DeviceKind;
+    std::vector<std::wstring> keys;
+    affinity_planner::Request req;
+    auto add = [&](const device_utils::ClassDevice& d, DeviceKind kind) {
+        req.devices.push_back({ std::to_string(keys.size()), kind });
+        keys.push_back(d.classKey);
+    };
+    for (const auto& d : device_utils::FindDevices(device_utils::kDisplayClass, device_utils::PciDevice()))
+        add(d, DeviceKind::Display);
+    for (const auto& d : device_utils::FindDevices(device_utils::kNetClass, device_utils::PciDevice()))
+        add(d, DeviceKind::Network);
+    for (const auto& d : device_utils::FindDevices(device_utils::kUsbClass, device_utils::PciDevice()))
+        if (device_utils::IsXhciController(d)) add(d, DeviceKind::Usb);
+
+    const auto& topo = cpu_topology::Current();
+    machine_profile::Profile profile;
+    std::string error;
+    machine_profile::Load(machine_profile::DefaultPath(), profile, error);   // none yet: default game cores
+    req.gameCpus = affinity_planner::GameCpus(topo, profile);
+
+    // Devices the planner could not place keep mask 0 and fail Apply
+    for (const auto& key : keys) m_targets.push_back({ key, 0 });
+    for (const auto& a : affinity_planner::Build(topo, req).assignments)
+        m_targets[std::stoul(a.deviceId)].mask = static_cast<uint32_t>(a.mask);
+    return m_targets;
+}
 
-bool NetworkInterruptAffinityTweak::Apply()
+bool InterruptAffinityPlanTweak::Apply()
 {
-    // *InterruptAffinityPolicy:  5 = IrqPolicySpecifiedProcessors
-    // *InterruptAffinity:        0x01 = CPU 0
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNetClassKey,
+    m_planned = false;               // pick up profile / device changes
+    m_targets.clear();
+    bool ok = !Targets().empty();
+    for (const auto& d : Targets())
+    {
+        // No DWORD mask (target outside group 0 or above CPU 31): never
+        // fall back to a hard-coded CPU
+        if (d.mask == 0)
+        {
+            ok = false;
+            continue;
+        }
+        ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, d.classKey,
                                           L"*InterruptAffinityPolicy", 5);
-    ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNetClassKey,
-                                      L"*InterruptAffinity", 0x01);
+        ok &= registry_utils::WriteDword(HKEY_LOCAL_MACHINE, d.classKey,
+                                          L"*InterruptAffinity", static_cast<DWORD>(d.mask));
+    }
     m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
     return ok;
 }
 
-bool NetworkInterruptAffinityTweak::Revert()
+bool InterruptAffinityPlanTweak::Revert()
 {
-    bool ok = registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, kNetClassKey,
-                                           L"*InterruptAffinityPolicy");
-    ok &= registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, kNetClassKey,
-                                       L"*InterruptAffinity");
+    bool ok = true;
+    for (const auto& d : Targets())
+    {
+        // Missing values are already the default
+        if (registry_utils::ValueExists(HKEY_LOCAL_MACHINE, d.classKey, L"*InterruptAffinityPolicy"))
+            ok &= registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, d.classKey, L"*InterruptAffinityPolicy");
+        if (registry_utils::ValueExists(HKEY_LOCAL_MACHINE, d.classKey, L"*InterruptAffinity"))
+            ok &= registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, d.classKey, L"*InterruptAffinity");
+    }
     m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
     return ok;
 }
 
-bool NetworkInterruptAffinityTweak::IsApplied() const
+bool InterruptAffinityPlanTweak::IsApplied() const
 {
-    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNetClassKey,
-                                          L"*InterruptAffinityPolicy");
-    return val.has_value() && *val == 5;
+    if (Targets().empty()) return false;
+    for (const auto& d : Targets())
+    {
+        auto policy = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, d.classKey, L"*InterruptAffinityPolicy");
+        auto mask   = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, d.classKey, L"*InterruptAffinity");
+        if (!policy || *policy != 5 || !mask || *mask != d.mask) return false;
+    }
+    return true;
 }
 
 // ─── DisableNetworkMSITweak ───────────────────────────────────────────────────
-// MSISupported 0 = legacy INTx, 1 = MSI
+// MSISupported 0 = legacy INTx, 1 = MSI; read from the hardware key, with the
+// original values kept by interrupt_manager for Revert.
 
 bool DisableNetworkMSITweak::Apply()
 {
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNetClassKey,
-                                          L"MSISupported", 0);
+    interrupt_manager::Setting s;
+    s.msi = false;
+    std::string error;
+    bool ok = interrupt_manager::ApplyToDevice(InstanceId(), s, error);
     m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
     return ok;
 }
 
 bool DisableNetworkMSITweak::Revert()
 {
-    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kNetClassKey,
-                                          L"MSISupported", 1);
+    std::string error;
+    bool ok = interrupt_manager::RestoreDevice(InstanceId(), error);
     m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
     return ok;
 }
 
 bool DisableNetworkMSITweak::IsApplied() const
 {
-    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kNetClassKey,
-                                          L"MSISupported");
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    auto val = reg ? reg->ReadDword(interrupt_manager::MsiKey(InstanceId()), "MSISupported") : std::nullopt;
     return val.has_value() && *val == 0;
 }
@@ -1,18 +1,26 @@
 #pragma once
 #include "tweak_base.h"
+#include "device_tweak.h"
+#include <cstdint>
+#include <string>
+#include <vector>
 
 // ─── Interrupts Category ──────────────────────────────────────────────────────
 
-// Tweak 20: Set Network Adapter Interrupt Affinity to CPU 0
-class NetworkInterruptAffinityTweak : public TweakBase {
+// Tweak: Planned interrupt affinity for every GPU, NIC and xHCI controller
+class InterruptAffinityPlanTweak : public TweakBase {
 public:
-    const char* Name()        const override { return "Network Adapter Interrupt Affinity"; }
-    const char* Description() const override { return "Pins NIC interrupts to CPU 0 to reduce inter-core latency."; }
+    const char* Name()        const override { return "Interrupt Affinity Plan (GPU, NIC, USB)"; }
+    const char* Description() const override { return "Gives each GPU, NIC and xHCI controller its own physical core, away from core 0 and the game cores."; }
     const char* Detail()      const override {
-        return "By default Windows can migrate NIC interrupts across cores.\n"
-               "Pinning them to a single core (CPU 0) reduces cache-line\n"
-               "ping-pong and gives a more predictable interrupt service time.\n"
-               "May reduce multi-core throughput slightly.";
+        return "Plans interrupt targets from the CPU topology: one physical\n"
+               "performance core per device, never core 0, never an SMT sibling\n"
+               "of another target, and never a reserved game core (game.cpus in\n"
+               "the machine profile, or the lower P-cores by default). E-cores\n"
+               "and shared cores are used only when the machine runs out.\n"
+               "Writes *InterruptAffinityPolicy / *InterruptAffinity per device;\n"
+               "the only tweak that writes them.\n"
+               "Requires reboot.";
     }
     const char* Category()    const override { return "Interrupts"; }
     TweakRisk   Risk()        const override { return TweakRisk::Medium; }
@@ -22,12 +30,26 @@ public:
     bool Apply()    override;
     bool Revert()   override;
     bool IsApplied() const override;
+
+private:
+    struct Target {
+        std::wstring classKey;
+        uint32_t     mask;
+    };
+
+    // Planned once per session (device enumeration is too slow per frame)
+    const std::vector<Target>& Targets() const;
+
+    mutable std::vector<Target> m_targets;
+    mutable bool                m_planned = false;
 };
 
 // Tweak 21: Disable Message-Signaled Interrupts (MSI) for network adapter
-class DisableNetworkMSITweak : public TweakBase {
+class DisableNetworkMSITweak : public DeviceTweak {
 public:
-    const char* Name()        const override { return "Disable MSI for Network Adapter"; }
+    using DeviceTweak::DeviceTweak;
+
+    const char* BaseName()    const override { return "Disable MSI for Network Adapter"; }
     const char* Description() const override { return "Switches NIC from MSI to legacy INTx interrupts if MSI causes issues."; }
     const char* Detail()      const override {
         return "Message Signaled Interrupts (MSI) are generally faster, but some\n"
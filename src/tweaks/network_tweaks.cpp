@@ -1,6 +1,13 @@
 #include "network_tweaks.h"
 #include "../utils/registry_utils.h"
 #include "../utils/cmd_utils.h"
+#include "../utils/device_utils.h"
+#include "../bench/affinity_planner.h"
+#include "../bench/cpu_topology.h"
+#include "../bench/machine_profile.h"
+#include "../bench/nic_params.h"
+#include "../bench/nic_tuning.h"
+#include "../bench/rss_planner.h"
 
 // ─── DisableNagleTweak ────────────────────────────────────────────────────────
 // Applied to every interface key under TCPIP\Parameters\Interfaces
@@ -140,3 +147,111 @@ bool DisableTCPTimestampsTweak::IsApplied() const
     auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kTcpParamKey, L"Tcp1323Opts");
     return val.has_value() && (*val == 0 || *val == 1);
 }
+
+// ─── RssPlanTweak ─────────────────────────────────────────────────────────────
+// Keywords come from the adapter's Ndi\params; nic_params keeps the original
+// values for Revert.
+
+const std::vector<std::pair<std::string, std::string>>& RssPlanTweak::Values() const
+{
+    if (m_planned) return m_values;
+    m_planned = true;
+
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    nic_params::Adapter a;
+    if (!reg || !nic_params::ReadAdapter(*reg, device_utils::ToUtf8(Key()), a)) return m_values;
+
+    const auto& topo = cpu_topology::Current();
+    rss_planner::Request req;
+    machine_profile::Profile profile;
+    machine_profile::Load(machine_profile::DefaultPath(), profile, error);   // none yet: default game cores
+    req.gameCpus = affinity_planner::GameCpus(topo, profile);
+
+    rss_planner::Plan plan = rss_planner::Build(topo, rss_planner::ReadCapabilities(a), req);
+    if (plan.ok) m_values = plan.values;
+    return m_values;
+}
+
+bool RssPlanTweak::Apply()
+{
+    m_planned = false;               // pick up profile / driver changes
+    m_values.clear();
+    std::string error;
+    bool ok = !Values().empty() && nic_params::SetAdapterValues(device_utils::ToUtf8(Key()), Values(), error);
+    m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
+    return ok;
+}
+
+bool RssPlanTweak::Revert()
+{
+    std::string error;
+    bool ok = nic_params::RestoreAdapter(device_utils::ToUtf8(Key()), rss_planner::Keywords(), error);
+    m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
+    return ok;
+}
+
+bool RssPlanTweak::IsApplied() const
+{
+    if (Values().empty()) return false;
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return false;
+    std::string key = device_utils::ToUtf8(Key());
+    for (const auto& [name, value] : Values())
+        if (reg->ReadString(key, name) != value) return false;
+    return true;
+}
+
+// ─── NicLatencyPresetTweak ────────────────────────────────────────────────────
+// Values resolved by nic_tuning from the driver's own metadata; nic_params
+// keeps the originals for Revert.
+
+bool NicLatencyPresetTweak::Planned() const
+{
+    if (m_planned) return m_ok;
+    m_planned = true;
+
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    nic_params::Adapter a;
+    if (!reg || !nic_params::ReadAdapter(*reg, device_utils::ToUtf8(Key()), a)) return m_ok = false;
+
+    m_values   = nic_tuning::Build(a, nic_tuning::Preset::Latency).values;
+    m_keywords = nic_tuning::Keywords(a);
+    for (const auto& v : m_values) m_defaults.push_back(a.Find(v.first)->defaultValue);
+    return m_ok = true;
+}
+
+bool NicLatencyPresetTweak::Apply()
+{
+    m_planned = false;               // pick up driver changes
+    m_values.clear();
+    m_keywords.clear();
+    m_defaults.clear();
+    std::string error;
+    bool ok = Planned() && !m_values.empty() &&
+              nic_params::SetAdapterValues(device_utils::ToUtf8(Key()), m_values, error);
+    m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
+    return ok;
+}
+
+bool NicLatencyPresetTweak::Revert()
+{
+    std::string error;
+    bool ok = Planned() && nic_params::RestoreAdapter(device_utils::ToUtf8(Key()), m_keywords, error);
+    m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
+    return ok;
+}
+
+bool NicLatencyPresetTweak::IsApplied() const
+{
+    if (!Planned() || m_values.empty()) return false;
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return false;
+    std::string key = device_utils::ToUtf8(Key());
+    for (std::size_t i = 0; i < m_values.size(); ++i)
+        if (reg->ReadString(key, m_values[i].first).value_or(m_defaults[i]) != m_values[i].second) return false;
+    return true;
+}
@@ -1,5 +1,9 @@
 #pragma once
 #include "tweak_base.h"
+#include "device_tweak.h"
+#include <string>
+#include <utility>
+#include <vector>
 
 // ─── Network Category ─────────────────────────────────────────────────────────
 
@@ -103,3 +107,72 @@ public:
     bool Revert()   override;
     bool IsApplied() const override;
 };
+
+// Tweak: Receive Side Scaling window off the game cores, per adapter
+class RssPlanTweak : public DeviceTweak {
+public:
+    using DeviceTweak::DeviceTweak;
+
+    const char* BaseName()    const override { return "Keep Receive Processing off Game Cores (RSS)"; }
+    const char* Description() const override { return "Moves the adapter's RSS queues to free physical cores above core 0 and the game cores."; }
+    const char* Detail()      const override {
+        return "RSS runs receive DPCs on the cores from *RSSBaseProcNumber up,\n"
+               "which defaults to CPU 0 and overlaps the game cores. Plans a\n"
+               "window of consecutive free physical cores (game.cpus in the\n"
+               "machine profile, or the lower P-cores by default) and writes\n"
+               "*RSSBaseProcNumber, *MaxRssProcessors, *NumRssQueues and a\n"
+               "static *RSSProfile, within what the driver allows. Original\n"
+               "values are backed up. Takes effect after the adapter restarts.";
+    }
+    const char* Category()    const override { return "Network"; }
+    TweakRisk   Risk()        const override { return TweakRisk::Medium; }
+    TweakCompat Compat()      const override { return TweakCompat::All; }
+    bool RequiresBackup()     const override { return true; }
+
+    bool Apply()    override;
+    bool Revert()   override;
+    bool IsApplied() const override;
+
+private:
+    // Planned once per session; empty when the driver has no RSS keywords
+    const std::vector<std::pair<std::string, std::string>>& Values() const;
+
+    mutable std::vector<std::pair<std::string, std::string>> m_values;
+    mutable bool                                             m_planned = false;
+};
+
+// Tweak: Latency preset for the adapter's advanced properties
+class NicLatencyPresetTweak : public DeviceTweak {
+public:
+    using DeviceTweak::DeviceTweak;
+
+    const char* BaseName()    const override { return "Adapter Latency Preset (Moderation, EEE, Flow Control, Offloads)"; }
+    const char* Description() const override { return "Turns off interrupt moderation, link power saving, pause frames and send/receive coalescing."; }
+    const char* Detail()      const override {
+        return "Reads the adapter's advanced properties and their allowed\n"
+               "values from the driver (Ndi\\params) and sets, where offered:\n"
+               "interrupt moderation off, Energy Efficient / Green Ethernet\n"
+               "off, flow control off, LSO / USO / RSC / packet coalescing off\n"
+               "and the largest receive ring. Costs CPU time per packet.\n"
+               "Original values are backed up. Takes effect after the\n"
+               "adapter restarts.";
+    }
+    const char* Category()    const override { return "Network"; }
+    TweakRisk   Risk()        const override { return TweakRisk::Medium; }
+    TweakCompat Compat()      const override { return TweakCompat::All; }
+    bool RequiresBackup()     const override { return true; }
+
+    bool Apply()    override;
+    bool Revert()   override;
+    bool IsApplied() const override;
+
+private:
+    // Planned once per session; false when the adapter cannot be read
+    bool Planned() const;
+
+    mutable std::vector<std::pair<std::string, std::string>> m_values;     // target values
+    mutable std::vector<std::string>                         m_keywords;   // keywords the preset owns
+    mutable std::vector<std::string>                         m_defaults;   // per target
+    mutable bool                                             m_planned = false;
+    mutable bool                                             m_ok      = false;
+};
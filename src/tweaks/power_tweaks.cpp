@@ -1,38 +1,33 @@
 #include "power_tweaks.h"
-#include "../utils/cmd_utils.h"
 #include "../utils/registry_utils.h"
+#include "../bench/device_power.h"
+#include "../bench/power_scheme.h"
+
+#include <iterator>
 
 // ─── UltimatePerformancePlanTweak ─────────────────────────────────────────────
+// power_scheme builds the scheme in-process and records the one to go back to.
 
 bool UltimatePerformancePlanTweak::Apply()
 {
-    // Duplicate the scheme (idempotent if already exists)
-    cmd_utils::RunCommand(L"powercfg",
-        L"/duplicatescheme e9a42b02-d5df-448d-aa00-03f14749eb61", false, true);
-
-    // Set it as active
-    std::string guid = kGUID;
-    std::wstring wguid(guid.begin(), guid.end());
-    int rc = cmd_utils::RunCommand(L"powercfg",
-        L"/setactive " + wguid, false, true);
-
-    m_lastStatus = (rc == 0) ? TweakStatus::Applied : TweakStatus::Failed;
-    return rc == 0;
+    power_scheme::BuildResult result;
+    std::string error;
+    bool ok = power_scheme::BuildLatencyScheme(power_scheme::Options{}, result, error);
+    m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
+    return ok;
 }
 
 bool UltimatePerformancePlanTweak::Revert()
 {
-    // Restore Balanced plan (381b4222-f694-41f0-9685-ff5bb260df2e)
-    int rc = cmd_utils::RunCommand(L"powercfg",
-        L"/setactive 381b4222-f694-41f0-9685-ff5bb260df2e", false, true);
-    m_lastStatus = (rc == 0) ? TweakStatus::Reverted : TweakStatus::Failed;
-    return rc == 0;
+    std::string error;
+    bool ok = power_scheme::RestoreOriginalScheme(error);
+    m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
+    return ok;
 }
 
 bool UltimatePerformancePlanTweak::IsApplied() const
 {
-    std::string out = cmd_utils::CaptureOutput("powercfg /getactivescheme");
-    return out.find(kGUID) != std::string::npos;
+    return power_scheme::LatencySchemeActive();
 }
 
 // ─── DisableUSBSuspendTweak ───────────────────────────────────────────────────
@@ -64,35 +59,89 @@ bool DisableUSBSuspendTweak::IsApplied() const
     return val.has_value() && *val == 1;
 }
 
+// ─── PathPowerManagementTweak ─────────────────────────────────────────────────
+// Values and the input / network path come from device_power, which also keeps
+// the originals for Revert.
+
+const std::vector<PathPowerManagementTweak::Target>& PathPowerManagementTweak::Targets() const
+{
+    if (m_planned) return m_targets;
+    m_planned = true;
+
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return m_targets;
+    for (const auto& d : device_power::LiveDevices(*reg))
+        if (d.onPath && d.present)
+            for (const auto& w : device_power::Plan(*reg, d))
+                m_targets.push_back({ w.key, w.name, w.value });
+    return m_targets;
+}
+
+bool PathPowerManagementTweak::Apply()
+{
+    m_planned = false;               // pick up newly attached devices
+    m_targets.clear();
+    std::string error;
+    bool ok = device_power::ApplyPath(error);
+    m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
+    return ok;
+}
+
+bool PathPowerManagementTweak::Revert()
+{
+    std::string error;
+    bool ok = device_power::RestoreAll(error);
+    m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
+    return ok;
+}
+
+bool PathPowerManagementTweak::IsApplied() const
+{
+    if (Targets().empty()) return false;
+    std::string error;
+    auto reg = registry_access::SystemRegistry(error);
+    if (!reg) return false;
+    for (const auto& t : Targets())
+        if (reg->ReadDword(t.key, t.name) != t.value) return false;
+    return true;
+}
+
 // ─── DisableCoreParkingTweak ─────────────────────────────────────────────────
+// Written into the active scheme; the originals live in power_scheme's state
+// file, so Revert restores the scheme's own values.
+
+static const char* kParkingKeys[] = { "cpmincores", "cpmincores1", "cpmaxcores", "cpmaxcores1" };
 
 bool DisableCoreParkingTweak::Apply()
 {
-    int rc = cmd_utils::RunCommand(L"powercfg",
-        L"/setacvalueindex scheme_current sub_processor CPMINCORES 100", false, true);
-    cmd_utils::RunCommand(L"powercfg",
-        L"/setdcvalueindex scheme_current sub_processor CPMINCORES 100", false, true);
-    cmd_utils::RunCommand(L"powercfg", L"/setactive scheme_current", false, true);
-    m_lastStatus = (rc == 0) ? TweakStatus::Applied : TweakStatus::Failed;
-    return rc == 0;
+    std::vector<power_scheme::Planned> plan;
+    for (const char* key : kParkingKeys) plan.push_back({ power_scheme::Find(key), 100 });
+    std::string error;
+    bool ok = power_scheme::ApplyValues(plan, true, error);
+    m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
+    return ok;
 }
 
 bool DisableCoreParkingTweak::Revert()
 {
-    int rc = cmd_utils::RunCommand(L"powercfg",
-        L"/setacvalueindex scheme_current sub_processor CPMINCORES 10", false, true);
-    cmd_utils::RunCommand(L"powercfg",
-        L"/setdcvalueindex scheme_current sub_processor CPMINCORES 10", false, true);
-    cmd_utils::RunCommand(L"powercfg", L"/setactive scheme_current", false, true);
-    m_lastStatus = (rc == 0) ? TweakStatus::Reverted : TweakStatus::Failed;
-    return rc == 0;
+    std::string error;
+    bool ok = power_scheme::RestoreValues({ std::begin(kParkingKeys), std::end(kParkingKeys) }, error);
+    m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
+    return ok;
 }
 
 bool DisableCoreParkingTweak::IsApplied() const
 {
-    std::string out = cmd_utils::CaptureOutput(
-        "powercfg /query scheme_current sub_processor CPMINCORES");
-    return out.find("0x00000064") != std::string::npos;
+    std::string active, error;
+    std::vector<power_scheme::Value> values;
+    if (!power_scheme::ActiveScheme(active, error) || !power_scheme::ReadScheme(active, values, error)) return false;
+    for (const auto& v : values)
+    {
+        std::string key = v.setting->key;
+        if ((key == "cpmincores" || key == "cpmaxcores") && (!v.ac || *v.ac != 100)) return false;
+    }
+    return true;
 }
 
 // ─── DisablePowerThrottlingTweak ─────────────────────────────────────────────
@@ -1,18 +1,26 @@
 #pragma once
 #include "tweak_base.h"
+#include <cstdint>
+#include <string>
+#include <vector>
 
 // ─── Power Category ───────────────────────────────────────────────────────────
 
-// Tweak 7: Activate Ultimate Performance power plan
+// Tweak 7: Activate a low-latency scheme built from Ultimate Performance
 class UltimatePerformancePlanTweak : public TweakBase {
 public:
     const char* Name()        const override { return "Ultimate Performance Power Plan"; }
-    const char* Description() const override { return "Activates the hidden Ultimate Performance power scheme."; }
+    const char* Description() const override { return "Builds and activates a low-latency scheme from the Ultimate Performance template."; }
     const char* Detail()      const override {
-        return "The Ultimate Performance plan removes micro-latency from power\n"
-               "management by keeping CPUs at maximum P-state and disabling\n"
-               "power saving idle states. Increases power usage noticeably.\n"
-               "Available on Windows 10 1803+ / Windows 11.";
+        return "Duplicates the hidden Ultimate Performance template (or the\n"
+               "active scheme where it is missing) into \"LatencyOptimizer Low\n"
+               "Latency\" and writes in one pass: aggressive boost, 100% min\n"
+               "and max processor state, EPP 0, no core parking, fast unpark,\n"
+               "latency-sensitivity hints at 100%, PCIe ASPM off and USB\n"
+               "selective suspend off. Revert returns to the scheme that was\n"
+               "active before and deletes the generated one.\n"
+               "Increases power usage noticeably. `latency-probe power` shows\n"
+               "every value.";
     }
     const char* Category()    const override { return "Power"; }
     TweakRisk   Risk()        const override { return TweakRisk::Safe; }
@@ -21,10 +29,6 @@ public:
     bool Apply()    override;
     bool Revert()   override;
     bool IsApplied() const override;
-
-private:
-    // GUID of the Ultimate Performance plan
-    static constexpr const char* kGUID = "e9a42b02-d5df-448d-aa00-03f14749eb61";
 };
 
 // Tweak 8: Disable USB Selective Suspend
@@ -48,6 +52,44 @@ public:
     bool IsApplied() const override;
 };
 
+// Tweak: Idle power management off for the input and network path only
+class PathPowerManagementTweak : public TweakBase {
+public:
+    const char* Name()        const override { return "Keep Input & Network Devices Awake"; }
+    const char* Description() const override { return "Turns off selective suspend and idle power-down only for mice, keyboards, NICs and the hubs above them."; }
+    const char* Detail()      const override {
+        return "Per-device alternative to the global USB suspend switch.\n"
+               "Finds keyboards, mice, game controllers and network adapters\n"
+               "and every USB interface, hub, root hub and controller between\n"
+               "them and the CPU, then clears EnhancedPowerManagementEnabled,\n"
+               "AllowIdleIrpInD3, SelectiveSuspendEnabled, KMDF idle, D3cold\n"
+               "and the NIC's \"allow the computer to turn off\" option.\n"
+               "Other devices keep their power saving (laptop battery life).\n"
+               "Originals are backed up. Replug or reboot to apply.";
+    }
+    const char* Category()    const override { return "Power"; }
+    TweakRisk   Risk()        const override { return TweakRisk::Safe; }
+    TweakCompat Compat()      const override { return TweakCompat::All; }
+    bool RequiresBackup()     const override { return true; }
+
+    bool Apply()    override;
+    bool Revert()   override;
+    bool IsApplied() const override;
+
+private:
+    struct Target {
+        std::string key;
+        std::string name;
+        uint32_t    value;
+    };
+
+    // Planned once per session (device enumeration is too slow per frame)
+    const std::vector<Target>& Targets() const;
+
+    mutable std::vector<Target> m_targets;
+    mutable bool                m_planned = false;
+};
+
 // Tweak: Disable Core Parking
 class DisableCoreParkingTweak : public TweakBase {
 public:
@@ -56,8 +98,10 @@ public:
     const char* Detail()      const override {
         return "Windows parks idle CPU cores to save power. Waking a parked core\n"
                "adds microseconds of latency when a thread migrates to it.\n"
-               "Setting CoreParkingMinCores to 100% ensures all cores stay active\n"
-               "and ready for immediate use. Increases idle power consumption.";
+               "Sets core parking min and max cores to 100% (both processor\n"
+               "classes on hybrid CPUs, AC and DC) in the active scheme so all\n"
+               "cores stay ready. The scheme's own values are recorded and put\n"
+               "back on revert. Increases idle power consumption.";
     }
     const char* Category()    const override { return "Power"; }
     TweakRisk   Risk()        const override { return TweakRisk::Safe; }
@@ -1,14 +1,41 @@
 #include "timers_tweaks.h"
 #include "../utils/cmd_utils.h"
+#include "../utils/registry_utils.h"
+#include "../bench/clock_source.h"
 
 // ─── HighResTimerTweak ────────────────────────────────────────────────────────
 
+// Measured once per run: the BCD change only takes effect after a reboot,
+// so measuring again before then would repeat the same answer.
+static clock_source::Verdict MeasuredClockVerdict()
+{
+    static const clock_source::Verdict verdict = [] {
+        clock_source::Options o;
+        o.calls  = 200000;
+        o.rounds = 500;
+        clock_source::Report r = clock_source::Run(o);
+        r.source.bcd = clock_source::ParseBcd(cmd_utils::CaptureOutput("bcdedit /enum {current}"));
+        return clock_source::Recommend(r).verdict;
+    }();
+    return verdict;
+}
+
 bool HighResTimerTweak::Apply()
 {
-    // Enable HPET / platform clock
-    int rc = cmd_utils::RunCommand(L"bcdedit", L"/set useplatformclock true", false, true);
-    // Also set the TSCSYNC flag for invariant TSC
-    cmd_utils::RunCommand(L"bcdedit", L"/set tscsyncpolicy enhanced", false, true);
+    // The platform clock makes every QPC call an HPET read; it is only
+    // forced when the TSC went backwards across cores or is not invariant.
+    int rc = 0;
+    if (clock_source::WantsPlatformClock(MeasuredClockVerdict()))
+    {
+        rc = cmd_utils::RunCommand(L"bcdedit", L"/set useplatformclock true", false, true);
+        cmd_utils::RunCommand(L"bcdedit", L"/set tscsyncpolicy enhanced", false, true);
+    }
+    else
+    {
+        // Keep QPC on the TSC; fails harmlessly when the values are absent.
+        cmd_utils::RunCommand(L"bcdedit", L"/deletevalue useplatformclock", false, true);
+        cmd_utils::RunCommand(L"bcdedit", L"/deletevalue tscsyncpolicy", false, true);
+    }
     m_lastStatus = (rc == 0) ? TweakStatus::Applied : TweakStatus::Failed;
     return rc == 0;
 }
@@ -23,9 +50,9 @@ bool HighResTimerTweak::Revert()
 
 bool HighResTimerTweak::IsApplied() const
 {
-    std::string out = cmd_utils::CaptureOutput("bcdedit /enum current");
-    return out.find("useplatformclock") != std::string::npos
-        && out.find("Yes") != std::string::npos;
+    clock_source::ActiveSource s;
+    s.bcd = clock_source::ParseBcd(cmd_utils::CaptureOutput("bcdedit /enum {current}"));
+    return clock_source::PlatformClockForced(s) == clock_source::WantsPlatformClock(MeasuredClockVerdict());
 }
 
 // ─── DisableDynamicTickTweak ──────────────────────────────────────────────────
@@ -48,8 +75,38 @@ bool DisableDynamicTickTweak::Revert()
 
 bool DisableDynamicTickTweak::IsApplied() const
 {
-    std::string out = cmd_utils::CaptureOutput("bcdedit /enum current");
+    std::string out = cmd_utils::CaptureOutput("bcdedit /enum {current}");
     return out.find("disabledynamictick") != std::string::npos
         && (out.find("Yes") != std::string::npos
             || out.find("yes") != std::string::npos);
 }
+
+// ─── GlobalTimerRequestsTweak ─────────────────────────────────────────────────
+
+static const wchar_t* kKernelKey =
+    L"SYSTEM\\CurrentControlSet\\Control\\Session Manager\\kernel";
+
+bool GlobalTimerRequestsTweak::Apply()
+{
+    bool ok = registry_utils::WriteDword(HKEY_LOCAL_MACHINE, kKernelKey,
+                                          L"GlobalTimerResolutionRequests", 1);
+    m_lastStatus = ok ? TweakStatus::Applied : TweakStatus::Failed;
+    return ok;
+}
+
+bool GlobalTimerRequestsTweak::Revert()
+{
+    bool ok = !registry_utils::ValueExists(HKEY_LOCAL_MACHINE, kKernelKey,
+                                            L"GlobalTimerResolutionRequests")
+           || registry_utils::DeleteValue(HKEY_LOCAL_MACHINE, kKernelKey,
+                                          L"GlobalTimerResolutionRequests");
+    m_lastStatus = ok ? TweakStatus::Reverted : TweakStatus::Failed;
+    return ok;
+}
+
+bool GlobalTimerRequestsTweak::IsApplied() const
+{
+    auto val = registry_utils::ReadDword(HKEY_LOCAL_MACHINE, kKernelKey,
+                                          L"GlobalTimerResolutionRequests");
+    return val.has_value() && *val == 1;
+}
@@ -3,16 +3,19 @@
 
 // ─── Timers Category ──────────────────────────────────────────────────────────
 
-// Tweak 18: Request high-resolution system timer (0.5 ms)
+// Tweak 18: Clock source chosen from a TSC / platform-clock measurement
 class HighResTimerTweak : public TweakBase {
 public:
     const char* Name()        const override { return "High-Resolution System Timer"; }
-    const char* Description() const override { return "Sets the global timer resolution to ~0.5 ms via bcdedit."; }
+    const char* Description() const override { return "Picks the QPC clock source (TSC or platform clock) from a measurement."; }
     const char* Detail()      const override {
-        return "Windows defaults to a 15.6 ms timer resolution. Setting it to\n"
-               "0.5 ms via bcdedit /set useplatformclock true and reducing the\n"
-               "minimum resolution improves scheduling granularity, which lowers\n"
-               "sleep-jitter and frame-time variance in games.";
+        return "Measures QueryPerformanceCounter and rdtsc cost and checks that\n"
+               "the TSC is invariant and stays monotonic across cores. When it\n"
+               "does, useplatformclock is removed so QPC keeps reading the TSC\n"
+               "(forcing the HPET multiplies the cost of every call). Only when\n"
+               "the TSC cannot be trusted are useplatformclock and\n"
+               "tscsyncpolicy enhanced set. Reboot to apply; details with\n"
+               "LatencyProbe clock.";
     }
     const char* Category()    const override { return "Timers"; }
     TweakRisk   Risk()        const override { return TweakRisk::Safe; }
@@ -41,3 +44,25 @@ public:
     bool Revert()   override;
     bool IsApplied() const override;
 };
+
+// Tweak: Let timer-resolution requests apply while the requester is in the background
+class GlobalTimerRequestsTweak : public TweakBase {
+public:
+    const char* Name()        const override { return "Global Timer Resolution Requests"; }
+    const char* Description() const override { return "Keeps timer-resolution requests in effect while the requesting app is minimized or hidden."; }
+    const char* Detail()      const override {
+        return "Windows 11 ignores a process's timer-resolution request\n"
+               "(timeBeginPeriod) while it has no visible window, so a game\n"
+               "or frame limiter that is alt-tabbed or runs in a background\n"
+               "launcher falls back to the 15.6 ms tick. Sets\n"
+               "GlobalTimerResolutionRequests = 1 to restore the Windows 10\n"
+               "behaviour. Check the effect with LatencyProbe timer.";
+    }
+    const char* Category()    const override { return "Timers"; }
+    TweakRisk   Risk()        const override { return TweakRisk::Safe; }
+    TweakCompat Compat()      const override { return TweakCompat::Win11Only; }
+
+    bool Apply()    override;
+    bool Revert()   override;
+    bool IsApplied() const override;
+};
@@ -33,6 +33,10 @@ public:
     // Human-readable name
     virtual const char* Name() const = 0;
 
+    // Identifier recorded in the machine profile; unlike Name() it must not
+    // change when a driver update renames the device or reorders instances.
+    virtual std::string Id() const { return Name(); }
+
     // One-sentence description shown in the list
     virtual const char* Description() const = 0;
 
@@ -0,0 +1,145 @@
+#include "device_utils.h"
+#include "registry_utils.h"
+
+#include <setupapi.h>
+#include <cfgmgr32.h>
+
+#include <cwctype>
+#include <map>
+
+namespace device_utils {
+
+const wchar_t* kDisplayClass = L"{4d36e968-e325-11ce-bfc1-08002be10318}";
+const wchar_t* kNetClass     = L"{4d36e972-e325-11ce-bfc1-08002be10318}";
+const wchar_t* kUsbClass     = L"{36fc9e60-c465-11cf-8056-444553540000}";
+
+static std::wstring Lower(std::wstring s)
+{
+    for (auto& c : s) c = static_cast<wchar_t>(std::towlower(c));
+    return s;
+}
+
+struct PresentDevice {
+    std::wstring instanceId;
+    bool         started = false;
+};
+
+// Present devices keyed by their driver key ("{class-guid}\0000", lower-case),
+// which is how a class instance finds its device node.
+static std::map<std::wstring, PresentDevice> PresentByDriverKey()
+{
+    std::map<std::wstring, PresentDevice> out;
+    HDEVINFO set = SetupDiGetClassDevsW(nullptr, nullptr, nullptr, DIGCF_PRESENT | DIGCF_ALLCLASSES);
+    if (set == INVALID_HANDLE_VALUE) return out;
+
+    SP_DEVINFO_DATA info = {};
+    info.cbSize = sizeof(info);
+    for (DWORD i = 0; SetupDiEnumDeviceInfo(set, i, &info); ++i)
+    {
+        wchar_t driver[128] = {};
+        if (!SetupDiGetDeviceRegistryPropertyW(set, &info, SPDRP_DRIVER, nullptr,
+                                               reinterpret_cast<PBYTE>(driver), sizeof(driver), nullptr))
+            continue;
+
+        wchar_t id[MAX_DEVICE_ID_LEN] = {};
+        if (CM_Get_Device_IDW(info.DevInst, id, MAX_DEVICE_ID_LEN, 0) != CR_SUCCESS) continue;
+
+        ULONG status = 0, problem = 0;
+        PresentDevice dev;
+        dev.instanceId = id;
+        dev.started    = CM_Get_DevNode_Status(&status, &problem, info.DevInst, 0) == CR_SUCCESS &&
+                         (status & DN_STARTED) && !(status & DN_HAS_PROBLEM);
+        out[Lower(driver)] = dev;
+    }
+    SetupDiDestroyDeviceInfoList(set);
+    return out;
+}
+
+std::vector<ClassDevice> EnumerateClass(const wchar_t* classGuid)
+{
+    const std::wstring base = std::wstring(L"SYSTEM\\CurrentControlSet\\Control\\Class\\") + classGuid;
+    const auto present = PresentByDriverKey();
+
+    std::vector<ClassDevice> out;
+    for (const auto& name : registry_utils::EnumSubKeys(HKEY_LOCAL_MACHINE, base))
+    {
+        // Skip "Properties" and "Configuration"; instances are four digits
+        if (name.size() != 4 || !std::iswdigit(name[0])) continue;
+
+        ClassDevice dev;
+        dev.classKey         = base + L"\\" + name;
+        dev.instance         = name;
+        dev.driverDesc       = registry_utils::ReadString(HKEY_LOCAL_MACHINE, dev.classKey, L"DriverDesc").value_or(L"");
+        dev.providerName     = registry_utils::ReadString(HKEY_LOCAL_MACHINE, dev.classKey, L"ProviderName").value_or(L"");
+        dev.matchingDeviceId = Lower(registry_utils::ReadString(HKEY_LOCAL_MACHINE, dev.classKey, L"MatchingDeviceId").value_or(L""));
+
+        auto it = present.find(Lower(std::wstring(classGuid) + L"\\" + name));
+        if (it != present.end())
+        {
+            dev.instanceId = it->second.instanceId;
+            dev.active     = it->second.started;
+        }
+        out.push_back(std::move(dev));
+    }
+    return out;
+}
+
+bool Matches(const ClassDevice& dev, const Match& match)
+{
+    if (match.activeOnly && !dev.active) return false;
+    if (!match.provider.empty() && Lower(dev.providerName) != Lower(match.provider)) return false;
+    if (!match.descContains.empty() && Lower(dev.driverDesc).find(Lower(match.descContains)) == std::wstring::npos)
+        return false;
+    if (!match.idPrefix.empty() && dev.matchingDeviceId.rfind(Lower(match.idPrefix), 0) != 0) return false;
+    return true;
+}
+
+std::vector<ClassDevice> FindDevices(const wchar_t* classGuid, const Match& match)
+{
+    std::vector<ClassDevice> out;
+    for (auto& dev : EnumerateClass(classGuid))
+        if (Matches(dev, match)) out.push_back(std::move(dev));
+    return out;
+}
+
+Match NvidiaGpu()
+{
+    Match m;
+    m.provider = L"NVIDIA";
+    m.idPrefix = L"pci\\ven_10de";
+    return m;
+}
+
+Match PciDevice()
+{
+    Match m;
+    m.idPrefix = L"pci\\";
+    return m;
+}
+
+bool IsPciDevice(const ClassDevice& dev)
+{
+    return dev.matchingDeviceId.rfind(L"pci\\", 0) == 0;
+}
+
+bool IsXhciController(const ClassDevice& dev)
+{
+    return dev.matchingDeviceId.find(L"cc_0c0330") != std::wstring::npos;
+}
+
+std::string Label(const ClassDevice& dev)
+{
+    std::string desc = ToUtf8(dev.driverDesc.empty() ? L"Device" : dev.driverDesc);
+    return desc + " #" + ToUtf8(dev.instance);
+}
+
+std::string ToUtf8(const std::wstring& w)
+{
+    if (w.empty()) return {};
+    int n = WideCharToMultiByte(CP_UTF8, 0, w.c_str(), static_cast<int>(w.size()), nullptr, 0, nullptr, nullptr);
+    std::string out(static_cast<std::size_t>(n), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, w.c_str(), static_cast<int>(w.size()), &out[0], n, nullptr, nullptr);
+    return out;
+}
+
+} // namespace device_utils
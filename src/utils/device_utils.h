@@ -0,0 +1,56 @@
+#pragma once
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <string>
+#include <vector>
+
+namespace device_utils {
+
+// Device setup class GUIDs
+extern const wchar_t* kDisplayClass;   // {4d36e968-...}
+extern const wchar_t* kNetClass;       // {4d36e972-...}
+extern const wchar_t* kUsbClass;       // {36fc9e60-...} host controllers and hubs
+
+// One numbered driver instance (0000, 0001, ...) under a class key
+struct ClassDevice {
+    std::wstring classKey;          // SYSTEM\CurrentControlSet\Control\Class\{guid}\0000
+    std::wstring instance;          // "0000"
+    std::wstring driverDesc;
+    std::wstring providerName;
+    std::wstring matchingDeviceId;  // lower-case, e.g. pci\ven_10de&dev_2684
+    std::wstring instanceId;        // PCI\VEN_10DE&DEV_2684&...\4&..., empty when not present
+    bool         active = false;    // present and started without a problem code
+};
+
+// Every numbered instance of a device class, in instance order.  Stale
+// instances of removed or replaced hardware are included (active = false).
+std::vector<ClassDevice> EnumerateClass(const wchar_t* classGuid);
+
+// Selection by driver identity; every non-empty field must match
+// (case-insensitive).
+struct Match {
+    std::wstring provider;          // ProviderName, exact
+    std::wstring descContains;      // substring of DriverDesc
+    std::wstring idPrefix;          // prefix of MatchingDeviceId
+    bool         activeOnly = true;
+};
+
+bool                     Matches(const ClassDevice& dev, const Match& match);
+std::vector<ClassDevice> FindDevices(const wchar_t* classGuid, const Match& match);
+
+// Common selections
+Match NvidiaGpu();                  // provider NVIDIA, pci\ven_10de
+Match PciDevice();                  // any active PCI / PCIe function
+
+// MatchingDeviceId starts with "pci\" (a physical PCI / PCIe function)
+bool IsPciDevice(const ClassDevice& dev);
+
+// USB host controller speaking xHCI (PCI class code 0C0330)
+bool IsXhciController(const ClassDevice& dev);
+
+// "NVIDIA GeForce RTX 4090 #0001" – unique per instance, for tweak names
+std::string Label(const ClassDevice& dev);
+
+std::string ToUtf8(const std::wstring& w);
+
+} // namespace device_utils
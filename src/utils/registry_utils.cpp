@@ -103,4 +103,24 @@ bool CreateKey(HKEY root, const std::wstring& subKey)
     return ok;
 }
 
+std::vector<std::wstring> EnumSubKeys(HKEY root, const std::wstring& subKey)
+{
+    std::vector<std::wstring> names;
+    HKEY hKey = nullptr;
+    if (RegOpenKeyExW(root, subKey.c_str(), 0, KEY_ENUMERATE_SUB_KEYS, &hKey) != ERROR_SUCCESS)
+        return names;
+
+    wchar_t name[256];
+    for (DWORD i = 0;; ++i)
+    {
+        DWORD len = 256;
+        LONG rc = RegEnumKeyExW(hKey, i, name, &len, nullptr, nullptr, nullptr, nullptr);
+        if (rc == ERROR_MORE_DATA) continue;     // longer than any key name we look for
+        if (rc != ERROR_SUCCESS) break;
+        names.emplace_back(name, len);
+    }
+    RegCloseKey(hKey);
+    return names;
+}
+
 } // namespace registry_utils
@@ -4,6 +4,7 @@
 #include <string>
 #include <optional>
 #include <variant>
+#include <vector>
 
 namespace registry_utils {
 
@@ -28,4 +29,7 @@ bool ValueExists(HKEY root, const std::wstring& subKey, const std::wstring& valu
 // Create a registry key (and all intermediate keys)
 bool CreateKey(HKEY root, const std::wstring& subKey);
 
+// Names of the immediate subkeys (empty if the key does not exist)
+std::vector<std::wstring> EnumSubKeys(HKEY root, const std::wstring& subKey);
+
 } // namespace registry_utils
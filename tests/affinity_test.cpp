@@ -0,0 +1,186 @@
+#include "test_util.h"
+#include "topology_fixtures.h"
+#include "bench/affinity_planner.h"
+#include "bench/machine_profile.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+// affinity_planner::Build against the fixtures in tests/data/topology, each
+// SKU in both its Windows (SLPI_EX) and Linux (sysfs) numbering.
+
+using namespace affinity_planner;
+using topology_fixtures::LoadRaw;
+using topology_fixtures::LoadSysfs;
+
+static std::vector<Device> Devices(std::size_t count)
+{
+    static const DeviceKind kinds[] = { DeviceKind::Display, DeviceKind::Network, DeviceKind::Usb };
+    std::vector<Device> out;
+    for (std::size_t i = 0; i < count; ++i)
+        out.push_back({ "dev" + std::to_string(i), kinds[i % 3] });
+    return out;
+}
+
+// Every CPU of cores [first, last].
+static std::vector<uint32_t> CoreCpus(const cpu_topology::Topology& t, uint32_t first, uint32_t last)
+{
+    std::vector<uint32_t> out;
+    for (uint32_t i = first; i <= last && i < t.cores.size(); ++i)
+        out.insert(out.end(), t.cores[i].cpus.begin(), t.cores[i].cpus.end());
+    return out;
+}
+
+// The planner's rules when there are enough cores: one primary thread per
+// device, each on its own performance core, never the core of CPU 0 or a
+// core (SMT sibling) of a game CPU; in DWORD mode group 0, CPUs 0-31.
+static void CheckRules(const cpu_topology::Topology& t, const Request& req, const Plan& p, bool dwordMask)
+{
+    CHECK_EQ(p.assignments.size(), req.devices.size());
+    std::set<uint32_t> gameCores, used;
+    for (uint32_t cpu : req.gameCpus) gameCores.insert(t.Find(cpu)->core);
+    const uint32_t core0 = t.Find(0)->core;
+
+    for (const auto& a : p.assignments)
+    {
+        const cpu_topology::Cpu* c = t.Find(a.cpu);
+        CHECK(c != nullptr);
+        if (!c) continue;
+        CHECK(c->core != core0);
+        CHECK(!gameCores.count(c->core));
+        CHECK_EQ(t.cores[c->core].efficiencyClass, t.maxEfficiencyClass);
+        CHECK(t.cores[c->core].cpus.front() == a.cpu);
+        CHECK(used.insert(c->core).second);
+        CHECK(!a.shared);
+        CHECK_EQ(a.group, c->group);
+        CHECK_EQ(a.mask, 1ull << c->number);
+        if (dwordMask) CHECK(a.group == 0 && c->number < 32);
+    }
+}
+
+// Same plan for the same request, whatever order the devices come in.
+static void CheckDeterministic(const cpu_topology::Topology& t, Request req)
+{
+    Plan a = Build(t, req);
+    std::reverse(req.devices.begin(), req.devices.end());
+    Plan b = Build(t, req);
+    CHECK_EQ(a.assignments.size(), b.assignments.size());
+    for (std::size_t i = 0; i < a.assignments.size() && i < b.assignments.size(); ++i)
+        CHECK(a.assignments[i].deviceId == b.assignments[i].deviceId && a.assignments[i].cpu == b.assignments[i].cpu);
+}
+
+// ─── Alder Lake ──────────────────────────────────────────────────────────────
+
+static void CheckHybrid(const cpu_topology::Topology& t)
+{
+    Request req;
+    req.devices  = Devices(3);
+    req.gameCpus = GameCpus(t, machine_profile::Profile{});
+    Plan p = Build(t, req);
+    CheckRules(t, req, p, true);
+    CHECK(p.notes.empty());
+    CheckDeterministic(t, req);
+
+    // Display first, on the highest free P-core
+    CHECK(p.assignments[0].kind == DeviceKind::Display);
+    CHECK(p.assignments[0].cpu == t.cores[7].cpus.front());
+
+    // Past the free P-cores: E-cores, with a note, before core 0 or sharing
+    req.devices = Devices(5);
+    p = Build(t, req);
+    CHECK_EQ(p.assignments.size(), 5u);
+    std::set<uint32_t> cores;
+    for (const auto& a : p.assignments)
+    {
+        const cpu_topology::Cpu* c = t.Find(a.cpu);
+        CHECK(c->core != t.Find(0)->core && !a.shared);
+        cores.insert(c->core);
+    }
+    CHECK_EQ(cores.size(), 5u);
+    CHECK(t.cores[t.Find(p.assignments[3].cpu)->core].efficiencyClass == 0);
+    CHECK(!p.notes.empty());
+
+    // More devices than cores: every one placed, the extras marked shared
+    req.devices = Devices(14);
+    p = Build(t, req);
+    CHECK_EQ(p.assignments.size(), 14u);
+    std::size_t shared = 0;
+    for (const auto& a : p.assignments) shared += a.shared;
+    CHECK(shared >= 2u);
+    CHECK(!p.assignments[0].shared);   // the display keeps its core
+}
+
+// ─── Ryzen 9 5950X ───────────────────────────────────────────────────────────
+
+static void CheckRyzen(const cpu_topology::Topology& t)
+{
+    Request req;
+    req.devices  = Devices(4);
+    req.gameCpus = GameCpus(t, machine_profile::Profile{});
+    Plan p = Build(t, req);
+    CheckRules(t, req, p, true);
+    CheckDeterministic(t, req);
+
+    // A quieter core wins over a higher-numbered one
+    req.devices    = Devices(1);
+    req.quietOrder = { t.cores[12].cpus.back() };
+    p = Build(t, req);
+    CHECK(p.assignments.size() == 1u && p.assignments[0].cpu == t.cores[12].cpus.front());
+}
+
+// ─── Two sockets, 72 CPUs ────────────────────────────────────────────────────
+
+static void CheckXeon(const cpu_topology::Topology& t)
+{
+    Request req;
+    req.devices  = Devices(3);
+    req.gameCpus = CoreCpus(t, 1, 8);
+    Plan p = Build(t, req, true);
+    CheckRules(t, req, p, true);
+    CheckDeterministic(t, req);
+
+    // DWORD mode never leaves group 0 / CPU 31, even when it runs out of room
+    req.devices = Devices(40);
+    p = Build(t, req, true);
+    CHECK_EQ(p.assignments.size(), 40u);
+    for (const auto& a : p.assignments)
+    {
+        CHECK_EQ(a.group, 0u);
+        CHECK(t.Find(a.cpu)->number < 32);
+        CHECK(a.mask != 0 && a.mask < (1ull << 32));
+    }
+
+    // Without the DWORD limit the highest cores are used, group 1 included
+    req.devices = Devices(3);
+    p = Build(t, req, false);
+    CheckRules(t, req, p, false);
+    for (const auto& a : p.assignments) CHECK_EQ(t.Find(a.cpu)->package, 1u);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: affinity_test <tests/data/topology>\n");
+        return 2;
+    }
+    const std::string dir = argv[1];
+    cpu_topology::Topology t;
+
+    for (const char* form : { "slpi.bin", "sysfs" })
+    {
+        const bool raw = std::string(form) == "slpi.bin";
+        auto load = [&](const std::string& sku) {
+            std::string path = dir + "/" + sku + "/" + form;
+            bool ok = raw ? LoadRaw(path, t) : LoadSysfs(path, t);
+            if (!ok) test_util::Fail(__FILE__, __LINE__, "cannot load " + path);
+            return ok;
+        };
+        if (load("hybrid-12700k")) CheckHybrid(t);
+        if (load("ryzen-5950x"))   CheckRyzen(t);
+        if (load("xeon-2x18"))     CheckXeon(t);
+    }
+    return test_util::Finish("affinity_test");
+}
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Writes the PresentMon fixtures used by tests/frames_test.cpp.
+
+  classic.csv   classic column set (MsBetweenPresents / MsUntilDisplayed /
+                Dropped), game.exe with dwm.exe rows interleaved
+  pm2.csv       PresentMon 2.x column set (FrameTime / DisplayLatency, "NA"
+                for frames never displayed)
+
+Frame times are a steady pace with a few slow frames placed so the expected
+percentiles, lows and stutter counts can be worked out by hand; the values
+asserted by the test are in the comments below.  Run from this directory;
+the output is checked in.
+"""
+import os
+
+# ─── Classic ────────────────────────────────────────────────────────────────
+# game.exe, 1000 frames: 990 x 10 ms, 5 x 20 ms, 5 x 40 ms (10.2 s).
+#   p50 = p90 = 10, p99 = 10.1, p99.9 = max = 40
+#   1% low = 1000 / 30 fps, 0.1% low = 25 fps
+#   stutters: the five 40 ms frames (20 ms is exactly 2x, not above it)
+#   dropped 4; display latency 12 ms on even rows, 16 on odd: p50 14, p99 16
+# dwm.exe, 100 frames of 16.5 ms, selected only with --app.
+
+CLASSIC_HEADER = ("Application,ProcessID,SwapChainAddress,Runtime,SyncInterval,PresentFlags,"
+                  "AllowsTearing,PresentMode,Dropped,TimeInSeconds,MsBetweenPresents,"
+                  "MsBetweenDisplayChange,MsInPresentAPI,MsUntilRenderComplete,MsUntilDisplayed")
+
+def classic():
+    rows, t = [CLASSIC_HEADER], 0.0
+    for i in range(1000):
+        ft = 40.0 if i in (100, 300, 500, 700, 900) else 20.0 if i in (50, 250, 450, 650, 850) else 10.0
+        dropped = i in (100, 300, 501, 701)
+        disp = "" if dropped else ("12.000" if i % 2 == 0 else "16.000")
+        t += ft / 1000
+        rows.append(f"game.exe,4242,0x0000021A5C3E1F70,DXGI,0,0,1,Hardware: Independent Flip,"
+                    f"{int(dropped)},{t:.6f},{ft:.3f},{ft:.3f},0.120,2.500,{disp}")
+        if i % 10 == 0:
+            rows.append(f"dwm.exe,1184,0x0000019D2A7B0C40,DXGI,1,0,0,Composed: Flip,"
+                        f"0,{t:.6f},16.500,16.500,0.080,1.200,16.600")
+    return rows
+
+# ─── PresentMon 2.x ─────────────────────────────────────────────────────────
+# game.exe, 600 frames: 594 x 8 ms, 3 x 16 ms, 3 x 32 ms (4.896 s).
+#   p50 = p90 = 8, p99 = 8.08, p99.9 = max = 32
+#   1% low = 1000 / 24 fps, 0.1% low = 31.25 fps, 3 stutters
+#   dropped 6 ("NA"); display latency 10 + (i % 5) ms: p50 12, p99 14
+
+PM2_HEADER = ("Application,ProcessID,SwapChainAddress,PresentRuntime,SyncInterval,PresentFlags,"
+              "AllowsTearing,PresentMode,FrameType,CPUStartTime,FrameTime,CPUBusy,CPUWait,"
+              "GPULatency,GPUTime,GPUBusy,GPUWait,DisplayLatency,DisplayedTime,AnimationError,"
+              "ClickToPhotonLatency")
+
+def pm2():
+    rows, t = [PM2_HEADER], 0.0
+    for i in range(600):
+        ft = 32.0 if i in (100, 300, 500) else 16.0 if i in (40, 240, 440) else 8.0
+        dropped = i in (1, 3, 5, 100, 300, 500)
+        disp = "NA" if dropped else f"{10 + i % 5:.4f}"
+        shown = "NA" if dropped else f"{ft:.4f}"
+        rows.append(f"game.exe,7310,0x000001F4C2D08A10,DXGI,0,0,1,Hardware: Independent Flip,"
+                    f"Application,{t:.4f},{ft:.4f},{ft * 0.6:.4f},{ft * 0.4:.4f},1.2000,"
+                    f"{ft * 0.5:.4f},{ft * 0.5:.4f},0.0000,{disp},{shown},0.0000,NA")
+        t += ft
+    return rows
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    for name, rows in (("classic.csv", classic()), ("pm2.csv", pm2())):
+        with open(os.path.join(here, name), "w", newline="") as f:
+            f.write("\r\n".join(rows) + "\r\n")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Writes the pointer recordings used by tests/input_test.cpp, in the CSV
+format `LatencyProbe input-capture --out` saves.
+
+  evdev.csv     Linux: a 1000 Hz mouse with kernel stamps (1 us resolution),
+                read four reports per read() so each batch shares one
+                receive time.  Two bursts 300 ms apart (500 and 300
+                reports); reports 250 and 251 of the first are missing.
+                Expected: 798 reports, 2 bursts, 1000 Hz, 2 dropped,
+                0 coalesced, delivery 0-3 ms (5 ms for the batch across
+                the missing reports).
+  windows.csv   Windows: receive times only (no source stamp), 1000 Hz,
+                200 reports; five reports arrive 0.8 ms late, right before
+                the next one.  Expected: 5 coalesced, 5 "dropped" (the
+                1.8 ms gaps), no delivery delay.  A second device sends 10
+                reports.
+
+Run from this directory; the output is checked in.
+"""
+import os
+
+HEADER = "receive_ns,source_ns,device,dx,dy"
+MS = 1000000
+
+def evdev():
+    device, t0 = 3392, 5000 * MS
+    first = [t0 + i * MS for i in range(500) if i not in (250, 251)]
+    start = first[-1] + 300 * MS
+    second = [start + i * MS for i in range(300)]
+    rows = ["# source_resolution_ns=1000", HEADER]
+    for burst in (first, second):
+        for b in range(0, len(burst), 4):
+            batch = burst[b:b + 4]
+            # read 150 us after the batch's last report; the receive clock
+            # runs 7 ms ahead of the kernel's
+            receive = batch[-1] + 150000 + 7 * MS
+            rows += [f"{receive},{s},{device},3,-1" for s in batch]
+    return rows
+
+def windows():
+    device, other, t0 = 65599, 131203, 900 * MS
+    rows = ["# source_resolution_ns=0", HEADER]
+    late = (40, 80, 120, 160, 190)
+    for i in range(200):
+        receive = t0 + i * MS + (800000 if i in late else 0)
+        rows.append(f"{receive},0,{device},-2,1")
+        if i % 20 == 0:
+            rows.append(f"{receive + 300000},0,{other},1,0")
+    return rows
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    for name, rows in (("evdev.csv", evdev()), ("windows.csv", windows())):
+        with open(os.path.join(here, name), "w", newline="") as f:
+            f.write("\n".join(rows) + "\n")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Writes the topology fixtures used by tests/topology_test.cpp.
+
+Each SKU gets the two inputs the decoders accept, laid out the way the OS
+reports that part:
+
+  <sku>/slpi.bin   GetLogicalProcessorInformationEx(RelationAll) buffer (x64),
+                   Windows CPU numbering (SMT siblings adjacent)
+  <sku>/sysfs/     the files `LatencyProbe topology --capture DIR` copies,
+                   Linux CPU numbering (siblings in the upper half, except
+                   on the hybrid part)
+
+  hybrid-12700k   Alder Lake: 8 P-cores with SMT + 4 E-cores sharing one L2
+  ryzen-5950x     two CCDs of 8 cores with SMT, one L3 per CCD
+  xeon-2x18       two sockets of 18 cores with SMT (72 CPUs): two NUMA nodes,
+                  two processor groups on Windows, CPUs 64-71 in group 1 on Linux
+
+Run from this directory; the output is checked in.
+"""
+import os
+import shutil
+import struct
+
+# ─── Model ──────────────────────────────────────────────────────────────────
+# A SKU is a list of cores: (package, efficiency class, threads, L2 id, L3 id);
+# numbering below turns it into CPU numbers for each OS.
+
+def hybrid_12700k():
+    cores = [(0, 1, 2, f"p{i}", "l3") for i in range(8)]
+    cores += [(0, 0, 1, "ecluster", "l3") for _ in range(4)]
+    caches = {**{f"p{i}": (2, 1280 << 10) for i in range(8)},
+              "ecluster": (2, 2 << 20), "l3": (3, 25 << 20)}
+    return cores, caches
+
+def ryzen_5950x():
+    cores = [(0, 0, 2, f"c{i}", f"ccd{i // 8}") for i in range(16)]
+    caches = {**{f"c{i}": (2, 512 << 10) for i in range(16)},
+              "ccd0": (3, 32 << 20), "ccd1": (3, 32 << 20)}
+    return cores, caches
+
+def xeon_2x18():
+    cores = [(p, 0, 2, f"s{p}c{i}", f"s{p}") for p in range(2) for i in range(18)]
+    caches = {**{f"s{p}c{i}": (2, 1280 << 10) for p in range(2) for i in range(18)},
+              "s0": (3, 24 << 20), "s1": (3, 24 << 20)}
+    return cores, caches
+
+def windows_numbering(cores):
+    """CPU numbers per core: threads adjacent, one group per package when
+    the machine has more than 64 CPUs.  Returns [(group, [bits])]."""
+    total = sum(c[2] for c in cores)
+    out, bit, group, package = [], 0, 0, cores[0][0]
+    for c in cores:
+        if total > 64 and c[0] != package:
+            group, bit, package = group + 1, 0, c[0]
+        out.append((group, list(range(bit, bit + c[2]))))
+        bit += c[2]
+    return out
+
+def linux_numbering(cores, adjacent):
+    """Primary threads first in core order, then the SMT siblings; Intel
+    hybrid parts number siblings adjacently instead."""
+    if adjacent:
+        return [bits for _, bits in windows_numbering(cores)]
+    out, n = [], 0
+    for c in cores:
+        out.append([n])
+        n += 1
+    for i, c in enumerate(cores):
+        for _ in range(c[2] - 1):
+            out[i].append(n)
+            n += 1
+    return out
+
+# ─── SLPI_EX ────────────────────────────────────────────────────────────────
+
+def affinity(group, mask):
+    return struct.pack("<QH6x", mask, group)
+
+def masks_of(bits_by_group):
+    return b"".join(affinity(g, sum(1 << b for b in bits)) for g, bits in sorted(bits_by_group.items()))
+
+def record(rel, body):
+    return struct.pack("<II", rel, 8 + len(body)) + body
+
+def processor(eff, bits_by_group):
+    return struct.pack("<BB20xH", 0, eff, len(bits_by_group)) + masks_of(bits_by_group)
+
+def cache(level, size, ctype, bits_by_group):
+    return struct.pack("<BBHII18xH", level, 8, 64, size, ctype, len(bits_by_group)) + masks_of(bits_by_group)
+
+def numa(node, bits_by_group):
+    return struct.pack("<I18xH", node, len(bits_by_group)) + masks_of(bits_by_group)
+
+def write_slpi(path, cores, caches):
+    numbering = windows_numbering(cores)
+    groups = {}
+    for g, bits in numbering:
+        groups.setdefault(g, []).extend(bits)
+
+    def collect(pred):
+        by_group = {}
+        for c, (g, bits) in zip(cores, numbering):
+            if pred(c):
+                by_group.setdefault(g, []).extend(bits)
+        return by_group
+
+    out = b""
+    for c, (g, bits) in zip(cores, numbering):
+        out += record(0, processor(c[1], {g: bits}))
+        # L1 data and instruction caches: decoded and ignored
+        out += record(2, cache(1, 48 << 10, 2, {g: bits}))
+        out += record(2, cache(1, 32 << 10, 1, {g: bits}))
+    packages = sorted({c[0] for c in cores})
+    for p in packages:
+        out += record(1, numa(p, collect(lambda c: c[0] == p)))
+    for cid, (level, size) in caches.items():
+        out += record(2, cache(level, size, 0, collect(lambda c: c[3] == cid or c[4] == cid)))
+    for p in packages:
+        out += record(3, processor(0, collect(lambda c: c[0] == p)))
+    info = b"".join(struct.pack("<BB38xQ", 64, len(bits), sum(1 << b for b in bits))
+                    for _, bits in sorted(groups.items()))
+    out += record(4, struct.pack("<HH20x", len(groups), len(groups)) + info)
+    with open(path, "wb") as f:
+        f.write(out)
+
+# ─── sysfs ──────────────────────────────────────────────────────────────────
+
+def cpulist(cpus):
+    cpus, parts, i = sorted(cpus), [], 0
+    while i < len(cpus):
+        j = i
+        while j + 1 < len(cpus) and cpus[j + 1] == cpus[j] + 1:
+            j += 1
+        parts.append(str(cpus[i]) if i == j else f"{cpus[i]}-{cpus[j]}")
+        i = j + 1
+    return ",".join(parts)
+
+def put(root, rel, text):
+    path = os.path.join(root, rel)
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "w") as f:
+        f.write(text + "\n")
+
+def write_sysfs(root, cores, caches):
+    hybrid = any(c[1] != cores[0][1] for c in cores)
+    numbering = linux_numbering(cores, hybrid)
+    total = sum(len(n) for n in numbering)
+    base = "sys/devices/system/cpu"
+    put(root, f"{base}/online", f"0-{total - 1}")
+
+    def cpus_of(pred):
+        return [cpu for c, n in zip(cores, numbering) if pred(c) for cpu in n]
+
+    core_ids = {}
+    for c, n in zip(cores, numbering):
+        core_id = core_ids.setdefault(c[0], 0)
+        core_ids[c[0]] += 4 if c[1] == 1 else 1   # P-core ids step by 4 on Alder Lake
+        for cpu in n:
+            d = f"{base}/cpu{cpu}"
+            put(root, f"{d}/topology/physical_package_id", str(c[0]))
+            put(root, f"{d}/topology/die_id", "0")
+            put(root, f"{d}/topology/core_id", str(core_id))
+            put(root, f"{d}/topology/thread_siblings_list", cpulist(n))
+            for index, cid in ((2, c[3]), (3, c[4])):
+                level, size = caches[cid]
+                shared = cpus_of(lambda o: o[3] == cid or o[4] == cid)
+                put(root, f"{d}/cache/index{index}/level", str(level))
+                put(root, f"{d}/cache/index{index}/type", "Unified")
+                put(root, f"{d}/cache/index{index}/size", f"{size >> 10}K")
+                put(root, f"{d}/cache/index{index}/shared_cpu_list", cpulist(shared))
+    for p in sorted({c[0] for c in cores}):
+        put(root, f"sys/devices/system/node/node{p}/cpulist", cpulist(cpus_of(lambda c: c[0] == p)))
+    if hybrid:
+        put(root, "sys/devices/cpu_core/cpus", cpulist(cpus_of(lambda c: c[1] == 1)))
+        put(root, "sys/devices/cpu_atom/cpus", cpulist(cpus_of(lambda c: c[1] == 0)))
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    for name, sku in (("hybrid-12700k", hybrid_12700k), ("ryzen-5950x", ryzen_5950x), ("xeon-2x18", xeon_2x18)):
+        cores, caches = sku()
+        d = os.path.join(here, name)
+        shutil.rmtree(d, ignore_errors=True)
+        os.makedirs(d)
+        write_slpi(os.path.join(d, "slpi.bin"), cores, caches)
+        write_sysfs(os.path.join(d, "sysfs"), cores, caches)
+
+if __name__ == "__main__":
+    main()
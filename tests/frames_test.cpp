@@ -0,0 +1,129 @@
+#include "test_util.h"
+#include "bench/frame_analyzer.h"
+
+#include <string>
+
+// frame_analyzer against the fixtures in tests/data/frames: one capture per
+// PresentMon column set, with the expected values worked out in
+// make_fixtures.py.
+
+using namespace frame_analyzer;
+
+static bool Load(const std::string& path, const std::string& app, Capture& cap)
+{
+    std::string error;
+    bool ok = LoadCsv(path, app, cap, error);
+    if (!ok) std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+    return ok;
+}
+
+// ─── Classic columns ─────────────────────────────────────────────────────────
+
+static void CheckClassic(const std::string& path)
+{
+    Capture cap;
+    if (!Load(path, "", cap)) { CHECK(!"classic.csv"); return; }
+
+    // game.exe has the most frames; dwm.exe rows are interleaved
+    CHECK(cap.application == "game.exe");
+    Stats s = Analyze(cap);
+    CHECK_EQ(s.frames, 1000u);
+    CHECK_NEAR(s.durationS, 10.2, 1e-6);
+    CHECK_NEAR(s.avgFps, 1000.0 / 10.2, 1e-3);
+    CHECK_NEAR(s.p50Ms, 10.0, 1e-6);
+    CHECK_NEAR(s.p90Ms, 10.0, 1e-6);
+    CHECK_NEAR(s.p99Ms, 10.1, 1e-4);
+    CHECK_NEAR(s.p999Ms, 40.0, 1e-6);
+    CHECK_NEAR(s.maxMs, 40.0, 1e-6);
+    CHECK_NEAR(s.low1Fps, 1000.0 / 30.0, 1e-3);
+    CHECK_NEAR(s.low01Fps, 25.0, 1e-6);
+    CHECK_EQ(s.stutters, 5u);
+    CHECK_EQ(s.dropped, 4u);
+    CHECK(s.hasDisplay);
+    CHECK_NEAR(s.displayP50Ms, 14.0, 1e-6);
+    CHECK_NEAR(s.displayP99Ms, 16.0, 1e-6);
+
+    // A lower stutter factor also catches the 20 ms frames
+    CHECK_EQ(Analyze(cap, 1.5).stutters, 10u);
+
+    Capture dwm;
+    if (!Load(path, "DWM.EXE", dwm)) { CHECK(!"classic.csv --app dwm.exe"); return; }
+    Stats d = Analyze(dwm);
+    CHECK_EQ(d.frames, 100u);
+    CHECK_NEAR(d.p50Ms, 16.5, 1e-4);
+    CHECK_EQ(d.stutters, 0u);
+    CHECK_EQ(d.dropped, 0u);
+
+    std::string error;
+    CHECK(!LoadCsv(path, "missing.exe", dwm, error) && !error.empty());
+}
+
+// ─── PresentMon 2.x columns ──────────────────────────────────────────────────
+
+static void CheckPm2(const std::string& path)
+{
+    Capture cap;
+    if (!Load(path, "", cap)) { CHECK(!"pm2.csv"); return; }
+
+    CHECK(cap.application == "game.exe");
+    Stats s = Analyze(cap);
+    CHECK_EQ(s.frames, 600u);
+    CHECK_NEAR(s.durationS, 4.896, 1e-6);
+    CHECK_NEAR(s.avgFps, 600.0 / 4.896, 1e-3);
+    CHECK_NEAR(s.p50Ms, 8.0, 1e-6);
+    CHECK_NEAR(s.p90Ms, 8.0, 1e-6);
+    CHECK_NEAR(s.p99Ms, 8.08, 1e-4);
+    CHECK_NEAR(s.p999Ms, 32.0, 1e-6);
+    CHECK_NEAR(s.maxMs, 32.0, 1e-6);
+    CHECK_NEAR(s.low1Fps, 1000.0 / 24.0, 1e-3);
+    CHECK_NEAR(s.low01Fps, 31.25, 1e-6);
+    CHECK_EQ(s.stutters, 3u);
+    CHECK_EQ(s.dropped, 6u);   // DisplayLatency "NA"
+    CHECK(s.hasDisplay);
+    CHECK_EQ(cap.displayLatencyMs.size(), 594u);
+    CHECK_NEAR(s.displayP50Ms, 12.0, 1e-6);
+    CHECK_NEAR(s.displayP99Ms, 14.0, 1e-6);
+}
+
+// ─── Comparison and malformed input ──────────────────────────────────────────
+
+static void CheckCompare(const std::string& dir)
+{
+    Capture classic, pm2;
+    if (!Load(dir + "/classic.csv", "", classic) || !Load(dir + "/pm2.csv", "", pm2)) return;
+
+    Comparison same = Compare(classic, classic);
+    CHECK(!same.frameTimeShift && !same.displayLatencyShift);
+
+    // 10 ms vs 8 ms frames: a shift in every rank
+    Comparison faster = Compare(classic, pm2);
+    CHECK(faster.frameTimeShift);
+    CHECK(faster.frameTime.effect < 0.0);
+}
+
+static void CheckRejects()
+{
+    Capture cap;
+    std::string error;
+    const std::string notPresentMon = "a,b\n1,2\n";
+    CHECK(!ParseCsv(notPresentMon.data(), notPresentMon.size(), "", cap, error) && !error.empty());
+    const std::string headerOnly = "Application,MsBetweenPresents\r\n";
+    CHECK(!ParseCsv(headerOnly.data(), headerOnly.size(), "", cap, error));
+    CHECK(!ParseCsv("", 0, "", cap, error));
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: frames_test <tests/data/frames>\n");
+        return 2;
+    }
+    const std::string dir = argv[1];
+
+    CheckClassic(dir + "/classic.csv");
+    CheckPm2(dir + "/pm2.csv");
+    CheckCompare(dir);
+    CheckRejects();
+    return test_util::Finish("frames_test");
+}
@@ -0,0 +1,131 @@
+#include "test_util.h"
+#include "bench/input_analyzer.h"
+
+#include <cstdio>
+#include <string>
+
+// input_analyzer against the recordings in tests/data/input, with the
+// expected values worked out in make_fixtures.py.
+
+using namespace input_analyzer;
+
+static bool Load(const std::string& path, Recording& rec)
+{
+    std::string error;
+    bool ok = LoadCsv(path, rec, error);
+    if (!ok) std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+    return ok;
+}
+
+// ─── Linux evdev ─────────────────────────────────────────────────────────────
+
+static void CheckEvdev(const std::string& path)
+{
+    Recording rec;
+    if (!Load(path, rec)) { CHECK(!"evdev.csv"); return; }
+    CHECK_EQ(rec.sourceResolutionNs, 1000u);
+
+    // Timed on the kernel stamps: the batches of four sharing one receive
+    // time are not coalesced
+    Analysis a = Analyze(rec);
+    CHECK_EQ(a.device, 3392u);
+    CHECK_EQ(a.reports, 798u);
+    CHECK_EQ(a.bursts, 2u);
+    CHECK_EQ(a.nominalNs, 1000000u);
+    CHECK_NEAR(a.effectiveHz, 1000.0, 1e-6);
+    CHECK_EQ(a.droppedReports, 2u);
+    CHECK_EQ(a.coalesced, 0u);
+    CHECK_EQ(a.intervals.Count(), 796u);
+    CHECK_EQ(a.intervals.Min(), 1000000u);
+    CHECK_EQ(a.intervals.Max(), 3000000u);
+
+    // Delivery: the first report of a batch waits for the other three
+    CHECK_EQ(a.deliveryDelay.Count(), 798u);
+    CHECK_EQ(a.deliveryDelay.Min(), 0u);
+    CHECK_EQ(a.deliveryDelay.Max(), 5000000u);
+    CHECK_NEAR(a.deliveryDelay.Mean(), 1502506.3, 1.0);
+
+    // A shorter idle gap splits at the missing reports too
+    Config cfg;
+    cfg.idleGapNs = 2000000;
+    CHECK_EQ(Analyze(rec, cfg).bursts, 3u);
+
+    // Coarse source stamps fall back to the receive times, where the
+    // batches do read as coalesced, and give no delivery delay
+    rec.sourceResolutionNs = 15625000;
+    a = Analyze(rec);
+    CHECK(a.coalesced > 500u);
+    CHECK_EQ(a.deliveryDelay.Count(), 0u);
+}
+
+// ─── Windows raw input ───────────────────────────────────────────────────────
+
+static void CheckWindows(const std::string& path)
+{
+    Recording rec;
+    if (!Load(path, rec)) { CHECK(!"windows.csv"); return; }
+    CHECK_EQ(rec.sourceResolutionNs, 0u);
+    CHECK_EQ(rec.reports.size(), 210u);
+
+    Analysis a = Analyze(rec);
+    CHECK_EQ(a.device, 65599u);
+    CHECK_EQ(a.reports, 200u);
+    CHECK_EQ(a.bursts, 1u);
+    CHECK_EQ(a.nominalNs, 1000000u);
+    CHECK_EQ(a.coalesced, 5u);
+    CHECK_EQ(a.droppedReports, 5u);
+    CHECK_EQ(a.intervals.Min(), 200000u);
+    CHECK_EQ(a.intervals.Max(), 1800000u);
+    CHECK_EQ(a.deliveryDelay.Count(), 0u);
+
+    // The other device, picked explicitly: one report every 20 ms
+    Config cfg;
+    cfg.device = 131203;
+    a = Analyze(rec, cfg);
+    CHECK_EQ(a.reports, 10u);
+    CHECK_EQ(a.nominalNs, 20000000u);
+    CHECK_EQ(a.coalesced, 0u);
+
+    cfg.device = 1;
+    CHECK_EQ(Analyze(rec, cfg).reports, 0u);
+}
+
+// ─── CSV round trip and malformed input ──────────────────────────────────────
+
+static void CheckRoundTrip(const std::string& path, const std::string& copy)
+{
+    Recording rec, back;
+    if (!Load(path, rec)) return;
+    rec.reports[0].dx = -7;
+    CHECK(SaveCsv(copy, rec));
+    if (!Load(copy, back)) { CHECK(!"round trip"); return; }
+    std::remove(copy.c_str());
+
+    CHECK_EQ(back.sourceResolutionNs, rec.sourceResolutionNs);
+    CHECK_EQ(back.reports.size(), rec.reports.size());
+    for (std::size_t i = 0; i < rec.reports.size() && i < back.reports.size(); ++i)
+    {
+        const InputReport& x = rec.reports[i];
+        const InputReport& y = back.reports[i];
+        CHECK(x.receiveNs == y.receiveNs && x.sourceNs == y.sourceNs && x.device == y.device &&
+              x.dx == y.dx && x.dy == y.dy);
+    }
+
+    std::string error;
+    CHECK(!LoadCsv(path + ".missing", back, error) && !error.empty());
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: input_test <tests/data/input>\n");
+        return 2;
+    }
+    const std::string dir = argv[1];
+
+    CheckEvdev(dir + "/evdev.csv");
+    CheckWindows(dir + "/windows.csv");
+    CheckRoundTrip(dir + "/evdev.csv", "input_test-roundtrip.csv");
+    return test_util::Finish("input_test");
+}
@@ -0,0 +1,152 @@
+#include "test_util.h"
+#include "bench/interrupt_manager.h"
+#include "bench/registry_access.h"
+
+#include <cctype>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// interrupt_manager against tests/data/registry/enum-pci.reg, a `reg export`
+// of Enum\PCI loaded into MemoryRegistry:
+//
+//   GPU      present, MSI key with MSISupported=0, no Affinity Policy
+//   NIC      present, MSI with limit 4, DevicePriority normal
+//   SMBus    present, no MSI key (driver does not declare MSI)
+//   xHCI     stale instance (no Control key), MSI
+
+using namespace interrupt_manager;
+
+static const char* kGpu   = "PCI\\VEN_10DE&DEV_2684&SUBSYS_16F310DE&REV_A1\\4&2283f625&0&0019";
+static const char* kNic   = "PCI\\VEN_8086&DEV_15F3&SUBSYS_86721043&REV_03\\3&11583659&0&E8";
+static const char* kSmbus = "PCI\\VEN_8086&DEV_7A23&SUBSYS_86941043&REV_11\\3&11583659&0&FC";
+
+// BackupSet is keyed by the upper-case instance id
+static std::string BackupKey(std::string id)
+{
+    for (char& c : id) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return id;
+}
+
+static DeviceInfo Read(const registry_access::Registry& reg, const char* id)
+{
+    DeviceInfo d;
+    CHECK(ReadDevice(reg, id, d));
+    return d;
+}
+
+static void CheckList(const registry_access::Registry& reg)
+{
+    std::vector<DeviceInfo> devices = ListDevices(reg);
+    CHECK_EQ(devices.size(), 4u);
+
+    DeviceInfo gpu = Read(reg, kGpu);
+    CHECK(gpu.present && gpu.msiCapable && !gpu.msiEnabled);
+    CHECK(gpu.className == "Display" && gpu.description == "NVIDIA GeForce RTX 4090");
+    CHECK(gpu.priority == Priority::Undefined);
+
+    DeviceInfo nic = Read(reg, kNic);
+    CHECK(nic.present && nic.msiEnabled && nic.messageLimit == 4u && nic.priority == Priority::Normal);
+    CHECK(ModeName(nic) == "MSI (limit 4)");
+
+    DeviceInfo smbus = Read(reg, kSmbus);
+    CHECK(smbus.present && !smbus.msiCapable && !smbus.msiEnabled);
+
+    std::size_t stale = 0;
+    for (const auto& d : devices) stale += !d.present;
+    CHECK_EQ(stale, 1u);
+}
+
+static void CheckApplyRestore(registry_access::MemoryRegistry& reg, const std::string& backupPath)
+{
+    const std::string original = reg.Format();
+    std::vector<DeviceInfo> present;
+    for (const auto& d : ListDevices(reg))
+        if (d.present) present.push_back(d);
+    CHECK_EQ(present.size(), 3u);
+
+    // Bulk: MSI on with high priority.  The SMBus controller does not
+    // declare MSI, so it fails and is left untouched.
+    Setting s;
+    s.msi      = true;
+    s.priority = Priority::High;
+    BackupSet backups;
+    for (const auto& r : ApplyAll(reg, present, s, backups))
+        CHECK_EQ(r.ok, r.instanceId != kSmbus);
+    CHECK_EQ(backups.size(), 2u);
+    CHECK(!reg.KeyExists(MsiKey(kSmbus)));
+
+    CHECK_EQ(reg.ReadDword(MsiKey(kGpu), "MSISupported").value_or(99), 1u);
+    CHECK(reg.KeyExists(PolicyKey(kGpu)));   // created
+    CHECK_EQ(reg.ReadDword(PolicyKey(kGpu), "DevicePriority").value_or(99), 3u);
+    CHECK_EQ(reg.ReadDword(MsiKey(kNic), "MessageNumberLimit").value_or(99), 4u);   // unset: left alone
+    CHECK_EQ(reg.ReadDword(PolicyKey(kNic), "DevicePriority").value_or(99), 3u);
+    CHECK(Matches(Read(reg, kGpu), s) && Matches(Read(reg, kNic), s));
+
+    // Forced MSI with a vector cap creates the SMBus MSI key
+    Setting forced;
+    forced.msi          = true;
+    forced.force        = true;
+    forced.messageLimit = 1;
+    std::string error;
+    CHECK(Apply(reg, Read(reg, kSmbus), forced, backups, error));
+    CHECK_EQ(reg.ReadDword(MsiKey(kSmbus), "MSISupported").value_or(99), 1u);
+    CHECK_EQ(reg.ReadDword(MsiKey(kSmbus), "MessageNumberLimit").value_or(99), 1u);
+
+    // A second change keeps the first originals
+    Setting low;
+    low.msi      = false;
+    low.priority = Priority::Low;
+    CHECK(Apply(reg, Read(reg, kNic), low, backups, error));
+    const DeviceBackup& nicBackup = backups.at(BackupKey(kNic));
+    CHECK(nicBackup.msiKey && nicBackup.policyKey);
+    CHECK_EQ(nicBackup.msiSupported.value_or(99), 1u);
+    CHECK_EQ(nicBackup.priority.value_or(99), 2u);
+    const DeviceBackup& gpuBackup = backups.at(BackupKey(kGpu));
+    CHECK(gpuBackup.msiKey && !gpuBackup.policyKey && !gpuBackup.priority);
+
+    // Backups and the edited export survive a save / load
+    CHECK(SaveBackups(backupPath, backups, error));
+    BackupSet loaded;
+    CHECK(LoadBackups(backupPath, loaded, error));
+    CHECK_EQ(loaded.size(), 3u);
+    const DeviceBackup& gpuLoaded = loaded.at(BackupKey(kGpu));
+    CHECK(gpuLoaded.msiSupported == gpuBackup.msiSupported && !gpuLoaded.policyKey);
+    std::remove(backupPath.c_str());
+
+    registry_access::MemoryRegistry copy;
+    CHECK(copy.Parse(reg.Format(), error));
+    CHECK(copy.Format() == reg.Format());
+
+    // Restore: values back, keys Apply created removed
+    for (const auto& r : RestoreAll(reg, loaded)) CHECK(r.ok);
+    CHECK(loaded.empty());
+    CHECK(!reg.KeyExists(PolicyKey(kGpu)));
+    CHECK(!reg.KeyExists(MsiKey(kSmbus)));
+    CHECK_EQ(reg.ReadDword(MsiKey(kGpu), "MSISupported").value_or(99), 0u);
+    CHECK_EQ(reg.ReadDword(PolicyKey(kNic), "DevicePriority").value_or(99), 2u);
+    CHECK_EQ(reg.ReadDword(MsiKey(kNic), "MessageNumberLimit").value_or(99), 4u);
+    CHECK(reg.Format() == original);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: interrupts_test <tests/data/registry>\n");
+        return 2;
+    }
+    const std::string dir = argv[1];
+
+    registry_access::MemoryRegistry reg;
+    std::string error;
+    if (!reg.Load(dir + "/enum-pci.reg", error))
+    {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        CHECK(!"enum-pci.reg");
+        return test_util::Finish("interrupts_test");
+    }
+    CheckList(reg);
+    CheckApplyRestore(reg, "interrupts_test-backup.txt");
+    return test_util::Finish("interrupts_test");
+}
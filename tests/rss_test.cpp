@@ -0,0 +1,226 @@
+#include "test_util.h"
+#include "topology_fixtures.h"
+#include "bench/affinity_planner.h"
+#include "bench/machine_profile.h"
+#include "bench/rss_planner.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+// rss_planner::Build against the fixtures in tests/data/topology, with the
+// driver capabilities spelled out per case instead of read from Ndi\params.
+
+using namespace rss_planner;
+using topology_fixtures::LoadRaw;
+using topology_fixtures::LoadSysfs;
+
+// A driver exposing every RSS keyword: queues 1/2/4/8, all five profiles.
+static Capabilities FullDriver()
+{
+    Capabilities c;
+    c.supported = c.enabled = true;
+    c.hasBase = c.hasMaxProcessors = c.hasQueues = c.hasProfile = c.hasMaxProcNumber = true;
+    c.queueOptions = { 1, 2, 4, 8 };
+    c.queues = 8;
+    c.maxProcessors = 8;
+    c.maxProcessorsLimit = 64;
+    c.profiles = { 1, 2, 3, 4, 5 };
+    c.profile = 1;
+    return c;
+}
+
+// Realtek-style: *RSS and *NumRssQueues only.
+static Capabilities QueuesOnlyDriver()
+{
+    Capabilities c;
+    c.supported = c.enabled = c.hasQueues = true;
+    c.queueOptions = { 1, 2, 4 };
+    c.queues = 2;
+    return c;
+}
+
+static const std::string* Value(const Plan& p, const std::string& name)
+{
+    for (const auto& [k, v] : p.values)
+        if (k == name) return &v;
+    return nullptr;
+}
+
+static Request DefaultRequest(const cpu_topology::Topology& t)
+{
+    Request req;
+    req.gameCpus = affinity_planner::GameCpus(t, machine_profile::Profile{});
+    return req;
+}
+
+// Every window CPU is a primary thread in group 0 whose core holds no game
+// CPU; with `avoidCore0` the core of CPU 0 is left out too.
+static void CheckWindow(const cpu_topology::Topology& t, const Plan& p, const Request& req, bool avoidCore0)
+{
+    std::set<uint32_t> gameCores;
+    for (uint32_t cpu : req.gameCpus) gameCores.insert(t.Find(cpu)->core);
+    for (uint32_t cpu : p.cpus)
+    {
+        const cpu_topology::Cpu* c = t.Find(cpu);
+        CHECK(c && c->group == 0);
+        if (!c) continue;
+        CHECK(!gameCores.count(c->core));
+        CHECK(t.cores[c->core].cpus.front() == cpu);
+        if (avoidCore0) CHECK(c->core != t.Find(0)->core);
+    }
+    CHECK_EQ(p.maxProcessors, static_cast<uint32_t>(p.cpus.size()));
+    if (!p.cpus.empty()) CHECK_EQ(p.base, t.Find(p.cpus.front())->number);
+}
+
+// ─── Windows numbering: the SLPI_EX captures ─────────────────────────────────
+
+static void CheckHybrid(const cpu_topology::Topology& t)
+{
+    Request req = DefaultRequest(t);
+    Plan p = Build(t, FullDriver(), req);
+    CHECK(p.ok);
+    CheckWindow(t, p, req, true);
+    // P-cores 5-7 and the first E-core: four cores, most of them P
+    CHECK(p.cpus == (std::vector<uint32_t>{ 10, 12, 14, 16 }));
+    CHECK_EQ(p.base, 10u);
+    CHECK_EQ(p.maxProcNumber, 16u);
+    CHECK_EQ(p.queues, 4u);
+    CHECK_EQ(p.profile, 2u);
+    CHECK(Value(p, "*RSSBaseProcNumber") && *Value(p, "*RSSBaseProcNumber") == "10");
+    CHECK(Value(p, "*NumRssQueues") && *Value(p, "*NumRssQueues") == "4");
+    CHECK(!Value(p, "*RSS"));   // already enabled
+
+    // Queue counts snap down to an allowed one that fits the window
+    Capabilities caps = FullDriver();
+    caps.queueOptions = { 1, 3, 8 };
+    p = Build(t, caps, req);
+    CHECK(p.ok && p.queues == 3u && p.maxProcessors == 4u);
+
+    caps.queueOptions = { 8, 16 };
+    p = Build(t, caps, req);
+    CHECK(p.ok && p.queues == 8u && !p.notes.empty());
+
+    // The processor limit shrinks the window; of the all-P windows the
+    // highest wins
+    caps = FullDriver();
+    caps.maxProcessorsLimit = 2;
+    p = Build(t, caps, req);
+    CHECK(p.ok && p.cpus == (std::vector<uint32_t>{ 12, 14 }) && p.queues == 2u);
+
+    // Profiles: ClosestProcessorStatic, else NUMAScalingStatic, else keep
+    caps = FullDriver();
+    caps.profiles = { 1, 3, 4 };
+    CHECK_EQ(Build(t, caps, req).profile, 4u);
+    caps.profiles = { 1, 3 };
+    p = Build(t, caps, req);
+    CHECK(p.ok && p.profile == 0u && !Value(p, "*RSSProfile"));
+    caps.hasProfile = false;
+    CHECK_EQ(Build(t, caps, req).profile, 0u);
+
+    // Disabled RSS is switched on
+    caps = FullDriver();
+    caps.enabled = false;
+    p = Build(t, caps, req);
+    CHECK(Value(p, "*RSS") && *Value(p, "*RSS") == "1");
+
+    // No base: the driver's window stays at CPU 0 and is cut before core 1
+    p = Build(t, QueuesOnlyDriver(), req);
+    CHECK(p.ok);
+    CHECK(p.cpus == std::vector<uint32_t>{ 0 });
+    CHECK_EQ(p.queues, 1u);
+    CHECK_EQ(p.values.size(), 1u);
+    CHECK(Value(p, "*NumRssQueues") && *Value(p, "*NumRssQueues") == "1");
+    CheckWindow(t, p, req, false);
+
+    // ... or at the base it already has
+    caps = QueuesOnlyDriver();
+    caps.baseProc = 10;
+    p = Build(t, caps, req);
+    CHECK(p.ok && p.cpus == (std::vector<uint32_t>{ 10, 12, 14, 16 }) && p.queues == 4u);
+
+    // ... and is left alone when the base core is a game core, no limit is
+    // exposed, or the smallest queue count would spill onto game cores
+    caps.baseProc = 2;
+    CHECK(!Build(t, caps, req).ok);
+    caps = QueuesOnlyDriver();
+    caps.hasQueues = false;
+    caps.queueOptions.clear();
+    CHECK(!Build(t, caps, req).ok);
+    caps = QueuesOnlyDriver();
+    caps.queueOptions = { 2, 4 };
+    p = Build(t, caps, req);
+    CHECK(!p.ok && p.values.empty());
+
+    // No room: every core holds a game thread
+    Request all;
+    for (const auto& c : t.cpus) all.gameCpus.push_back(c.index);
+    p = Build(t, FullDriver(), all);
+    CHECK(!p.ok && p.values.empty() && !p.notes.empty());
+
+    Capabilities none;
+    CHECK(!Build(t, none, req).ok);
+}
+
+static void CheckRyzen(const cpu_topology::Topology& t)
+{
+    Request req = DefaultRequest(t);
+    Plan p = Build(t, FullDriver(), req);
+    CHECK(p.ok);
+    CheckWindow(t, p, req, true);
+    CHECK_EQ(p.cpus.size(), 4u);
+    CHECK_EQ(p.queues, 4u);
+    // The top of the CPU range: the last four cores of the second CCD
+    CHECK(t.Find(p.cpus.front())->core == 12u);
+}
+
+static void CheckXeon(const cpu_topology::Topology& t)
+{
+    // The default game set covers every group-0 core but core 0
+    Request req = DefaultRequest(t);
+    Plan p = Build(t, FullDriver(), req);
+    CHECK(p.ok);
+    CheckWindow(t, p, req, false);
+    CHECK(p.cpus == std::vector<uint32_t>{ 0 });
+    CHECK_EQ(p.queues, 1u);
+
+    // Game on socket 0's upper cores: the window stays in group 0
+    Request socket0;
+    for (const auto& c : t.cpus)
+        if (c.group == 0 && t.cores[c.core].cpus.front() >= 8) socket0.gameCpus.push_back(c.index);
+    p = Build(t, FullDriver(), socket0);
+    CHECK(p.ok);
+    CheckWindow(t, p, socket0, true);
+    CHECK_EQ(p.cpus.size(), 3u);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: rss_test <tests/data/topology>\n");
+        return 2;
+    }
+    const std::string dir = argv[1];
+    cpu_topology::Topology t;
+
+    if (LoadRaw(dir + "/hybrid-12700k/slpi.bin", t)) CheckHybrid(t);
+    else CHECK(!"hybrid-12700k slpi.bin");
+    if (LoadRaw(dir + "/ryzen-5950x/slpi.bin", t)) CheckRyzen(t);
+    else CHECK(!"ryzen-5950x slpi.bin");
+    if (LoadRaw(dir + "/xeon-2x18/slpi.bin", t)) CheckXeon(t);
+    else CHECK(!"xeon-2x18 slpi.bin");
+
+    // Linux numbering moves siblings, not the plan's rules
+    if (LoadSysfs(dir + "/ryzen-5950x/sysfs", t))
+    {
+        Request req = DefaultRequest(t);
+        Plan p = Build(t, FullDriver(), req);
+        CHECK(p.ok);
+        CheckWindow(t, p, req, true);
+        CHECK_EQ(p.cpus.size(), 4u);
+    }
+    else CHECK(!"ryzen-5950x sysfs");
+
+    return test_util::Finish("rss_test");
+}
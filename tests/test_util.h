@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdio>
+#include <string>
+
+// Minimal checks for the ctest executables: each failed CHECK prints its
+// location and the test exits non-zero at the end.  No framework, so the
+// tests build wherever LatencyProbe does.
+namespace test_util {
+
+inline int& Failures()
+{
+    static int n = 0;
+    return n;
+}
+
+inline void Fail(const char* file, int line, const std::string& what)
+{
+    std::fprintf(stderr, "%s:%d: FAILED %s\n", file, line, what.c_str());
+    ++Failures();
+}
+
+inline int Finish(const char* name)
+{
+    if (Failures() == 0) std::printf("%s: all checks passed\n", name);
+    else std::fprintf(stderr, "%s: %d check(s) failed\n", name, Failures());
+    return Failures() == 0 ? 0 : 1;
+}
+
+} // namespace test_util
+
+#define CHECK(cond) \
+    do { if (!(cond)) test_util::Fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { if (!((a) == (b))) test_util::Fail(__FILE__, __LINE__, #a " == " #b " (got " + std::to_string(a) + ")"); } while (0)
+
+#define CHECK_NEAR(a, b, tol) \
+    do { double a_ = (a), b_ = (b); \
+         if (!(a_ - b_ <= (tol) && b_ - a_ <= (tol))) \
+             test_util::Fail(__FILE__, __LINE__, #a " ~= " #b " (got " + std::to_string(a_) + ")"); } while (0)
@@ -0,0 +1,32 @@
+#pragma once
+#include "test_util.h"
+#include "bench/cpu_topology.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Loaders for the captures in tests/data/topology, shared by the tests that
+// plan against them.
+namespace topology_fixtures {
+
+inline bool LoadRaw(const std::string& path, cpu_topology::Topology& t)
+{
+    std::ifstream f(path, std::ios::binary);
+    std::vector<char> raw((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    std::string error;
+    bool ok = !raw.empty() && cpu_topology::DecodeProcessorInformation(raw.data(), raw.size(), t, error);
+    if (!ok) std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+    return ok;
+}
+
+inline bool LoadSysfs(const std::string& root, cpu_topology::Topology& t)
+{
+    std::string error;
+    bool ok = cpu_topology::ParseSysfs(root, t, error);
+    if (!ok) std::fprintf(stderr, "%s: %s\n", root.c_str(), error.c_str());
+    return ok;
+}
+
+} // namespace topology_fixtures
@@ -0,0 +1,188 @@
+#include "test_util.h"
+#include "topology_fixtures.h"
+#include "bench/affinity_planner.h"
+#include "bench/cpu_topology.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// cpu_topology against the fixtures in tests/data/topology: each SKU as a
+// GetLogicalProcessorInformationEx buffer and as a sysfs capture.  The two
+// number SMT siblings differently, so numbering-dependent checks take the
+// expected CPUs as arguments.
+
+using namespace cpu_topology;
+using topology_fixtures::LoadRaw;
+using topology_fixtures::LoadSysfs;
+
+static std::size_t CountCaches(const Topology& t, uint8_t level)
+{
+    std::size_t n = 0;
+    for (const auto& c : t.caches) n += c.level == level;
+    return n;
+}
+
+// Every core's threads share one L2 holding exactly that core, except cores
+// of `clusterClass` when `haveCluster` (E-cores sharing an L2 per cluster).
+static void CheckPrivateL2(const Topology& t, uint8_t clusterClass, bool haveCluster)
+{
+    for (const auto& core : t.cores)
+    {
+        const Cpu* first = t.Find(core.cpus[0]);
+        CHECK(first && first->l2 >= 0);
+        if (!first || first->l2 < 0) continue;
+        for (uint32_t cpu : core.cpus) CHECK(t.Find(cpu)->l2 == first->l2);
+        if (!(haveCluster && core.efficiencyClass == clusterClass))
+            CHECK(t.caches[first->l2].cpus == core.cpus);
+    }
+}
+
+// ─── Alder Lake: 8 P-cores with SMT + 4 E-cores ──────────────────────────────
+
+static void CheckHybrid(const Topology& t)
+{
+    CHECK_EQ(t.cpus.size(), 20u);
+    CHECK_EQ(t.cores.size(), 12u);
+    CHECK(t.Smt());
+    CHECK(t.Hybrid());
+    CHECK_EQ(t.maxEfficiencyClass, 1);
+    CHECK_EQ(t.packages, 1u);
+    CHECK_EQ(t.numaNodes, 1u);
+    CHECK_EQ(t.groups, 1);
+
+    std::vector<uint32_t> perf = PrimaryThreads(t, true);
+    CHECK(perf == (std::vector<uint32_t>{ 0, 2, 4, 6, 8, 10, 12, 14 }));
+    CHECK_EQ(PrimaryThreads(t, false).size(), 12u);
+    for (const auto& core : t.cores)
+        CHECK_EQ(core.cpus.size(), core.efficiencyClass == 1 ? 2u : 1u);
+    for (uint32_t cpu = 16; cpu < 20; ++cpu) CHECK(t.Find(cpu) && t.Find(cpu)->efficiencyClass == 0);
+
+    CHECK(Siblings(t, 2) == std::vector<uint32_t>{ 3 });
+    CHECK(Siblings(t, 17).empty());
+
+    // Private L2 per P-core, one L2 for the E-core cluster, one L3 for all
+    CHECK_EQ(CountCaches(t, 2), 9u);
+    CHECK_EQ(CountCaches(t, 3), 1u);
+    CheckPrivateL2(t, 0, true);
+    const Cpu* e = t.Find(16);
+    CHECK(e && e->l2 >= 0 && t.caches[e->l2].cpus == (std::vector<uint32_t>{ 16, 17, 18, 19 }));
+    CHECK(t.Find(0)->l2 != e->l2);
+    for (const auto& c : t.cpus) CHECK(c.l3 == t.Find(0)->l3);
+
+    // P-cores 1-4 for the game, 5-7 (at most half of 1-7) for interrupts
+    std::vector<uint32_t> game;
+    for (uint32_t cpu = 2; cpu < 10; ++cpu) game.push_back(cpu);
+    CHECK(affinity_planner::DefaultGameCpus(t) == game);
+    CHECK(affinity_planner::GameCpus(t, machine_profile::Profile{}) == game);
+}
+
+// ─── Ryzen 9 5950X: two CCDs of 8 cores with SMT ─────────────────────────────
+
+static void CheckRyzen(const Topology& t, uint32_t siblingOf0)
+{
+    CHECK_EQ(t.cpus.size(), 32u);
+    CHECK_EQ(t.cores.size(), 16u);
+    CHECK(t.Smt());
+    CHECK(!t.Hybrid());
+    CHECK_EQ(t.groups, 1);
+    CHECK_EQ(t.packages, 1u);
+    for (const auto& core : t.cores) CHECK_EQ(core.cpus.size(), 2u);
+    CHECK(Siblings(t, 0) == std::vector<uint32_t>{ siblingOf0 });
+    CHECK_EQ(PrimaryThreads(t, true).size(), 16u);
+
+    CHECK_EQ(CountCaches(t, 2), 16u);
+    CHECK_EQ(CountCaches(t, 3), 2u);
+    CheckPrivateL2(t, 0, false);
+
+    // One L3 per CCD: cores 0-7 on the first, 8-15 on the second
+    int ccd0 = t.Find(t.cores[0].cpus[0])->l3, ccd1 = t.Find(t.cores[8].cpus[0])->l3;
+    CHECK(ccd0 >= 0 && ccd1 >= 0 && ccd0 != ccd1);
+    for (std::size_t i = 0; i < t.cores.size(); ++i)
+        for (uint32_t cpu : t.cores[i].cpus) CHECK(t.Find(cpu)->l3 == (i < 8 ? ccd0 : ccd1));
+    CHECK_EQ(t.caches[ccd0].cpus.size(), 16u);
+    CHECK_EQ(t.caches[ccd1].cpus.size(), 16u);
+}
+
+// ─── Two sockets of 18 cores with SMT: 72 CPUs, two groups ───────────────────
+
+static void CheckXeon(const Topology& t, uint32_t siblingOf0, uint32_t firstOfSocket1, uint32_t firstOfGroup1)
+{
+    CHECK_EQ(t.cpus.size(), 72u);
+    CHECK_EQ(t.cores.size(), 36u);
+    CHECK_EQ(t.packages, 2u);
+    CHECK_EQ(t.numaNodes, 2u);
+    CHECK_EQ(t.groups, 2);
+    CHECK(!t.Hybrid());
+    for (const auto& core : t.cores)
+    {
+        CHECK_EQ(core.cpus.size(), 2u);
+        for (uint32_t cpu : core.cpus)
+        {
+            CHECK(t.Find(cpu)->package == core.package);
+            CHECK(t.Find(cpu)->numaNode == core.package);
+        }
+    }
+    CHECK(Siblings(t, 0) == std::vector<uint32_t>{ siblingOf0 });
+    CHECK_EQ(t.Find(firstOfSocket1)->package, 1u);
+    CHECK_EQ(t.Find(firstOfSocket1 - 1)->package, 0u);
+
+    const Cpu* g1 = t.Find(firstOfGroup1);
+    CHECK(g1 && g1->group == 1 && g1->number == 0);
+    const Cpu* g0 = t.Find(firstOfGroup1 - 1);
+    CHECK(g0 && g0->group == 0);
+    CHECK_EQ(GroupMask(t, { firstOfGroup1, firstOfGroup1 + 1 }, 1), 3u);
+    CHECK_EQ(GroupMask(t, { firstOfGroup1 }, 0), 0u);
+    CHECK_EQ(GroupMask(t, { 0, firstOfGroup1 }, 0), 1u);
+
+    CHECK_EQ(CountCaches(t, 2), 36u);
+    CHECK_EQ(CountCaches(t, 3), 2u);
+    CheckPrivateL2(t, 0, false);
+    for (const auto& c : t.caches)
+        if (c.level == 3) CHECK_EQ(c.cpus.size(), 36u);
+}
+
+// ─── Malformed input ─────────────────────────────────────────────────────────
+
+static void CheckRejects(const std::string& raw, const std::string& dir)
+{
+    std::ifstream f(raw, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    Topology t;
+    std::string error;
+    CHECK(!data.empty() && !DecodeProcessorInformation(data.data(), data.size() - 1, t, error));
+    CHECK(!error.empty());
+    CHECK(!ParseSysfs(dir + "/no-such-root", t, error));
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: topology_test <tests/data/topology>\n");
+        return 2;
+    }
+    const std::string dir = argv[1];
+    Topology t;
+
+    if (LoadRaw(dir + "/hybrid-12700k/slpi.bin", t)) CheckHybrid(t);
+    else CHECK(!"hybrid-12700k slpi.bin");
+    if (LoadSysfs(dir + "/hybrid-12700k/sysfs", t)) CheckHybrid(t);
+    else CHECK(!"hybrid-12700k sysfs");
+
+    if (LoadRaw(dir + "/ryzen-5950x/slpi.bin", t)) CheckRyzen(t, 1);
+    else CHECK(!"ryzen-5950x slpi.bin");
+    if (LoadSysfs(dir + "/ryzen-5950x/sysfs", t)) CheckRyzen(t, 16);
+    else CHECK(!"ryzen-5950x sysfs");
+
+    // Windows: one group per socket (36 CPUs each), siblings adjacent.
+    // Linux: groups are index / 64, sockets interleave 0-17 / 18-35.
+    if (LoadRaw(dir + "/xeon-2x18/slpi.bin", t)) CheckXeon(t, 1, 36, 36);
+    else CHECK(!"xeon-2x18 slpi.bin");
+    if (LoadSysfs(dir + "/xeon-2x18/sysfs", t)) CheckXeon(t, 36, 18, 64);
+    else CHECK(!"xeon-2x18 sysfs");
+
+    CheckRejects(dir + "/ryzen-5950x/slpi.bin", dir);
+    return test_util::Finish("topology_test");
+}